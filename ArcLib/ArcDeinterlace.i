@@ -13,6 +13,9 @@
 #include <string>
 #include <vector>
 #include <CArcDeinterlace.h>
+#include <CArcAmpLayout.h>
+#include <CArcDeinterlacePlan.h>
+#include <CArcDeinterlaceBench.h>
 #include <CArcDeinterlaceDllMain.h>
 #include <CArcPluginManager.h>
 #include <CArcBase.h>
@@ -67,11 +70,28 @@
 
 /* cant do this because SWIG can't handle requires expressions from c++20 yet
 %import "CArcBase.h" */
+%include "std_unique_ptr.i"
+%include "std_string.i"
+%include "std_vector.i"
+%include "stdint.i"
+
+%unique_ptr(arc::gen3::CArcAmpLayout)
+
 %include "CArcDeinterlace.h"
+%include "CArcAmpLayout.h"
+%include "CArcDeinterlacePlan.h"
+%include "CArcDeinterlaceBench.h"
 
 //%template(arcDeinterlaceUint8) arc::gen3::CArcDeinterlace<uint8_t>;
 %template(arcDeinterlaceUint16) arc::gen3::CArcDeinterlace<arc::gen3::dlace::BPP_16>;
 %template(arcDeinterlaceUint32) arc::gen3::CArcDeinterlace<arc::gen3::dlace::BPP_32>;
+%template(arcDeinterlacePlanUint16) arc::gen3::CArcDeinterlacePlan<arc::gen3::dlace::BPP_16>;
+%template(arcDeinterlacePlanUint32) arc::gen3::CArcDeinterlacePlan<arc::gen3::dlace::BPP_32>;
+%template(arcDeinterlaceBenchUint16) arc::gen3::CArcDeinterlaceBench<arc::gen3::dlace::BPP_16>;
+%template(arcDeinterlaceBenchUint32) arc::gen3::CArcDeinterlaceBench<arc::gen3::dlace::BPP_32>;
+
+/* Template for measureAll() results */
+%template(vectorBench) std::vector<arc::gen3::dlace::Bench_t>;
 
 //%extend arcticICC::CameraConfig {
 //    std::string __repr__() const {
@@ -0,0 +1,144 @@
+%define ModuleDocStr
+"Python interface to CArcImage C++ code."
+%enddef
+
+%feature("autodoc", "1");
+%module(package="ArcLib", docstring=ModuleDocStr) ArcImage
+
+%{
+#include <initializer_list>
+#include <cstdint>
+#include <cstdarg>
+#include <memory>
+#include <string>
+#include <vector>
+#include <CArcImage.h>
+#include <CArcHistogram.h>
+#include <CArcPtc.h>
+#include <CArcStack.h>
+#include <CArcCombine.h>
+#include <CArcCalibrate.h>
+#include <CArcDisplayScale.h>
+#include <CArcCentroid.h>
+#include <CArcFrameVerifier.h>
+#include <CArcThreadPool.h>
+#include <CArcRampFit.h>
+#include <CArcImageTest.h>
+#include <CArcImageDllMain.h>
+#include <CArcBase.h>
+
+%}
+
+%init %{
+%}
+
+#define __attribute__(x)
+//#define GEN3_CARCBASE_API __attribute__((visibility( "default" )))
+#define GEN3_CARCIMAGE_API __attribute__((visibility( "default" )))
+
+// Specifies the default C++ to python exception handling interface
+%exception {
+    try {
+        $action
+    } catch (std::domain_error & e) {
+        PyErr_SetString(PyExc_ArithmeticError, e.what());
+        SWIG_fail;
+    } catch (std::invalid_argument & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        SWIG_fail;
+    } catch (std::length_error & e) {
+        PyErr_SetString(PyExc_IndexError, e.what());
+        SWIG_fail;
+    } catch (std::out_of_range & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        SWIG_fail;
+    } catch (std::logic_error & e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        SWIG_fail;
+    } catch (std::range_error & e) {
+        PyErr_SetString(PyExc_ValueError, e.what());
+        SWIG_fail;
+    } catch (std::underflow_error & e) {
+        PyErr_SetString(PyExc_ArithmeticError, e.what());
+        SWIG_fail;
+    } catch (std::overflow_error & e) {
+        PyErr_SetString(PyExc_OverflowError, e.what());
+        SWIG_fail;
+    } catch (std::runtime_error & e) {
+        PyErr_SetString(PyExc_RuntimeError, e.what());
+        SWIG_fail;
+    } catch (std::exception & e) {
+        PyErr_SetString(PyExc_Exception, e.what());
+        SWIG_fail;
+    } catch (...) {
+        SWIG_fail;
+    }
+}
+
+/* cant do this because SWIG can't handle requires expressions from c++20 yet
+%import "CArcBase.h" */
+%include "std_unique_ptr.i"
+%include "std_string.i"
+%include "std_vector.i"
+%include "std_pair.i"
+%include "typemaps.i"
+%include "stdint.i"
+
+%unique_ptr(arc::gen3::image::CStats)
+%unique_ptr(arc::gen3::image::CDifStats)
+
+/* CArcCentroid::offset() returns the guide offsets as a tuple */
+%apply double& OUTPUT { double& gDx, double& gDy };
+
+/* Python sets the pool size and executor; the task loops take C++ callables */
+%ignore arc::gen3::IArcExecutor::parallelFor;
+%ignore arc::gen3::IArcExecutor::parallelForBlocks;
+%ignore arc::gen3::CArcThreadPool::parallelFor;
+%include "CArcThreadPool.h"
+
+%include "CArcImage.h"
+%include "CArcHistogram.h"
+%include "CArcPtc.h"
+%include "CArcStack.h"
+%include "CArcCombine.h"
+%include "CArcCalibrate.h"
+%include "CArcDisplayScale.h"
+%include "CArcCentroid.h"
+%include "CArcFrameVerifier.h"
+%include "CArcRampFit.h"
+%include "CArcImageTest.h"
+
+%template(arcImageUint16) arc::gen3::CArcImage<arc::gen3::image::BPP_16>;
+%template(arcImageUint32) arc::gen3::CArcImage<arc::gen3::image::BPP_32>;
+%template(arcHistogramUint16) arc::gen3::CArcHistogram<arc::gen3::image::BPP_16>;
+%template(arcHistogramUint32) arc::gen3::CArcHistogram<arc::gen3::image::BPP_32>;
+%template(arcPtcUint16) arc::gen3::CArcPtc<arc::gen3::image::BPP_16>;
+%template(arcPtcUint32) arc::gen3::CArcPtc<arc::gen3::image::BPP_32>;
+%template(arcStackUint16) arc::gen3::CArcStack<arc::gen3::image::BPP_16>;
+%template(arcStackUint32) arc::gen3::CArcStack<arc::gen3::image::BPP_32>;
+%template(arcCombineUint16) arc::gen3::CArcCombine<arc::gen3::image::BPP_16>;
+%template(arcCombineUint32) arc::gen3::CArcCombine<arc::gen3::image::BPP_32>;
+%template(arcCalibrateUint16) arc::gen3::CArcCalibrate<arc::gen3::image::BPP_16>;
+%template(arcCalibrateUint32) arc::gen3::CArcCalibrate<arc::gen3::image::BPP_32>;
+%template(imageViewUint16) arc::gen3::image::ImageView<arc::gen3::image::BPP_16>;
+%template(imageViewUint32) arc::gen3::image::ImageView<arc::gen3::image::BPP_32>;
+%template(constImageViewUint16) arc::gen3::image::ImageView<const arc::gen3::image::BPP_16>;
+%template(constImageViewUint32) arc::gen3::image::ImageView<const arc::gen3::image::BPP_32>;
+%template(arcDisplayScaleUint16) arc::gen3::CArcDisplayScale<arc::gen3::image::BPP_16>;
+%template(arcDisplayScaleUint32) arc::gen3::CArcDisplayScale<arc::gen3::image::BPP_32>;
+%template(arcCentroidUint16) arc::gen3::CArcCentroid<arc::gen3::image::BPP_16>;
+%template(arcCentroidUint32) arc::gen3::CArcCentroid<arc::gen3::image::BPP_32>;
+%template(arcFrameVerifierUint16) arc::gen3::CArcFrameVerifier<arc::gen3::image::BPP_16>;
+%template(arcFrameVerifierUint32) arc::gen3::CArcFrameVerifier<arc::gen3::image::BPP_32>;
+%template(arcRampFitUint16) arc::gen3::CArcRampFit<arc::gen3::image::BPP_16>;
+%template(arcRampFitUint32) arc::gen3::CArcRampFit<arc::gen3::image::BPP_32>;
+%template(arcImageTestUint16) arc::gen3::CArcImageTest<arc::gen3::image::BPP_16>;
+%template(arcImageTestUint32) arc::gen3::CArcImageTest<arc::gen3::image::BPP_32>;
+
+/* Templates for the region lists, profile requests, display limits, sources and the PTC table */
+%template(pairDouble) std::pair<double, double>;
+%template(vectorPosition) std::vector<std::pair<double, double>>;
+%template(vectorSource) std::vector<arc::gen3::image::Source_t>;
+%template(vectorRoi) std::vector<arc::gen3::image::Roi_t>;
+%template(vectorProfile) std::vector<arc::gen3::image::Profile_t>;
+%template(vectorPtcPoint) std::vector<arc::gen3::image::PtcPoint_t>;
@@ -8,7 +8,13 @@ srcDict={}
 srcDict['ArcDeinterlace'] = glob.glob("src/ARC_API/3.6.2/CArcDeinterlace/src/*.cpp")
 srcDict['ArcDeinterlace'].append( "ArcLib/ArcDeinterlace.i")
 srcDict['ArcDeinterlace'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcBase.cpp")
+srcDict['ArcDeinterlace'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcThreadPool.cpp")
 srcDict['ArcDeinterlace'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcStringList.cpp")
+srcDict['ArcImage'] = glob.glob("src/ARC_API/3.6.2/CArcImage/src/*.cpp")
+srcDict['ArcImage'].append( "ArcLib/ArcImage.i")
+srcDict['ArcImage'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcBase.cpp")
+srcDict['ArcImage'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcThreadPool.cpp")
+srcDict['ArcImage'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcStringList.cpp")
 srcDict['ArcFitsFile'] = glob.glob("src/ARC_API/3.6.2/CArcFitsFile/src/*.cpp")
 srcDict['ArcFitsFile'].append( "ArcLib/ArcFitsFile.i")
 srcDict['ArcFitsFile'].append( "src/ARC_API/3.6.2/CArcBase/src/CArcStringList.cpp")
@@ -56,6 +62,21 @@ setup(
                     ],
                 swig_opts=swigOpts,
                 ),
+            Extension(
+                name="_ArcImage",
+                sources=srcDict['ArcImage'],
+                include_dirs=incList,
+                library_dirs=[
+                    ],
+                libraries=[
+                    ],
+                define_macros=[
+                    ],
+                extra_compile_args=[
+                    "-std=c++20",
+                    ],
+                swig_opts=swigOpts,
+                ),
             Extension(
                 name="_ArcFitsFile",
                 sources=srcDict['ArcFitsFile'],
@@ -0,0 +1,256 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcThreadPool.h  ( Gen3 )                                                                               |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC task executor interface and the shared work-stealing thread pool.            |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 25, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _CARCTHREADPOOL_H_
+#define _CARCTHREADPOOL_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <cstdint>
+#include <atomic>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <deque>
+
+#include <CArcBaseDllMain.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @interface IArcExecutor
+		 *  Task executor used by the library for all multithreaded image operations. The library uses the
+		 *  executor set with CArcThreadPool::setExecutor(), or a shared CArcThreadPool by default, so that every
+		 *  operation runs on the same long lived threads instead of creating threads per call. Implement this
+		 *  interface to run the library on an application's own threads.
+		 */
+		class GEN3_CARCBASE_API IArcExecutor
+		{
+			public:
+
+				/** Destructor
+				 */
+				virtual ~IArcExecutor( void );
+
+				/** Returns the number of tasks that may run concurrently.
+				 *  @return The executor thread count.
+				 */
+				virtual std::uint32_t concurrency( void ) const noexcept = 0;
+
+				/** Runs fnTask( i ) for every i in [ 0, uiCount ) and returns once all tasks are complete. The calling
+				 *  thread runs tasks too, so tasks may themselves call parallelFor().
+				 *  @param uiCount	- The number of tasks.
+				 *  @param fnTask	- The task function. Receives the task index.
+				 *  @throws The first exception thrown by a task.
+				 */
+				virtual void parallelFor( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnTask ) = 0;
+
+				/** Splits the range [ uiBegin, uiEnd ) into at most uiBlocks contiguous blocks of nearly equal size and
+				 *  runs fnBlock( uiBlock, uiFirst, uiLast ) for each block as one task.
+				 *  @param uiBegin	- The start of the range, e.g. the first row.
+				 *  @param uiEnd	- One past the end of the range.
+				 *  @param uiBlocks	- The maximum number of blocks.
+				 *  @param fnBlock	- The block function.
+				 *  @return The number of blocks.
+				 *  @throws The first exception thrown by a block.
+				 */
+				std::uint32_t parallelForBlocks( const std::uint32_t uiBegin, const std::uint32_t uiEnd, const std::uint32_t uiBlocks,
+												 const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBlock );
+
+				/** Reduces the range [ uiBegin, uiEnd ) in at most uiBlocks blocks. Each block folds its range into
+				 *  its own partial result with fnBlock( tPartial, uiFirst, uiLast ), starting from tInit, and the
+				 *  partial results are then combined in block order with fnCombine( tResult, tPartial ), so the result
+				 *  does not depend on which thread ran which block.
+				 *  @param uiBegin		- The start of the range.
+				 *  @param uiEnd		- One past the end of the range.
+				 *  @param uiBlocks		- The maximum number of blocks.
+				 *  @param tInit		- The initial value of every partial result.
+				 *  @param fnBlock		- The block function.
+				 *  @param fnCombine	- The combine function.
+				 *  @return The combined result.
+				 *  @throws The first exception thrown by a block.
+				 */
+				template <typename R, typename FB, typename FC>
+				R parallelReduce( const std::uint32_t uiBegin, const std::uint32_t uiEnd, const std::uint32_t uiBlocks, const R& tInit,
+								  FB&& fnBlock, FC&& fnCombine )
+				{
+					std::vector<R> vPartial( ( uiBlocks > 0 ? uiBlocks : 1 ), tInit );
+
+					const std::uint32_t uiCount = parallelForBlocks( uiBegin, uiEnd, uiBlocks, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+					{
+						fnBlock( vPartial[ uiBlock ], uiFirst, uiLast );
+					} );
+
+					R tResult = vPartial[ 0 ];
+
+					for ( std::uint32_t b = 1; b < uiCount; b++ )
+					{
+						fnCombine( tResult, vPartial[ b ] );
+					}
+
+					return tResult;
+				}
+		};
+
+
+		/** @class CArcThreadPool
+		 *  Work-stealing thread pool. Each worker owns a task queue; tasks queued by a worker go to its own queue
+		 *  and are taken newest first, while idle workers and waiting callers steal the oldest task from any other
+		 *  queue. A caller of parallelFor() runs tasks while it waits, so nested parallel loops cannot deadlock.
+		 *  Workers may be pinned to CPUs and restricted to the CPUs of one NUMA node.
+		 *  @see arc::gen3::IArcExecutor
+		 */
+		class GEN3_CARCBASE_API CArcThreadPool : public arc::gen3::IArcExecutor
+		{
+			public:
+
+				/** Constructor
+				 *  @param uiThreads	- The number of worker threads. Zero uses one per CPU available to the pool
+				 *						  ( default = 0 ).
+				 *  @param bPinThreads	- true to pin each worker to one CPU, round robin over the available CPUs
+				 *						  ( default = false ).
+				 *  @param iNumaNode	- The NUMA node whose CPUs the workers run on. Negative allows every CPU. If the
+				 *						  node is unknown the workers are not restricted ( default = -1 ).
+				 *  @throws std::runtime_error if a worker thread cannot be started.
+				 */
+				CArcThreadPool( const std::uint32_t uiThreads = 0, const bool bPinThreads = false, const std::int32_t iNumaNode = -1 );
+
+				/** Destructor
+				 *  Waits for the workers to finish the queued tasks and stops them.
+				 */
+				virtual ~CArcThreadPool( void );
+
+				CArcThreadPool( const CArcThreadPool& ) = delete;
+				CArcThreadPool& operator=( const CArcThreadPool& ) = delete;
+
+				/** Returns the number of worker threads.
+				 *  @return The worker count.
+				 */
+				std::uint32_t concurrency( void ) const noexcept override;
+
+				/** Runs fnTask( i ) for every i in [ 0, uiCount ) and returns once all tasks are complete. Task 0 runs
+				 *  on the calling thread.
+				 *  @param uiCount	- The number of tasks.
+				 *  @param fnTask	- The task function. Receives the task index.
+				 *  @throws The first exception thrown by a task.
+				 */
+				void parallelFor( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnTask ) override;
+
+				/** Returns the CPUs the workers may run on.
+				 *  @return The CPU numbers. Empty if the workers are not restricted.
+				 */
+				const std::vector<std::uint32_t>& cpus( void ) const noexcept;
+
+				/** Returns the executor used by the library. Unless one was set with setExecutor(), this is a shared
+				 *  pool with one worker per CPU, created on first use.
+				 *  @return The library executor.
+				 */
+				static arc::gen3::IArcExecutor& executor( void );
+
+				/** Sets the executor used by the library. The executor must outlive its use by the library.
+				 *  @param pExecutor - The executor. nullptr restores the shared pool.
+				 */
+				static void setExecutor( arc::gen3::IArcExecutor* pExecutor ) noexcept;
+
+			private:
+
+				/** A parallelFor() call in progress */
+				struct Job_t
+				{
+					const std::function<void( std::uint32_t )>*	pTask;
+					std::uint32_t								uiPending;
+					std::exception_ptr							pError;
+					std::mutex									tMutex;
+					std::condition_variable						tDone;
+				};
+
+				/** A queued task; one index of a job */
+				struct Task_t
+				{
+					Job_t*			pJob;
+					std::uint32_t	uiIndex;
+				};
+
+				/** A worker task queue */
+				struct Queue_t
+				{
+					std::mutex				tMutex;
+					std::deque<Task_t>		dTasks;
+				};
+
+				/** Worker thread loop.
+				 *  @param uiWorker - The worker index.
+				 */
+				void work( const std::uint32_t uiWorker );
+
+				/** Takes a task, newest first from the queue uiOwn, otherwise oldest first from any other queue.
+				 *  @param uiOwn	- The queue of the calling worker, or concurrency() for a thread outside the pool.
+				 *  @param tTask	- Receives the task.
+				 *  @return true if a task was taken.
+				 */
+				bool take( const std::uint32_t uiOwn, Task_t& tTask );
+
+				/** Runs a task and completes its job index.
+				 *  @param tTask - The task.
+				 */
+				static void run( const Task_t& tTask ) noexcept;
+
+				/** Returns the CPUs of a NUMA node.
+				 *  @param iNode - The NUMA node.
+				 *  @return The CPU numbers. Empty if the node is unknown.
+				 */
+				static std::vector<std::uint32_t> nodeCpus( const std::int32_t iNode );
+
+				/** Pins the calling thread to a set of CPUs.
+				 *  @param vCpus - The CPU numbers.
+				 */
+				static void pin( const std::vector<std::uint32_t>& vCpus ) noexcept;
+
+				/** Worker task queues */
+				std::vector<std::unique_ptr<Queue_t>> m_vQueues;
+
+				/** Worker threads */
+				std::vector<std::thread> m_vWorkers;
+
+				/** CPUs the workers may run on */
+				std::vector<std::uint32_t> m_vCpus;
+
+				/** Next queue for tasks queued from outside the pool */
+				std::atomic<std::uint32_t> m_uiNext;
+
+				/** Number of queued tasks */
+				std::atomic<std::uint64_t> m_uiQueued;
+
+				/** Idle worker wait */
+				std::mutex m_tIdleMutex;
+				std::condition_variable m_tIdle;
+
+				/** true once the pool is stopping */
+				bool m_bStop;
+
+				/** Executor set with setExecutor() */
+				static std::atomic<arc::gen3::IArcExecutor*> m_pExecutor;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _CARCTHREADPOOL_H_
@@ -0,0 +1,604 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcThreadPool.cpp  ( Gen3 )                                                                             |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC task executor interface and the shared work-stealing thread pool.         |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 25, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+#ifdef _WINDOWS
+	#include <windows.h>
+#else
+	#include <pthread.h>
+	#include <sched.h>
+#endif
+
+#include <system_error>
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <CArcThreadPool.h>
+#include <CArcBase.h>
+
+
+using namespace std::string_literals;
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace
+		{
+			// The pool and queue index of the calling worker thread; nullptr outside any pool.
+			thread_local const void* g_pWorkerPool = nullptr;
+			thread_local std::uint32_t g_uiWorkerQueue = 0;
+		}
+
+
+		std::atomic<arc::gen3::IArcExecutor*> CArcThreadPool::m_pExecutor{ nullptr };
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | IArcExecutor Destructor                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		IArcExecutor::~IArcExecutor( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  parallelForBlocks                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Splits the range [ uiBegin, uiEnd ) into at most uiBlocks contiguous blocks and runs each block as one  |
+		// |  task. A single block runs directly on the calling thread. Returns the number of blocks.                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiBegin  - The start of the range.                                                              |
+		// |  <IN> -> uiEnd    - One past the end of the range.                                                       |
+		// |  <IN> -> uiBlocks - The maximum number of blocks.                                                        |
+		// |  <IN> -> fnBlock  - The block function, called as fnBlock( uiBlock, uiFirst, uiLast ).                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t IArcExecutor::parallelForBlocks( const std::uint32_t uiBegin, const std::uint32_t uiEnd, const std::uint32_t uiBlocks,
+													   const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBlock )
+		{
+			const std::uint32_t uiCount = ( uiEnd > uiBegin ? ( uiEnd - uiBegin ) : 0 );
+
+			const std::uint32_t uiBlockCount = std::max( 1U, std::min( uiBlocks, uiCount ) );
+
+			auto blockFirst = [ & ]( std::uint32_t uiBlock )
+			{
+				return static_cast< std::uint32_t >( uiBegin + ( static_cast< std::uint64_t >( uiCount ) * uiBlock ) / uiBlockCount );
+			};
+
+			if ( uiBlockCount == 1 )
+			{
+				fnBlock( 0, uiBegin, ( uiBegin + uiCount ) );
+			}
+
+			else
+			{
+				parallelFor( uiBlockCount, [ & ]( std::uint32_t uiBlock ) { fnBlock( uiBlock, blockFirst( uiBlock ), blockFirst( uiBlock + 1 ) ); } );
+			}
+
+			return uiBlockCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Starts the worker threads.                                                                              |
+		// |                                                                                                          |
+		// |  <IN> -> uiThreads   - The number of worker threads. Zero uses one per available CPU.                    |
+		// |  <IN> -> bPinThreads - true to pin each worker to one CPU.                                               |
+		// |  <IN> -> iNumaNode   - The NUMA node to run on. Negative allows every CPU.                               |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		CArcThreadPool::CArcThreadPool( const std::uint32_t uiThreads, const bool bPinThreads, const std::int32_t iNumaNode )
+			: m_uiNext( 0 ), m_uiQueued( 0 ), m_bStop( false )
+		{
+			if ( iNumaNode >= 0 )
+			{
+				m_vCpus = nodeCpus( iNumaNode );
+			}
+
+			std::vector<std::uint32_t> vPinCpus = m_vCpus;
+
+			if ( bPinThreads && vPinCpus.empty() )
+			{
+				for ( std::uint32_t i = 0; i < std::max( 1U, std::thread::hardware_concurrency() ); i++ )
+				{
+					vPinCpus.push_back( i );
+				}
+			}
+
+			std::uint32_t uiCount = uiThreads;
+
+			if ( uiCount == 0 )
+			{
+				uiCount = ( m_vCpus.empty() ? std::max( 1U, std::thread::hardware_concurrency() ) : static_cast< std::uint32_t >( m_vCpus.size() ) );
+			}
+
+			for ( std::uint32_t i = 0; i < uiCount; i++ )
+			{
+				m_vQueues.push_back( std::make_unique<Queue_t>() );
+			}
+
+			try
+			{
+				for ( std::uint32_t i = 0; i < uiCount; i++ )
+				{
+					//  Pinned workers get one CPU each; otherwise a NUMA node restricts every worker to the whole node.
+					std::vector<std::uint32_t> vAffinity;
+
+					if ( bPinThreads )
+					{
+						vAffinity.push_back( vPinCpus[ i % vPinCpus.size() ] );
+					}
+
+					else
+					{
+						vAffinity = m_vCpus;
+					}
+
+					m_vWorkers.emplace_back( [ this, i, vAffinity ]()
+					{
+						if ( !vAffinity.empty() )
+						{
+							pin( vAffinity );
+						}
+
+						work( i );
+					} );
+				}
+			}
+			catch ( const std::system_error& e )
+			{
+				{
+					std::lock_guard<std::mutex> tLock( m_tIdleMutex );
+
+					m_bStop = true;
+				}
+
+				m_tIdle.notify_all();
+
+				for ( auto& rWorker : m_vWorkers )
+				{
+					rWorker.join();
+				}
+
+				throwArcGen3Error( "Failed to start worker thread [ %u of %u ]: %s", static_cast< std::uint32_t >( m_vWorkers.size() + 1 ), uiCount, e.what() );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		CArcThreadPool::~CArcThreadPool( void )
+		{
+			{
+				std::lock_guard<std::mutex> tLock( m_tIdleMutex );
+
+				m_bStop = true;
+			}
+
+			m_tIdle.notify_all();
+
+			for ( auto& rWorker : m_vWorkers )
+			{
+				rWorker.join();
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  concurrency                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of worker threads.                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t CArcThreadPool::concurrency( void ) const noexcept
+		{
+			return static_cast< std::uint32_t >( m_vQueues.size() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  parallelFor                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Runs fnTask( i ) for every i in [ 0, uiCount ). Tasks 1 to uiCount - 1 are queued, on the calling       |
+		// |  worker's own queue or spread over the worker queues for a thread outside the pool, and task 0 runs on   |
+		// |  the calling thread. The caller then takes queued tasks, its own or any other job's, until its job is    |
+		// |  complete, and only sleeps once no task is left to take.                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiCount - The number of tasks.                                                                  |
+		// |  <IN> -> fnTask  - The task function.                                                                    |
+		// |                                                                                                          |
+		// |  Throws the first exception thrown by a task.                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcThreadPool::parallelFor( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnTask )
+		{
+			if ( uiCount <= 1 )
+			{
+				if ( uiCount == 1 )
+				{
+					fnTask( 0 );
+				}
+
+				return;
+			}
+
+			const std::uint32_t uiQueues = concurrency();
+
+			const std::uint32_t uiOwn = ( g_pWorkerPool == this ? g_uiWorkerQueue : uiQueues );
+
+			Job_t tJob;
+
+			tJob.pTask = &fnTask;
+			tJob.uiPending = uiCount;
+
+			if ( uiOwn < uiQueues )
+			{
+				std::lock_guard<std::mutex> tLock( m_vQueues[ uiOwn ]->tMutex );
+
+				for ( std::uint32_t i = 1; i < uiCount; i++ )
+				{
+					m_vQueues[ uiOwn ]->dTasks.push_back( { &tJob, i } );
+				}
+			}
+
+			else
+			{
+				const std::uint32_t uiFirst = m_uiNext.fetch_add( ( uiCount - 1 ), std::memory_order_relaxed );
+
+				for ( std::uint32_t i = 1; i < uiCount; i++ )
+				{
+					auto& rQueue = *m_vQueues[ ( uiFirst + i ) % uiQueues ];
+
+					std::lock_guard<std::mutex> tLock( rQueue.tMutex );
+
+					rQueue.dTasks.push_back( { &tJob, i } );
+				}
+			}
+
+			m_uiQueued.fetch_add( ( uiCount - 1 ) );
+
+			{
+				std::lock_guard<std::mutex> tLock( m_tIdleMutex );
+			}
+
+			m_tIdle.notify_all();
+
+			run( { &tJob, 0 } );
+
+			Task_t tTask;
+
+			while ( true )
+			{
+				{
+					std::lock_guard<std::mutex> tLock( tJob.tMutex );
+
+					if ( tJob.uiPending == 0 )
+					{
+						break;
+					}
+				}
+
+				if ( take( uiOwn, tTask ) )
+				{
+					run( tTask );
+				}
+
+				else
+				{
+					//  Every remaining task of this job is running on another thread
+					std::unique_lock<std::mutex> tLock( tJob.tMutex );
+
+					tJob.tDone.wait( tLock, [ &tJob ]() { return ( tJob.uiPending == 0 ); } );
+
+					break;
+				}
+			}
+
+			if ( tJob.pError )
+			{
+				std::rethrow_exception( tJob.pError );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  cpus                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the CPUs the workers may run on. Empty if the workers are not restricted.                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		const std::vector<std::uint32_t>& CArcThreadPool::cpus( void ) const noexcept
+		{
+			return m_vCpus;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  executor                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the executor used by the library. The shared pool is created on first use and never destroyed,  |
+		// |  so that no worker is joined while the library is being unloaded.                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		arc::gen3::IArcExecutor& CArcThreadPool::executor( void )
+		{
+			auto pExecutor = m_pExecutor.load( std::memory_order_acquire );
+
+			if ( pExecutor != nullptr )
+			{
+				return *pExecutor;
+			}
+
+			static CArcThreadPool* pShared = new CArcThreadPool();
+
+			return *pShared;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setExecutor                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the executor used by the library.                                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> pExecutor - The executor. nullptr restores the shared pool.                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcThreadPool::setExecutor( arc::gen3::IArcExecutor* pExecutor ) noexcept
+		{
+			m_pExecutor.store( pExecutor, std::memory_order_release );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  work                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Worker thread loop. Runs tasks while any are queued and sleeps otherwise.                               |
+		// |                                                                                                          |
+		// |  <IN> -> uiWorker - The worker index.                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcThreadPool::work( const std::uint32_t uiWorker )
+		{
+			g_pWorkerPool = this;
+			g_uiWorkerQueue = uiWorker;
+
+			Task_t tTask;
+
+			while ( true )
+			{
+				if ( take( uiWorker, tTask ) )
+				{
+					run( tTask );
+
+					continue;
+				}
+
+				std::unique_lock<std::mutex> tLock( m_tIdleMutex );
+
+				m_tIdle.wait( tLock, [ this ]() { return ( m_bStop || m_uiQueued.load() > 0 ); } );
+
+				if ( m_bStop && m_uiQueued.load() == 0 )
+				{
+					break;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  take                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Takes the newest task from queue uiOwn, otherwise steals the oldest task from the other queues.         |
+		// |                                                                                                          |
+		// |  <IN>  -> uiOwn  - The queue of the calling worker, or concurrency() for a thread outside the pool.      |
+		// |  <OUT> -> tTask  - The task.                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		bool CArcThreadPool::take( const std::uint32_t uiOwn, Task_t& tTask )
+		{
+			const std::uint32_t uiQueues = concurrency();
+
+			if ( uiOwn < uiQueues )
+			{
+				auto& rQueue = *m_vQueues[ uiOwn ];
+
+				std::lock_guard<std::mutex> tLock( rQueue.tMutex );
+
+				if ( !rQueue.dTasks.empty() )
+				{
+					tTask = rQueue.dTasks.back();
+
+					rQueue.dTasks.pop_back();
+
+					m_uiQueued.fetch_sub( 1 );
+
+					return true;
+				}
+			}
+
+			for ( std::uint32_t i = 1; i <= uiQueues; i++ )
+			{
+				auto& rQueue = *m_vQueues[ ( uiOwn + i ) % uiQueues ];
+
+				std::lock_guard<std::mutex> tLock( rQueue.tMutex );
+
+				if ( !rQueue.dTasks.empty() )
+				{
+					tTask = rQueue.dTasks.front();
+
+					rQueue.dTasks.pop_front();
+
+					m_uiQueued.fetch_sub( 1 );
+
+					return true;
+				}
+			}
+
+			return false;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  run                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Runs a task, keeps the first exception of its job and completes the job index. The job may be released  |
+		// |  by its caller as soon as the job mutex is unlocked.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> tTask - The task.                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcThreadPool::run( const Task_t& tTask ) noexcept
+		{
+			std::exception_ptr pError;
+
+			try
+			{
+				( *tTask.pJob->pTask )( tTask.uiIndex );
+			}
+			catch ( ... )
+			{
+				pError = std::current_exception();
+			}
+
+			Job_t& rJob = *tTask.pJob;
+
+			std::lock_guard<std::mutex> tLock( rJob.tMutex );
+
+			if ( pError && !rJob.pError )
+			{
+				rJob.pError = pError;
+			}
+
+			if ( --rJob.uiPending == 0 )
+			{
+				rJob.tDone.notify_all();
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  nodeCpus                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the CPUs of a NUMA node, from the node cpulist in sysfs on Linux or the node processor mask on  |
+		// |  Windows. Returns an empty list if the node is unknown.                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> iNode - The NUMA node.                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::vector<std::uint32_t> CArcThreadPool::nodeCpus( const std::int32_t iNode )
+		{
+			std::vector<std::uint32_t> vCpus;
+
+		#ifdef _WINDOWS
+
+			ULONGLONG uiMask = 0;
+
+			if ( iNode <= 0xFF && GetNumaNodeProcessorMask( static_cast< UCHAR >( iNode ), &uiMask ) )
+			{
+				for ( std::uint32_t i = 0; i < 64; i++ )
+				{
+					if ( ( uiMask >> i ) & 1 )
+					{
+						vCpus.push_back( i );
+					}
+				}
+			}
+
+		#else
+
+			std::ifstream tFile( "/sys/devices/system/node/node"s + std::to_string( iNode ) + "/cpulist"s );
+
+			std::string sList;
+
+			if ( tFile && std::getline( tFile, sList ) )
+			{
+				//  The list has the form "0-3,8-11,16"
+				std::istringstream iss( sList );
+
+				std::string sRange;
+
+				while ( std::getline( iss, sRange, ',' ) )
+				{
+					std::uint32_t uiFirst = 0;
+					std::uint32_t uiLast = 0;
+
+					const auto uiDash = sRange.find( '-' );
+
+					try
+					{
+						uiFirst = static_cast< std::uint32_t >( std::stoul( sRange.substr( 0, uiDash ) ) );
+
+						uiLast = ( uiDash == std::string::npos ? uiFirst : static_cast< std::uint32_t >( std::stoul( sRange.substr( uiDash + 1 ) ) ) );
+					}
+					catch ( const std::exception& )
+					{
+						continue;
+					}
+
+					for ( std::uint32_t i = uiFirst; i <= uiLast; i++ )
+					{
+						vCpus.push_back( i );
+					}
+				}
+			}
+
+		#endif
+
+			return vCpus;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  pin                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Pins the calling thread to a set of CPUs. Failures are ignored; the thread then runs on any CPU.        |
+		// |                                                                                                          |
+		// |  <IN> -> vCpus - The CPU numbers.                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcThreadPool::pin( const std::vector<std::uint32_t>& vCpus ) noexcept
+		{
+		#ifdef _WINDOWS
+
+			DWORD_PTR uiMask = 0;
+
+			for ( auto uiCpu : vCpus )
+			{
+				if ( uiCpu < ( 8 * sizeof( DWORD_PTR ) ) )
+				{
+					uiMask |= ( static_cast< DWORD_PTR >( 1 ) << uiCpu );
+				}
+			}
+
+			if ( uiMask != 0 )
+			{
+				SetThreadAffinityMask( GetCurrentThread(), uiMask );
+			}
+
+		#else
+
+			cpu_set_t tSet;
+
+			CPU_ZERO( &tSet );
+
+			for ( auto uiCpu : vCpus )
+			{
+				if ( uiCpu < CPU_SETSIZE )
+				{
+					CPU_SET( uiCpu, &tSet );
+				}
+			}
+
+			if ( CPU_COUNT( &tSet ) > 0 )
+			{
+				pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &tSet );
+			}
+
+		#endif
+		}
+
+	}	// end gen3 namespace
+}		// end arc namespace
@@ -123,6 +123,20 @@ extern "C" {		// Using a C++ compiler
 	 */
 	GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_maxTVal( unsigned long long ulHandle, ArcStatus_t* pStatus );
 
+	/** Sets the scratch memory limit. Frames that need more scratch memory than the limit are deinterlaced
+	 *  with a memory-lean algorithm variant.
+	 *  @param ulHandle	- A reference to a deinterlace object.
+	 *  @param ulBytes	- The maximum number of scratch bytes. Zero always selects the memory-lean variants.
+	 *  @param pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.
+	 */
+	GEN3_CARCDEINTERLACE_API void ArcDLace_setMemoryLimit( unsigned long long ulHandle, unsigned long long ulBytes, ArcStatus_t* pStatus );
+
+	/** Returns the peak scratch memory used by the last deinterlace.
+	 *  @param ulHandle	- A reference to a deinterlace object.
+	 *  @param pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.
+	 */
+	GEN3_CARCDEINTERLACE_API unsigned long long ArcDLace_scratchBytes( unsigned long long ulHandle, ArcStatus_t* pStatus );
+
 	/** Returns true [ 1 ] if plugins were found; false [ 0 ] otherwise.
 	 *  @param ulHandle	- A reference to a deinterlace object.
 	 *  @param pszDir	- The directory to search for libraries in.
@@ -150,6 +164,20 @@ extern "C" {		// Using a C++ compiler
 	 */
 	GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginListCount( unsigned long long ulHandle, unsigned int uiPlugin, ArcStatus_t* pStatus );
 
+	/** Returns the interface version of a plugin; 1 or 2.
+	 *  @param ulHandle	- A reference to a deinterlace object.
+	 *  @param uiPlugin  - The plugin index. The range is 0 to ArcDLace_pluginCount().
+	 *  @param pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.
+	 */
+	GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginVersion( unsigned long long ulHandle, unsigned int uiPlugin, ArcStatus_t* pStatus );
+
+	/** Returns the capability flags of a plugin algorithm. See the arc::gen3::plugin::CAP_* flags in IArcPlugin.h.
+	 *  @param ulHandle	- A reference to a deinterlace object.
+	 *  @param pszAlg	- The deinterlace algorithm name. One of the strings returned from the pluginList() function.
+	 *  @param pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.
+	 */
+	GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginCapabilities( unsigned long long ulHandle, const char* pszAlg, ArcStatus_t* pStatus );
+
 	/** Executes a custom plugin deinterlace algorithm on the specified image buffer.
 	 *  @param ulHandle	- A reference to a deinterlace object.
 	 *  @param uiPlugin - The plugin index. The range is 0 to ArcDLace_pluginCount().
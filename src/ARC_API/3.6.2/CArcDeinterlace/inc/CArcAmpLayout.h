@@ -0,0 +1,197 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcAmpLayout.h  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC amplifier readout layout interface.                                          |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _GEN3_CARCAMPLAYOUT_H_
+#define _GEN3_CARCAMPLAYOUT_H_
+
+#ifdef _WINDOWS
+	#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <CArcDeinterlaceDllMain.h>
+#include <CArcDeinterlace.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace dlace
+		{
+
+			/** @enum e_Dir
+			 *  Defines the direction of an amplifier read within the deinterlaced image.
+			 */
+			enum class e_Dir : std::uint32_t
+			{
+				POS_X = 0,		/**< Increasing column */
+				NEG_X,			/**< Decreasing column */
+				POS_Y,			/**< Increasing row */
+				NEG_Y			/**< Decreasing row */
+			};
+
+
+			/** @struct Amp_t
+			 *  Describes one readout amplifier. The amplifier reads a uiWidth x uiHeight block of pixels, where
+			 *  uiWidth is measured along the fast ( serial ) direction and uiHeight along the slow ( parallel )
+			 *  direction. The first pixel read lands at column uiX, row uiY of the deinterlaced image.
+			 */
+			struct GEN3_CARCDEINTERLACE_API Amp_t
+			{
+				std::uint32_t	uiX;		/**< Destination column of the first pixel read */
+				std::uint32_t	uiY;		/**< Destination row of the first pixel read */
+				std::uint32_t	uiWidth;	/**< Number of pixels read along the fast direction */
+				std::uint32_t	uiHeight;	/**< Number of lines read along the slow direction */
+				e_Dir			eFast;		/**< Fast ( serial ) read direction */
+				e_Dir			eSlow;		/**< Slow ( parallel ) read direction. Must be perpendicular to eFast */
+				std::uint32_t	uiOrder;	/**< Position of the amplifier within the pixel interleave of its frame */
+				std::uint32_t	uiFrame;	/**< Raw stream frame. Frames follow each other in the raw data ( e.g. CDS ) */
+			};
+
+		}	// end dlace namespace
+
+
+		/** @class CArcAmpLayout
+		 *  Declarative description of a detector readout. A layout lists the amplifiers of a detector and how
+		 *  their pixels are interleaved in the raw data stream. Within a frame, the amplifiers are interleaved
+		 *  pixel by pixel in uiOrder order and must all read the same number of pixels per line and lines.
+		 *  Frames are stored one after the other. Layouts are compiled into a CArcDeinterlacePlan.
+		 *
+		 *  Layouts may also be described in text, one statement per line ( '#' starts a comment ):
+		 *
+		 *      size <cols> <rows>
+		 *      amp <x> <y> <width> <height> <fast> <slow> [ <order> [ <frame> ] ]
+		 *
+		 *  where <fast> and <slow> are one of +x, -x, +y, -y. If <order> is omitted the amplifiers are
+		 *  interleaved in the order listed; <frame> defaults to 0.
+		 *
+		 *  @see arc::gen3::CArcDeinterlacePlan
+		 *  @see arc::gen3::CArcBase
+		 */
+		class GEN3_CARCDEINTERLACE_API CArcAmpLayout : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  @param uiCols - The number of columns in the deinterlaced image.
+				 *  @param uiRows - The number of rows in the deinterlaced image.
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcAmpLayout( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcAmpLayout( void );
+
+				/** Adds an amplifier to the layout.
+				 *  @param tAmp - The amplifier description.
+				 *  @throws std::invalid_argument if the amplifier does not fit within the image.
+				 */
+				void addAmp( const arc::gen3::dlace::Amp_t& tAmp );
+
+				/** Adds an amplifier to the layout. The amplifier is interleaved after all previously added
+				 *  amplifiers of the same frame.
+				 *  @param uiX		- Destination column of the first pixel read.
+				 *  @param uiY		- Destination row of the first pixel read.
+				 *  @param uiWidth	- Number of pixels read along the fast direction.
+				 *  @param uiHeight	- Number of lines read along the slow direction.
+				 *  @param eFast	- Fast ( serial ) read direction.
+				 *  @param eSlow	- Slow ( parallel ) read direction.
+				 *  @param uiFrame	- Raw stream frame ( default = 0 ).
+				 *  @throws std::invalid_argument if the amplifier does not fit within the image.
+				 */
+				void addAmp( const std::uint32_t uiX, const std::uint32_t uiY, const std::uint32_t uiWidth, const std::uint32_t uiHeight,
+							 const arc::gen3::dlace::e_Dir eFast, const arc::gen3::dlace::e_Dir eSlow, const std::uint32_t uiFrame = 0 );
+
+				/** Returns the number of columns in the deinterlaced image.
+				 *  @return The image column count.
+				 */
+				std::uint32_t cols( void ) const noexcept;
+
+				/** Returns the number of rows in the deinterlaced image.
+				 *  @return The image row count.
+				 */
+				std::uint32_t rows( void ) const noexcept;
+
+				/** Returns the number of amplifiers in the layout.
+				 *  @return The amplifier count.
+				 */
+				std::uint32_t ampCount( void ) const noexcept;
+
+				/** Returns an amplifier description.
+				 *  @param uiIndex - The amplifier index. Range 0 to ampCount() - 1.
+				 *  @return The amplifier description.
+				 *  @throws std::out_of_range
+				 */
+				const arc::gen3::dlace::Amp_t& amp( const std::uint32_t uiIndex ) const;
+
+				/** Verifies that the layout is complete. Every image pixel must be read by exactly one amplifier and
+				 *  the amplifiers of each frame must have identical line length and line count.
+				 *  @throws std::invalid_argument if the layout is invalid.
+				 */
+				void validate( void ) const;
+
+				/** Returns a textual description of the layout. The text may be passed to fromString().
+				 *  @return The layout description.
+				 */
+				std::string toString( void ) const;
+
+				/** Creates the layout for one of the built-in deinterlace algorithms. The layout reproduces the
+				 *  CArcDeinterlace algorithm output exactly.
+				 *  @param eAlg		- The algorithm. Must not be e_Alg::CUSTOM.
+				 *  @param uiCols	- The number of columns in the image.
+				 *  @param uiRows	- The number of rows in the image.
+				 *  @param uiArg	- Algorithm dependent argument. HAWAII_RG requires the readout channel count ( default = 0 ).
+				 *  @return The algorithm layout. Has no amplifiers for e_Alg::NONE.
+				 *  @throws std::invalid_argument if the algorithm and geometry are incompatible.
+				 */
+				static std::unique_ptr<CArcAmpLayout> fromAlg( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg = 0 );
+
+				/** Creates a layout from its textual description. See the class description for the format.
+				 *  @param sLayout - The layout description.
+				 *  @return The layout.
+				 *  @throws std::invalid_argument if the description is invalid.
+				 */
+				static std::unique_ptr<CArcAmpLayout> fromString( const std::string& sLayout );
+
+				/** Creates a layout from a text file. See the class description for the format.
+				 *  @param sFile - The layout description file.
+				 *  @return The layout.
+				 *  @throws std::runtime_error if the file cannot be read.
+				 *  @throws std::invalid_argument if the description is invalid.
+				 */
+				static std::unique_ptr<CArcAmpLayout> fromFile( const std::string& sFile );
+
+			private:
+
+				/** Image columns */
+				std::uint32_t m_uiCols;
+
+				/** Image rows */
+				std::uint32_t m_uiRows;
+
+				/** Amplifier list */
+				std::vector<arc::gen3::dlace::Amp_t> m_vAmps;
+
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCAMPLAYOUT_H_
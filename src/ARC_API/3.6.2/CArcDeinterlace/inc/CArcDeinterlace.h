@@ -17,6 +17,7 @@
 #endif
 
 #include <initializer_list>
+#include <functional>
 #include <cstdint>
 #include <cstdarg>
 #include <memory>
@@ -93,10 +94,14 @@ namespace arc
 				 *  @param uiRows	- The number of rows in the buffer.
 				 *  @param eAlg		- The algorithm to use to deinterlace the buffer.
 				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @param uiThreads	- The number of threads. Zero uses one per library executor thread,
+				 *					  CArcThreadPool::executor() ( default = 0 ). The memory-lean variants run on the
+				 *					  calling thread.
 				 *  @see CArcDeinterlace::e_Alg
 				 *  @throws std::exception on error.
 				 */
-				void run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+				void run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList = {},
+						  const std::uint32_t uiThreads = 0 );
 
 
 				/** Deinterlace the buffer data using a custom algorithm loaded through the plugin manager.
@@ -109,6 +114,39 @@ namespace arc
 				 */
 				void run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
 
+				/** Deinterlace the buffer data using a plugin algorithm resolved through CArcPluginManager::resolve().
+				 *  Resolve the algorithm once and reuse it for every frame. Version 2 plugins that only support out of
+				 *  place operation are run through the instance scratch buffer, which is bound by setMemoryLimit(); if
+				 *  the frame exceeds the limit, algorithms with plugin::CAP_ROW_STREAM are run on bands of whole rows
+				 *  that fit the limit, and other algorithms throw.
+				 *  @param pBuf		- Pointer to the buffer to deinterlace.
+				 *  @param uiCols	- The number of columns in the buffer.
+				 *  @param uiRows	- The number of rows in the buffer.
+				 *  @param pAlg		- The resolved plugin algorithm.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @throws std::exception on error.
+				 */
+				void run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::PluginAlg_t* pAlg, const std::initializer_list<std::uint32_t>& tArgList = {} );
+
+				/** Deinterlace the source buffer into a separate destination buffer using a resolved plugin algorithm.
+				 *  Algorithms without out of place support are run in place on a copy of the source.
+				 *  @param pSrc		- Pointer to the buffer to deinterlace.
+				 *  @param pDst		- Pointer to the deinterlaced buffer. Must not overlap pSrc.
+				 *  @param uiCols	- The number of columns in the buffer.
+				 *  @param uiRows	- The number of rows in the buffer.
+				 *  @param pAlg		- The resolved plugin algorithm.
+				 *  @param tArgList	- A reference to a list of algorithm dependent arguments ( default = {}, empty list ).
+				 *  @throws std::exception on error.
+				 */
+				void run( const T* pSrc, T* pDst, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::PluginAlg_t* pAlg,
+						  const std::initializer_list<std::uint32_t>& tArgList = {} );
+
+				/** Sets the task executor passed to version 2 plugins. The built-in algorithms always run on the
+				 *  library executor, CArcThreadPool::executor().
+				 *  @param pExecutor - The executor. The default, nullptr, passes the library executor.
+				 */
+				void setPluginExecutor( arc::gen3::IArcPluginExecutor* pExecutor ) noexcept;
+
 				/** Returns the deinterlace plugin manager.
 				 *  @return The plugin manager.
 				 */
@@ -119,64 +157,143 @@ namespace arc
 				 */
 				std::uint32_t maxTVal( void ) noexcept;
 
+				/** Sets the scratch memory limit for this instance. The built-in algorithms normally deinterlace
+				 *  through a full frame scratch buffer. If a frame would need more scratch memory than the limit,
+				 *  a memory-lean variant is used instead: SERIAL and HAWAII_RG deinterlace one row at a time
+				 *  through a single row of scratch; all other algorithms deinterlace in place through a band of one
+				 *  line per amplifier, then move whole line segments into place by following permutation cycles.
+				 *  Any full frame buffer held by the instance is released when a lean variant runs. The limit also
+				 *  applies to version 2 plugin algorithms that only support out of place operation.
+				 *  @param uiBytes - The maximum number of scratch bytes. Zero always selects the lean variants.
+				 */
+				void setMemoryLimit( const std::uint64_t uiBytes ) noexcept;
+
+				/** Returns the scratch memory limit for this instance.
+				 *  @return The maximum number of scratch bytes. Unlimited by default.
+				 */
+				std::uint64_t getMemoryLimit( void ) const noexcept;
+
+				/** Returns the peak scratch memory used by the last call to run().
+				 *  @return The number of scratch bytes.
+				 */
+				std::uint64_t scratchBytes( void ) const noexcept;
+
 			protected:
 
 				/** Parallel deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void parallel( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void parallel( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
 
 				/** Serial deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void serial( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void serial( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
 
 				/** Quad CCD deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void quadCCD( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void quadCCD( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
 
 				/** Quad IR deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void quadIR( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void quadIR( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
 
 				/** Quad IR CDS ( correlated double sampling ) deinterlace algorithm.
 				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
 
 				/** Hawaii RG deinterlace algorithm.
 				 *  @param pBuf			- Pointer to the buffer data to deinterlace.
 				 *  @param uiCols		- The number of columns in the buffer.
 				 *  @param uiRows		- The number of rows in the buffer.
 				 *  @param uiChannels	- The number of channels in the image ( 16, 32, ... ).
+				 *  @param uiThreads	- The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void hawaiiRG( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiChannels );
+				void hawaiiRG( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiChannels, const std::uint32_t uiThreads );
 
 				/** STA 1600 deinterlace algorithm.
 				 *  @param pBuf	  - Pointer to the buffer data to deinterlace.
 				 *  @param uiCols - The number of columns in the buffer.
 				 *  @param uiRows - The number of rows in the buffer.
+				 *  @param uiThreads - The number of threads. Zero uses one per library executor thread.
 				 *  @throws std::exception on error.
 				 */
-				void sta1600( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+				void sta1600( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads );
+
+				/** Returns a scratch buffer of at least the specified size. Any larger buffer is released first if it
+				 *  exceeds the memory limit.
+				 *  @param uiCols - The number of scratch columns.
+				 *  @param uiRows - The number of scratch rows.
+				 *  @return A pointer to the scratch buffer.
+				 *  @throws std::runtime_error on error.
+				 */
+				T* scratch( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Returns the task executor passed to version 2 plugins.
+				 *  @return The executor set with setPluginExecutor(), or the library executor by default.
+				 */
+				arc::gen3::IArcPluginExecutor* pluginExecutor( void ) const;
+
+				/** Splits the rows [ 0, uiRows ) into one contiguous block per thread and runs fnBlock( uiFirstRow,
+				 *  uiEndRow ) for each block on CArcThreadPool::executor().
+				 *  @param uiRows		- The number of rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per library executor thread.
+				 *  @param fnBlock		- The block function.
+				 *  @throws The first exception thrown by a block.
+				 */
+				static void forEachRowBlock( const std::uint32_t uiRows, const std::uint32_t uiThreads, const std::function<void( std::uint32_t, std::uint32_t )>& fnBlock );
+
+				/** Serial deinterlace algorithm using one row of scratch memory.
+				 *  @param pBuf   - Pointer to the buffer data to deinterlace.
+				 *  @param uiCols - The number of columns in the buffer.
+				 *  @param uiRows - The number of rows in the buffer.
+				 *  @throws std::exception on error.
+				 */
+				void serialLean( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Hawaii RG deinterlace algorithm using one row of scratch memory.
+				 *  @param pBuf			- Pointer to the buffer data to deinterlace.
+				 *  @param uiCols		- The number of columns in the buffer.
+				 *  @param uiRows		- The number of rows in the buffer.
+				 *  @param uiChannels	- The number of channels in the image ( 16, 32, ... ).
+				 *  @throws std::exception on error.
+				 */
+				void hawaiiRGLean( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiChannels );
+
+				/** Deinterlaces the buffer in place using a band of one line per amplifier, followed by a cycle
+				 *  following permutation of whole line segments. Needs one bit of scratch memory per line segment.
+				 *  @param pBuf		- Pointer to the buffer data to deinterlace.
+				 *  @param uiCols	- The number of columns in the buffer.
+				 *  @param uiRows	- The number of rows in the buffer.
+				 *  @param eAlg		- The algorithm to use to deinterlace the buffer.
+				 *  @param uiArg	- Algorithm dependent argument.
+				 *  @throws std::exception on error.
+				 */
+				void permute( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiArg );
 
 				/** version() text holder */
 				static const std::string m_sVersion;
@@ -190,6 +307,15 @@ namespace arc
 				/** Intermediate buffer rows */
 				std::uint32_t m_uiNewRows;
 
+				/** Version 2 plugin executor; nullptr for the library executor */
+				arc::gen3::IArcPluginExecutor* m_pExecutor;
+
+				/** Scratch memory limit ( bytes ) */
+				std::uint64_t m_uiMemoryLimit;
+
+				/** Peak scratch memory used by the last run() ( bytes ) */
+				std::uint64_t m_uiScratchBytes;
+
 				/** Deinterlace plugin manager */
 				static std::unique_ptr<arc::gen3::CArcPluginManager> m_pPluginManager;
 
@@ -0,0 +1,207 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDeinterlaceBench.h  ( Gen3 )                                                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC deinterlace benchmark and verification interface.                            |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _GEN3_CARCDEINTERLACEBENCH_H_
+#define _GEN3_CARCDEINTERLACEBENCH_H_
+
+#ifdef _WINDOWS
+	#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <CArcDeinterlaceDllMain.h>
+#include <CArcDeinterlace.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace dlace
+		{
+
+			/** @struct Bench_t
+			 *  Deinterlace benchmark result for one algorithm, geometry and thread count. Throughput is given in
+			 *  image bytes deinterlaced per second, summed over all threads. The process peak resident set size
+			 *  never decreases, so it is only meaningful relative to earlier measurements.
+			 */
+			struct GEN3_CARCDEINTERLACE_API Bench_t
+			{
+				e_Alg			eAlg;				/**< Algorithm */
+				std::uint32_t	uiCols;				/**< Image columns */
+				std::uint32_t	uiRows;				/**< Image rows */
+				std::uint32_t	uiArg;				/**< Algorithm dependent argument */
+				std::uint32_t	uiThreads;			/**< Number of threads, each deinterlacing its own image */
+				std::uint32_t	uiBytesPerPixel;	/**< Image data type size */
+				double			gRunGBps;			/**< CArcDeinterlace::run() throughput ( GB/s ) */
+				double			gRunNsPerPixel;		/**< CArcDeinterlace::run() time per pixel ( ns ) */
+				double			gPlanCreateUs;		/**< CArcDeinterlacePlan creation time ( us ) */
+				double			gPlanGBps;			/**< CArcDeinterlacePlan::execute() in place throughput ( GB/s ) */
+				double			gPlanNsPerPixel;	/**< CArcDeinterlacePlan::execute() in place time per pixel ( ns ) */
+				double			gPlanCopyGBps;		/**< CArcDeinterlacePlan::execute() out of place throughput ( GB/s ) */
+				double			gPlanCopyNsPerPixel;/**< CArcDeinterlacePlan::execute() out of place time per pixel ( ns ) */
+				double			gLeanGBps;			/**< CArcDeinterlace::run() memory-lean variant throughput ( GB/s ) */
+				double			gLeanNsPerPixel;	/**< CArcDeinterlace::run() memory-lean variant time per pixel ( ns ) */
+				std::uint64_t	uiRunScratchBytes;	/**< CArcDeinterlace::run() scratch memory per thread ( bytes ) */
+				std::uint64_t	uiLeanScratchBytes;	/**< CArcDeinterlace::run() memory-lean variant scratch memory per thread ( bytes ) */
+				std::uint64_t	uiPeakRSS;			/**< Process peak resident set size after the measurement ( bytes ) */
+			};
+
+		}	// end dlace namespace
+
+
+		/** @class CArcDeinterlaceBench
+		 *  Deinterlace benchmark and correctness checker. Measures the throughput of CArcDeinterlace and
+		 *  CArcDeinterlacePlan over a grid of algorithms, image geometries and thread counts, and verifies their
+		 *  output against golden interlaced ramps. The golden data is generated from closed form readout
+		 *  equations that are independent of the deinterlace and layout code, so that optimization work can
+		 *  be checked against it.
+		 *  @see arc::gen3::CArcDeinterlace
+		 *  @see arc::gen3::CArcDeinterlacePlan
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::dlace::BPP_16>
+		class GEN3_CARCDEINTERLACE_API CArcDeinterlaceBench : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  @param uiIterations - The number of timed iterations per measurement ( default = 10 ).
+				 *  @throws std::invalid_argument if the iteration count is zero.
+				 */
+				CArcDeinterlaceBench( const std::uint32_t uiIterations = 10 );
+
+				/** Destructor
+				 */
+				virtual ~CArcDeinterlaceBench( void );
+
+				/** Benchmarks one algorithm and geometry. Each thread deinterlaces its own image, so the thread
+				 *  count measures how throughput scales with concurrent readouts. CArcDeinterlace::run() is measured
+				 *  both with the full frame scratch buffer and with the memory-lean variant ( memory limit of zero ).
+				 *  @param eAlg			- The algorithm to measure. Must not be e_Alg::CUSTOM.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiArg		- Algorithm dependent argument. HAWAII_RG requires the readout channel count ( default = 0 ).
+				 *  @param uiThreads	- The number of concurrent threads ( default = 1 ).
+				 *  @return The benchmark result.
+				 *  @throws std::invalid_argument if the algorithm and geometry are incompatible.
+				 *  @throws std::runtime_error on error.
+				 */
+				arc::gen3::dlace::Bench_t measure( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows,
+												   const std::uint32_t uiArg = 0, const std::uint32_t uiThreads = 1 );
+
+				/** Benchmarks every built-in algorithm over a grid of square geometries ( 512, 1024, 2048 and 4096
+				 *  pixels ) and thread counts ( powers of two up to uiMaxThreads ). HAWAII_RG is measured with 32
+				 *  readout channels.
+				 *  @param uiMaxThreads - The maximum number of concurrent threads ( default = 1 ).
+				 *  @return The list of benchmark results.
+				 *  @throws std::runtime_error on error.
+				 */
+				std::vector<arc::gen3::dlace::Bench_t> measureAll( const std::uint32_t uiMaxThreads = 1 );
+
+				/** Returns a printable table of benchmark results.
+				 *  @param vResults - The results to format.
+				 *  @return The formatted results.
+				 */
+				static std::string report( const std::vector<arc::gen3::dlace::Bench_t>& vResults );
+
+				/** Verifies the output of CArcDeinterlace::run(), including its memory-lean variant, and both
+				 *  CArcDeinterlacePlan::execute() methods against a golden interlaced ramp, and the round trip through CArcDeinterlacePlan::interlace().
+				 *  CDS plans are also checked with CArcDeinterlacePlan::cds().
+				 *  @param eAlg		- The algorithm to verify. Must not be e_Alg::CUSTOM.
+				 *  @param uiCols	- The number of image columns.
+				 *  @param uiRows	- The number of image rows.
+				 *  @param uiArg	- Algorithm dependent argument. HAWAII_RG requires the readout channel count ( default = 0 ).
+				 *  @throws std::runtime_error describing the first mismatched pixel if verification fails.
+				 *  @throws std::invalid_argument if the algorithm and geometry are incompatible.
+				 */
+				static void verify( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg = 0 );
+
+				/** Verifies every built-in algorithm over a grid of geometries, including non-square and
+				 *  non-power-of-two images and several HAWAII_RG channel counts.
+				 *  @throws std::runtime_error describing the first failure.
+				 */
+				static void verifyAll( void );
+
+				/** Fills a buffer with a golden interlaced ramp, i.e. the raw data stream a controller would deliver
+				 *  for an image whose pixel at index i holds goldenValue( i ).
+				 *  @param pBuf		- The buffer to fill. Must hold uiCols x uiRows pixels.
+				 *  @param eAlg		- The algorithm. Must not be e_Alg::CUSTOM.
+				 *  @param uiCols	- The number of image columns.
+				 *  @param uiRows	- The number of image rows.
+				 *  @param uiArg	- Algorithm dependent argument ( default = 0 ).
+				 *  @throws std::invalid_argument on error.
+				 */
+				static void fillGolden( T* pBuf, arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg = 0 );
+
+				/** Returns the peak resident set size of the calling process.
+				 *  @return The peak resident set size in bytes, or zero if it is not available.
+				 */
+				static std::uint64_t peakRSS( void ) noexcept;
+
+				/** Returns the golden value of the deinterlaced image pixel at the specified index. The value is a
+				 *  scrambled ramp so that misplaced pixels are detected even when the image holds more pixels than
+				 *  the data type can count.
+				 *  @param uiIndex - The deinterlaced image pixel index ( row x cols + col ).
+				 *  @return The golden pixel value.
+				 */
+				static T goldenValue( const std::uint64_t uiIndex ) noexcept;
+
+			protected:
+
+				/** Returns the deinterlaced image index of a raw data stream pixel using the closed form readout
+				 *  equations of the algorithm.
+				 *  @param eAlg		- The algorithm.
+				 *  @param uiCols	- The number of image columns.
+				 *  @param uiRows	- The number of image rows.
+				 *  @param uiArg	- Algorithm dependent argument.
+				 *  @param uiRaw	- The raw data stream index.
+				 *  @return The deinterlaced image index.
+				 */
+				static std::uint64_t goldenIndex( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows,
+												  const std::uint32_t uiArg, const std::uint64_t uiRaw ) noexcept;
+
+				/** Compares a deinterlaced buffer against the golden ramp.
+				 *  @param pBuf		- The deinterlaced buffer.
+				 *  @param uiCols	- The number of image columns.
+				 *  @param uiRows	- The number of image rows.
+				 *  @param sWhat	- Description of the tested method, used in the error message.
+				 *  @param eAlg		- The algorithm, used in the error message.
+				 *  @throws std::runtime_error describing the first mismatched pixel.
+				 */
+				static void compareGolden( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sWhat, arc::gen3::dlace::e_Alg eAlg );
+
+				/** Compares a re-interlaced buffer against the golden raw data stream.
+				 *  @param pBuf		- The re-interlaced buffer.
+				 *  @param pRaw		- The golden raw data stream.
+				 *  @param uiCols	- The number of image columns.
+				 *  @param uiRows	- The number of image rows.
+				 *  @param sWhat	- Description of the tested method, used in the error message.
+				 *  @param eAlg		- The algorithm, used in the error message.
+				 *  @throws std::runtime_error describing the first mismatched pixel.
+				 */
+				static void compareRaw( const T* pBuf, const T* pRaw, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sWhat, arc::gen3::dlace::e_Alg eAlg );
+
+				/** Timed iterations per measurement */
+				std::uint32_t m_uiIterations;
+
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCDEINTERLACEBENCH_H_
@@ -0,0 +1,278 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDeinterlacePlan.h  ( Gen3 )                                                                          |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC precomputed deinterlace plan interface.                                      |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#ifndef _GEN3_CARCDEINTERLACEPLAN_H_
+#define _GEN3_CARCDEINTERLACEPLAN_H_
+
+#ifdef _WINDOWS
+	#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <CArcDeinterlaceDllMain.h>
+#include <CArcDeinterlace.h>
+#include <CArcAmpLayout.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @class CArcDeinterlacePlan
+		 *  Precomputed deinterlace plan. A plan is created once for a fixed algorithm, image geometry and data type
+		 *  and may then be executed on any number of frames. All argument validation, index arithmetic and
+		 *  algorithm selection is done when the plan is created, so that execution is reduced to a set of
+		 *  strided copies. Plans also provide the inverse transform, which converts an image into the raw data
+		 *  stream the controller would deliver. Plans are created for one of the built-in algorithms or from an amplifier layout.
+		 *  Plans are not thread safe; use one plan per thread.
+		 *  @see arc::gen3::CArcDeinterlace
+		 *  @see arc::gen3::CArcAmpLayout
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::dlace::BPP_16>
+		class GEN3_CARCDEINTERLACE_API CArcDeinterlacePlan : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  @param eAlg		- The algorithm to use to deinterlace the buffer. Must not be e_Alg::CUSTOM.
+				 *  @param uiCols	- The number of columns in the buffer.
+				 *  @param uiRows	- The number of rows in the buffer.
+				 *  @param uiArg	- Algorithm dependent argument. HAWAII_RG requires the readout channel count ( default = 0 ).
+				 *  @throws std::invalid_argument if the algorithm and geometry are incompatible.
+				 *  @throws std::runtime_error on error.
+				 */
+				CArcDeinterlacePlan( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg = 0 );
+
+				/** Constructor
+				 *  @param tLayout - The amplifier layout that describes the detector readout. The plan algorithm is
+				 *                   reported as e_Alg::CUSTOM.
+				 *  @throws std::invalid_argument if the layout is invalid.
+				 *  @throws std::runtime_error on error.
+				 */
+				CArcDeinterlacePlan( const arc::gen3::CArcAmpLayout& tLayout );
+
+				/** Destructor
+				 */
+				virtual ~CArcDeinterlacePlan( void );
+
+				/** Deinterlaces the buffer in place. Uses the plans internal scratch buffer, allocated on first use.
+				 *  @param pBuf - Pointer to the buffer to deinterlace. Must hold cols() x rows() pixels.
+				 *  @throws std::invalid_argument if the buffer is nullptr.
+				 */
+				void execute( T* pBuf );
+
+				/** Deinterlaces the source buffer into the destination buffer. The buffers must not overlap. No
+				 *  scratch memory is used.
+				 *  @param pSrc - Pointer to the interlaced buffer. Must hold cols() x rows() pixels.
+				 *  @param pDst - Pointer to the deinterlaced result buffer. Must hold cols() x rows() pixels.
+				 *  @throws std::invalid_argument if either buffer is nullptr or the buffers are the same.
+				 */
+				void execute( const T* pSrc, T* pDst );
+
+				/** Re-interlaces the buffer in place. This is the inverse of execute(); it converts a deinterlaced
+				 *  image into the raw data stream the controller would deliver. Uses the plans internal scratch buffer.
+				 *  @param pBuf - Pointer to the image to re-interlace. Must hold cols() x rows() pixels.
+				 *  @throws std::invalid_argument if the buffer is nullptr.
+				 */
+				void interlace( T* pBuf );
+
+				/** Re-interlaces the source image into the destination buffer. This is the inverse of execute(). The
+				 *  buffers must not overlap. No scratch memory is used.
+				 *  @param pSrc - Pointer to the deinterlaced image. Must hold cols() x rows() pixels.
+				 *  @param pDst - Pointer to the raw data stream result buffer. Must hold cols() x rows() pixels.
+				 *  @throws std::invalid_argument if either buffer is nullptr or the buffers are the same.
+				 */
+				void interlace( const T* pSrc, T* pDst );
+
+				/** Deinterlaces a correlated double sampling ( CDS ) frame and subtracts its two halves in a single
+				 *  pass. The raw data is read once and only the difference image is written. The result is the
+				 *  same as execute() followed by CArcImage::subtractHalves(), but cannot wrap. The plan must have
+				 *  two frames with identical readouts, one above the other ( e.g. e_Alg::QUAD_IR_CDS ).
+				 *  @param pRaw - Pointer to the interlaced CDS buffer. Must hold cols() x rows() pixels.
+				 *  @param pDst - Pointer to the signed difference ( first frame - second frame ) buffer. Must hold
+				 *                cols() x rows() / 2 pixels. Values are saturated to the int32 range.
+				 *  @throws std::invalid_argument if either buffer is nullptr or the plan is not a CDS plan.
+				 */
+				void cds( const T* pRaw, std::int32_t* pDst );
+
+				/** Deinterlaces a CDS frame and subtracts its two halves in a single pass. See cds( const T*, std::int32_t* ).
+				 *  @param pRaw - Pointer to the interlaced CDS buffer. Must hold cols() x rows() pixels.
+				 *  @param pDst - Pointer to the difference ( first frame - second frame ) buffer. Must hold
+				 *                cols() x rows() / 2 pixels.
+				 *  @throws std::invalid_argument if either buffer is nullptr or the plan is not a CDS plan.
+				 */
+				void cds( const T* pRaw, float* pDst );
+
+				/** Deinterlaces a CDS frame and subtracts its two halves in a single pass. An offset is added to the
+				 *  difference and the result is saturated to the range of the data type, so that negative
+				 *  differences do not wrap. See cds( const T*, std::int32_t* ).
+				 *  @param pRaw		- Pointer to the interlaced CDS buffer. Must hold cols() x rows() pixels.
+				 *  @param pDst		- Pointer to the difference ( first frame - second frame + offset ) buffer. Must
+				 *					  hold cols() x rows() / 2 pixels. May be the same as pRaw.
+				 *  @param iOffset	- The offset added to every difference.
+				 *  @throws std::invalid_argument if either buffer is nullptr or the plan is not a CDS plan.
+				 */
+				void cds( const T* pRaw, T* pDst, const std::int64_t iOffset );
+
+				/** Returns whether the plan describes a CDS readout that can be used with cds().
+				 *  @return true if the plan has two frames with identical readouts, one above the other.
+				 */
+				bool isCDS( void ) const noexcept;
+
+				/** Returns the algorithm the plan was created for.
+				 *  @return The plan algorithm.
+				 */
+				arc::gen3::dlace::e_Alg algorithm( void ) const noexcept;
+
+				/** Returns the number of image columns the plan was created for.
+				 *  @return The plan column count.
+				 */
+				std::uint32_t cols( void ) const noexcept;
+
+				/** Returns the number of image rows the plan was created for.
+				 *  @return The plan row count.
+				 */
+				std::uint32_t rows( void ) const noexcept;
+
+				/** Returns the number of readout channels ( amplifiers ) interleaved in the raw data stream.
+				 *  @return The plan channel count. Zero if the plan does nothing ( i.e. e_Alg::NONE ).
+				 */
+				std::uint32_t channels( void ) const noexcept;
+
+			protected:
+
+				/** @struct Channel_t
+				 *  Precomputed placement of one readout channel within the deinterlaced image.
+				 */
+				struct Channel_t
+				{
+					std::int64_t iDstStart;			/**< Destination index of the first pixel read by the channel */
+					std::int64_t iFastStep;			/**< Destination index step between consecutive pixels of a line */
+					std::int64_t iSlowStep;			/**< Destination index step between consecutive lines */
+				};
+
+				/** @struct Section_t
+				 *  A contiguous section of the raw data stream in which a fixed set of channels are interleaved
+				 *  pixel by pixel.
+				 */
+				struct Section_t
+				{
+					std::uint64_t			uiSrcOffset;	/**< Raw stream index of the first pixel in the section */
+					std::uint32_t			uiFastLen;		/**< Number of pixels per channel line */
+					std::uint32_t			uiSlowLen;		/**< Number of lines per channel */
+					std::vector<Channel_t>	vChannels;		/**< Channels in raw stream interleave order */
+				};
+
+				/** Builds the copy schedule from an amplifier layout.
+				 *  @param tLayout - The amplifier layout. Must match the plan geometry.
+				 *  @throws std::invalid_argument if the layout is invalid.
+				 */
+				void compile( const arc::gen3::CArcAmpLayout& tLayout );
+
+				/** Returns the scratch buffer used for in place execution, allocating it on first use, so that plans
+				 *  only used out of place hold no scratch memory.
+				 *  @return Pointer to the cols() x rows() pixel scratch buffer.
+				 *  @throws std::runtime_error on error.
+				 */
+				T* scratch( void );
+
+				/** Appends a new, empty section to the schedule.
+				 *  @param uiSrcOffset	- Raw stream index of the first pixel in the section.
+				 *  @param uiFastLen	- Number of pixels per channel line.
+				 *  @param uiSlowLen	- Number of lines per channel.
+				 *  @return A reference to the new section.
+				 */
+				Section_t& addSection( const std::uint64_t uiSrcOffset, const std::uint32_t uiFastLen, const std::uint32_t uiSlowLen );
+
+				/** Appends a channel to a section. The next channel in raw stream interleave order is added.
+				 *  @param tSection	- The section to add the channel to.
+				 *  @param tAmp		- The amplifier read by the channel.
+				 */
+				void addChannel( Section_t& tSection, const arc::gen3::dlace::Amp_t& tAmp );
+
+				/** Executes one section of the schedule with a compile time channel count.
+				 *  @param tSection - The section to execute.
+				 *  @param pSrc		- Pointer to the interlaced buffer.
+				 *  @param pDst		- Pointer to the deinterlaced result buffer.
+				 */
+				template <std::uint32_t N>
+				static void executeSection( const Section_t& tSection, const T* pSrc, T* pDst );
+
+				/** Executes one section of the schedule with a run time channel count.
+				 *  @param tSection - The section to execute.
+				 *  @param pSrc		- Pointer to the interlaced buffer.
+				 *  @param pDst		- Pointer to the deinterlaced result buffer.
+				 */
+				static void executeSectionN( const Section_t& tSection, const T* pSrc, T* pDst );
+
+				/** Re-interlaces one section of the schedule with a compile time channel count.
+				 *  @param tSection - The section to re-interlace.
+				 *  @param pSrc		- Pointer to the deinterlaced image.
+				 *  @param pDst		- Pointer to the raw data stream result buffer.
+				 */
+				template <std::uint32_t N>
+				static void interlaceSection( const Section_t& tSection, const T* pSrc, T* pDst );
+
+				/** Re-interlaces one section of the schedule with a run time channel count.
+				 *  @param tSection - The section to re-interlace.
+				 *  @param pSrc		- Pointer to the deinterlaced image.
+				 *  @param pDst		- Pointer to the raw data stream result buffer.
+				 */
+				static void interlaceSectionN( const Section_t& tSection, const T* pSrc, T* pDst );
+
+				/** Deinterlaces and subtracts the two frames of a CDS plan.
+				 *  @param pRaw		- Pointer to the interlaced CDS buffer.
+				 *  @param pDst		- Pointer to the difference buffer.
+				 *  @param iOffset	- The offset added to every difference.
+				 *  @throws std::invalid_argument on error.
+				 */
+				template <typename D>
+				void cdsDispatch( const T* pRaw, D* pDst, const std::int64_t iOffset );
+
+				/** Deinterlaces and subtracts the two frames of a CDS plan with a compile time channel count.
+				 *  @param tFirst	- The first frame section.
+				 *  @param tSecond	- The second frame section.
+				 *  @param pRaw		- Pointer to the interlaced CDS buffer.
+				 *  @param pDst		- Pointer to the difference buffer.
+				 *  @param iOffset	- The offset added to every difference.
+				 */
+				template <typename D, std::uint32_t N>
+				static void cdsSection( const Section_t& tFirst, const Section_t& tSecond, const T* pRaw, D* pDst, const std::int64_t iOffset );
+
+				/** Plan algorithm */
+				arc::gen3::dlace::e_Alg m_eAlg;
+
+				/** Plan image columns */
+				std::uint32_t m_uiCols;
+
+				/** Plan image rows */
+				std::uint32_t m_uiRows;
+
+				/** The copy schedule */
+				std::vector<Section_t> m_vSections;
+
+				/** Scratch buffer used for in place execution; nullptr until first needed */
+				std::unique_ptr<T[]> m_pScratch;
+
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCDEINTERLACEPLAN_H_
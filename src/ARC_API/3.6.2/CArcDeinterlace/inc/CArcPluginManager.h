@@ -16,6 +16,8 @@
 	#include <windows.h>
 #endif
 
+#include <unordered_map>
+#include <string>
 #include <vector>
 
 #include <CArcDeinterlaceDllMain.h>
@@ -34,6 +36,7 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		typedef arc::gen3::IArcPlugin* ( *PluginCreate )( );
 		typedef void( *PluginRelease )( IArcPlugin* );
+		typedef std::uint32_t( *PluginVersion )( );
 
 
 		/**
@@ -55,6 +58,21 @@ namespace arc
 			PluginCreate	ctor;
 			PluginRelease	dtor;
 			IArcPlugin*		pObj;
+			std::uint32_t	uiVersion;
+		};
+
+
+		/**
+		 * Resolved plugin algorithm. Returned by CArcPluginManager::resolve() and valid for the lifetime of
+		 * the plugin manager.
+		 */
+		struct PluginAlg_t
+		{
+			IArcPlugin*		pObj;		/**< Plugin object */
+			IArcPlugin2*	pObj2;		/**< Version 2 plugin object, nullptr for version 1 plugins */
+			std::string		sAlg;		/**< Algorithm name */
+			std::uint32_t	uiAlg;		/**< Version 2 algorithm handle */
+			std::uint32_t	uiCaps;		/**< Capability flags. Version 1 algorithms only report plugin::CAP_IN_PLACE */
 		};
 
 
@@ -98,6 +116,21 @@ namespace arc
 				 */
 				std::uint32_t pluginCount( void );
 
+				/** Returns the interface version of a loaded plugin.
+				 *  @param uiIndex - The plugin index. Range 0 to pluginCount() - 1.
+				 *  @return The plugin interface version; plugin::VERSION_1 or plugin::VERSION_2.
+				 *  @throws std::out_of_range
+				 */
+				std::uint32_t pluginVersion( std::uint32_t uiIndex );
+
+				/** Looks up an algorithm by name in the index of all loaded plugin algorithms. If more than one plugin
+				 *  provides the algorithm, the first plugin loaded is used. The result should be kept and reused for
+				 *  every frame.
+				 *  @param sAlg - The algorithm name.
+				 *  @return The resolved algorithm, or nullptr if no loaded plugin provides it.
+				 */
+				const arc::gen3::PluginAlg_t* resolve( const std::string& sAlg ) const;
+
 			private:
 
 				/** Returns the list of files within the specified directory path. Note: the "." and ".." path listings are excluded from the list.
@@ -121,8 +154,17 @@ namespace arc
 				 */
 				Plugin_t* createInstance( ArcPluginLib hPluginLib );
 
+				/** Adds the algorithms of a plugin to the algorithm index.
+				 *  @param pPlugin - The plugin.
+				 *  @throws std::exception on error.
+				 */
+				void indexPlugin( const Plugin_t* pPlugin );
+
 				/** The plugin list */
 				std::vector<Plugin_t*> m_pluginMap;
+
+				/** Algorithm name index */
+				std::unordered_map<std::string, arc::gen3::PluginAlg_t> m_algIndex;
 		};
 
 	}
@@ -11,12 +11,14 @@
 #ifndef _GEN3_IPLUGIN_H_
 #define _GEN3_IPLUGIN_H_
 
+#include <functional>
 #include <memory>
 #include <cstdint>
 #include <string>
 
 #include <CArcDeinterlaceDllMain.h>
 #include <CArcStringList.h>
+#include <CArcThreadPool.h>
 #include <CArcBase.h>
 
 
@@ -32,6 +34,31 @@ namespace arc
 	namespace gen3
 	{
 
+		namespace plugin
+		{
+
+			/** Plugin interface versions. A plugin library declares its version by exporting the C function
+			 *  "std::uint32_t pluginVersion( void )". Libraries without this function are version 1 plugins.
+			 */
+			constexpr std::uint32_t VERSION_1			= static_cast<std::uint32_t>( 1 );
+			constexpr std::uint32_t VERSION_2			= static_cast<std::uint32_t>( 2 );
+
+			/** Version 2 algorithm capability flags. See IArcPlugin2::capabilities(). */
+			constexpr std::uint32_t CAP_IN_PLACE		= static_cast<std::uint32_t>( 0x1 );	// Supports execute()
+			constexpr std::uint32_t CAP_OUT_OF_PLACE	= static_cast<std::uint32_t>( 0x2 );	// Supports executeOutOfPlace()
+			constexpr std::uint32_t CAP_MULTI_THREAD	= static_cast<std::uint32_t>( 0x4 );	// Uses the supplied executor
+			constexpr std::uint32_t CAP_ROW_STREAM		= static_cast<std::uint32_t>( 0x8 );	// Any band of whole rows may be deinterlaced as an image of its own
+
+		}	// end plugin namespace
+
+
+		/** Host task executor supplied to version 2 plugins, so that multithreaded algorithms share the host
+		 *  threads instead of creating their own. This is the library executor interface.
+		 *  @see arc::gen3::IArcExecutor
+		 */
+		using IArcPluginExecutor = arc::gen3::IArcExecutor;
+
+
 		/** @interface IArcPlugin
 		 *  Deinterlace plugin interface. Abstract class.
 		 *  @see arc::gen3::CArcBase()
@@ -78,6 +105,88 @@ namespace arc
 				std::unique_ptr<arc::gen3::CArcStringList> m_pList;
 		};
 
+
+		/** @interface IArcPlugin2
+		 *  Version 2 deinterlace plugin interface. Abstract class. Algorithms are resolved to a handle once,
+		 *  through resolve(), and then executed by handle, so no name lookup is done per frame. Each algorithm
+		 *  reports its capabilities. The version 1 run() method is implemented on top of execute(), so that
+		 *  version 2 plugins may also be used by version 1 hosts.
+		 *
+		 *  Version 2 plugin libraries must export "pluginVersion", returning plugin::VERSION_2, in addition to
+		 *  "createPlugin" and "releasePlugin".
+		 *
+		 *  @see arc::gen3::IArcPlugin()
+		 */
+		class GEN3_CARCDEINTERLACE_API IArcPlugin2 : public IArcPlugin
+		{
+
+			public:
+
+				/** Destructor
+				 */
+				virtual ~IArcPlugin2( void );
+
+				/** Returns the handle of an algorithm. The default implementation returns the index of the
+				 *  algorithm within the name list.
+				 *  @param sAlg - The deinterlace algorithm name. One of the strings returned from the getNameList() method.
+				 *  @return The algorithm handle.
+				 *  @throws std::invalid_argument if the algorithm is not supported.
+				 */
+				virtual std::uint32_t resolve( const std::string& sAlg );
+
+				/** Returns the capabilities of an algorithm.
+				 *  @param uiAlg - The algorithm handle returned from resolve().
+				 *  @return A bitwise OR of the plugin::CAP_* flags.
+				 */
+				virtual std::uint32_t capabilities( const std::uint32_t uiAlg ) = 0;
+
+				/** Executes a deinterlace algorithm in place. Requires plugin::CAP_IN_PLACE.
+				 *  @param uiAlg		- The algorithm handle returned from resolve().
+				 *  @param pBuf			- The buffer to deinterlace.
+				 *  @param uiCols		- The number of columns in the image.
+				 *  @param uiRows		- The number of rows in the image.
+				 *  @param uiBpp		- The bits-per-pixel for the buffer data.
+				 *  @param uiArg		- Algorithm argument.
+				 *  @param pExecutor	- Host task executor. May be nullptr, in which case the algorithm runs on the calling thread.
+				 *  @throws std::runtime_error on error
+				 */
+				virtual void execute( const std::uint32_t uiAlg, void* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiBpp,
+									  const std::uint32_t uiArg, arc::gen3::IArcPluginExecutor* pExecutor ) = 0;
+
+				/** Executes a deinterlace algorithm from a source buffer into a separate destination buffer. Requires
+				 *  plugin::CAP_OUT_OF_PLACE. The default implementation throws.
+				 *  @param uiAlg		- The algorithm handle returned from resolve().
+				 *  @param pSrc			- The interlaced source buffer.
+				 *  @param pDst			- The deinterlaced destination buffer. Must not overlap pSrc.
+				 *  @param uiCols		- The number of columns in the image.
+				 *  @param uiRows		- The number of rows in the image.
+				 *  @param uiBpp		- The bits-per-pixel for the buffer data.
+				 *  @param uiArg		- Algorithm argument.
+				 *  @param pExecutor	- Host task executor. May be nullptr, in which case the algorithm runs on the calling thread.
+				 *  @throws std::runtime_error on error
+				 */
+				virtual void executeOutOfPlace( const std::uint32_t uiAlg, const void* pSrc, void* pDst, const std::uint32_t uiCols, const std::uint32_t uiRows,
+												const std::uint32_t uiBpp, const std::uint32_t uiArg, arc::gen3::IArcPluginExecutor* pExecutor );
+
+				/** Version 1 entry point. Resolves the algorithm and executes it on the calling thread. Algorithms with
+				 *  plugin::CAP_IN_PLACE are executed in place; algorithms with only plugin::CAP_OUT_OF_PLACE are
+				 *  executed from a full frame copy of the buffer back into the buffer.
+				 *  @param pBuf		- The buffer to deinterlace.
+				 *  @param uiCols	- The number of columns in the image.
+				 *  @param uiRows	- The number of rows in the image.
+				 *  @param uiBpp	- The bits-per-pixel for the buffer data.
+				 *  @param sAlg		- The deinterlace algorithm name. One of the strings returned from the getNameList() method.
+				 *  @param uiArg	- Optional algorithm argument ( default = 0 ).
+				 *  @throws std::runtime_error on error
+				 */
+				void run( void* pBuf, std::uint32_t uiCols, std::uint32_t uiRows, const std::uint32_t uiBpp, const std::string& sAlg, std::uint32_t uiArg = 0 ) override;
+
+			protected:
+
+				/** Constructor */
+				IArcPlugin2( void );
+		};
+
 	}		// end gen3 namespace
 }			// end arc namespace
 
@@ -277,6 +277,78 @@ GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_maxTVal( unsigned long long ulHan
 }
 
 
+// +------------------------------------------------------------------------------------------------------------------+
+// |  ArcDLace_setMemoryLimit                                                                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  Sets the scratch memory limit. Frames that need more scratch memory than the limit are deinterlaced with a      |
+// |  memory-lean algorithm variant.                                                                                  |
+// |                                                                                                                  |
+// |  <IN>  -> ulHandle	- A reference to a deinterlace object.                                                        |
+// |  <IN>  -> ulBytes	- The maximum number of scratch bytes.                                                        |
+// |  <OUT> -> pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+GEN3_CARCDEINTERLACE_API void ArcDLace_setMemoryLimit( unsigned long long ulHandle, unsigned long long ulBytes, ArcStatus_t* pStatus )
+{
+	try
+	{
+		VERIFY_INSTANCE_HANDLE( ulHandle )
+
+			INIT_STATUS( pStatus, ARC_STATUS_OK );
+
+		if ( ulHandle == reinterpret_cast< std::uint64_t >( g_pDLace16.get() ) )
+		{
+			g_pDLace16->setMemoryLimit( ulBytes );
+		}
+
+		else if ( ulHandle == reinterpret_cast< std::uint64_t >( g_pDLace32.get() ) )
+		{
+			g_pDLace32->setMemoryLimit( ulBytes );
+		}
+	}
+	catch ( std::exception& e )
+	{
+		SET_ERROR_STATUS( pStatus, e );
+	}
+}
+
+
+// +------------------------------------------------------------------------------------------------------------------+
+// |  ArcDLace_scratchBytes                                                                                           |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  Returns the peak scratch memory used by the last deinterlace.                                                   |
+// |                                                                                                                  |
+// |  <IN>  -> ulHandle	- A reference to a deinterlace object.                                                        |
+// |  <OUT> -> pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+GEN3_CARCDEINTERLACE_API unsigned long long ArcDLace_scratchBytes( unsigned long long ulHandle, ArcStatus_t* pStatus )
+{
+	unsigned long long ulBytes = 0;
+
+	try
+	{
+		VERIFY_INSTANCE_HANDLE( ulHandle )
+
+			INIT_STATUS( pStatus, ARC_STATUS_OK );
+
+		if ( ulHandle == reinterpret_cast< std::uint64_t >( g_pDLace16.get() ) )
+		{
+			ulBytes = g_pDLace16->scratchBytes();
+		}
+
+		else if ( ulHandle == reinterpret_cast< std::uint64_t >( g_pDLace32.get() ) )
+		{
+			ulBytes = g_pDLace32->scratchBytes();
+		}
+	}
+	catch ( std::exception& e )
+	{
+		SET_ERROR_STATUS( pStatus, e );
+	}
+
+	return ulBytes;
+}
+
+
 // +------------------------------------------------------------------------------------------------------------------+
 // |  ArcDLace_findPlugins                                                                                            |
 // +------------------------------------------------------------------------------------------------------------------+
@@ -419,6 +491,87 @@ GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginListCount( unsigned long lo
 }
 
 
+// +------------------------------------------------------------------------------------------------------------------+
+// |  ArcDLace_pluginVersion                                                                                          |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  Returns the interface version of a plugin.                                                                      |
+// |                                                                                                                  |
+// |  <IN>  -> ulHandle	- A reference to a deinterlace object.                                                        |
+// |  <IN>  -> uiPlugin - The plugin index. The range is 0 to ArcDLace_pluginCount().                                 |
+// |  <OUT> -> pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginVersion( unsigned long long ulHandle, unsigned int uiPlugin, ArcStatus_t* pStatus )
+{
+	unsigned int uiVersion = 0;
+
+	INIT_STATUS( pStatus, ARC_STATUS_OK )
+
+		try
+	{
+		VERIFY_INSTANCE_HANDLE( ulHandle )
+
+			auto pluginManager = GET_PLUGIN_MANAGER( ulHandle );
+
+		if ( uiPlugin >= pluginManager->pluginCount() )
+		{
+			throwArcGen3InvalidArgument( "Invalid plugin value [ %u ], expected range: 0 to %u", uiPlugin, pluginManager->pluginCount() );
+		}
+
+		uiVersion = pluginManager->pluginVersion( uiPlugin );
+	}
+	catch ( std::exception& e )
+	{
+		SET_ERROR_STATUS( pStatus, e );
+	}
+
+	return uiVersion;
+}
+
+
+// +------------------------------------------------------------------------------------------------------------------+
+// |  ArcDLace_pluginCapabilities                                                                                     |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  Returns the capability flags of a plugin algorithm.                                                             |
+// |                                                                                                                  |
+// |  <IN>  -> ulHandle	- A reference to a deinterlace object.                                                        |
+// |  <IN>  -> pszAlg	- The deinterlace algorithm name.                                                             |
+// |  <OUT> -> pStatus	- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+GEN3_CARCDEINTERLACE_API unsigned int ArcDLace_pluginCapabilities( unsigned long long ulHandle, const char* pszAlg, ArcStatus_t* pStatus )
+{
+	unsigned int uiCaps = 0;
+
+	INIT_STATUS( pStatus, ARC_STATUS_OK )
+
+		try
+	{
+		VERIFY_INSTANCE_HANDLE( ulHandle )
+
+			auto pluginManager = GET_PLUGIN_MANAGER( ulHandle );
+
+		if ( pszAlg == nullptr )
+		{
+			throwArcGen3InvalidArgument( std::string( "Invalid algorithm name parameter ( NULL )." ) );
+		}
+
+		auto pAlg = pluginManager->resolve( pszAlg );
+
+		if ( pAlg == nullptr )
+		{
+			throwArcGen3InvalidArgument( "Algorithm [ \'%s\' ] not found!", pszAlg );
+		}
+
+		uiCaps = pAlg->uiCaps;
+	}
+	catch ( std::exception& e )
+	{
+		SET_ERROR_STATUS( pStatus, e );
+	}
+
+	return uiCaps;
+}
+
+
 // +------------------------------------------------------------------------------------------------------------------+
 // |  ArcDLace_pluginRun                                                                                              |
 // +------------------------------------------------------------------------------------------------------------------+
@@ -0,0 +1,658 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcAmpLayout.cpp  ( Gen3 )                                                                              |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC amplifier readout layout interface.                                       |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <utility>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <CArcAmpLayout.h>
+
+
+using namespace std::string_literals;
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Local helpers                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		namespace
+		{
+			bool isXDir( arc::gen3::dlace::e_Dir eDir )
+			{
+				return ( eDir == arc::gen3::dlace::e_Dir::POS_X || eDir == arc::gen3::dlace::e_Dir::NEG_X );
+			}
+
+			std::int64_t dirStep( arc::gen3::dlace::e_Dir eDir )
+			{
+				return ( ( eDir == arc::gen3::dlace::e_Dir::POS_X || eDir == arc::gen3::dlace::e_Dir::POS_Y ) ? 1 : -1 );
+			}
+
+			const char* dirName( arc::gen3::dlace::e_Dir eDir )
+			{
+				switch ( eDir )
+				{
+					case arc::gen3::dlace::e_Dir::POS_X: return "+x";
+					case arc::gen3::dlace::e_Dir::NEG_X: return "-x";
+					case arc::gen3::dlace::e_Dir::POS_Y: return "+y";
+					default:							 return "-y";
+				}
+			}
+
+			bool parseDir( const std::string& sDir, arc::gen3::dlace::e_Dir& eDir )
+			{
+				if ( sDir == "+x" || sDir == "x" ) { eDir = arc::gen3::dlace::e_Dir::POS_X; return true; }
+				if ( sDir == "-x" ) { eDir = arc::gen3::dlace::e_Dir::NEG_X; return true; }
+				if ( sDir == "+y" || sDir == "y" ) { eDir = arc::gen3::dlace::e_Dir::POS_Y; return true; }
+				if ( sDir == "-y" ) { eDir = arc::gen3::dlace::e_Dir::NEG_Y; return true; }
+
+				return false;
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  <IN>  -> uiCols - Number of columns in the deinterlaced image.                                          |
+		// |  <IN>  -> uiRows - Number of rows in the deinterlaced image.                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		CArcAmpLayout::CArcAmpLayout( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows )
+		{
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image dimensions [ %u x %u ]! Cannot be zero!", uiCols, uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Destructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		CArcAmpLayout::~CArcAmpLayout( void )
+		{
+			m_vAmps.clear();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | addAmp                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Adds an amplifier to the layout. The amplifier must read entirely within the image.                      |
+		// |                                                                                                          |
+		// |  <IN>  -> tAmp - The amplifier description.                                                              |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcAmpLayout::addAmp( const arc::gen3::dlace::Amp_t& tAmp )
+		{
+			if ( tAmp.uiWidth == 0 || tAmp.uiHeight == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid amplifier read size [ %u x %u ]! Cannot be zero!", tAmp.uiWidth, tAmp.uiHeight );
+			}
+
+			if ( isXDir( tAmp.eFast ) == isXDir( tAmp.eSlow ) )
+			{
+				throwArcGen3InvalidArgument( "Amplifier fast [ %s ] and slow [ %s ] read directions must be perpendicular!", dirName( tAmp.eFast ), dirName( tAmp.eSlow ) );
+			}
+
+			//
+			// Determine the span of the amplifier along each image axis
+			// ------------------------------------------------------------
+			std::uint32_t uiSpanX = ( isXDir( tAmp.eFast ) ? tAmp.uiWidth : tAmp.uiHeight );
+			std::uint32_t uiSpanY = ( isXDir( tAmp.eFast ) ? tAmp.uiHeight : tAmp.uiWidth );
+
+			std::int64_t iStepX = dirStep( isXDir( tAmp.eFast ) ? tAmp.eFast : tAmp.eSlow );
+			std::int64_t iStepY = dirStep( isXDir( tAmp.eFast ) ? tAmp.eSlow : tAmp.eFast );
+
+			std::int64_t iEndX = ( static_cast< std::int64_t >( tAmp.uiX ) + iStepX * ( static_cast< std::int64_t >( uiSpanX ) - 1 ) );
+			std::int64_t iEndY = ( static_cast< std::int64_t >( tAmp.uiY ) + iStepY * ( static_cast< std::int64_t >( uiSpanY ) - 1 ) );
+
+			if ( tAmp.uiX >= m_uiCols || tAmp.uiY >= m_uiRows || iEndX < 0 || iEndX >= m_uiCols || iEndY < 0 || iEndY >= m_uiRows )
+			{
+				throwArcGen3InvalidArgument( "Amplifier at [ %u, %u ] reading [ %u x %u ] exceeds the image bounds [ %u x %u ]!",
+											 tAmp.uiX, tAmp.uiY, tAmp.uiWidth, tAmp.uiHeight, m_uiCols, m_uiRows );
+			}
+
+			m_vAmps.push_back( tAmp );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | addAmp                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Adds an amplifier to the layout. The amplifier is interleaved after all previously added amplifiers of   |
+		// | the same frame.                                                                                          |
+		// |                                                                                                          |
+		// |  <IN>  -> uiX		- Destination column of the first pixel read.                                         |
+		// |  <IN>  -> uiY		- Destination row of the first pixel read.                                            |
+		// |  <IN>  -> uiWidth	- Number of pixels read along the fast direction.                                     |
+		// |  <IN>  -> uiHeight	- Number of lines read along the slow direction.                                      |
+		// |  <IN>  -> eFast		- Fast ( serial ) read direction.                                                     |
+		// |  <IN>  -> eSlow		- Slow ( parallel ) read direction.                                                   |
+		// |  <IN>  -> uiFrame	- Raw stream frame.                                                                   |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcAmpLayout::addAmp( const std::uint32_t uiX, const std::uint32_t uiY, const std::uint32_t uiWidth, const std::uint32_t uiHeight,
+									const arc::gen3::dlace::e_Dir eFast, const arc::gen3::dlace::e_Dir eSlow, const std::uint32_t uiFrame )
+		{
+			auto uiOrder = static_cast< std::uint32_t >( std::count_if( m_vAmps.begin(), m_vAmps.end(),
+														 [ uiFrame ]( const arc::gen3::dlace::Amp_t& tAmp ) { return ( tAmp.uiFrame == uiFrame ); } ) );
+
+			addAmp( arc::gen3::dlace::Amp_t{ uiX, uiY, uiWidth, uiHeight, eFast, eSlow, uiOrder, uiFrame } );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  cols                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of columns in the deinterlaced image.                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t CArcAmpLayout::cols( void ) const noexcept
+		{
+			return m_uiCols;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rows                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of rows in the deinterlaced image.                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t CArcAmpLayout::rows( void ) const noexcept
+		{
+			return m_uiRows;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  ampCount                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of amplifiers in the layout.                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t CArcAmpLayout::ampCount( void ) const noexcept
+		{
+			return static_cast< std::uint32_t >( m_vAmps.size() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  amp                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns an amplifier description.                                                                       |
+		// |                                                                                                          |
+		// |  <IN>  -> uiIndex - The amplifier index. Range 0 to ampCount() - 1.                                      |
+		// |                                                                                                          |
+		// |  Throws std::out_of_range                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		const arc::gen3::dlace::Amp_t& CArcAmpLayout::amp( const std::uint32_t uiIndex ) const
+		{
+			if ( uiIndex >= m_vAmps.size() )
+			{
+				throwArcGen3OutOfRange( uiIndex, std::make_pair( static_cast< std::uint32_t >( 0 ), ( ampCount() - 1 ) ) );
+			}
+
+			return m_vAmps[ uiIndex ];
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | validate                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies that the layout is complete. Frames must be numbered from zero without gaps, the amplifiers of  |
+		// | each frame must have unique interleave positions from zero without gaps and identical read sizes, and    |
+		// | every image pixel must be read by exactly one amplifier. A layout without amplifiers is valid and        |
+		// | describes an image that needs no deinterlacing.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcAmpLayout::validate( void ) const
+		{
+			if ( m_vAmps.empty() )
+			{
+				return;
+			}
+
+			std::uint32_t uiFrames = 0;
+
+			for ( const auto& tAmp : m_vAmps )
+			{
+				uiFrames = std::max( uiFrames, ( tAmp.uiFrame + 1 ) );
+			}
+
+			for ( std::uint32_t uiFrame = 0; uiFrame < uiFrames; uiFrame++ )
+			{
+				std::vector<const arc::gen3::dlace::Amp_t*> vFrame;
+
+				for ( const auto& tAmp : m_vAmps )
+				{
+					if ( tAmp.uiFrame == uiFrame )
+					{
+						vFrame.push_back( &tAmp );
+					}
+				}
+
+				if ( vFrame.empty() )
+				{
+					throwArcGen3InvalidArgument( "Layout frame %u has no amplifiers! Frames must be numbered without gaps.", uiFrame );
+				}
+
+				std::vector<bool> vOrder( vFrame.size(), false );
+
+				for ( const auto pAmp : vFrame )
+				{
+					if ( pAmp->uiWidth != vFrame.front()->uiWidth || pAmp->uiHeight != vFrame.front()->uiHeight )
+					{
+						throwArcGen3InvalidArgument( "All amplifiers of layout frame %u must read the same size [ %u x %u ]!",
+													 uiFrame, vFrame.front()->uiWidth, vFrame.front()->uiHeight );
+					}
+
+					if ( pAmp->uiOrder >= vFrame.size() || vOrder[ pAmp->uiOrder ] )
+					{
+						throwArcGen3InvalidArgument( "Invalid or duplicate amplifier interleave order [ %u ] in layout frame %u!", pAmp->uiOrder, uiFrame );
+					}
+
+					vOrder[ pAmp->uiOrder ] = true;
+				}
+			}
+
+			//
+			// Every pixel must be read exactly once. Each amplifier reads a
+			// rectangle, so the rectangles may not overlap and their total
+			// area must equal the image area.
+			// ----------------------------------------------------------------
+			struct Rect_t { std::int64_t iX0, iY0, iX1, iY1; };
+
+			std::vector<Rect_t> vRects;
+
+			std::uint64_t uiArea = 0;
+
+			for ( const auto& tAmp : m_vAmps )
+			{
+				std::uint32_t uiSpanX = ( isXDir( tAmp.eFast ) ? tAmp.uiWidth : tAmp.uiHeight );
+				std::uint32_t uiSpanY = ( isXDir( tAmp.eFast ) ? tAmp.uiHeight : tAmp.uiWidth );
+
+				std::int64_t iEndX = ( tAmp.uiX + dirStep( isXDir( tAmp.eFast ) ? tAmp.eFast : tAmp.eSlow ) * ( static_cast< std::int64_t >( uiSpanX ) - 1 ) );
+				std::int64_t iEndY = ( tAmp.uiY + dirStep( isXDir( tAmp.eFast ) ? tAmp.eSlow : tAmp.eFast ) * ( static_cast< std::int64_t >( uiSpanY ) - 1 ) );
+
+				vRects.push_back( Rect_t{ std::min<std::int64_t>( tAmp.uiX, iEndX ), std::min<std::int64_t>( tAmp.uiY, iEndY ),
+										  std::max<std::int64_t>( tAmp.uiX, iEndX ), std::max<std::int64_t>( tAmp.uiY, iEndY ) } );
+
+				uiArea += ( static_cast< std::uint64_t >( tAmp.uiWidth ) * static_cast< std::uint64_t >( tAmp.uiHeight ) );
+			}
+
+			for ( std::size_t i = 0; i < vRects.size(); i++ )
+			{
+				for ( std::size_t j = ( i + 1 ); j < vRects.size(); j++ )
+				{
+					if ( vRects[ i ].iX0 <= vRects[ j ].iX1 && vRects[ j ].iX0 <= vRects[ i ].iX1 &&
+						 vRects[ i ].iY0 <= vRects[ j ].iY1 && vRects[ j ].iY0 <= vRects[ i ].iY1 )
+					{
+						throwArcGen3InvalidArgument( "Amplifiers %u and %u read overlapping image pixels!", static_cast< std::uint32_t >( i ), static_cast< std::uint32_t >( j ) );
+					}
+				}
+			}
+
+			if ( uiArea != ( static_cast< std::uint64_t >( m_uiCols ) * static_cast< std::uint64_t >( m_uiRows ) ) )
+			{
+				throwArcGen3InvalidArgument( "Amplifiers read %J of %J image pixels! Every pixel must be read by one amplifier.",
+											 static_cast< unsigned long long >( uiArea ),
+											 static_cast< unsigned long long >( static_cast< std::uint64_t >( m_uiCols ) * static_cast< std::uint64_t >( m_uiRows ) ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | toString                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns a textual description of the layout that may be passed to fromString().                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::string CArcAmpLayout::toString( void ) const
+		{
+			std::ostringstream oss;
+
+			oss << "size " << m_uiCols << " " << m_uiRows << std::endl;
+
+			for ( const auto& tAmp : m_vAmps )
+			{
+				oss << "amp " << tAmp.uiX << " " << tAmp.uiY << " " << tAmp.uiWidth << " " << tAmp.uiHeight << " "
+					<< dirName( tAmp.eFast ) << " " << dirName( tAmp.eSlow ) << " " << tAmp.uiOrder << " " << tAmp.uiFrame << std::endl;
+			}
+
+			return oss.str();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | fromAlg                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Creates the layout for one of the built-in deinterlace algorithms. The layouts reproduce the             |
+		// | CArcDeinterlace algorithms exactly. See CArcDeinterlace::run() for readout diagrams.                     |
+		// |                                                                                                          |
+		// |  <IN>  -> eAlg		- Algorithm that corresponds to the deinterlacing method.                             |
+		// |  <IN>  -> uiCols	- Number of columns in the image.                                                     |
+		// |  <IN>  -> uiRows	- Number of rows in the image.                                                        |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument. HAWAII_RG requires the readout channel count.         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::unique_ptr<CArcAmpLayout> CArcAmpLayout::fromAlg( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg )
+		{
+			using arc::gen3::dlace::e_Dir;
+
+			auto pLayout = std::make_unique<CArcAmpLayout>( uiCols, uiRows );
+
+			switch ( eAlg )
+			{
+				case arc::gen3::dlace::e_Alg::NONE:
+				{
+					// Do nothing
+					;
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::PARALLEL:
+				{
+					if ( ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of ROWS must be EVEN for PARALLEL deinterlace."s );
+					}
+
+					pLayout->addAmp( 0, 0, uiCols, ( uiRows / 2 ), e_Dir::POS_X, e_Dir::POS_Y );
+					pLayout->addAmp( ( uiCols - 1 ), ( uiRows - 1 ), uiCols, ( uiRows / 2 ), e_Dir::NEG_X, e_Dir::NEG_Y );
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::SERIAL:
+				{
+					if ( ( uiCols % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS must be EVEN for SERIAL deinterlace."s );
+					}
+
+					pLayout->addAmp( 0, 0, ( uiCols / 2 ), uiRows, e_Dir::POS_X, e_Dir::POS_Y );
+					pLayout->addAmp( ( uiCols - 1 ), 0, ( uiCols / 2 ), uiRows, e_Dir::NEG_X, e_Dir::POS_Y );
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::QUAD_CCD:
+				{
+					if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS and ROWS must be EVEN for QUAD CCD deinterlace."s );
+					}
+
+					std::uint32_t uiWidth  = ( uiCols / 2 );
+					std::uint32_t uiHeight = ( uiRows / 2 );
+
+					pLayout->addAmp( 0, 0, uiWidth, uiHeight, e_Dir::POS_X, e_Dir::POS_Y );
+					pLayout->addAmp( ( uiCols - 1 ), 0, uiWidth, uiHeight, e_Dir::NEG_X, e_Dir::POS_Y );
+					pLayout->addAmp( ( uiCols - 1 ), ( uiRows - 1 ), uiWidth, uiHeight, e_Dir::NEG_X, e_Dir::NEG_Y );
+					pLayout->addAmp( 0, ( uiRows - 1 ), uiWidth, uiHeight, e_Dir::POS_X, e_Dir::NEG_Y );
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::QUAD_IR:
+				case arc::gen3::dlace::e_Alg::QUAD_IR_CDS:
+				{
+					if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS and ROWS must be EVEN for QUAD IR%s deinterlace.",
+													 ( eAlg == arc::gen3::dlace::e_Alg::QUAD_IR_CDS ? " CDS" : "" ) );
+					}
+
+					//
+					// CDS data contains two complete quad IR frames, one after the other.
+					//
+					std::uint32_t uiFrames = ( eAlg == arc::gen3::dlace::e_Alg::QUAD_IR_CDS ? 2 : 1 );
+					std::uint32_t uiFrameRows = ( uiRows / uiFrames );
+
+					if ( ( uiFrameRows % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of ROWS must be a multiple of 4 for QUAD IR CDS deinterlace."s );
+					}
+
+					std::uint32_t uiWidth  = ( uiCols / 2 );
+					std::uint32_t uiHeight = ( uiFrameRows / 2 );
+
+					for ( std::uint32_t uiFrame = 0; uiFrame < uiFrames; uiFrame++ )
+					{
+						std::uint32_t uiY0 = ( uiFrame * uiFrameRows );
+
+						pLayout->addAmp( 0, ( uiY0 + uiFrameRows - 1 ), uiWidth, uiHeight, e_Dir::POS_X, e_Dir::NEG_Y, uiFrame );
+						pLayout->addAmp( uiWidth, ( uiY0 + uiFrameRows - 1 ), uiWidth, uiHeight, e_Dir::POS_X, e_Dir::NEG_Y, uiFrame );
+						pLayout->addAmp( uiWidth, ( uiY0 + uiHeight - 1 ), uiWidth, uiHeight, e_Dir::POS_X, e_Dir::NEG_Y, uiFrame );
+						pLayout->addAmp( 0, ( uiY0 + uiHeight - 1 ), uiWidth, uiHeight, e_Dir::POS_X, e_Dir::NEG_Y, uiFrame );
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::HAWAII_RG:
+				{
+					const std::uint32_t ERR = 0x00455252;
+
+					if ( ( uiCols % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS must be EVEN for HAWAII RG deinterlace."s );
+					}
+
+					else if ( uiArg == 1 )
+					{
+						// Ignore and don't de-interlace. Matches CArcDeinterlace::hawaiiRG().
+					}
+
+					else if ( uiArg == 0 || uiArg == ERR )
+					{
+						throwArcGen3InvalidArgument( "The number of readout channels must be supplied for HAWAII RG deinterlace."s );
+					}
+
+					else if ( ( uiArg % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "The readout channel count must be EVEN for HAWAII RG deinterlace."s );
+					}
+
+					else if ( ( uiCols % uiArg ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS [ %u ] must be a multiple of the channel count [ %u ] for HAWAII RG deinterlace.", uiCols, uiArg );
+					}
+
+					else
+					{
+						std::uint32_t uiOffset = ( uiCols / uiArg );
+
+						for ( std::uint32_t i = 0; i < uiArg; i++ )
+						{
+							pLayout->addAmp( ( i * uiOffset ), 0, uiOffset, uiRows, e_Dir::POS_X, e_Dir::POS_Y );
+						}
+					}
+				}
+				break;
+
+				case arc::gen3::dlace::e_Alg::STA1600:
+				{
+					if ( ( uiCols % 16 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of COLS must be a multiple of 16 for STA1600 deinterlace."s );
+					}
+
+					if ( ( uiRows % 2 ) != 0 )
+					{
+						throwArcGen3InvalidArgument( "Number of ROWS must be a multiple of 2 for STA1600 deinterlace."s );
+					}
+
+					std::uint32_t uiOffset = ( uiCols / 8 );
+
+					for ( std::uint32_t i = 0; i < 8; i++ )
+					{
+						pLayout->addAmp( ( ( 7 - i ) * uiOffset ), 0, uiOffset, ( uiRows / 2 ), e_Dir::POS_X, e_Dir::POS_Y );
+					}
+
+					for ( std::uint32_t i = 0; i < 8; i++ )
+					{
+						pLayout->addAmp( ( ( 7 - i ) * uiOffset ), ( uiRows - 1 ), uiOffset, ( uiRows / 2 ), e_Dir::POS_X, e_Dir::NEG_Y );
+					}
+				}
+				break;
+
+				default:
+				{
+					throwArcGen3InvalidArgument( "Invalid deinterlace layout algorithm [ %d ]! Custom algorithms have no layout.", static_cast< int >( eAlg ) );
+				}
+				break;
+			}
+
+			return pLayout;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | fromString                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Creates a layout from its textual description. See CArcAmpLayout.h for the format.                       |
+		// |                                                                                                          |
+		// |  <IN>  -> sLayout - The layout description.                                                              |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::unique_ptr<CArcAmpLayout> CArcAmpLayout::fromString( const std::string& sLayout )
+		{
+			std::unique_ptr<CArcAmpLayout> pLayout;
+
+			std::istringstream iss( sLayout );
+
+			std::string sLine;
+
+			std::uint32_t uiLine = 0;
+
+			while ( std::getline( iss, sLine ) )
+			{
+				uiLine++;
+
+				auto uiComment = sLine.find( '#' );
+
+				if ( uiComment != std::string::npos )
+				{
+					sLine.erase( uiComment );
+				}
+
+				std::istringstream issLine( sLine );
+
+				std::string sKeyword;
+
+				if ( !( issLine >> sKeyword ) )
+				{
+					continue;
+				}
+
+				if ( sKeyword == "size" )
+				{
+					std::uint32_t uiCols = 0, uiRows = 0;
+
+					if ( pLayout != nullptr )
+					{
+						throwArcGen3InvalidArgument( "Layout line %u: image size already specified!", uiLine );
+					}
+
+					if ( !( issLine >> uiCols >> uiRows ) )
+					{
+						throwArcGen3InvalidArgument( "Layout line %u: expected \"size <cols> <rows>\"!", uiLine );
+					}
+
+					pLayout = std::make_unique<CArcAmpLayout>( uiCols, uiRows );
+				}
+
+				else if ( sKeyword == "amp" )
+				{
+					arc::gen3::dlace::Amp_t tAmp{};
+
+					std::string sFast, sSlow;
+
+					if ( pLayout == nullptr )
+					{
+						throwArcGen3InvalidArgument( "Layout line %u: image size must be specified before any amplifier!", uiLine );
+					}
+
+					if ( !( issLine >> tAmp.uiX >> tAmp.uiY >> tAmp.uiWidth >> tAmp.uiHeight >> sFast >> sSlow ) ||
+						 !parseDir( sFast, tAmp.eFast ) || !parseDir( sSlow, tAmp.eSlow ) )
+					{
+						throwArcGen3InvalidArgument( "Layout line %u: expected \"amp <x> <y> <width> <height> <fast> <slow> [ <order> [ <frame> ] ]\"!", uiLine );
+					}
+
+					if ( issLine >> tAmp.uiOrder )
+					{
+						if ( !( issLine >> tAmp.uiFrame ) )
+						{
+							tAmp.uiFrame = 0;
+						}
+
+						pLayout->addAmp( tAmp );
+					}
+
+					else
+					{
+						pLayout->addAmp( tAmp.uiX, tAmp.uiY, tAmp.uiWidth, tAmp.uiHeight, tAmp.eFast, tAmp.eSlow );
+					}
+				}
+
+				else
+				{
+					throwArcGen3InvalidArgument( "Layout line %u: unknown keyword \"%s\"!", uiLine, sKeyword.c_str() );
+				}
+			}
+
+			if ( pLayout == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Layout does not specify an image size!"s );
+			}
+
+			pLayout->validate();
+
+			return pLayout;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | fromFile                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Creates a layout from a text file. See CArcAmpLayout.h for the format.                                   |
+		// |                                                                                                          |
+		// |  <IN>  -> sFile - The layout description file.                                                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::unique_ptr<CArcAmpLayout> CArcAmpLayout::fromFile( const std::string& sFile )
+		{
+			std::ifstream inFile( sFile );
+
+			if ( !inFile.is_open() )
+			{
+				throwArcGen3Error( "Cannot open file: %s", sFile.c_str() );
+			}
+
+			std::ostringstream oss;
+
+			oss << inFile.rdbuf();
+
+			return fromString( oss.str() );
+		}
+
+	}	// end gen3 namespace
+}		// end arc namespace
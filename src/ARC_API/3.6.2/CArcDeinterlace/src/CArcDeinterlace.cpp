@@ -13,13 +13,17 @@
 #endif
 
 #include <iomanip>
+#include <algorithm>
 #include <type_traits>
+#include <limits>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <cmath>
 
 #include <CArcDeinterlace.h>
+#include <CArcAmpLayout.h>
+#include <CArcThreadPool.h>
 #include <IArcPlugin.h>
 
 
@@ -70,6 +74,11 @@ namespace arc
 
 			m_uiNewCols = 0;
 			m_uiNewRows = 0;
+
+			m_uiMemoryLimit = std::numeric_limits<std::uint64_t>::max();
+			m_uiScratchBytes = 0;
+
+			m_pExecutor = nullptr;
 		}
 
 
@@ -161,30 +170,63 @@ namespace arc
 		// |  <IN>  -> uiRows	- Number of rows in image to deinterlace                                              |
 		// |  <IN>  -> eAlg		- Algorithm number that corresponds to deinterlacing method                           |
 		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread ( default = 0 ).  |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcDeinterlace<T>::run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		void CArcDeinterlace<T>::run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::initializer_list<std::uint32_t>& tArgList,
+									  const std::uint32_t uiThreads )
 		{
 			T* pOldBuf = pBuf;	// Old image buffer pointer
 
-			// NOTE ****** Instead of memcpy pOldBuf to m_pNewData, maybe just return the
-			// buffer pointer.
-
-			// Allocate a new buffer to hold the deinterlaced image
-			// -------------------------------------------------------------------
-			if ( uiCols > m_uiNewCols || uiRows > m_uiNewRows )
+			if ( pOldBuf == nullptr )
 			{
-				m_pNewData.reset( new T[ static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) ] );
+				throwArcGen3Error( "Invalid image buffer parameter ( NULL )."s );
+			}
 
-				m_uiNewCols = uiCols;
-				m_uiNewRows = uiRows;
+			m_uiScratchBytes = 0;
+
+			if ( eAlg == arc::gen3::dlace::e_Alg::NONE )
+			{
+				return;
 			}
 
-			if ( m_pNewData == nullptr || pOldBuf == nullptr )
+			// Use a memory-lean variant if the frame does not fit the scratch
+			// memory limit. See setMemoryLimit().
+			// -------------------------------------------------------------------
+			if ( ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) * sizeof( T ) ) > m_uiMemoryLimit )
 			{
-				throwArcGen3Error( "Error in allocating temporary image buffer for deinterlacing."s );
+				std::uint32_t uiArg = ( tArgList.size() > 0 ? *tArgList.begin() : 0 );
+
+				if ( eAlg == arc::gen3::dlace::e_Alg::SERIAL )
+				{
+					serialLean( pOldBuf, uiCols, uiRows );
+				}
+
+				else if ( eAlg == arc::gen3::dlace::e_Alg::HAWAII_RG )
+				{
+					if ( tArgList.size() != 1 )
+					{
+						throwArcGen3Error( "Invalid number of arguments. Expected 1, found: %d", static_cast< int >( tArgList.size() ) );
+					}
+
+					hawaiiRGLean( pOldBuf, uiCols, uiRows, uiArg );
+				}
+
+				else
+				{
+					permute( pOldBuf, uiCols, uiRows, eAlg, uiArg );
+				}
+
+				return;
 			}
 
+			// NOTE ****** Instead of memcpy pOldBuf to m_pNewData, maybe just return the
+			// buffer pointer.
+
+			// Allocate a new buffer to hold the deinterlaced image
+			// -------------------------------------------------------------------
+			scratch( uiCols, uiRows );
+
 			switch ( eAlg )
 			{
 				// +-------------------------------------------------------------------+
@@ -202,7 +244,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::PARALLEL:
 				{
-					parallel( pOldBuf, uiCols, uiRows );
+					parallel( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -211,7 +253,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::SERIAL:
 				{
-					serial( pOldBuf, uiCols, uiRows );
+					serial( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -220,7 +262,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::QUAD_CCD:
 				{
-					quadCCD( pOldBuf, uiCols, uiRows );
+					quadCCD( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -229,7 +271,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::QUAD_IR:
 				{
-					quadIR( pOldBuf, uiCols, uiRows );
+					quadIR( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -238,7 +280,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::QUAD_IR_CDS:
 				{
-					quadIRCDS( pOldBuf, uiCols, uiRows );
+					quadIRCDS( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -249,10 +291,10 @@ namespace arc
 				{
 					if ( tArgList.size() != 1 )
 					{
-						throwArcGen3Error( "Invalid number of arguments. Expected 1, found: %d", tArgList.size() );
+						throwArcGen3Error( "Invalid number of arguments. Expected 1, found: %d", static_cast< int >( tArgList.size() ) );
 					}
 
-					hawaiiRG( pOldBuf, uiCols, uiRows, *tArgList.begin() );
+					hawaiiRG( pOldBuf, uiCols, uiRows, *tArgList.begin(), uiThreads );
 				}
 				break;
 
@@ -261,7 +303,7 @@ namespace arc
 				// +-------------------------------------------------------------------+
 				case arc::gen3::dlace::e_Alg::STA1600:
 				{
-					sta1600( pOldBuf, uiCols, uiRows );
+					sta1600( pOldBuf, uiCols, uiRows, uiThreads );
 				}
 				break;
 
@@ -291,34 +333,147 @@ namespace arc
 		template <typename T>
 		void CArcDeinterlace<T>::run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sAlg, const std::initializer_list<std::uint32_t>& tArgList )
 		{
-			if ( m_pPluginManager->pluginLoaded() )
+			if ( !m_pPluginManager->pluginLoaded() )
+			{
+				throwArcGen3Error( "No deinterlace plugins loaded!"s );
+			}
+
+			auto pAlg = m_pPluginManager->resolve( sAlg );
+
+			if ( pAlg == nullptr )
 			{
-				bool bSuccess = false;
+				throwArcGen3Error( "Algorithm [ \'%s\' ] not found!", sAlg.c_str() );
+			}
 
-				for ( std::uint32_t j = 0; j < m_pPluginManager->pluginCount(); j++ )
-				{
-					arc::gen3::IArcPlugin* pPlugin = m_pPluginManager->getPluginObject( j );
+			run( pBuf, uiCols, uiRows, pAlg, tArgList );
+		}
 
-					if ( ( bSuccess = pPlugin->getNameList()->find( sAlg ) ) )
-					{
-						pPlugin->run( pBuf, uiCols, uiRows, ( 8 * sizeof( T ) ), sAlg, ( tArgList.begin() != tArgList.end() ? *tArgList.begin() : 0 ) );
 
-						break;
+		// +----------------------------------------------------------------------------------------------------------+
+		// | run                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Calls a plugin algorithm that has been resolved through the deinterlace plugin manager. Version 2        |
+		// | plugins are executed by handle; version 1 plugins by name.                                               |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf		- Pointer to the image pBuf to deinterlace                                            |
+		// |  <IN>  -> uiCols	- Number of uiCols in image to deinterlace                                            |
+		// |  <IN>  -> uiRows	- Number of rows in image to deinterlace                                              |
+		// |  <IN>  -> pAlg		- The resolved plugin algorithm                                                       |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::run( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::PluginAlg_t* pAlg, const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( pAlg == nullptr || pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid plugin algorithm or image buffer parameter ( NULL )."s );
+			}
+
+			const std::uint32_t uiArg = ( tArgList.begin() != tArgList.end() ? *tArgList.begin() : 0 );
+
+			if ( pAlg->pObj2 == nullptr )
+			{
+				pAlg->pObj->run( pBuf, uiCols, uiRows, ( 8 * sizeof( T ) ), pAlg->sAlg, uiArg );
+			}
+
+			else if ( ( pAlg->uiCaps & plugin::CAP_IN_PLACE ) != 0 )
+			{
+				pAlg->pObj2->execute( pAlg->uiAlg, pBuf, uiCols, uiRows, ( 8 * sizeof( T ) ), uiArg, pluginExecutor() );
+			}
+
+			else if ( ( pAlg->uiCaps & plugin::CAP_OUT_OF_PLACE ) != 0 )
+			{
+				m_uiScratchBytes = 0;
+
+				//
+				// Run through a full frame copy, or if that does not fit the scratch
+				// memory limit, through bands of whole rows. See setMemoryLimit().
+				// -------------------------------------------------------------------
+				const std::uint64_t uiRowBytes = ( static_cast< std::uint64_t >( uiCols ) * sizeof( T ) );
+
+				std::uint32_t uiBandRows = uiRows;
+
+				if ( ( uiRowBytes * uiRows ) > m_uiMemoryLimit )
+				{
+					if ( ( pAlg->uiCaps & plugin::CAP_ROW_STREAM ) == 0 )
+					{
+						throwArcGen3Error( "Algorithm [ \'%s\' ] only supports out of place deinterlacing and a [ %u x %u ] frame exceeds the scratch memory limit [ %J bytes ]!",
+										   pAlg->sAlg.c_str(), uiCols, uiRows, static_cast< unsigned long long >( m_uiMemoryLimit ) );
 					}
+
+					uiBandRows = static_cast< std::uint32_t >( std::clamp<std::uint64_t>( ( m_uiMemoryLimit / uiRowBytes ), 1, uiRows ) );
 				}
 
-				if ( !bSuccess )
+				T* pScratch = scratch( uiCols, uiBandRows );
+
+				for ( std::uint32_t uiRow = 0; uiRow < uiRows; uiRow += uiBandRows )
 				{
-					throwArcGen3Error( "Algorithm [ \'%s\' ] not found!", sAlg.c_str() );
+					const std::uint32_t uiCount = std::min( uiBandRows, ( uiRows - uiRow ) );
+
+					T* pBand = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+					copyMemory( pScratch, pBand, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiCount ) * sizeof( T ) ) );
+
+					pAlg->pObj2->executeOutOfPlace( pAlg->uiAlg, pScratch, pBand, uiCols, uiCount, ( 8 * sizeof( T ) ), uiArg, pluginExecutor() );
 				}
 			}
+
 			else
 			{
-				throwArcGen3Error( "No deinterlace plugins loaded!"s );
+				throwArcGen3Error( "Algorithm [ \'%s\' ] reports neither in place nor out of place support!", pAlg->sAlg.c_str() );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | run                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Calls a resolved plugin algorithm from a source buffer into a separate destination buffer. Algorithms    |
+		// | without out of place support are run in place on a copy of the source.                                   |
+		// |                                                                                                          |
+		// |  <IN>  -> pSrc		- Pointer to the image to deinterlace                                                 |
+		// |  <OUT> -> pDst		- Pointer to the deinterlaced image                                                   |
+		// |  <IN>  -> uiCols	- Number of uiCols in image to deinterlace                                            |
+		// |  <IN>  -> uiRows	- Number of rows in image to deinterlace                                              |
+		// |  <IN>  -> pAlg		- The resolved plugin algorithm                                                       |
+		// |  <IN>  -> tArgList - An optional argument list ( default = {}, empty list }.                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::run( const T* pSrc, T* pDst, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::PluginAlg_t* pAlg,
+									  const std::initializer_list<std::uint32_t>& tArgList )
+		{
+			if ( pAlg == nullptr || pSrc == nullptr || pDst == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid plugin algorithm or image buffer parameter ( NULL )."s );
+			}
+
+			if ( pAlg->pObj2 != nullptr && ( pAlg->uiCaps & plugin::CAP_OUT_OF_PLACE ) != 0 )
+			{
+				const std::uint32_t uiArg = ( tArgList.begin() != tArgList.end() ? *tArgList.begin() : 0 );
+
+				pAlg->pObj2->executeOutOfPlace( pAlg->uiAlg, pSrc, pDst, uiCols, uiRows, ( 8 * sizeof( T ) ), uiArg, pluginExecutor() );
+			}
+
+			else
+			{
+				copyMemory( pDst, const_cast< T* >( pSrc ), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+
+				run( pDst, uiCols, uiRows, pAlg, tArgList );
 			}
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setPluginExecutor                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the task executor passed to version 2 plugins. nullptr passes the library executor.                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlace<T>::setPluginExecutor( arc::gen3::IArcPluginExecutor* pExecutor ) noexcept
+		{
+			m_pExecutor = pExecutor;
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  maxTVal                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -332,6 +487,121 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setMemoryLimit                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the scratch memory limit for this instance. Frames that need more full frame scratch memory than   |
+		// |  the limit are deinterlaced with a memory-lean algorithm variant.                                        |
+		// |                                                                                                          |
+		// |  <IN>  -> uiBytes - The maximum number of scratch bytes.                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlace<T>::setMemoryLimit( const std::uint64_t uiBytes ) noexcept
+		{
+			m_uiMemoryLimit = uiBytes;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getMemoryLimit                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the scratch memory limit for this instance.                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t CArcDeinterlace<T>::getMemoryLimit( void ) const noexcept
+		{
+			return m_uiMemoryLimit;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  scratchBytes                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the peak scratch memory used by the last call to run().                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t CArcDeinterlace<T>::scratchBytes( void ) const noexcept
+		{
+			return m_uiScratchBytes;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | pluginExecutor                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the task executor passed to version 2 plugins; the one set with setPluginExecutor(), or the      |
+		// | library executor, CArcThreadPool::executor(), by default.                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> arc::gen3::IArcPluginExecutor* CArcDeinterlace<T>::pluginExecutor( void ) const
+		{
+			return ( m_pExecutor != nullptr ? m_pExecutor : &arc::gen3::CArcThreadPool::executor() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | forEachRowBlock                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Splits the rows [ 0, uiRows ) into one contiguous block per thread and calls fnBlock( uiFirstRow,        |
+		// | uiEndRow ) for each block as a task on CArcThreadPool::executor(). The built-in algorithms split the     |
+		// | rows of the deinterlaced image, so the blocks write disjoint scratch memory.                             |
+		// |                                                                                                          |
+		// | <IN>  -> uiRows    - The number of rows.                                                                 |
+		// | <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread.                   |
+		// | <IN>  -> fnBlock   - The block function.                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::forEachRowBlock( const std::uint32_t uiRows, const std::uint32_t uiThreads, const std::function<void( std::uint32_t, std::uint32_t )>& fnBlock )
+		{
+			arc::gen3::IArcExecutor& tExecutor = arc::gen3::CArcThreadPool::executor();
+
+			tExecutor.parallelForBlocks( 0, uiRows, ( uiThreads > 0 ? uiThreads : tExecutor.concurrency() ), [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				fnBlock( uiFirst, uiLast );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | scratch                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns a scratch buffer of at least uiCols x uiRows pixels. A held buffer that is larger than the       |
+		// | memory limit is released first, so that switching to a lean variant returns the full frame memory.       |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols - The number of scratch columns.                                                        |
+		// |  <IN>  -> uiRows - The number of scratch rows.                                                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> T* CArcDeinterlace<T>::scratch( const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			std::uint64_t uiHeldBytes = ( static_cast< std::uint64_t >( m_uiNewCols ) * static_cast< std::uint64_t >( m_uiNewRows ) * sizeof( T ) );
+
+			if ( uiHeldBytes > m_uiMemoryLimit )
+			{
+				m_pNewData.reset();
+
+				m_uiNewCols = 0;
+				m_uiNewRows = 0;
+			}
+
+			if ( uiCols > m_uiNewCols || uiRows > m_uiNewRows )
+			{
+				m_pNewData.reset();
+
+				m_pNewData.reset( new T[ static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) ] );
+
+				m_uiNewCols = uiCols;
+				m_uiNewRows = uiRows;
+			}
+
+			if ( m_pNewData == nullptr )
+			{
+				throwArcGen3Error( "Error in allocating temporary image buffer for deinterlacing."s );
+			}
+
+			m_uiScratchBytes = std::max( m_uiScratchBytes, ( static_cast< std::uint64_t >( m_uiNewCols ) * static_cast< std::uint64_t >( m_uiNewRows ) * sizeof( T ) ) );
+
+			return m_pNewData.get();
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// | parallel                                                                                                 |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -351,21 +621,30 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::parallel( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::parallel( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
 			if ( ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of ROWS must be EVEN for PARALLEL deinterlace."s );
 			}
 
-			for ( std::uint64_t i = 0; i < ( ( uiCols * uiRows ) / 2 ); i++ )
+			const std::uint64_t uiCount = ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) );
+
+			// Each pair of raw rows fills one row at either end of the image
+			forEachRowBlock( ( uiRows / 2 ), uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				*( m_pNewData.get() + i ) = *( pBuf + ( 2 * i ) );
-				*( m_pNewData.get() + ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) ) - i - 1 ) = *( pBuf + ( 2 * i ) + 1 );
-			}
+				T* pNew = m_pNewData.get();
+
+				for ( std::uint64_t i = ( static_cast< std::uint64_t >( uiFirst ) * uiCols ); i < ( static_cast< std::uint64_t >( uiLast ) * uiCols ); i++ )
+				{
+					*( pNew + i ) = *( pBuf + ( 2 * i ) );
+					*( pNew + uiCount - i - 1 ) = *( pBuf + ( 2 * i ) + 1 );
+				}
+			} );
 
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast<std::size_t>( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
 
 
@@ -388,39 +667,38 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::serial( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::serial( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			std::uint32_t p1 = 0;
-			std::uint32_t p2 = 0;
-			std::uint32_t begin = 0;
-			std::uint32_t end = 0;
-
 			if ( ( uiCols % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS must be EVEN for SERIAL deinterlace."s );
 			}
 
-			for ( std::remove_const_t<decltype( uiRows )> i = 0; i < uiRows; i++ )
+			forEachRowBlock( uiRows, uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				// Leave in +0 for clarity
-				p1 = i * uiCols + 0;	// Position in raw image
-				p2 = i * uiCols + 1;
-				begin = i * uiCols + 0;	// Position in deinterlaced image
-				end = i * uiCols + uiCols - 1;
-
-				for ( std::remove_const_t<decltype( uiCols )> j = 0; j < uiCols; j += 2 )
+				for ( std::uint32_t i = uiFirst; i < uiLast; i++ )
 				{
-					*( m_pNewData.get() + begin ) = *( pBuf + p1 );
-					*( m_pNewData.get() + end ) = *( pBuf + p2 );
+					// Leave in +0 for clarity
+					std::uint64_t p1 = static_cast< std::uint64_t >( i ) * uiCols + 0;	// Position in raw image
+					std::uint64_t p2 = static_cast< std::uint64_t >( i ) * uiCols + 1;
+					std::uint64_t begin = static_cast< std::uint64_t >( i ) * uiCols + 0;	// Position in deinterlaced image
+					std::uint64_t end = static_cast< std::uint64_t >( i ) * uiCols + uiCols - 1;
+
+					for ( std::remove_const_t<decltype( uiCols )> j = 0; j < uiCols; j += 2 )
+					{
+						*( m_pNewData.get() + begin ) = *( pBuf + p1 );
+						*( m_pNewData.get() + end ) = *( pBuf + p2 );
 
-					++begin;
-					--end;
+						++begin;
+						--end;
 
-					p1 += 2;
-					p2 += 2;
+						p1 += 2;
+						p2 += 2;
+					}
 				}
-			}
+			} );
 
 			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
@@ -445,39 +723,36 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::quadCCD( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::quadCCD( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			std::uint32_t i = 0;
-			std::uint32_t j = 0;
-			std::uint32_t counter = 0;
-			std::uint32_t end = 0;
-			std::uint32_t begin = 0;
-
 			if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD CCD deinterlace."s );
 			}
 
-			while ( i < ( uiCols * uiRows ) )
+			const std::uint64_t uiCount = ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) );
+
+			// Each pair of raw rows fills row j from both sides and row ( rows - j - 1 ) from both sides
+			forEachRowBlock( ( uiRows / 2 ), uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				if ( counter % ( uiCols / 2 ) == 0 )
+				for ( std::uint32_t j = uiFirst; j < uiLast; j++ )
 				{
-					end = ( uiCols * uiRows ) - ( uiCols * j ) - 1;
-					begin = ( uiCols * j ) + 0;	// Left in 0 for clarity
+					const T* pRaw = pBuf + ( 2 * static_cast< std::uint64_t >( uiCols ) * j );
 
-					j++;							// Number of completed rows
+					std::uint64_t end = uiCount - ( static_cast< std::uint64_t >( uiCols ) * j ) - 1;
+					std::uint64_t begin = ( static_cast< std::uint64_t >( uiCols ) * j ) + 0;	// Left in 0 for clarity
 
-					counter = 0;					// Reset for next convergece
+					for ( std::uint32_t counter = 0; counter < ( uiCols / 2 ); counter++ )
+					{
+						*( m_pNewData.get() + begin + counter ) = *( pRaw++ );		// front_row--->
+						*( m_pNewData.get() + begin + uiCols - 1 - counter ) = *( pRaw++ );		// front_row<--
+						*( m_pNewData.get() + end - counter ) = *( pRaw++ );		// end_row<----
+						*( m_pNewData.get() + end - uiCols + 1 + counter ) = *( pRaw++ );		// end_row---->
+					}
 				}
-
-				*( m_pNewData.get() + begin + counter ) = *( pBuf + i++ );		// front_row--->
-				*( m_pNewData.get() + begin + uiCols - 1 - counter ) = *( pBuf + i++ );		// front_row<--
-				*( m_pNewData.get() + end - counter ) = *( pBuf + i++ );		// end_row<----
-				*( m_pNewData.get() + end - uiCols + 1 + counter ) = *( pBuf + i++ );		// end_row---->
-
-				counter++;
-			}
+			} );
 
 			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
@@ -502,39 +777,36 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::quadIR( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::quadIR( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			std::uint32_t i = 0;
-			std::uint32_t j = uiRows - 1;
-			std::uint32_t counter = 0;
-			std::uint32_t end = 0;
-			std::uint32_t begin = 0;
-
 			if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD IR deinterlace."s );
 			}
 
-			while ( i < ( uiCols * uiRows ) )
+			// Each pair of raw rows fills one row of the top half and one row of the bottom half
+			forEachRowBlock( ( uiRows / 2 ), uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				if ( counter % ( uiCols / 2 ) == 0 )
+				for ( std::uint32_t g = uiFirst; g < uiLast; g++ )
 				{
-					end = ( j - ( uiRows / 2 ) ) * uiCols;
-					begin = j * uiCols;
+					const T* pRaw = pBuf + ( 2 * static_cast< std::uint64_t >( uiCols ) * g );
 
-					j--; 						// Nnumber of completed rows
-
-					counter = 0; 				// Reset for next convergece
-				}
+					const std::uint32_t j = ( uiRows - 1 - g );
 
-				*( m_pNewData.get() + begin + counter ) = *( pBuf + i++ );	// front_row--->
-				*( m_pNewData.get() + begin + ( uiCols / 2 ) + counter ) = *( pBuf + i++ );	// front_row<--
-				*( m_pNewData.get() + end + ( uiCols / 2 ) + counter ) = *( pBuf + i++ );	// end_row<----
-				*( m_pNewData.get() + end + counter ) = *( pBuf + i++ );	// end_row---->
+					std::uint64_t end = static_cast< std::uint64_t >( j - ( uiRows / 2 ) ) * uiCols;
+					std::uint64_t begin = static_cast< std::uint64_t >( j ) * uiCols;
 
-				counter++;
-			}
+					for ( std::uint32_t counter = 0; counter < ( uiCols / 2 ); counter++ )
+					{
+						*( m_pNewData.get() + begin + counter ) = *( pRaw++ );	// front_row--->
+						*( m_pNewData.get() + begin + ( uiCols / 2 ) + counter ) = *( pRaw++ );	// front_row<--
+						*( m_pNewData.get() + end + ( uiCols / 2 ) + counter ) = *( pRaw++ );	// end_row<----
+						*( m_pNewData.get() + end + counter ) = *( pRaw++ );	// end_row---->
+					}
+				}
+			} );
 
 			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
@@ -568,62 +840,52 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::quadIRCDS( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			std::uint32_t i			= 0;
-			std::uint32_t j			= 0;
-			std::uint32_t counter	= 0;
-			std::uint32_t end		= 0;
-			std::uint32_t begin		= 0;
-
-			T* pOldStart = pBuf;
-			T* pNewStart = m_pNewData.get();
-
-			auto uiLocalRows = uiRows;
-
-			if ( ( uiCols % 2 ) != 0 || ( uiLocalRows % 2 ) != 0 )
+			if ( ( uiCols % 2 ) != 0 || ( uiRows % 2 ) != 0 )
 			{
 				throwArcGen3Error( "Number of COLS and ROWS must be EVEN for QUAD IR CDS deinterlace."s );
 			}
 
+			// Each image half is a complete quad IR frame
+			if ( ( uiRows % 4 ) != 0 )
+			{
+				throwArcGen3Error( "Number of ROWS must be a multiple of 4 for QUAD IR CDS deinterlace."s );
+			}
+
 			// Set the the number of rows to half the image size.
-			uiLocalRows	= ( uiLocalRows / 2U );
+			const std::uint32_t uiLocalRows = ( uiRows / 2U );
+			const std::uint32_t uiGroups = ( uiLocalRows / 2U );
 
-			// Deinterlace the two image halves separately.
-			for ( int imageSection = 0; imageSection < 2; imageSection++ )
+			// Deinterlace the two image halves together; each pair of raw rows
+			// fills one row of the top and bottom quarter of its half.
+			forEachRowBlock( ( 2 * uiGroups ), uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				i = 0;
-				j = uiLocalRows - 1;
-				counter = 0;
-				end = 0;
-				begin = 0;
-
-				while ( i < ( uiCols * uiLocalRows ) )
+				for ( std::uint32_t g = uiFirst; g < uiLast; g++ )
 				{
-					if ( ( counter % ( uiCols / 2 ) ) == 0 )
-					{
-						end = ( j - ( uiLocalRows / 2 ) ) * uiCols;
-						begin = j * uiCols;
+					const std::uint64_t uiSection = ( static_cast< std::uint64_t >( g / uiGroups ) * uiLocalRows * uiCols );
 
-						j--; 			// Number of completed rows
+					const T* pRaw = pBuf + uiSection + ( 2 * static_cast< std::uint64_t >( uiCols ) * ( g % uiGroups ) );
+					T* pNewStart = m_pNewData.get() + uiSection;
 
-						counter = 0; 	// Reset for next convergece
-					}
+					const std::uint32_t j = ( uiLocalRows - 1 - ( g % uiGroups ) );
 
-					*( pNewStart + begin + counter ) = *( pOldStart + i++ );		// front_row--->
-					*( pNewStart + begin + ( uiCols / 2 ) + counter ) = *( pOldStart + i++ );		// front_row<--
-					*( pNewStart + end + ( uiCols / 2 ) + counter ) = *( pOldStart + i++ );		// end_row<----
-					*( pNewStart + end + counter ) = *( pOldStart + i++ );		// end_row---->
+					std::uint64_t end = static_cast< std::uint64_t >( j - uiGroups ) * uiCols;
+					std::uint64_t begin = static_cast< std::uint64_t >( j ) * uiCols;
 
-					counter++;
+					for ( std::uint32_t counter = 0; counter < ( uiCols / 2 ); counter++ )
+					{
+						*( pNewStart + begin + counter ) = *( pRaw++ );		// front_row--->
+						*( pNewStart + begin + ( uiCols / 2 ) + counter ) = *( pRaw++ );		// front_row<--
+						*( pNewStart + end + ( uiCols / 2 ) + counter ) = *( pRaw++ );		// end_row<----
+						*( pNewStart + end + counter ) = *( pRaw++ );		// end_row---->
+					}
 				}
+			} );
 
-				pOldStart += ( static_cast< std::uint64_t >( uiLocalRows ) * static_cast< std::uint64_t >( uiCols ) );
-				pNewStart += ( static_cast< std::uint64_t >( uiLocalRows ) * static_cast< std::uint64_t >( uiCols ) );
-			}
-
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiLocalRows ) * sizeof( T ) ) );
+			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 		}
 
 
@@ -647,9 +909,11 @@ namespace arc
 		// |  <IN>  -> uiCols    - Number of columns in image to deinterlace                                          |
 		// |  <IN>  -> uiRows    - Number of rows in image to deinterlace                                             |
 		// |  <IN>  -> uChannels - The number of channels in the image (16, 32, ..)                                   |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcDeinterlace<T>::hawaiiRG( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uChannels )
+		void CArcDeinterlace<T>::hawaiiRG( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uChannels,
+											const std::uint32_t uiThreads )
 		{
 			const std::uint32_t ERR = 0x00455252;
 
@@ -676,23 +940,25 @@ namespace arc
 
 			else
 			{
-				T* pRow = m_pNewData.get();
-
-				std::uint32_t offset = uiCols / uChannels;
-				std::uint32_t dataIndex = 0;
+				const std::uint32_t offset = uiCols / uChannels;
 
-				for ( std::uint64_t r = 0; r < uiRows; r++ )
+				forEachRowBlock( uiRows, uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
 				{
-					pRow = m_pNewData.get() + ( uiCols * r );
-
-					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / uChannels ); c++ )
+					for ( std::uint64_t r = uiFirst; r < uiLast; r++ )
 					{
-						for ( std::remove_const_t<decltype( uChannels )> i = 0; i < uChannels; i++ )
+						T* pRow = m_pNewData.get() + ( uiCols * r );
+
+						std::uint64_t dataIndex = ( r * offset * uChannels );
+
+						for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / uChannels ); c++ )
 						{
-							pRow[ c + i * offset ] = pBuf[ dataIndex++ ];
+							for ( std::remove_const_t<decltype( uChannels )> i = 0; i < uChannels; i++ )
+							{
+								pRow[ c + i * offset ] = pBuf[ dataIndex++ ];
+							}
 						}
 					}
-				}
+				} );
 
 				copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 			}
@@ -723,8 +989,9 @@ namespace arc
 		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
 		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
 		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per library executor thread                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcDeinterlace<T>::sta1600( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcDeinterlace<T>::sta1600( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
 			if ( ( uiCols % 16 ) != 0 )
 			{
@@ -736,43 +1003,328 @@ namespace arc
 				throwArcGen3Error( "Number of ROWS must be a multiple of 2 for STA1600 deinterlace."s );
 			}
 
-			T* botPtr = m_pNewData.get();
-			T* topPtr = m_pNewData.get() + ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows - 1 ) );
+			const std::uint32_t offset = uiCols / 8;
+
+			// Each pair of raw rows fills one row at either end of the image
+			forEachRowBlock( ( uiRows / 2 ), uiThreads, [ & ]( std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint64_t r = uiFirst; r < uiLast; r++ )
+				{
+					T* topPtr = m_pNewData.get() + ( uiCols * ( uiRows - r - 1 ) );
+					T* botPtr = m_pNewData.get() + ( uiCols * r );
+
+					std::uint64_t dataIndex = ( 2 * r * uiCols );
+
+					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / 8 ); c++ )
+					{
+						botPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
+						botPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
+
+						topPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
+						topPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
+					}
+				}
+			} );
+
+			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+		}
+
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | serialLean                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Serial deinterlace using one row of scratch memory. Each serial readout row only holds pixels of the     |
+		// | same image row, so rows are deinterlaced independently.                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf   - Pointer to the image pixels to deinterlace                                            |
+		// |  <IN>  -> uiCols - Number of columns in image to deinterlace                                             |
+		// |  <IN>  -> uiRows - Number of rows in image to deinterlace                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlace<T>::serialLean( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( ( uiCols % 2 ) != 0 )
+			{
+				throwArcGen3Error( "Number of COLS must be EVEN for SERIAL deinterlace."s );
+			}
+
+			T* pRow = scratch( uiCols, 1 );
 
-			std::uint32_t offset = uiCols / 8;
-			std::uint32_t dataIndex = 0;
+			const std::uint32_t uiHalf = ( uiCols / 2 );
 
-			for ( std::uint64_t r = 0; r < ( uiRows / 2 ); r++ )
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
 			{
-				topPtr = m_pNewData.get() + ( uiCols * ( uiRows - r - 1 ) );
-				botPtr = m_pNewData.get() + ( uiCols * r );
+				T* pLine = pBuf + ( static_cast< std::uint64_t >( r ) * static_cast< std::uint64_t >( uiCols ) );
 
-				for ( std::remove_const_t<decltype( uiCols )> c = 0; c < ( uiCols / 8 ); c++ )
+				for ( std::uint32_t c = 0; c < uiHalf; c++ )
 				{
-					botPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
-					botPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
-
-					topPtr[ c + 7 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 6 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 5 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 4 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 3 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 2 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 1 * offset ] = pBuf[ dataIndex++ ];
-					topPtr[ c + 0 * offset ] = pBuf[ dataIndex++ ];
+					pRow[ c ] = pLine[ 2 * c ];
+					pRow[ uiCols - 1 - c ] = pLine[ 2 * c + 1 ];
 				}
+
+				copyMemory( pLine, pRow, ( static_cast< std::size_t >( uiCols ) * sizeof( T ) ) );
 			}
+		}
 
-			copyMemory( pBuf, m_pNewData.get(), ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | hawaiiRGLean                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Hawaii RG deinterlace using one row of scratch memory. Each readout row only holds pixels of the same    |
+		// | image row, so rows are deinterlaced independently.                                                       |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf      - Pointer to the image pixels to deinterlace                                         |
+		// |  <IN>  -> uiCols    - Number of columns in image to deinterlace                                          |
+		// |  <IN>  -> uiRows    - Number of rows in image to deinterlace                                             |
+		// |  <IN>  -> uChannels - The number of channels in the image (16, 32, ..)                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::hawaiiRGLean( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uChannels )
+		{
+			const std::uint32_t ERR = 0x00455252;
+
+			if ( ( uiCols % 2 ) != 0 )
+			{
+				throwArcGen3Error( "Number of COLS must be EVEN for HAWAII RG deinterlace."s );
+			}
+
+			else if ( uChannels == 1 )
+			{
+				// Ignore and don't de-interlace. Matches hawaiiRG().
+			}
+
+			else if ( uChannels == 0 || uChannels == ERR )
+			{
+				throwArcGen3Error( "The number of readout channels must be supplied for HAWAII RG deinterlace."s );
+			}
+
+			else if ( uChannels % 2 != 0 )
+			{
+				throwArcGen3Error( "The readout channel count must be EVEN for HAWAII RG deinterlace."s );
+			}
+
+			else if ( ( uiCols % uChannels ) != 0 )
+			{
+				throwArcGen3Error( "Number of COLS [ %u ] must be a multiple of the channel count [ %u ] for HAWAII RG deinterlace.", uiCols, uChannels );
+			}
+
+			else
+			{
+				T* pRow = scratch( uiCols, 1 );
+
+				const std::uint32_t offset = ( uiCols / uChannels );
+
+				for ( std::uint32_t r = 0; r < uiRows; r++ )
+				{
+					T* pLine = pBuf + ( static_cast< std::uint64_t >( r ) * static_cast< std::uint64_t >( uiCols ) );
+
+					for ( std::uint32_t i = 0; i < uChannels; i++ )
+					{
+						T* pOut = pRow + ( i * offset );
+
+						for ( std::uint32_t c = 0; c < offset; c++ )
+						{
+							pOut[ c ] = pLine[ c * uChannels + i ];
+						}
+					}
+
+					copyMemory( pLine, pRow, ( static_cast< std::size_t >( uiCols ) * sizeof( T ) ) );
+				}
+			}
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// | permute                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces the buffer in place using the algorithm amplifier layout ( see CArcAmpLayout ). The raw     |
+		// | data holds one line of every amplifier per group of N x W pixels, where N is the amplifier count and W   |
+		// | the line length. First, each group is deinterlaced through a band of scratch memory, leaving N whole     |
+		// | image line segments of W pixels. Then the segments are moved to their image position by following the    |
+		// | cycles of the segment permutation, carrying one segment at a time. A bitmap records which segments are   |
+		// | already in place.                                                                                        |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf		- Pointer to the image pixels to deinterlace                                          |
+		// |  <IN>  -> uiCols	- Number of columns in image to deinterlace                                           |
+		// |  <IN>  -> uiRows	- Number of rows in image to deinterlace                                              |
+		// |  <IN>  -> eAlg		- Algorithm number that corresponds to deinterlacing method                           |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlace<T>::permute( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiArg )
+		{
+			//
+			// Validate the layout before the buffer is modified. Layout errors
+			// are reported as std::runtime_error, like every other run() error.
+			// -------------------------------------------------------------------
+			std::unique_ptr<CArcAmpLayout> pLayout;
+
+			try
+			{
+				pLayout = CArcAmpLayout::fromAlg( eAlg, uiCols, uiRows, uiArg );
+			}
+			catch ( const std::invalid_argument& e )
+			{
+				throwArcGen3Error( "%s", e.what() );
+			}
+
+			if ( pLayout->ampCount() == 0 )
+			{
+				return;
+			}
+
+			//
+			// Gather the amplifiers of each frame in interleave order. The line
+			// segments must tile the image on a grid of W pixels.
+			// -------------------------------------------------------------------
+			struct Seg_t { std::uint64_t uiStart; std::int64_t iSlow; bool bReverse; };
+
+			std::vector<std::vector<Seg_t>> vFrames;
+
+			const std::uint32_t uiWidth = pLayout->amp( 0 ).uiWidth;
+
+			const std::uint32_t uiHeight = pLayout->amp( 0 ).uiHeight;
+
+			for ( std::uint32_t i = 0; i < pLayout->ampCount(); i++ )
+			{
+				const auto& tAmp = pLayout->amp( i );
+
+				bool bReverse = ( tAmp.eFast == arc::gen3::dlace::e_Dir::NEG_X );
+
+				std::uint32_t uiX = ( bReverse ? ( tAmp.uiX + 1 - tAmp.uiWidth ) : tAmp.uiX );
+
+				if ( ( tAmp.eFast != arc::gen3::dlace::e_Dir::POS_X && !bReverse ) || tAmp.uiWidth != uiWidth || tAmp.uiHeight != uiHeight || ( uiX % uiWidth ) != 0 || ( uiCols % uiWidth ) != 0 )
+				{
+					throwArcGen3Error( "Memory-lean deinterlace does not support the %s layout!", pLayout->toString().c_str() );
+				}
+
+				if ( tAmp.uiFrame >= vFrames.size() )
+				{
+					vFrames.resize( tAmp.uiFrame + 1 );
+				}
+
+				if ( tAmp.uiOrder >= vFrames[ tAmp.uiFrame ].size() )
+				{
+					vFrames[ tAmp.uiFrame ].resize( tAmp.uiOrder + 1 );
+				}
+
+				vFrames[ tAmp.uiFrame ][ tAmp.uiOrder ] = Seg_t{ ( ( static_cast< std::uint64_t >( tAmp.uiY ) * uiCols + uiX ) / uiWidth ),
+																 ( tAmp.eSlow == arc::gen3::dlace::e_Dir::POS_Y ? 1 : -1 ) * static_cast< std::int64_t >( uiCols / uiWidth ),
+																 bReverse };
+			}
+
+			//
+			// Deinterlace every line group through the band
+			// ------------------------------------------------
+			const std::uint32_t uiAmps = static_cast< std::uint32_t >( vFrames[ 0 ].size() );
+
+			T* pBand = scratch( uiWidth, ( uiAmps + 1 ) );
+
+			T* pCarry = pBand + ( static_cast< std::uint64_t >( uiAmps ) * uiWidth );
+
+			const std::uint64_t uiGroup = ( static_cast< std::uint64_t >( uiAmps ) * uiWidth );
+
+			const std::uint64_t uiPixels = ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) );
+
+			for ( std::uint64_t uiOffset = 0; uiOffset < uiPixels; uiOffset += uiGroup )
+			{
+				T* pGroup = pBuf + uiOffset;
+
+				const auto& vSegs = vFrames[ ( uiOffset / uiGroup ) / uiHeight ];
+
+				for ( std::uint32_t k = 0; k < uiAmps; k++ )
+				{
+					T* pOut = pBand + ( static_cast< std::uint64_t >( k ) * uiWidth );
+
+					const T* pIn = pGroup + k;
+
+					if ( vSegs[ k ].bReverse )
+					{
+						for ( std::uint32_t f = 0; f < uiWidth; f++ )
+						{
+							pOut[ uiWidth - 1 - f ] = pIn[ static_cast< std::uint64_t >( f ) * uiAmps ];
+						}
+					}
+					else
+					{
+						for ( std::uint32_t f = 0; f < uiWidth; f++ )
+						{
+							pOut[ f ] = pIn[ static_cast< std::uint64_t >( f ) * uiAmps ];
+						}
+					}
+				}
+
+				copyMemory( pGroup, pBand, ( uiGroup * sizeof( T ) ) );
+			}
+
+			//
+			// Follow each segment permutation cycle
+			// ----------------------------------------
+			const std::uint64_t uiSegments = ( uiPixels / uiWidth );
+
+			auto destination = [ & ]( std::uint64_t uiSeg ) -> std::uint64_t
+			{
+				const std::uint64_t uiLine = ( uiSeg / uiAmps );
+
+				const auto& tSeg = vFrames[ uiLine / uiHeight ][ uiSeg % uiAmps ];
+
+				return static_cast< std::uint64_t >( static_cast< std::int64_t >( tSeg.uiStart ) + static_cast< std::int64_t >( uiLine % uiHeight ) * tSeg.iSlow );
+			};
+
+			std::vector<std::uint64_t> vDone( ( ( uiSegments + 63 ) / 64 ), 0 );
+
+			m_uiScratchBytes += ( vDone.size() * sizeof( std::uint64_t ) );
+
+			const std::size_t uiSegBytes = ( static_cast< std::size_t >( uiWidth ) * sizeof( T ) );
+
+			for ( std::uint64_t uiStart = 0; uiStart < uiSegments; uiStart++ )
+			{
+				if ( ( vDone[ uiStart >> 6 ] >> ( uiStart & 63 ) ) & 1 )
+				{
+					continue;
+				}
+
+				std::uint64_t uiDst = destination( uiStart );
+
+				if ( uiDst == uiStart )
+				{
+					vDone[ uiStart >> 6 ] |= ( 1ULL << ( uiStart & 63 ) );
+
+					continue;
+				}
+
+				copyMemory( pCarry, ( pBuf + uiStart * uiWidth ), uiSegBytes );
+
+				std::uint64_t uiSrc = uiStart;
+
+				do
+				{
+					uiDst = destination( uiSrc );
+
+					std::swap_ranges( pCarry, ( pCarry + uiWidth ), ( pBuf + uiDst * uiWidth ) );
+
+					vDone[ uiDst >> 6 ] |= ( 1ULL << ( uiDst & 63 ) );
+
+					uiSrc = uiDst;
+
+				} while ( uiSrc != uiStart );
+			}
+		}
+
 	}	// end gen3 namespace
 }		// end arc namespace
 
@@ -0,0 +1,726 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDeinterlaceBench.cpp  ( Gen3 )                                                                       |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC deinterlace benchmark and verification interface.                         |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <exception>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <limits>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef _WINDOWS
+	#include <windows.h>
+	#include <psapi.h>
+#else
+	#include <sys/resource.h>
+#endif
+
+#include <CArcDeinterlaceBench.h>
+#include <CArcDeinterlacePlan.h>
+
+
+using namespace std::string_literals;
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Local helpers                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		namespace
+		{
+			const char* algName( arc::gen3::dlace::e_Alg eAlg )
+			{
+				switch ( eAlg )
+				{
+					case arc::gen3::dlace::e_Alg::NONE:			return "NONE";
+					case arc::gen3::dlace::e_Alg::PARALLEL:		return "PARALLEL";
+					case arc::gen3::dlace::e_Alg::SERIAL:		return "SERIAL";
+					case arc::gen3::dlace::e_Alg::QUAD_CCD:		return "QUAD_CCD";
+					case arc::gen3::dlace::e_Alg::QUAD_IR:		return "QUAD_IR";
+					case arc::gen3::dlace::e_Alg::QUAD_IR_CDS:	return "QUAD_IR_CDS";
+					case arc::gen3::dlace::e_Alg::HAWAII_RG:	return "HAWAII_RG";
+					case arc::gen3::dlace::e_Alg::STA1600:		return "STA1600";
+					default:									return "CUSTOM";
+				}
+			}
+
+			const arc::gen3::dlace::e_Alg g_eAlgs[] =
+			{
+				arc::gen3::dlace::e_Alg::NONE,
+				arc::gen3::dlace::e_Alg::PARALLEL,
+				arc::gen3::dlace::e_Alg::SERIAL,
+				arc::gen3::dlace::e_Alg::QUAD_CCD,
+				arc::gen3::dlace::e_Alg::QUAD_IR,
+				arc::gen3::dlace::e_Alg::QUAD_IR_CDS,
+				arc::gen3::dlace::e_Alg::HAWAII_RG,
+				arc::gen3::dlace::e_Alg::STA1600
+			};
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  <IN>  -> uiIterations - The number of timed iterations per measurement.                                 |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> CArcDeinterlaceBench<T>::CArcDeinterlaceBench( const std::uint32_t uiIterations )
+			: CArcBase(), m_uiIterations( uiIterations )
+		{
+			if ( uiIterations == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid iteration count [ 0 ]! Must be greater than zero."s );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Destructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> CArcDeinterlaceBench<T>::~CArcDeinterlaceBench( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | measure                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Benchmarks one algorithm and geometry. Each thread deinterlaces its own copy of a golden interlaced      |
+		// | image using CArcDeinterlace::run(), an in place plan and an out of place plan. Throughput is summed over |
+		// | all threads; the time per pixel is averaged over all threads.                                            |
+		// |                                                                                                          |
+		// |  <IN>  -> eAlg			- The algorithm to measure.                                                       |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiArg		- Algorithm dependent argument.                                                   |
+		// |  <IN>  -> uiThreads	- The number of concurrent threads.                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::runtime_error                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::dlace::Bench_t CArcDeinterlaceBench<T>::measure( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows,
+																	const std::uint32_t uiArg, const std::uint32_t uiThreads )
+		{
+			using clock_t = std::chrono::steady_clock;
+
+			if ( uiThreads == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid thread count [ 0 ]! Must be greater than zero."s );
+			}
+
+			//
+			// Validates the algorithm and geometry before any thread is started
+			// ---------------------------------------------------------------------
+			CArcDeinterlacePlan<T> cCheck( eAlg, uiCols, uiRows, uiArg );
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
+
+			std::unique_ptr<T[]> pRaw( new T[ uiPixels ] );
+
+			fillGolden( pRaw.get(), eAlg, uiCols, uiRows, uiArg );
+
+			struct Times_t { double gRun, gCreate, gPlan, gCopy, gLean; std::uint64_t uiRunBytes, uiLeanBytes; };
+
+			std::vector<Times_t> vTimes( uiThreads, Times_t{ 0, 0, 0, 0, 0, 0, 0 } );
+
+			std::vector<std::exception_ptr> vErrors( uiThreads );
+
+			std::vector<std::thread> vThreads;
+
+			const auto uiIterations = m_uiIterations;
+
+			for ( std::uint32_t t = 0; t < uiThreads; t++ )
+			{
+				vThreads.emplace_back( [ &, t ]()
+				{
+					try
+					{
+						std::unique_ptr<T[]> pWork( new T[ uiPixels ] );
+						std::unique_ptr<T[]> pOut( new T[ uiPixels ] );
+
+						auto seconds = []( clock_t::time_point tStart ) { return std::chrono::duration<double>( clock_t::now() - tStart ).count(); };
+
+						copyMemory( pWork.get(), pRaw.get(), ( uiPixels * sizeof( T ) ) );
+
+						CArcDeinterlace<T> cDeinterlace;
+
+						cDeinterlace.run( pWork.get(), uiCols, uiRows, eAlg, { uiArg } );		// Warm up and allocate
+
+						auto tStart = clock_t::now();
+
+						for ( std::uint32_t i = 0; i < uiIterations; i++ )
+						{
+							cDeinterlace.run( pWork.get(), uiCols, uiRows, eAlg, { uiArg } );
+						}
+
+						vTimes[ t ].gRun = seconds( tStart );
+
+						vTimes[ t ].uiRunBytes = cDeinterlace.scratchBytes();
+
+						CArcDeinterlace<T> cLean;
+
+						cLean.setMemoryLimit( 0 );
+
+						cLean.run( pWork.get(), uiCols, uiRows, eAlg, { uiArg } );
+
+						tStart = clock_t::now();
+
+						for ( std::uint32_t i = 0; i < uiIterations; i++ )
+						{
+							cLean.run( pWork.get(), uiCols, uiRows, eAlg, { uiArg } );
+						}
+
+						vTimes[ t ].gLean = seconds( tStart );
+
+						vTimes[ t ].uiLeanBytes = cLean.scratchBytes();
+
+						tStart = clock_t::now();
+
+						CArcDeinterlacePlan<T> cPlan( eAlg, uiCols, uiRows, uiArg );
+
+						vTimes[ t ].gCreate = seconds( tStart );
+
+						cPlan.execute( pWork.get() );
+
+						tStart = clock_t::now();
+
+						for ( std::uint32_t i = 0; i < uiIterations; i++ )
+						{
+							cPlan.execute( pWork.get() );
+						}
+
+						vTimes[ t ].gPlan = seconds( tStart );
+
+						cPlan.execute( pRaw.get(), pOut.get() );
+
+						tStart = clock_t::now();
+
+						for ( std::uint32_t i = 0; i < uiIterations; i++ )
+						{
+							cPlan.execute( pRaw.get(), pOut.get() );
+						}
+
+						vTimes[ t ].gCopy = seconds( tStart );
+					}
+					catch ( ... )
+					{
+						vErrors[ t ] = std::current_exception();
+					}
+				} );
+			}
+
+			for ( auto& tThread : vThreads )
+			{
+				tThread.join();
+			}
+
+			for ( auto& pError : vErrors )
+			{
+				if ( pError )
+				{
+					std::rethrow_exception( pError );
+				}
+			}
+
+			//
+			// Reduce the per-thread times
+			// ------------------------------
+			const double gBytes = ( static_cast< double >( uiPixels ) * sizeof( T ) * uiIterations );
+			const double gCount = ( static_cast< double >( uiPixels ) * uiIterations );
+
+			arc::gen3::dlace::Bench_t tResult{ eAlg, uiCols, uiRows, uiArg, uiThreads, static_cast< std::uint32_t >( sizeof( T ) ), 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+
+			for ( const auto& tTimes : vTimes )
+			{
+				tResult.gRunGBps			+= ( gBytes / std::max( tTimes.gRun, 1e-12 ) / 1e9 );
+				tResult.gPlanGBps			+= ( gBytes / std::max( tTimes.gPlan, 1e-12 ) / 1e9 );
+				tResult.gPlanCopyGBps		+= ( gBytes / std::max( tTimes.gCopy, 1e-12 ) / 1e9 );
+				tResult.gRunNsPerPixel		+= ( tTimes.gRun * 1e9 / gCount / uiThreads );
+				tResult.gPlanNsPerPixel		+= ( tTimes.gPlan * 1e9 / gCount / uiThreads );
+				tResult.gPlanCopyNsPerPixel	+= ( tTimes.gCopy * 1e9 / gCount / uiThreads );
+				tResult.gPlanCreateUs		+= ( tTimes.gCreate * 1e6 / uiThreads );
+				tResult.gLeanGBps			+= ( gBytes / std::max( tTimes.gLean, 1e-12 ) / 1e9 );
+				tResult.gLeanNsPerPixel		+= ( tTimes.gLean * 1e9 / gCount / uiThreads );
+				tResult.uiRunScratchBytes	 = std::max( tResult.uiRunScratchBytes, tTimes.uiRunBytes );
+				tResult.uiLeanScratchBytes	 = std::max( tResult.uiLeanScratchBytes, tTimes.uiLeanBytes );
+			}
+
+			tResult.uiPeakRSS = peakRSS();
+
+			return tResult;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | measureAll                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Benchmarks every built-in algorithm over a grid of geometries and thread counts.                         |
+		// |                                                                                                          |
+		// |  <IN>  -> uiMaxThreads - The maximum number of concurrent threads.                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::vector<arc::gen3::dlace::Bench_t> CArcDeinterlaceBench<T>::measureAll( const std::uint32_t uiMaxThreads )
+		{
+			const std::uint32_t uiSizes[] = { 512, 1024, 2048, 4096 };
+
+			std::vector<std::uint32_t> vThreads;
+
+			for ( std::uint32_t uiThreads = 1; uiThreads < uiMaxThreads; uiThreads *= 2 )
+			{
+				vThreads.push_back( uiThreads );
+			}
+
+			vThreads.push_back( std::max( uiMaxThreads, 1U ) );
+
+			std::vector<arc::gen3::dlace::Bench_t> vResults;
+
+			for ( auto eAlg : g_eAlgs )
+			{
+				for ( auto uiSize : uiSizes )
+				{
+					for ( auto uiThreads : vThreads )
+					{
+						vResults.push_back( measure( eAlg, uiSize, uiSize, ( eAlg == arc::gen3::dlace::e_Alg::HAWAII_RG ? 32 : 0 ), uiThreads ) );
+					}
+				}
+			}
+
+			return vResults;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | report                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns a printable table of benchmark results.                                                          |
+		// |                                                                                                          |
+		// |  <IN>  -> vResults - The results to format.                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::string CArcDeinterlaceBench<T>::report( const std::vector<arc::gen3::dlace::Bench_t>& vResults )
+		{
+			char szLine[ 320 ];
+
+			std::snprintf( szLine, sizeof( szLine ), "%-12s %5s %5s %4s %3s %4s | %8s %8s %9s | %9s %8s %9s | %10s | %9s %8s | %9s %8s | %9s\n",
+						   "ALG", "COLS", "ROWS", "ARG", "BPP", "THR", "RUN GB/s", "ns/pix", "RUN KiB", "LEAN GB/s", "ns/pix", "LEAN KiB",
+						   "PLAN us", "PLAN GB/s", "ns/pix", "COPY GB/s", "ns/pix", "RSS MiB" );
+
+			std::string sReport( szLine );
+
+			for ( const auto& tResult : vResults )
+			{
+				std::snprintf( szLine, sizeof( szLine ), "%-12s %5u %5u %4u %3u %4u | %8.2f %8.3f %9.1f | %9.2f %8.3f %9.1f | %10.1f | %9.2f %8.3f | %9.2f %8.3f | %9.1f\n",
+							   algName( tResult.eAlg ), tResult.uiCols, tResult.uiRows, tResult.uiArg, ( tResult.uiBytesPerPixel * 8 ), tResult.uiThreads,
+							   tResult.gRunGBps, tResult.gRunNsPerPixel, ( tResult.uiRunScratchBytes / 1024.0 ),
+							   tResult.gLeanGBps, tResult.gLeanNsPerPixel, ( tResult.uiLeanScratchBytes / 1024.0 ),
+							   tResult.gPlanCreateUs, tResult.gPlanGBps, tResult.gPlanNsPerPixel,
+							   tResult.gPlanCopyGBps, tResult.gPlanCopyNsPerPixel, ( tResult.uiPeakRSS / 1048576.0 ) );
+
+				sReport += szLine;
+			}
+
+			return sReport;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verify                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcDeinterlace::run(), with and without a memory limit, and both                               |
+		// | CArcDeinterlacePlan::execute() methods against a golden interlaced ramp, and both                        |
+		// | CArcDeinterlacePlan::interlace() methods against the golden raw data stream.                             |
+		// | CDS plans are also checked against the difference of the golden image halves.                            |
+		// |                                                                                                          |
+		// |  <IN>  -> eAlg		- The algorithm to verify.                                                            |
+		// |  <IN>  -> uiCols	- The number of image columns.                                                        |
+		// |  <IN>  -> uiRows	- The number of image rows.                                                           |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlaceBench<T>::verify( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg )
+		{
+			CArcDeinterlacePlan<T> cPlan( eAlg, uiCols, uiRows, uiArg );
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) );
+
+			std::unique_ptr<T[]> pRaw( new T[ uiPixels ] );
+			std::unique_ptr<T[]> pBuf( new T[ uiPixels ] );
+
+			fillGolden( pRaw.get(), eAlg, uiCols, uiRows, uiArg );
+
+			copyMemory( pBuf.get(), pRaw.get(), ( uiPixels * sizeof( T ) ) );
+
+			CArcDeinterlace<T> cDeinterlace;
+
+			cDeinterlace.run( pBuf.get(), uiCols, uiRows, eAlg, { uiArg } );
+
+			compareGolden( pBuf.get(), uiCols, uiRows, "CArcDeinterlace::run()"s, eAlg );
+
+			copyMemory( pBuf.get(), pRaw.get(), ( uiPixels * sizeof( T ) ) );
+
+			cDeinterlace.setMemoryLimit( 0 );
+
+			cDeinterlace.run( pBuf.get(), uiCols, uiRows, eAlg, { uiArg } );
+
+			compareGolden( pBuf.get(), uiCols, uiRows, "CArcDeinterlace::run( memory-lean )"s, eAlg );
+
+			copyMemory( pBuf.get(), pRaw.get(), ( uiPixels * sizeof( T ) ) );
+
+			cPlan.execute( pBuf.get() );
+
+			compareGolden( pBuf.get(), uiCols, uiRows, "CArcDeinterlacePlan::execute( in place )"s, eAlg );
+
+			zeroMemory( pBuf.get(), ( uiPixels * sizeof( T ) ) );
+
+			cPlan.execute( pRaw.get(), pBuf.get() );
+
+			compareGolden( pBuf.get(), uiCols, uiRows, "CArcDeinterlacePlan::execute( out of place )"s, eAlg );
+
+			//
+			// The inverse transform must reproduce the golden raw data stream
+			// ------------------------------------------------------------------
+			std::unique_ptr<T[]> pImage( new T[ uiPixels ] );
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				pImage[ i ] = goldenValue( i );
+			}
+
+			cPlan.interlace( pImage.get(), pBuf.get() );
+
+			compareRaw( pBuf.get(), pRaw.get(), uiCols, uiRows, "CArcDeinterlacePlan::interlace( out of place )"s, eAlg );
+
+			cPlan.interlace( pImage.get() );
+
+			compareRaw( pImage.get(), pRaw.get(), uiCols, uiRows, "CArcDeinterlacePlan::interlace( in place )"s, eAlg );
+
+			//
+			// The fused CDS kernel must match the difference of the golden halves
+			// ----------------------------------------------------------------------
+			if ( cPlan.isCDS() )
+			{
+				const std::size_t uiHalf = ( uiPixels / 2 );
+
+				std::unique_ptr<std::int32_t[]> pDiff( new std::int32_t[ uiHalf ] );
+
+				cPlan.cds( pRaw.get(), pDiff.get() );
+
+				for ( std::size_t i = 0; i < uiHalf; i++ )
+				{
+					auto iExpected = static_cast< std::int64_t >( goldenValue( i ) ) - static_cast< std::int64_t >( goldenValue( i + uiHalf ) );
+
+					iExpected = std::clamp<std::int64_t>( iExpected, std::numeric_limits<std::int32_t>::min(), std::numeric_limits<std::int32_t>::max() );
+
+					if ( pDiff[ i ] != iExpected )
+					{
+						throwArcGen3Error( "CArcDeinterlacePlan::cds() %s [ %u x %u ] mismatch at pixel [ %u, %u ]! Expected: %l Found: %d",
+										   algName( eAlg ), uiCols, uiRows, static_cast< std::uint32_t >( i % uiCols ), static_cast< std::uint32_t >( i / uiCols ),
+										   static_cast< long >( iExpected ), pDiff[ i ] );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyAll                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies every built-in algorithm over a grid of geometries.                                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlaceBench<T>::verifyAll( void )
+		{
+			const std::uint32_t uiDims[][ 2 ] = { { 16, 4 }, { 32, 8 }, { 64, 12 }, { 160, 20 }, { 528, 1028 }, { 1024, 1024 }, { 4096, 256 } };
+
+			const std::uint32_t uiChannels[] = { 1, 2, 4, 8, 16, 32 };
+
+			for ( const auto& uiDim : uiDims )
+			{
+				for ( auto eAlg : g_eAlgs )
+				{
+					if ( eAlg == arc::gen3::dlace::e_Alg::HAWAII_RG )
+					{
+						for ( auto uiChannel : uiChannels )
+						{
+							if ( ( uiDim[ 0 ] % uiChannel ) == 0 )
+							{
+								verify( eAlg, uiDim[ 0 ], uiDim[ 1 ], uiChannel );
+							}
+						}
+					}
+
+					else
+					{
+						verify( eAlg, uiDim[ 0 ], uiDim[ 1 ] );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | fillGolden                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Fills a buffer with the raw data stream that deinterlaces to the golden ramp.                            |
+		// |                                                                                                          |
+		// |  <OUT> -> pBuf		- The buffer to fill.                                                                 |
+		// |  <IN>  -> eAlg		- The algorithm.                                                                      |
+		// |  <IN>  -> uiCols	- The number of image columns.                                                        |
+		// |  <IN>  -> uiRows	- The number of image rows.                                                           |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlaceBench<T>::fillGolden( T* pBuf, arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( eAlg == arc::gen3::dlace::e_Alg::CUSTOM )
+			{
+				throwArcGen3InvalidArgument( "Custom algorithms have no golden data!"s );
+			}
+
+			const std::uint64_t uiPixels = ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) );
+
+			for ( std::uint64_t i = 0; i < uiPixels; i++ )
+			{
+				pBuf[ i ] = goldenValue( goldenIndex( eAlg, uiCols, uiRows, uiArg, i ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | peakRSS                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the peak resident set size of the calling process in bytes, or zero if it is not available.      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint64_t CArcDeinterlaceBench<T>::peakRSS( void ) noexcept
+		{
+		#ifdef _WINDOWS
+			PROCESS_MEMORY_COUNTERS tCounters;
+
+			if ( GetProcessMemoryInfo( GetCurrentProcess(), &tCounters, sizeof( tCounters ) ) )
+			{
+				return static_cast< std::uint64_t >( tCounters.PeakWorkingSetSize );
+			}
+		#else
+			struct rusage tUsage;
+
+			if ( getrusage( RUSAGE_SELF, &tUsage ) == 0 )
+			{
+				#ifdef __APPLE__
+					return static_cast< std::uint64_t >( tUsage.ru_maxrss );			// bytes
+				#else
+					return ( static_cast< std::uint64_t >( tUsage.ru_maxrss ) * 1024 );	// kilobytes
+				#endif
+			}
+		#endif
+
+			return 0;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | goldenValue                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the golden value of a deinterlaced image pixel. The ramp is scrambled with a multiplicative hash |
+		// | so that 16-bit images larger than 65536 pixels do not repeat with a period of whole rows.                |
+		// |                                                                                                          |
+		// |  <IN>  -> uiIndex - The deinterlaced image pixel index.                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> T CArcDeinterlaceBench<T>::goldenValue( const std::uint64_t uiIndex ) noexcept
+		{
+			return static_cast< T >( ( ( uiIndex + 1 ) * 0x9E3779B97F4A7C15ULL ) >> 32 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | goldenIndex                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the deinterlaced image index of a raw stream pixel. Pixel i of the raw stream was read by        |
+		// | channel k = i % N as its t = i / N 'th pixel, which lies at fast position f = t % W along line            |
+		// | s = t / W, where N is the channel count and W the channel line length.                                   |
+		// |                                                                                                          |
+		// |  <IN>  -> eAlg		- The algorithm.                                                                      |
+		// |  <IN>  -> uiCols	- The number of image columns.                                                        |
+		// |  <IN>  -> uiRows	- The number of image rows.                                                           |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument.                                                       |
+		// |  <IN>  -> uiRaw	- The raw data stream index.                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcDeinterlaceBench<T>::goldenIndex( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows,
+															const std::uint32_t uiArg, const std::uint64_t uiRaw ) noexcept
+		{
+			const std::uint64_t C = uiCols;
+			const std::uint64_t R = uiRows;
+
+			auto index = []( std::uint64_t uiY, std::uint64_t uiX, std::uint64_t uiC ) { return ( uiY * uiC + uiX ); };
+
+			switch ( eAlg )
+			{
+				case arc::gen3::dlace::e_Alg::PARALLEL:
+				{
+					std::uint64_t k = ( uiRaw % 2 ), t = ( uiRaw / 2 ), f = ( t % C ), s = ( t / C );
+
+					return ( k == 0 ? index( s, f, C ) : index( ( R - 1 - s ), ( C - 1 - f ), C ) );
+				}
+
+				case arc::gen3::dlace::e_Alg::SERIAL:
+				{
+					std::uint64_t W = ( C / 2 ), k = ( uiRaw % 2 ), t = ( uiRaw / 2 ), f = ( t % W ), s = ( t / W );
+
+					return ( k == 0 ? index( s, f, C ) : index( s, ( C - 1 - f ), C ) );
+				}
+
+				case arc::gen3::dlace::e_Alg::QUAD_CCD:
+				{
+					std::uint64_t W = ( C / 2 ), k = ( uiRaw % 4 ), t = ( uiRaw / 4 ), f = ( t % W ), s = ( t / W );
+
+					switch ( k )
+					{
+						case 0:  return index( s, f, C );
+						case 1:  return index( s, ( C - 1 - f ), C );
+						case 2:  return index( ( R - 1 - s ), ( C - 1 - f ), C );
+						default: return index( ( R - 1 - s ), f, C );
+					}
+				}
+
+				case arc::gen3::dlace::e_Alg::QUAD_IR:
+				case arc::gen3::dlace::e_Alg::QUAD_IR_CDS:
+				{
+					std::uint64_t F = ( eAlg == arc::gen3::dlace::e_Alg::QUAD_IR_CDS ? ( R / 2 ) : R );
+					std::uint64_t uiFrame = ( uiRaw / ( F * C ) ), uiLocal = ( uiRaw % ( F * C ) );
+					std::uint64_t W = ( C / 2 ), k = ( uiLocal % 4 ), t = ( uiLocal / 4 ), f = ( t % W ), s = ( t / W );
+					std::uint64_t Y0 = ( uiFrame * F );
+
+					switch ( k )
+					{
+						case 0:  return index( ( Y0 + F - 1 - s ), f, C );
+						case 1:  return index( ( Y0 + F - 1 - s ), ( W + f ), C );
+						case 2:  return index( ( Y0 + ( F / 2 ) - 1 - s ), ( W + f ), C );
+						default: return index( ( Y0 + ( F / 2 ) - 1 - s ), f, C );
+					}
+				}
+
+				case arc::gen3::dlace::e_Alg::HAWAII_RG:
+				{
+					if ( uiArg <= 1 )
+					{
+						return uiRaw;
+					}
+
+					std::uint64_t N = uiArg, W = ( C / N ), k = ( uiRaw % N ), t = ( uiRaw / N ), f = ( t % W ), s = ( t / W );
+
+					return index( s, ( k * W + f ), C );
+				}
+
+				case arc::gen3::dlace::e_Alg::STA1600:
+				{
+					std::uint64_t W = ( C / 8 ), k = ( uiRaw % 16 ), t = ( uiRaw / 16 ), f = ( t % W ), s = ( t / W );
+
+					return ( k < 8 ? index( s, ( ( 7 - k ) * W + f ), C ) : index( ( R - 1 - s ), ( ( 15 - k ) * W + f ), C ) );
+				}
+
+				default:
+				{
+					return uiRaw;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | compareGolden                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Compares a deinterlaced buffer against the golden ramp.                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf		- The deinterlaced buffer.                                                            |
+		// |  <IN>  -> uiCols	- The number of image columns.                                                        |
+		// |  <IN>  -> uiRows	- The number of image rows.                                                           |
+		// |  <IN>  -> sWhat	- Description of the tested method.                                                   |
+		// |  <IN>  -> eAlg		- The algorithm.                                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlaceBench<T>::compareGolden( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sWhat, arc::gen3::dlace::e_Alg eAlg )
+		{
+			for ( std::uint32_t uiRow = 0; uiRow < uiRows; uiRow++ )
+			{
+				for ( std::uint32_t uiCol = 0; uiCol < uiCols; uiCol++ )
+				{
+					auto uiIndex = ( static_cast< std::uint64_t >( uiRow ) * uiCols + uiCol );
+
+					if ( pBuf[ uiIndex ] != goldenValue( uiIndex ) )
+					{
+						throwArcGen3Error( "%s %s [ %u x %u ] mismatch at pixel [ %u, %u ]! Expected: %u Found: %u",
+										   sWhat.c_str(), algName( eAlg ), uiCols, uiRows, uiCol, uiRow,
+										   static_cast< std::uint32_t >( goldenValue( uiIndex ) ), static_cast< std::uint32_t >( pBuf[ uiIndex ] ) );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | compareRaw                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Compares a re-interlaced buffer against the golden raw data stream.                                      |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf		- The re-interlaced buffer.                                                           |
+		// |  <IN>  -> pRaw		- The golden raw data stream.                                                         |
+		// |  <IN>  -> uiCols	- The number of image columns.                                                        |
+		// |  <IN>  -> uiRows	- The number of image rows.                                                           |
+		// |  <IN>  -> sWhat	- Description of the tested method.                                                   |
+		// |  <IN>  -> eAlg		- The algorithm.                                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlaceBench<T>::compareRaw( const T* pBuf, const T* pRaw, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::string& sWhat, arc::gen3::dlace::e_Alg eAlg )
+		{
+			const std::uint64_t uiPixels = ( static_cast< std::uint64_t >( uiCols ) * static_cast< std::uint64_t >( uiRows ) );
+
+			for ( std::uint64_t i = 0; i < uiPixels; i++ )
+			{
+				if ( pBuf[ i ] != pRaw[ i ] )
+				{
+					throwArcGen3Error( "%s %s [ %u x %u ] mismatch at raw stream index %J! Expected: %u Found: %u",
+									   sWhat.c_str(), algName( eAlg ), uiCols, uiRows, static_cast< unsigned long long >( i ),
+									   static_cast< std::uint32_t >( pRaw[ i ] ), static_cast< std::uint32_t >( pBuf[ i ] ) );
+				}
+			}
+		}
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcDeinterlaceBench<arc::gen3::dlace::BPP_16>;
+template class arc::gen3::CArcDeinterlaceBench<arc::gen3::dlace::BPP_32>;
@@ -0,0 +1,828 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDeinterlacePlan.cpp  ( Gen3 )                                                                        |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC precomputed deinterlace plan interface.                                   |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 27, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <type_traits>
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <CArcDeinterlacePlan.h>
+
+
+using namespace std::string_literals;
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  <IN>  -> eAlg		- Algorithm that corresponds to the deinterlacing method.                             |
+		// |  <IN>  -> uiCols	- Number of columns in the image to deinterlace.                                      |
+		// |  <IN>  -> uiRows	- Number of rows in the image to deinterlace.                                         |
+		// |  <IN>  -> uiArg	- Algorithm dependent argument. HAWAII_RG requires the readout channel count.         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::runtime_error                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcDeinterlacePlan<T>::CArcDeinterlacePlan( arc::gen3::dlace::e_Alg eAlg, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiArg )
+			: CArcBase(), m_eAlg( eAlg ), m_uiCols( uiCols ), m_uiRows( uiRows )
+		{
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image dimensions [ %u x %u ]! Cannot be zero!", uiCols, uiRows );
+			}
+
+			compile( *CArcAmpLayout::fromAlg( eAlg, uiCols, uiRows, uiArg ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  <IN>  -> tLayout - The amplifier layout that describes the detector readout.                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::runtime_error                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcDeinterlacePlan<T>::CArcDeinterlacePlan( const CArcAmpLayout& tLayout )
+			: CArcBase(), m_eAlg( arc::gen3::dlace::e_Alg::CUSTOM ), m_uiCols( tLayout.cols() ), m_uiRows( tLayout.rows() )
+		{
+			compile( tLayout );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | scratch                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the scratch buffer used for in place execution. The buffer is allocated on the first in place    |
+		// | call, so plans that are only used out of place never allocate it.                                        |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> T* CArcDeinterlacePlan<T>::scratch( void )
+		{
+			if ( m_pScratch == nullptr )
+			{
+				m_pScratch.reset( new T[ static_cast< std::uint64_t >( m_uiCols ) * static_cast< std::uint64_t >( m_uiRows ) ] );
+
+				if ( m_pScratch == nullptr )
+				{
+					throwArcGen3Error( "Error in allocating temporary image buffer for deinterlacing."s );
+				}
+			}
+
+			return m_pScratch.get();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Destructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> CArcDeinterlacePlan<T>::~CArcDeinterlacePlan( void )
+		{
+			m_pScratch.reset();
+
+			m_vSections.clear();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | execute                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces the buffer in place using the plans internal scratch buffer.                                |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf - Pointer to the image buffer to deinterlace.                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::execute( T* pBuf )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( m_vSections.empty() )
+			{
+				return;
+			}
+
+			T* pScratch = scratch();
+
+			execute( pBuf, pScratch );
+
+			copyMemory( pBuf, pScratch, ( static_cast< std::size_t >( m_uiCols ) * static_cast< std::size_t >( m_uiRows ) * sizeof( T ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | execute                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces the source buffer into the destination buffer. The buffers must not overlap.                |
+		// |                                                                                                          |
+		// |  <IN>  -> pSrc - Pointer to the interlaced image buffer.                                                 |
+		// |  <OUT> -> pDst - Pointer to the deinterlaced image buffer.                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::execute( const T* pSrc, T* pDst )
+		{
+			if ( pSrc == nullptr || pDst == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( pSrc == pDst )
+			{
+				throwArcGen3InvalidArgument( "Source and destination buffers must be different!"s );
+			}
+
+			if ( m_vSections.empty() )
+			{
+				copyMemory( pDst, const_cast< T* >( pSrc ), ( static_cast< std::size_t >( m_uiCols ) * static_cast< std::size_t >( m_uiRows ) * sizeof( T ) ) );
+
+				return;
+			}
+
+			for ( const auto& tSection : m_vSections )
+			{
+				switch ( tSection.vChannels.size() )
+				{
+					case 2:  executeSection<2>( tSection, pSrc, pDst );  break;
+					case 4:  executeSection<4>( tSection, pSrc, pDst );  break;
+					case 8:  executeSection<8>( tSection, pSrc, pDst );  break;
+					case 16: executeSection<16>( tSection, pSrc, pDst ); break;
+					case 32: executeSection<32>( tSection, pSrc, pDst ); break;
+					default: executeSectionN( tSection, pSrc, pDst );    break;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlace                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Re-interlaces the image in place using the plans internal scratch buffer.                                |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf - Pointer to the image buffer to re-interlace.                                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::interlace( T* pBuf )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( m_vSections.empty() )
+			{
+				return;
+			}
+
+			T* pScratch = scratch();
+
+			interlace( pBuf, pScratch );
+
+			copyMemory( pBuf, pScratch, ( static_cast< std::size_t >( m_uiCols ) * static_cast< std::size_t >( m_uiRows ) * sizeof( T ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlace                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Re-interlaces the source image into the destination buffer, producing the raw data stream the            |
+		// | controller would deliver. The buffers must not overlap.                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> pSrc - Pointer to the deinterlaced image buffer.                                               |
+		// |  <OUT> -> pDst - Pointer to the raw data stream buffer.                                                  |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::interlace( const T* pSrc, T* pDst )
+		{
+			if ( pSrc == nullptr || pDst == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( pSrc == pDst )
+			{
+				throwArcGen3InvalidArgument( "Source and destination buffers must be different!"s );
+			}
+
+			if ( m_vSections.empty() )
+			{
+				copyMemory( pDst, const_cast< T* >( pSrc ), ( static_cast< std::size_t >( m_uiCols ) * static_cast< std::size_t >( m_uiRows ) * sizeof( T ) ) );
+
+				return;
+			}
+
+			for ( const auto& tSection : m_vSections )
+			{
+				switch ( tSection.vChannels.size() )
+				{
+					case 2:  interlaceSection<2>( tSection, pSrc, pDst );  break;
+					case 4:  interlaceSection<4>( tSection, pSrc, pDst );  break;
+					case 8:  interlaceSection<8>( tSection, pSrc, pDst );  break;
+					case 16: interlaceSection<16>( tSection, pSrc, pDst ); break;
+					case 32: interlaceSection<32>( tSection, pSrc, pDst ); break;
+					default: interlaceSectionN( tSection, pSrc, pDst );    break;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | cds                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces a CDS frame and subtracts its two halves ( first - second ) in a single pass. The result is |
+		// | saturated to the int32 range.                                                                            |
+		// |                                                                                                          |
+		// |  <IN>  -> pRaw - Pointer to the interlaced CDS buffer.                                                   |
+		// |  <OUT> -> pDst - Pointer to the difference buffer ( cols x rows / 2 pixels ).                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::cds( const T* pRaw, std::int32_t* pDst )
+		{
+			cdsDispatch( pRaw, pDst, 0 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | cds                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces a CDS frame and subtracts its two halves ( first - second ) in a single pass.               |
+		// |                                                                                                          |
+		// |  <IN>  -> pRaw - Pointer to the interlaced CDS buffer.                                                   |
+		// |  <OUT> -> pDst - Pointer to the difference buffer ( cols x rows / 2 pixels ).                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::cds( const T* pRaw, float* pDst )
+		{
+			cdsDispatch( pRaw, pDst, 0 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | cds                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces a CDS frame and subtracts its two halves ( first - second + offset ) in a single pass. The  |
+		// | result is saturated to the range of the data type. The destination may be the raw buffer, in which case  |
+		// | the difference is built in the plan scratch buffer and copied back.                                      |
+		// |                                                                                                          |
+		// |  <IN>  -> pRaw		- Pointer to the interlaced CDS buffer.                                               |
+		// |  <OUT> -> pDst		- Pointer to the difference buffer ( cols x rows / 2 pixels ).                        |
+		// |  <IN>  -> iOffset	- The offset added to every difference.                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::cds( const T* pRaw, T* pDst, const std::int64_t iOffset )
+		{
+			if ( pRaw == pDst )
+			{
+				if ( !isCDS() )
+				{
+					throwArcGen3InvalidArgument( "Plan does not describe a CDS readout! Expected two identical frames, one above the other."s );
+				}
+
+				T* pScratch = scratch();
+
+				cdsDispatch( pRaw, pScratch, iOffset );
+
+				copyMemory( pDst, pScratch, ( static_cast< std::size_t >( m_uiCols ) * static_cast< std::size_t >( m_uiRows / 2 ) * sizeof( T ) ) );
+
+				return;
+			}
+
+			cdsDispatch( pRaw, pDst, iOffset );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | isCDS                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns whether the plan has two frames with identical readouts, the second one image half below the     |
+		// | first.                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> bool CArcDeinterlacePlan<T>::isCDS( void ) const noexcept
+		{
+			if ( m_vSections.size() != 2 || ( m_uiRows % 2 ) != 0 )
+			{
+				return false;
+			}
+
+			const auto& tFirst  = m_vSections[ 0 ];
+			const auto& tSecond = m_vSections[ 1 ];
+
+			const std::int64_t iHalf = ( static_cast< std::int64_t >( m_uiCols ) * static_cast< std::int64_t >( m_uiRows / 2 ) );
+
+			if ( tFirst.uiFastLen != tSecond.uiFastLen || tFirst.uiSlowLen != tSecond.uiSlowLen ||
+				 tFirst.vChannels.size() != tSecond.vChannels.size() || tSecond.uiSrcOffset != static_cast< std::uint64_t >( iHalf ) )
+			{
+				return false;
+			}
+
+			for ( std::size_t k = 0; k < tFirst.vChannels.size(); k++ )
+			{
+				const auto& tA = tFirst.vChannels[ k ];
+				const auto& tB = tSecond.vChannels[ k ];
+
+				if ( tA.iFastStep != tB.iFastStep || tA.iSlowStep != tB.iSlowStep || ( tB.iDstStart - tA.iDstStart ) != iHalf || tA.iDstStart >= iHalf )
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | cdsDispatch                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Validates the arguments and runs the CDS kernel for the plan channel count.                              |
+		// |                                                                                                          |
+		// |  <IN>  -> pRaw		- Pointer to the interlaced CDS buffer.                                               |
+		// |  <OUT> -> pDst		- Pointer to the difference buffer.                                                   |
+		// |  <IN>  -> iOffset	- The offset added to every difference.                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <typename D>
+		void CArcDeinterlacePlan<T>::cdsDispatch( const T* pRaw, D* pDst, const std::int64_t iOffset )
+		{
+			if ( pRaw == nullptr || pDst == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( !isCDS() )
+			{
+				throwArcGen3InvalidArgument( "Plan does not describe a CDS readout! Expected two identical frames, one above the other."s );
+			}
+
+			const auto& tFirst  = m_vSections[ 0 ];
+			const auto& tSecond = m_vSections[ 1 ];
+
+			switch ( tFirst.vChannels.size() )
+			{
+				case 1:  cdsSection<D, 1>( tFirst, tSecond, pRaw, pDst, iOffset );   break;
+				case 2:  cdsSection<D, 2>( tFirst, tSecond, pRaw, pDst, iOffset );   break;
+				case 4:  cdsSection<D, 4>( tFirst, tSecond, pRaw, pDst, iOffset );   break;
+				case 8:  cdsSection<D, 8>( tFirst, tSecond, pRaw, pDst, iOffset );   break;
+				case 16: cdsSection<D, 16>( tFirst, tSecond, pRaw, pDst, iOffset );  break;
+				case 32: cdsSection<D, 32>( tFirst, tSecond, pRaw, pDst, iOffset );  break;
+				default:
+				{
+					throwArcGen3InvalidArgument( "CDS plans support 1, 2, 4, 8, 16 or 32 channels, found: %u",
+												 static_cast< std::uint32_t >( tFirst.vChannels.size() ) );
+				}
+				break;
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  algorithm                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the algorithm the plan was created for.                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> arc::gen3::dlace::e_Alg CArcDeinterlacePlan<T>::algorithm( void ) const noexcept
+		{
+			return m_eAlg;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  cols                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of image columns the plan was created for.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcDeinterlacePlan<T>::cols( void ) const noexcept
+		{
+			return m_uiCols;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rows                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of image rows the plan was created for.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcDeinterlacePlan<T>::rows( void ) const noexcept
+		{
+			return m_uiRows;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  channels                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of readout channels interleaved in the raw data stream.                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcDeinterlacePlan<T>::channels( void ) const noexcept
+		{
+			return ( m_vSections.empty() ? 0 : static_cast< std::uint32_t >( m_vSections.front().vChannels.size() ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | compile                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Builds the copy schedule from an amplifier layout. Each layout frame becomes one section of the raw      |
+		// | data stream, with the frame amplifiers as its channels in interleave order.                              |
+		// |                                                                                                          |
+		// |  <IN>  -> tLayout - The amplifier layout. Must match the plan geometry.                                  |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcDeinterlacePlan<T>::compile( const CArcAmpLayout& tLayout )
+		{
+			tLayout.validate();
+
+			std::uint64_t uiSrcOffset = 0;
+
+			for ( std::uint32_t uiFrame = 0; uiSrcOffset < ( static_cast< std::uint64_t >( m_uiCols ) * static_cast< std::uint64_t >( m_uiRows ) ); uiFrame++ )
+			{
+				std::vector<const arc::gen3::dlace::Amp_t*> vAmps;
+
+				for ( std::uint32_t i = 0; i < tLayout.ampCount(); i++ )
+				{
+					if ( tLayout.amp( i ).uiFrame == uiFrame )
+					{
+						vAmps.push_back( &tLayout.amp( i ) );
+					}
+				}
+
+				if ( vAmps.empty() )
+				{
+					break;
+				}
+
+				std::sort( vAmps.begin(), vAmps.end(), []( const auto pA, const auto pB ) { return ( pA->uiOrder < pB->uiOrder ); } );
+
+				auto& tSection = addSection( uiSrcOffset, vAmps.front()->uiWidth, vAmps.front()->uiHeight );
+
+				for ( const auto pAmp : vAmps )
+				{
+					addChannel( tSection, *pAmp );
+				}
+
+				uiSrcOffset += ( static_cast< std::uint64_t >( tSection.uiFastLen ) * static_cast< std::uint64_t >( tSection.uiSlowLen ) * vAmps.size() );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | addSection                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Appends a new, empty section to the schedule and returns a reference to it.                              |
+		// |                                                                                                          |
+		// |  <IN>  -> uiSrcOffset	- Raw stream index of the first pixel in the section.                             |
+		// |  <IN>  -> uiFastLen	- Number of pixels per channel line.                                              |
+		// |  <IN>  -> uiSlowLen	- Number of lines per channel.                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> typename CArcDeinterlacePlan<T>::Section_t&
+		CArcDeinterlacePlan<T>::addSection( const std::uint64_t uiSrcOffset, const std::uint32_t uiFastLen, const std::uint32_t uiSlowLen )
+		{
+			m_vSections.push_back( Section_t{ uiSrcOffset, uiFastLen, uiSlowLen, {} } );
+
+			return m_vSections.back();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | addChannel                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Appends the next channel ( in raw stream interleave order ) to the specified section.                    |
+		// |                                                                                                          |
+		// |  <IN>  -> tSection	- The section to add the channel to.                                                  |
+		// |  <IN>  -> tAmp		- The amplifier read by the channel.                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlacePlan<T>::addChannel( Section_t& tSection, const arc::gen3::dlace::Amp_t& tAmp )
+		{
+			auto toStep = [ this ]( arc::gen3::dlace::e_Dir eDir ) -> std::int64_t
+			{
+				switch ( eDir )
+				{
+					case arc::gen3::dlace::e_Dir::POS_X: return 1;
+					case arc::gen3::dlace::e_Dir::NEG_X: return -1;
+					case arc::gen3::dlace::e_Dir::POS_Y: return static_cast< std::int64_t >( m_uiCols );
+					default:							 return -static_cast< std::int64_t >( m_uiCols );
+				}
+			};
+
+			Channel_t tChannel;
+
+			tChannel.iDstStart = ( static_cast< std::int64_t >( tAmp.uiY ) * static_cast< std::int64_t >( m_uiCols ) + static_cast< std::int64_t >( tAmp.uiX ) );
+			tChannel.iFastStep = toStep( tAmp.eFast );
+			tChannel.iSlowStep = toStep( tAmp.eSlow );
+
+			tSection.vChannels.push_back( tChannel );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | executeSection                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Executes one section of the schedule. For each line, the block of raw data holding one line of every     |
+		// | channel is small enough to stay in cache, so each channel line is gathered from it with a fixed stride   |
+		// | and written out sequentially. The channel count is a compile time constant so that the gather can be     |
+		// | vectorized by the compiler.                                                                              |
+		// |                                                                                                          |
+		// |  <IN>  -> tSection	- The section to execute.                                                             |
+		// |  <IN>  -> pSrc		- Pointer to the interlaced image buffer.                                             |
+		// |  <OUT> -> pDst		- Pointer to the deinterlaced image buffer.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <std::uint32_t N>
+		void CArcDeinterlacePlan<T>::executeSection( const Section_t& tSection, const T* pSrc, T* pDst )
+		{
+			const auto uiFastLen = tSection.uiFastLen;
+
+			const T* pLine = pSrc + tSection.uiSrcOffset;
+
+			for ( std::uint32_t s = 0; s < tSection.uiSlowLen; s++ )
+			{
+				for ( std::uint32_t k = 0; k < N; k++ )
+				{
+					const auto& tChannel = tSection.vChannels[ k ];
+
+					const T* __restrict pIn = pLine + k;
+
+					T* __restrict pOut = pDst + ( tChannel.iDstStart + static_cast< std::int64_t >( s ) * tChannel.iSlowStep );
+
+					if ( tChannel.iFastStep == 1 )
+					{
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ f ] = pIn[ static_cast< std::size_t >( f ) * N ];
+						}
+					}
+
+					else if ( tChannel.iFastStep == -1 )
+					{
+						pOut -= ( uiFastLen - 1 );
+
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ uiFastLen - 1 - f ] = pIn[ static_cast< std::size_t >( f ) * N ];
+						}
+					}
+
+					else
+					{
+						//
+						// Column wise read ( fast direction along Y )
+						//
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ static_cast< std::int64_t >( f ) * tChannel.iFastStep ] = pIn[ static_cast< std::size_t >( f ) * N ];
+						}
+					}
+				}
+
+				pLine += ( static_cast< std::size_t >( uiFastLen ) * N );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | executeSectionN                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Executes one section of the schedule for channel counts that have no compile time specialization.        |
+		// |                                                                                                          |
+		// |  <IN>  -> tSection	- The section to execute.                                                             |
+		// |  <IN>  -> pSrc		- Pointer to the interlaced image buffer.                                             |
+		// |  <OUT> -> pDst		- Pointer to the deinterlaced image buffer.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlacePlan<T>::executeSectionN( const Section_t& tSection, const T* pSrc, T* pDst )
+		{
+			const auto uiChannels = tSection.vChannels.size();
+
+			for ( std::size_t k = 0; k < uiChannels; k++ )
+			{
+				const auto& tChannel = tSection.vChannels[ k ];
+
+				const T* pIn = pSrc + tSection.uiSrcOffset + k;
+
+				for ( std::uint32_t s = 0; s < tSection.uiSlowLen; s++ )
+				{
+					T* pOut = pDst + ( tChannel.iDstStart + static_cast< std::int64_t >( s ) * tChannel.iSlowStep );
+
+					for ( std::uint32_t f = 0; f < tSection.uiFastLen; f++ )
+					{
+						*pOut = *pIn;
+
+						pOut += tChannel.iFastStep;
+						pIn += uiChannels;
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlaceSection                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Re-interlaces one section of the schedule. This is executeSection() with the copy direction reversed;    |
+		// | each channel line is read sequentially from the image and scattered into the raw block with a fixed      |
+		// | stride.                                                                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> tSection	- The section to re-interlace.                                                        |
+		// |  <IN>  -> pSrc		- Pointer to the deinterlaced image buffer.                                           |
+		// |  <OUT> -> pDst		- Pointer to the raw data stream buffer.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <std::uint32_t N>
+		void CArcDeinterlacePlan<T>::interlaceSection( const Section_t& tSection, const T* pSrc, T* pDst )
+		{
+			const auto uiFastLen = tSection.uiFastLen;
+
+			T* pLine = pDst + tSection.uiSrcOffset;
+
+			for ( std::uint32_t s = 0; s < tSection.uiSlowLen; s++ )
+			{
+				for ( std::uint32_t k = 0; k < N; k++ )
+				{
+					const auto& tChannel = tSection.vChannels[ k ];
+
+					T* __restrict pOut = pLine + k;
+
+					const T* __restrict pIn = pSrc + ( tChannel.iDstStart + static_cast< std::int64_t >( s ) * tChannel.iSlowStep );
+
+					if ( tChannel.iFastStep == 1 )
+					{
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ static_cast< std::size_t >( f ) * N ] = pIn[ f ];
+						}
+					}
+
+					else if ( tChannel.iFastStep == -1 )
+					{
+						pIn -= ( uiFastLen - 1 );
+
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ static_cast< std::size_t >( f ) * N ] = pIn[ uiFastLen - 1 - f ];
+						}
+					}
+
+					else
+					{
+						//
+						// Column wise read ( fast direction along Y )
+						//
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ static_cast< std::size_t >( f ) * N ] = pIn[ static_cast< std::int64_t >( f ) * tChannel.iFastStep ];
+						}
+					}
+				}
+
+				pLine += ( static_cast< std::size_t >( uiFastLen ) * N );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | interlaceSectionN                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Re-interlaces one section of the schedule for channel counts that have no compile time specialization.   |
+		// |                                                                                                          |
+		// |  <IN>  -> tSection	- The section to re-interlace.                                                        |
+		// |  <IN>  -> pSrc		- Pointer to the deinterlaced image buffer.                                           |
+		// |  <OUT> -> pDst		- Pointer to the raw data stream buffer.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDeinterlacePlan<T>::interlaceSectionN( const Section_t& tSection, const T* pSrc, T* pDst )
+		{
+			const auto uiChannels = tSection.vChannels.size();
+
+			for ( std::size_t k = 0; k < uiChannels; k++ )
+			{
+				const auto& tChannel = tSection.vChannels[ k ];
+
+				T* pOut = pDst + tSection.uiSrcOffset + k;
+
+				for ( std::uint32_t s = 0; s < tSection.uiSlowLen; s++ )
+				{
+					const T* pIn = pSrc + ( tChannel.iDstStart + static_cast< std::int64_t >( s ) * tChannel.iSlowStep );
+
+					for ( std::uint32_t f = 0; f < tSection.uiFastLen; f++ )
+					{
+						*pOut = *pIn;
+
+						pIn += tChannel.iFastStep;
+						pOut += uiChannels;
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | cdsSection                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Deinterlaces and subtracts the two frames of a CDS readout. Each channel line of the first frame is      |
+		// | gathered together with the matching line of the second frame, and the difference is written straight     |
+		// | to its place in the result. The difference is computed in 64 bits and saturated to the result type,      |
+		// | except for float results, which cannot overflow.                                                         |
+		// |                                                                                                          |
+		// |  <IN>  -> tFirst	- The first frame section.                                                            |
+		// |  <IN>  -> tSecond	- The second frame section.                                                           |
+		// |  <IN>  -> pRaw		- Pointer to the interlaced CDS buffer.                                               |
+		// |  <OUT> -> pDst		- Pointer to the difference buffer.                                                   |
+		// |  <IN>  -> iOffset	- The offset added to every difference.                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> template <typename D, std::uint32_t N>
+		void CArcDeinterlacePlan<T>::cdsSection( const Section_t& tFirst, const Section_t& tSecond, const T* pRaw, D* pDst, const std::int64_t iOffset )
+		{
+			const auto uiFastLen = tFirst.uiFastLen;
+
+			const T* pLine1 = pRaw + tFirst.uiSrcOffset;
+			const T* pLine2 = pRaw + tSecond.uiSrcOffset;
+
+			auto convert = [ iOffset ]( std::int64_t iA, std::int64_t iB ) -> D
+			{
+				if constexpr ( std::is_floating_point_v<D> )
+				{
+					return static_cast< D >( iA - iB + iOffset );
+				}
+
+				else
+				{
+					return static_cast< D >( std::clamp<std::int64_t>( ( iA - iB + iOffset ),
+																	   static_cast< std::int64_t >( std::numeric_limits<D>::min() ),
+																	   static_cast< std::int64_t >( std::numeric_limits<D>::max() ) ) );
+				}
+			};
+
+			for ( std::uint32_t s = 0; s < tFirst.uiSlowLen; s++ )
+			{
+				for ( std::uint32_t k = 0; k < N; k++ )
+				{
+					const auto& tChannel = tFirst.vChannels[ k ];
+
+					const T* __restrict pIn1 = pLine1 + k;
+					const T* __restrict pIn2 = pLine2 + k;
+
+					D* __restrict pOut = pDst + ( tChannel.iDstStart + static_cast< std::int64_t >( s ) * tChannel.iSlowStep );
+
+					if ( tChannel.iFastStep == 1 )
+					{
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ f ] = convert( pIn1[ static_cast< std::size_t >( f ) * N ], pIn2[ static_cast< std::size_t >( f ) * N ] );
+						}
+					}
+
+					else if ( tChannel.iFastStep == -1 )
+					{
+						pOut -= ( uiFastLen - 1 );
+
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ uiFastLen - 1 - f ] = convert( pIn1[ static_cast< std::size_t >( f ) * N ], pIn2[ static_cast< std::size_t >( f ) * N ] );
+						}
+					}
+
+					else
+					{
+						for ( std::uint32_t f = 0; f < uiFastLen; f++ )
+						{
+							pOut[ static_cast< std::int64_t >( f ) * tChannel.iFastStep ] = convert( pIn1[ static_cast< std::size_t >( f ) * N ], pIn2[ static_cast< std::size_t >( f ) * N ] );
+						}
+					}
+				}
+
+				pLine1 += ( static_cast< std::size_t >( uiFastLen ) * N );
+				pLine2 += ( static_cast< std::size_t >( uiFastLen ) * N );
+			}
+		}
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcDeinterlacePlan<arc::gen3::dlace::BPP_16>;
+template class arc::gen3::CArcDeinterlacePlan<arc::gen3::dlace::BPP_32>;
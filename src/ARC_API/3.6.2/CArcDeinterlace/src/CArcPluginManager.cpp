@@ -15,9 +15,14 @@
 
 #endif
 
+#include <algorithm>
+
 #include <CArcPluginManager.h>
 
 
+using namespace std::string_literals;
+
+
 
 namespace arc
 {
@@ -62,8 +67,12 @@ namespace arc
 
 					ArcFreeLibrary( pPlugin->hlib );
 				}
+
+				delete pPlugin;
 			}
 
+			m_algIndex.clear();
+
 			m_pluginMap.clear();
 		}
 
@@ -119,7 +128,15 @@ namespace arc
 			#elif defined( __APPLE__ )
 				// Place holder
 			#else
-				getDirList( sLibPath + "/*.so", vDirs );
+				getDirList( sLibPath, vDirs );
+
+				//  opendir() does not accept wildcards, keep only the shared libraries
+				// +--------------------------------------------------------------------+
+				vDirs.erase( std::remove_if( vDirs.begin(), vDirs.end(), []( const std::string& sFile )
+				{
+					return ( sFile.size() < 3 || sFile.compare( ( sFile.size() - 3 ), 3, ".so" ) != 0 );
+
+				} ), vDirs.end() );
 			#endif
 
 			if ( vDirs.size() > 0 )
@@ -147,6 +164,82 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// | pluginVersion                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the interface version of a loaded plugin.                                                        |
+		// |                                                                                                          |
+		// | <IN> -> uiIndex - The plugin index.                                                                      |
+		// |                                                                                                          |
+		// | Throws std::out_of_range                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t CArcPluginManager::pluginVersion( std::uint32_t uiIndex )
+		{
+			if ( uiIndex >= m_pluginMap.size() )
+			{
+				throwArcGen3OutOfRange( uiIndex, std::make_pair( static_cast< std::uint32_t >( 0 ), pluginCount() ) );
+			}
+
+			return m_pluginMap[ uiIndex ]->uiVersion;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | resolve                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Looks up an algorithm in the index of all loaded plugin algorithms. Returns nullptr if no loaded plugin  |
+		// | provides the algorithm.                                                                                  |
+		// |                                                                                                          |
+		// | <IN> -> sAlg - The algorithm name.                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		const arc::gen3::PluginAlg_t* CArcPluginManager::resolve( const std::string& sAlg ) const
+		{
+			auto it = m_algIndex.find( sAlg );
+
+			return ( it != m_algIndex.end() ? &it->second : nullptr );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | indexPlugin                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Adds the algorithms of a plugin to the algorithm index. Version 2 algorithms are resolved to their       |
+		// | handle and capabilities here, once. Names already provided by an earlier plugin are not replaced.        |
+		// |                                                                                                          |
+		// | <IN> -> pPlugin - The plugin.                                                                            |
+		// |                                                                                                          |
+		// | Throws a std::runtime_error                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		void CArcPluginManager::indexPlugin( const Plugin_t* pPlugin )
+		{
+			//
+			// A library may report version 2 without its object deriving from
+			// IArcPlugin2. Such plugins are used through the version 1 run().
+			// -------------------------------------------------------------------
+			IArcPlugin2* pObj2 = ( pPlugin->uiVersion >= plugin::VERSION_2 ? dynamic_cast< IArcPlugin2* >( pPlugin->pObj ) : nullptr );
+
+			auto pList = pPlugin->pObj->getNameList();
+
+			for ( std::uint32_t i = 0; i < pList->length(); i++ )
+			{
+				const std::string& sAlg = pList->at( i );
+
+				if ( m_algIndex.find( sAlg ) == m_algIndex.end() )
+				{
+					PluginAlg_t tAlg{ pPlugin->pObj, pObj2, sAlg, 0, plugin::CAP_IN_PLACE };
+
+					if ( pObj2 != nullptr )
+					{
+						tAlg.uiAlg  = pObj2->resolve( sAlg );
+						tAlg.uiCaps = pObj2->capabilities( tAlg.uiAlg );
+					}
+
+					m_algIndex.emplace( sAlg, tAlg );
+				}
+			}
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// | getDirList                                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -261,6 +354,8 @@ namespace arc
 			if ( tPlugin == nullptr )
 			{
 				ArcFreeLibrary( hPluginLib );
+
+				return;
 			}
 
 			bool bExists = false;
@@ -278,6 +373,17 @@ namespace arc
 			if ( !bExists )
 			{
 				m_pluginMap.push_back( tPlugin );
+
+				indexPlugin( tPlugin );
+			}
+
+			else
+			{
+				( *tPlugin->dtor ) ( tPlugin->pObj );
+
+				ArcFreeLibrary( hPluginLib );
+
+				delete tPlugin;
 			}
 		}
 
@@ -300,6 +406,7 @@ namespace arc
 			{
 				PluginCreate  pCtor = ( PluginCreate )ArcFindLibrarySymbol( hPluginLib, "createPlugin" );
 				PluginRelease pDtor = ( PluginRelease )ArcFindLibrarySymbol( hPluginLib, "releasePlugin" );
+				PluginVersion pVers = ( PluginVersion )ArcFindLibrarySymbol( hPluginLib, "pluginVersion" );
 
 				if ( pCtor != nullptr && pDtor != nullptr )
 				{
@@ -311,6 +418,7 @@ namespace arc
 						pPlugin->ctor = pCtor;
 						pPlugin->dtor = pDtor;
 						pPlugin->pObj = ( *pCtor ) ( );
+						pPlugin->uiVersion = ( pVers != nullptr ? ( *pVers ) ( ) : plugin::VERSION_1 );
 					}
 				}
 			}
@@ -8,9 +8,15 @@
 // |  Copyright 2013 Astronomical Research Cameras, Inc. All rights reserved.                                         |
 // +------------------------------------------------------------------------------------------------------------------+
 
+#include <cstring>
+#include <memory>
+
 #include <IArcPlugin.h>
 
 
+using namespace std::string_literals;
+
+
 namespace arc
 {
 	namespace gen3
@@ -58,6 +64,99 @@ namespace arc
 			return m_pList->length();
 		}
 
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | IArcPlugin2 Constructor                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		IArcPlugin2::IArcPlugin2( void ) : IArcPlugin()
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | IArcPlugin2 Destructor                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		IArcPlugin2::~IArcPlugin2( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | resolve                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Returns the handle of an algorithm, which by default is its index within the name list.                  |
+		// |                                                                                                          |
+		// | <IN> -> sAlg - The deinterlace algorithm name.                                                           |
+		// |                                                                                                          |
+		// | Throws std::invalid_argument                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		std::uint32_t IArcPlugin2::resolve( const std::string& sAlg )
+		{
+			for ( std::uint32_t i = 0; i < m_pList->length(); i++ )
+			{
+				if ( m_pList->at( i ) == sAlg )
+				{
+					return i;
+				}
+			}
+
+			throwArcGen3InvalidArgument( "Algorithm [ \'%s\' ] not supported by plugin!", sAlg.c_str() );
+
+			return 0;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | executeOutOfPlace                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Default out of place execute. Algorithms that report plugin::CAP_OUT_OF_PLACE must override this method. |
+		// |                                                                                                          |
+		// | Throws std::runtime_error                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		void IArcPlugin2::executeOutOfPlace( const std::uint32_t uiAlg, const void*, void*, const std::uint32_t, const std::uint32_t, const std::uint32_t,
+											 const std::uint32_t, arc::gen3::IArcPluginExecutor* )
+		{
+			throwArcGen3Error( "Algorithm [ %u ] does not support out of place deinterlacing!", uiAlg );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | run                                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Version 1 entry point. Resolves the algorithm and executes it on the calling thread; in place if the     |
+		// | algorithm supports it, otherwise out of place from a copy of the buffer.                                 |
+		// |                                                                                                          |
+		// | Throws std::runtime_error                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		void IArcPlugin2::run( void* pBuf, std::uint32_t uiCols, std::uint32_t uiRows, const std::uint32_t uiBpp, const std::string& sAlg, std::uint32_t uiArg )
+		{
+			const std::uint32_t uiAlg = resolve( sAlg );
+
+			const std::uint32_t uiCaps = capabilities( uiAlg );
+
+			if ( ( uiCaps & plugin::CAP_IN_PLACE ) != 0 )
+			{
+				execute( uiAlg, pBuf, uiCols, uiRows, uiBpp, uiArg, nullptr );
+			}
+
+			else if ( ( uiCaps & plugin::CAP_OUT_OF_PLACE ) != 0 )
+			{
+				const std::size_t uiBytes = ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * ( ( uiBpp + 7 ) / 8 ) );
+
+				std::unique_ptr<std::uint8_t[]> pCopy( new std::uint8_t[ uiBytes ] );
+
+				std::memcpy( pCopy.get(), pBuf, uiBytes );
+
+				executeOutOfPlace( uiAlg, pCopy.get(), pBuf, uiCols, uiRows, uiBpp, uiArg, nullptr );
+			}
+
+			else
+			{
+				throwArcGen3Error( "Algorithm [ \'%s\' ] reports neither in place nor out of place support!", sAlg.c_str() );
+			}
+		}
+
 	}	// end gen3 namespace
 }		// end arc namespace
 
@@ -216,6 +216,19 @@ extern "C" {		// Using a C++ compiler
 	GEN3_CARCIMAGE_API void ArcImage_getStats( struct CStats* pStats, const void* pBuf, unsigned int uiCol1, unsigned int uiCol2, unsigned int uiRow1,
 		unsigned int uiRow2, unsigned int uiCols, unsigned int uiRows, ArcStatus_t* pStatus );
 
+	/** Calculates the statistics of every channel ( amplifier ) region of an image in a single pass over the image.
+	 *  @param pStats		- Array of uiChannelCount CStats structures to fill, one per channel.
+	 *  @param pBuf			- Pointer to the image data buffer.
+	 *  @param uiCols		- The image column size ( in pixels ).
+	 *  @param uiRows		- The image row size ( in pixels ).
+	 *  @param pChannels	- The channel regions, four values per channel: start column, one past the end column,
+	 *						  start row, one past the end row.
+	 *  @param uiChannelCount - The number of channels.
+	 *  @param pStatus		- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.
+	 */
+	GEN3_CARCIMAGE_API void ArcImage_getChannelStats( struct CStats* pStats, const void* pBuf, unsigned int uiCols, unsigned int uiRows,
+		const unsigned int* pChannels, unsigned int uiChannelCount, ArcStatus_t* pStatus );
+
 	/** Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel count for
 	 *  each image as well as the difference mean, variance and standard deviation over the specified image buffer
 	 *  cols and rows. This is used for photon transfer curves ( PTC ). The two images MUST be the same size or the
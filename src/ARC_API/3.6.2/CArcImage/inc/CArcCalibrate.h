@@ -0,0 +1,190 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCalibrate.h  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC image calibration stage.                                                     |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcCalibrate.h */
+
+#ifndef _GEN3_CARCCALIBRATE_H_
+#define _GEN3_CARCCALIBRATE_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @enum e_OverscanFit
+			 *  Overscan level fits. The level of each row is the median of the row's overscan pixels.
+			 */
+			enum class e_OverscanFit : std::uint32_t
+			{
+				NONE = 0,		/**< No overscan correction */
+				MEAN,			/**< The mean of the row levels is subtracted from every row */
+				ROW,			/**< Each row level is subtracted from its row; rows outside the region use the mean */
+				POLYNOMIAL		/**< A least squares polynomial in the row number is fitted to the row levels */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcCalibrate
+		 *  Image calibration stage. Applies overscan correction, master bias and dark subtraction and flat field
+		 *  division to a frame in a single pass over the image:
+		 *
+		 *		out = ( in - overscan( row ) - bias - darkScale x dark ) / flat
+		 *
+		 *  All corrections are optional. The masters are copied into the stage, e.g. from CArcStack::mean() or
+		 *  CArcCombine::combine(), and the flat is held as its reciprocal, so the per-pixel loop is a branch free
+		 *  multiply-add that the compiler vectorizes. Pixels with a flat value that is not positive are set to zero.
+		 *  The output has the same dimensions as the input and may be float or the image data type.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcCalibrate : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Largest overscan polynomial order */
+				static constexpr std::uint32_t ORDER_MAX = 8;
+
+				/** Constructor
+				 *  Creates a stage with no corrections.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcCalibrate( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcCalibrate( void );
+
+				/** Sets the overscan region and fit. The region is usually the serial overscan columns over all rows.
+				 *  @param tRegion	- The overscan region.
+				 *  @param eFit		- The overscan level fit.
+				 *  @param uiOrder	- The polynomial order, for e_OverscanFit::POLYNOMIAL ( default = 1 ).
+				 *  @throws std::invalid_argument
+				 */
+				void setOverscan( const arc::gen3::image::Roi_t& tRegion, const arc::gen3::image::e_OverscanFit eFit, const std::uint32_t uiOrder = 1 );
+
+				/** Sets the master bias frame.
+				 *  @param pBias - Pointer to cols x rows values, or nullptr to remove the bias.
+				 */
+				void setBias( const float* pBias );
+
+				/** Sets the master dark frame.
+				 *  @param pDark	- Pointer to cols x rows values, or nullptr to remove the dark.
+				 *  @param gScale	- The dark scale, e.g. the ratio of the frame and dark exposure times ( default = 1 ).
+				 */
+				void setDark( const float* pDark, const double gScale = 1.0 );
+
+				/** Sets the dark scale, e.g. when the exposure time changes between frames.
+				 *  @param gScale - The dark scale.
+				 */
+				void setDarkScale( const double gScale ) noexcept;
+
+				/** Sets the master flat frame.
+				 *  @param pFlat		- Pointer to cols x rows values, or nullptr to remove the flat.
+				 *  @param bNormalize	- true to divide the flat by the mean of its positive values ( default = true ).
+				 *  @throws std::invalid_argument if the flat has no positive values.
+				 */
+				void setFlat( const float* pFlat, const bool bNormalize = true );
+
+				/** Sets the number of threads the image is split over.
+				 *  @param uiThreads - The number of threads. Zero uses one per hardware thread.
+				 */
+				void setThreads( const std::uint32_t uiThreads ) noexcept;
+
+				/** Calibrates a frame.
+				 *  @param pSrcBuf - Pointer to the image buffer.
+				 *  @param pDstBuf - Pointer to a buffer of cols x rows values.
+				 *  @throws std::runtime_error
+				 */
+				void calibrate( const T* pSrcBuf, float* pDstBuf );
+
+				/** Calibrates a frame. The values are rounded to the nearest integer and clamped to the data type
+				 *  range. The destination may be the source buffer.
+				 *  @param pSrcBuf - Pointer to the image buffer.
+				 *  @param pDstBuf - Pointer to a buffer of cols x rows pixels.
+				 *  @throws std::runtime_error
+				 */
+				void calibrate( const T* pSrcBuf, T* pDstBuf );
+
+				/** Returns the overscan level subtracted from each row by the last calibrate() call.
+				 *  @return The overscan levels; empty if no overscan correction was applied.
+				 */
+				const std::vector<double>& overscanLevels( void ) const noexcept;
+
+			private:
+
+				/** Fills m_vLevels with the overscan level of every row.
+				 *  @param pSrcBuf - Pointer to the image buffer.
+				 */
+				void fitOverscan( const T* pSrcBuf );
+
+				/** Applies the corrections to every row.
+				 *  @param pSrcBuf - Pointer to the image buffer.
+				 *  @param pDstBuf - Pointer to the output buffer.
+				 */
+				template <typename U>
+				void apply( const T* pSrcBuf, U* pDstBuf );
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** Number of threads */
+				std::uint32_t m_uiThreads;
+
+				/** Overscan region */
+				arc::gen3::image::Roi_t m_tOverscan;
+
+				/** Overscan level fit */
+				arc::gen3::image::e_OverscanFit m_eFit;
+
+				/** Overscan polynomial order */
+				std::uint32_t m_uiOrder;
+
+				/** Dark scale */
+				double m_gDarkScale;
+
+				/** Master bias */
+				std::vector<float> m_vBias;
+
+				/** Master dark */
+				std::vector<float> m_vDark;
+
+				/** Master flat reciprocal */
+				std::vector<float> m_vFlatInv;
+
+				/** Per-row overscan levels */
+				std::vector<double> m_vLevels;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCCALIBRATE_H_
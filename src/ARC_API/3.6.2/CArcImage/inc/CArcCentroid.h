@@ -0,0 +1,183 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCentroid.h  ( Gen3 )                                                                                 |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC star centroid, FWHM and guide star tracking engine.                          |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcCentroid.h */
+
+#ifndef _GEN3_CARCCENTROID_H_
+#define _GEN3_CARCCENTROID_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @struct Source_t
+			 *  A measured source. Positions are in view pixels; the center of pixel ( c, r ) is at ( c, r ).
+			 */
+			struct Source_t
+			{
+				double gX;				/**< Centroid column */
+				double gY;				/**< Centroid row */
+				double gFlux;			/**< Background subtracted flux within the aperture */
+				double gPeak;			/**< Background subtracted peak value */
+				double gBackground;		/**< Local background level */
+				double gNoise;			/**< Local background noise ( standard deviation ) */
+				double gFwhm;			/**< FWHM from the second moments ( in pixels ) */
+				double gEllipticity;	/**< 1 - minor / major axis, from the second moments */
+				bool   bValid;			/**< true if the source was measured above the detection threshold */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcCentroid
+		 *  Source finding, measurement and guide star tracking for guiding and focus loops on small subarrays.
+		 *  Sources are measured in a square box: the background and noise are the median and scaled MAD of the box
+		 *  edge pixels, and the centroid, flux and second moments are taken over the background subtracted positive
+		 *  pixels within a circular aperture, recentered once on the first centroid. All buffers are sized when the
+		 *  engine is configured, so find(), measure() and track() do not allocate.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcCentroid : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Largest box half width */
+				static constexpr std::uint32_t HALF_WIDTH_MAX = 32;
+
+				/** Constructor
+				 *  Creates an engine with a 15 x 15 pixel box and a 5 sigma detection threshold.
+				 *  @param uiMaxSources - The largest number of sources returned by find() ( default = 16 ).
+				 *  @throws std::invalid_argument if uiMaxSources is zero.
+				 */
+				CArcCentroid( const std::uint32_t uiMaxSources = 16 );
+
+				/** Destructor
+				 */
+				virtual ~CArcCentroid( void );
+
+				/** Sets the measurement box size. The aperture is the circle inscribed in the box.
+				 *  @param uiHalfWidth - The box half width; the box is 2 x uiHalfWidth + 1 pixels square ( default = 7 ).
+				 *  @throws std::out_of_range unless 2 <= uiHalfWidth <= HALF_WIDTH_MAX.
+				 */
+				void setBox( const std::uint32_t uiHalfWidth );
+
+				/** Sets the detection threshold.
+				 *  @param gSigma - The threshold, in standard deviations of the background noise ( default = 5 ).
+				 *  @throws std::invalid_argument if the threshold is not positive.
+				 */
+				void setThreshold( const double gSigma );
+
+				/** Finds and measures the brightest sources in a view. Candidates are local maxima above the frame
+				 *  background by the threshold; candidates that centroid onto an already measured source are dropped.
+				 *  @param tSrc - The source view.
+				 *  @return The valid sources, brightest flux first.
+				 *  @throws std::invalid_argument
+				 */
+				const std::vector<arc::gen3::image::Source_t>& find( const arc::gen3::image::ImageView<const T>& tSrc );
+
+				/** Measures a source at a position.
+				 *  @param tSrc	- The source view.
+				 *  @param gX	- The approximate column.
+				 *  @param gY	- The approximate row.
+				 *  @return The source; bValid is false if the peak is not above the local background by the threshold.
+				 *  @throws std::invalid_argument
+				 */
+				arc::gen3::image::Source_t measure( const arc::gen3::image::ImageView<const T>& tSrc, const double gX, const double gY );
+
+				/** Sets the guide stars and their reference positions, e.g. from find() on the first frame.
+				 *  @param vPositions - The ( column, row ) reference positions.
+				 */
+				void setGuideStars( const std::vector<std::pair<double, double>>& vPositions );
+
+				/** Measures every guide star at its last position. A star that is lost keeps its last position and is
+				 *  searched for there in the next frame.
+				 *  @param tSrc - The source view.
+				 *  @return The guide stars, in the order they were set.
+				 *  @throws std::invalid_argument
+				 */
+				const std::vector<arc::gen3::image::Source_t>& track( const arc::gen3::image::ImageView<const T>& tSrc );
+
+				/** Returns the mean guide star offset from the reference positions after the last track() call.
+				 *  @param gDx - The column offset.
+				 *  @param gDy - The row offset.
+				 *  @return false if no guide star was valid; the offsets are then zero.
+				 */
+				bool offset( double& gDx, double& gDy ) const noexcept;
+
+			private:
+
+				/** A detection candidate */
+				struct Peak_t
+				{
+					double gValue;
+					std::uint32_t uiCol;
+					std::uint32_t uiRow;
+				};
+
+				/** Verifies a source view.
+				 *  @param tSrc - The source view.
+				 *  @throws std::invalid_argument
+				 */
+				void verifyView( const arc::gen3::image::ImageView<const T>& tSrc ) const;
+
+				/** Returns the median and noise of the values in m_vScratch[ 0, uiCount ).
+				 *  @param uiCount - The number of values.
+				 *  @return The median and 1.4826 x MAD, floored at one.
+				 */
+				std::pair<double, double> robustLevel( const std::size_t uiCount );
+
+				/** Maximum number of sources returned by find() */
+				std::uint32_t m_uiMaxSources;
+
+				/** Box half width */
+				std::uint32_t m_uiHalfWidth;
+
+				/** Detection threshold ( standard deviations ) */
+				double m_gThreshold;
+
+				/** Candidate heap */
+				std::vector<Peak_t> m_vPeaks;
+
+				/** Sources found */
+				std::vector<arc::gen3::image::Source_t> m_vSources;
+
+				/** Guide star reference positions */
+				std::vector<std::pair<double, double>> m_vReference;
+
+				/** Guide star measurements */
+				std::vector<arc::gen3::image::Source_t> m_vGuide;
+
+				/** Background sample and box edge scratch */
+				std::vector<double> m_vScratch;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCCENTROID_H_
@@ -0,0 +1,216 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCombine.h  ( Gen3 )                                                                                  |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC tiled median and sigma clipped frame combiner.                               |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcCombine.h */
+
+#ifndef _GEN3_CARCCOMBINE_H_
+#define _GEN3_CARCCOMBINE_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @enum e_CombineMethod
+			 *  Per-pixel frame combine methods.
+			 */
+			enum class e_CombineMethod : std::uint32_t
+			{
+				MEDIAN = 0,		/**< The median of the pixel values; the mean of the two middle values for an even frame count */
+				SIGMA_CLIP		/**< The mean of the pixel values that remain after iterative clipping about the median */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcCombine
+		 *  Median and sigma clipped frame combiner for master calibration frames. Frames are read in tiles of whole
+		 *  rows, either directly from memory or through a reader function, e.g. one that wraps
+		 *  CArcFitsFile::readSubImage(), so only one or two tiles of every frame are held at a time and the tile
+		 *  size is chosen to keep the engine under a memory limit. While one tile is combined the next tile is
+		 *  read. For up to NETWORK_MAX frames each row is sorted per pixel with a sorting network applied across
+		 *  the whole row, so every compare-exchange is a vectorized min/max over the row; larger frame counts use
+		 *  a per-pixel selection.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcCombine : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Frame reader. Called as fnRead( uiFrame, uiRow1, uiRow2, pDst ) to read rows uiRow1 up to but not
+				 *  including uiRow2 of frame uiFrame into pDst, which holds ( uiRow2 - uiRow1 ) x cols pixels. Reads
+				 *  are made from one thread at a time, but not always the calling thread. CArcThreadPool runs them on
+				 *  the calling thread. An executor installed with CArcThreadPool::setExecutor() may run them on one of
+				 *  its worker threads. With CArcFitsFile the rows are readSubImage( { 0, uiRow1 },
+				 *  { cols - 1, uiRow2 - 1 } ).
+				 */
+				using Reader_t = std::function<void( std::uint32_t, std::uint32_t, std::uint32_t, T* )>;
+
+				/** Largest frame count combined with a sorting network */
+				static constexpr std::uint32_t NETWORK_MAX = 32;
+
+				/** Constructor
+				 *  Creates a median combiner with a 256 MB memory limit.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcCombine( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcCombine( void );
+
+				/** Sets the combine method.
+				 *  @param eMethod - The combine method.
+				 */
+				void setMethod( const arc::gen3::image::e_CombineMethod eMethod ) noexcept;
+
+				/** Sets the sigma clipping limits. Values further than gLow standard deviations below or gHigh standard
+				 *  deviations above the median are rejected, and the median and standard deviation of the remaining
+				 *  values are recomputed, until nothing is rejected or uiIterations is reached.
+				 *  @param gLow			- The lower limit, in standard deviations ( default = 3 ).
+				 *  @param gHigh		- The upper limit, in standard deviations ( default = 3 ).
+				 *  @param uiIterations	- The maximum number of iterations ( default = 5 ).
+				 *  @throws std::invalid_argument if a limit is not positive.
+				 */
+				void setSigmaClip( const double gLow = 3.0, const double gHigh = 3.0, const std::uint32_t uiIterations = 5 );
+
+				/** Sets the memory limit for the tile and scratch buffers.
+				 *  @param uiBytes - The memory limit ( in bytes ).
+				 */
+				void setMemoryLimit( const std::uint64_t uiBytes ) noexcept;
+
+				/** Sets the number of threads each tile is split over.
+				 *  @param uiThreads - The number of threads. Zero uses one per hardware thread.
+				 */
+				void setThreads( const std::uint32_t uiThreads ) noexcept;
+
+				/** Returns the number of rows per tile used to combine a frame count under the memory limit.
+				 *  @param uiFrames - The number of frames.
+				 *  @return The number of rows per tile.
+				 *  @throws std::invalid_argument if the limit does not hold one row of every frame.
+				 */
+				std::uint32_t tileRows( const std::uint32_t uiFrames ) const;
+
+				/** Combines frames held in memory. No tile buffers are needed.
+				 *  @param vFrames - The frames.
+				 *  @param pDstBuf - Pointer to a buffer of cols x rows values.
+				 *  @throws std::invalid_argument
+				 */
+				void combine( const std::vector<const T*>& vFrames, float* pDstBuf );
+
+				/** Combines frames read in row tiles. The read of the next tile overlaps the combine of the current
+				 *  tile as a second executor task. See Reader_t for the thread the reader runs on.
+				 *  @param uiFrames	- The number of frames.
+				 *  @param fnRead	- The frame reader.
+				 *  @param pDstBuf	- Pointer to a buffer of cols x rows values.
+				 *  @throws std::invalid_argument
+				 *  @throws Any exception thrown by the reader.
+				 */
+				void combine( const std::uint32_t uiFrames, const Reader_t& fnRead, float* pDstBuf );
+
+				/** Returns the tile and scratch memory held by the engine.
+				 *  @return The memory in bytes.
+				 */
+				std::uint64_t memoryBytes( void ) const noexcept;
+
+			private:
+
+				/** Sizes the sorting network and the per-thread scratch buffers for a frame count.
+				 *  @param uiFrames - The number of frames.
+				 */
+				void prepare( const std::uint32_t uiFrames );
+
+				/** Combines a block of rows. Row r of frame f starts at vFrames[ f ] + r x cols.
+				 *  @param uiBlock	- The thread block, which selects the scratch buffers.
+				 *  @param vFrames	- Pointer to the first row in every frame.
+				 *  @param uiFirst	- The first row of the block.
+				 *  @param uiLast	- One past the last row of the block.
+				 *  @param pDst		- Pointer to the output value of the first row.
+				 */
+				void combineBlock( const std::uint32_t uiBlock, const std::vector<const T*>& vFrames, const std::uint32_t uiFirst, const std::uint32_t uiLast, float* pDst );
+
+				/** Combines one pixel from its sorted values.
+				 *  @param pValues	- The sorted values.
+				 *  @param uiCount	- The number of values.
+				 *  @return The combined value.
+				 */
+				double combineSorted( const double* pValues, const std::uint32_t uiCount ) const noexcept;
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** Number of threads per tile */
+				std::uint32_t m_uiThreads;
+
+				/** Number of frames the network and scratch buffers are sized for */
+				std::uint32_t m_uiFrames;
+
+				/** Combine method */
+				arc::gen3::image::e_CombineMethod m_eMethod;
+
+				/** Lower clip limit ( standard deviations ) */
+				double m_gLow;
+
+				/** Upper clip limit ( standard deviations ) */
+				double m_gHigh;
+
+				/** Maximum clip iterations */
+				std::uint32_t m_uiIterations;
+
+				/** Memory limit ( bytes ) */
+				std::uint64_t m_uiMemoryLimit;
+
+				/** Number of columns sorted by the network at a time */
+				static constexpr std::size_t CHUNK_SIZE = 256;
+
+				/** Sorting network compare-exchange pairs */
+				std::vector<std::pair<std::uint32_t, std::uint32_t>> m_vNetwork;
+
+				/** Sorting network compare-exchange pairs that reach the median */
+				std::vector<std::pair<std::uint32_t, std::uint32_t>> m_vMedianNetwork;
+
+				/** Tile buffers, two tiles of every frame */
+				std::vector<T> m_vTile;
+
+				/** Per-thread row scratch, one row of every frame */
+				std::vector<T> m_vScratch;
+
+				/** Per-thread pixel value scratch, one value of every frame */
+				std::vector<double> m_vValues;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCCOMBINE_H_
@@ -0,0 +1,223 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDisplayScale.h  ( Gen3 )                                                                             |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC display scaling engine.                                                      |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcDisplayScale.h */
+
+#ifndef _GEN3_CARCDISPLAYSCALE_H_
+#define _GEN3_CARCDISPLAYSCALE_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @enum e_ScaleLimits
+			 *  Display limit estimators. The estimates are made from a strided sample of the frame.
+			 */
+			enum class e_ScaleLimits : std::uint32_t
+			{
+				MANUAL = 0,		/**< Fixed limits set by the caller */
+				ZSCALE,			/**< The IRAF zscale algorithm; a line fitted to the sorted sample with iterative rejection */
+				PERCENTILE		/**< Lower and upper percentiles of the sample */
+			};
+
+			/** @enum e_Stretch
+			 *  Display stretch functions. Each maps the value between the limits, normalized to [ 0, 1 ], to [ 0, 1 ].
+			 */
+			enum class e_Stretch : std::uint32_t
+			{
+				LINEAR = 0,		/**< y = x */
+				LOG,			/**< y = log( a x + 1 ) / log( a + 1 ) */
+				ASINH			/**< y = asinh( x / b ) / asinh( 1 / b ) */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcDisplayScale
+		 *  Display scaling engine for live frames. Estimates display limits from a strided sample of the frame and
+		 *  maps every pixel through a lookup table of the stretch to an 8-bit preview buffer. 16-bit pixels index the
+		 *  table directly; 32-bit pixels are first quantized to a table index between the limits. The table is only
+		 *  rebuilt when the limits move by more than a tolerance or the stretch changes, so a stream of similar
+		 *  frames costs one sample and one table pass per frame.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcDisplayScale : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Lookup table size */
+				static constexpr std::uint32_t TABLE_SIZE = 65536;
+
+				/** Constructor
+				 *  Creates an engine with zscale limits and a linear stretch.
+				 */
+				CArcDisplayScale( void );
+
+				/** Destructor
+				 */
+				virtual ~CArcDisplayScale( void );
+
+				/** Selects zscale limits.
+				 *  @param gContrast - The zscale contrast; smaller values widen the limits ( default = 0.25 ).
+				 *  @throws std::invalid_argument if the contrast is not positive.
+				 */
+				void setZScale( const double gContrast = 0.25 );
+
+				/** Selects percentile limits.
+				 *  @param gLow		- The lower percentile ( default = 0.25 ).
+				 *  @param gHigh	- The upper percentile ( default = 99.75 ).
+				 *  @throws std::invalid_argument unless 0 <= gLow < gHigh <= 100.
+				 */
+				void setPercentile( const double gLow = 0.25, const double gHigh = 99.75 );
+
+				/** Selects fixed limits.
+				 *  @param gLow		- The value shown as black.
+				 *  @param gHigh	- The value shown as white.
+				 *  @throws std::invalid_argument unless gLow < gHigh.
+				 */
+				void setLimits( const double gLow, const double gHigh );
+
+				/** Sets the stretch function.
+				 *  @param eStretch	- The stretch function.
+				 *  @param gParam	- The LOG exponent a or the ASINH softening b. Zero selects the default; a = 1000,
+				 *					  b = 0.1 ( default = 0 ).
+				 *  @throws std::invalid_argument if the parameter is negative.
+				 */
+				void setStretch( const arc::gen3::image::e_Stretch eStretch, const double gParam = 0.0 );
+
+				/** Sets the number of pixels sampled to estimate the limits.
+				 *  @param uiSamples - The number of samples ( default = 10000 ).
+				 *  @throws std::invalid_argument if the number of samples is zero.
+				 */
+				void setSampleSize( const std::uint32_t uiSamples );
+
+				/** Sets how far the limits may move before the table is rebuilt.
+				 *  @param gTolerance - The tolerance as a fraction of the current limit range ( default = 0.002, about
+				 *						half an output level ).
+				 */
+				void setTolerance( const double gTolerance ) noexcept;
+
+				/** Sets the number of threads the frame is split over.
+				 *  @param uiThreads - The number of threads. Zero uses one per hardware thread.
+				 */
+				void setThreads( const std::uint32_t uiThreads ) noexcept;
+
+				/** Scales a frame to an 8-bit preview.
+				 *  @param tSrc		- The source view.
+				 *  @param pDstBuf	- Pointer to a buffer of cols x rows bytes.
+				 *  @throws std::invalid_argument
+				 */
+				void scale( const arc::gen3::image::ImageView<const T>& tSrc, std::uint8_t* pDstBuf );
+
+				/** Scales a frame to an 8-bit preview.
+				 *  @param pSrcBuf	- Pointer to the image buffer.
+				 *  @param uiCols	- The image column size ( in pixels ).
+				 *  @param uiRows	- The image row size ( in pixels ).
+				 *  @param pDstBuf	- Pointer to a buffer of cols x rows bytes.
+				 *  @throws std::invalid_argument
+				 */
+				void scale( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint8_t* pDstBuf );
+
+				/** Returns the limits used by the last scale() call.
+				 *  @return The values shown as black and white.
+				 */
+				std::pair<double, double> limits( void ) const noexcept;
+
+				/** Returns the number of times the lookup table has been built.
+				 *  @return The table build count.
+				 */
+				std::uint64_t tableBuilds( void ) const noexcept;
+
+			private:
+
+				/** Estimates the limits of a frame from a strided sample.
+				 *  @param tSrc - The source view.
+				 *  @return The estimated limits.
+				 */
+				std::pair<double, double> estimateLimits( const arc::gen3::image::ImageView<const T>& tSrc );
+
+				/** Fits a line to the sorted sample with iterative rejection and returns the zscale limits.
+				 *  @return The zscale limits.
+				 */
+				std::pair<double, double> zscale( void ) const;
+
+				/** Builds the lookup table for the current limits and stretch.
+				 */
+				void buildTable( void );
+
+				/** Limit estimator */
+				arc::gen3::image::e_ScaleLimits m_eLimits;
+
+				/** Stretch function */
+				arc::gen3::image::e_Stretch m_eStretch;
+
+				/** Stretch parameter */
+				double m_gParam;
+
+				/** Zscale contrast */
+				double m_gContrast;
+
+				/** Lower percentile */
+				double m_gLowPercent;
+
+				/** Upper percentile */
+				double m_gHighPercent;
+
+				/** Fixed limits */
+				std::pair<double, double> m_tManual;
+
+				/** Number of samples */
+				std::uint32_t m_uiSamples;
+
+				/** Table rebuild tolerance */
+				double m_gTolerance;
+
+				/** Number of threads */
+				std::uint32_t m_uiThreads;
+
+				/** Limits the table was built for */
+				std::pair<double, double> m_tLimits;
+
+				/** true if the table must be rebuilt */
+				bool m_bDirty;
+
+				/** Number of table builds */
+				std::uint64_t m_uiBuilds;
+
+				/** Sample scratch */
+				std::vector<double> m_vSample;
+
+				/** Lookup table */
+				std::vector<std::uint8_t> m_vTable;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCDISPLAYSCALE_H_
@@ -0,0 +1,115 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcFrameVerifier.h  ( Gen3 )                                                                            |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC streaming synthetic image verifier.                                          |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcFrameVerifier.h */
+
+#ifndef _GEN3_CARCFRAMEVERIFIER_H_
+#define _GEN3_CARCFRAMEVERIFIER_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <cstddef>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @class CArcFrameVerifier
+		 *  Streaming synthetic image verifier for continuous readout. Pixels are pushed as they arrive, in any
+		 *  amount, e.g. each row or each frame of a continuous() sequence, and are checked in place against the
+		 *  expected pattern with CArcImage::compareRamp() or CArcImage::compareConstant(). Every frame restarts the
+		 *  pattern. The report accumulates over all frames until reset() is called.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcFrameVerifier : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  Creates a verifier for the ramp 0, 1, ..., maxTVal() - 1, 0, 1, ..., as written by
+				 *  CArcImage::fillWithRamp() and, for 16-bit data, the controller synthetic image.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcFrameVerifier( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcFrameVerifier( void );
+
+				/** Selects a ramp pattern and resets the verifier.
+				 *  @param uiStart	- The value of the first pixel of every frame ( default = 0 ).
+				 *  @param uiPeriod	- The ramp period ( default = CArcImage::maxTVal(), the period of fillWithRamp() ).
+				 *  @throws std::out_of_range
+				 */
+				void setRamp( const std::uint32_t uiStart = 0, const std::uint64_t uiPeriod = CArcImage<T>::maxTVal() );
+
+				/** Selects a constant pattern and resets the verifier.
+				 *  @param uiValue - The expected value.
+				 */
+				void setConstant( const T uiValue );
+
+				/** Checks the next pixels of the stream.
+				 *  @param pBuf		- Pointer to the pixels.
+				 *  @param uiCount	- The number of pixels.
+				 *  @throws std::invalid_argument if pBuf is nullptr.
+				 */
+				void push( const T* pBuf, const std::size_t uiCount );
+
+				/** Returns the accumulated report. uiFrames counts complete frames; uiPixels includes a partial frame.
+				 *  @return The report.
+				 */
+				const arc::gen3::image::VerifyReport_t& report( void ) const noexcept;
+
+				/** Clears the report and restarts at the first pixel of a frame.
+				 */
+				void reset( void ) noexcept;
+
+			private:
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** true for a ramp pattern, false for a constant */
+				bool m_bRamp;
+
+				/** Ramp start or constant value */
+				std::uint64_t m_uiStart;
+
+				/** Ramp period */
+				std::uint64_t m_uiPeriod;
+
+				/** Position in the current frame ( in pixels ) */
+				std::uint64_t m_uiPosition;
+
+				/** Accumulated report */
+				arc::gen3::image::VerifyReport_t m_tReport;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCFRAMEVERIFIER_H_
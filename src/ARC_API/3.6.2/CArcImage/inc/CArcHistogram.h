@@ -0,0 +1,287 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcHistogram.h  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC image histogram engine.                                                      |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcHistogram.h */
+
+#ifndef _GEN3_CARCHISTOGRAM_H_
+#define _GEN3_CARCHISTOGRAM_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @enum e_HistMode
+			 *  Histogram bin storage modes.
+			 */
+			enum class e_HistMode : std::uint32_t
+			{
+				BINNED = 0,		/**< A fixed number of equal width bins over a configured value range */
+				SPARSE			/**< One bin per value over the full data type range, allocated in pages of 65536 values on first use */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcHistogram
+		 *  Image histogram engine. An engine is configured once and reused across frames, so the bin buffers
+		 *  are only allocated on first use. Binned histograms count into a fixed number of bins over a value
+		 *  range and may count into a caller owned buffer. Sparse histograms count every value of the data type
+		 *  exactly, but only allocate memory for the 65536 value pages that hold data, which keeps 32-bit
+		 *  histograms of real images small. Each thread counts into a private sub-histogram that is merged at
+		 *  the end of the pass. Percentiles and the median are derived from the counts.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcHistogram : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  Creates an exact histogram over the full data type range. 16-bit histograms are binned with one
+				 *  bin per value, 32-bit histograms are sparse.
+				 */
+				CArcHistogram( void );
+
+				/** Constructor
+				 *  Creates a binned histogram. Values from tMin to tMax inclusive are divided into uiBins bins of
+				 *  equal width ( to within one value ). Values outside the range are counted by underflow() and
+				 *  overflow().
+				 *  @param uiBins	- The number of bins. Must not exceed the number of values in the range.
+				 *  @param tMin		- The lowest value of the first bin.
+				 *  @param tMax		- The highest value of the last bin.
+				 *  @throws std::invalid_argument
+				 */
+				CArcHistogram( const std::uint32_t uiBins, const T tMin, const T tMax );
+
+				/** Destructor
+				 */
+				virtual ~CArcHistogram( void );
+
+				/** Returns the bin storage mode.
+				 *  @return The bin storage mode.
+				 */
+				arc::gen3::image::e_HistMode mode( void ) const noexcept;
+
+				/** Returns the number of bins. A sparse histogram has one bin per data type value.
+				 *  @return The number of bins.
+				 */
+				std::uint64_t bins( void ) const noexcept;
+
+				/** Returns the lowest value of a bin.
+				 *  @param uiBin - The bin index.
+				 *  @return The lowest value counted in the bin.
+				 *  @throws std::out_of_range
+				 */
+				T binLow( const std::uint64_t uiBin ) const;
+
+				/** Directs a binned histogram to count into a caller owned buffer, e.g. to reuse one buffer across
+				 *  frames or to accumulate into shared memory. The buffer contents are kept, so clear() or compute()
+				 *  must be used to start from zero.
+				 *  @param pBins - The bin buffer, bins() counts. Must remain valid while attached. nullptr reverts to the internal buffer.
+				 *  @throws std::invalid_argument if the histogram is sparse.
+				 */
+				void attach( std::uint32_t* pBins );
+
+				/** Returns the counts of a binned histogram.
+				 *  @return The bins() counts, or nullptr for a sparse histogram or before the first pass.
+				 */
+				const std::uint32_t* data( void ) const noexcept;
+
+				/** Zeroes all counts.
+				 */
+				void clear( void );
+
+				/** Zeroes all counts and counts the pixels of an image.
+				 *  @param pBuf			- Pointer to the image buffer.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param uiRows		- The image row size ( in pixels ).
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument
+				 */
+				void compute( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Zeroes all counts and counts the pixels of an image region.
+				 *  @param pBuf			- Pointer to the image buffer.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param uiRows		- The image row size ( in pixels ).
+				 *  @param tRoi			- The image region.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument
+				 *  @throws std::out_of_range
+				 */
+				void compute( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads = 1 );
+
+				/** Adds the pixels of an image to the counts, e.g. to histogram a sequence of frames.
+				 *  @param pBuf			- Pointer to the image buffer.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param uiRows		- The image row size ( in pixels ).
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument
+				 */
+				void accumulate( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Adds the pixels of an image region to the counts.
+				 *  @param pBuf			- Pointer to the image buffer.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param uiRows		- The image row size ( in pixels ).
+				 *  @param tRoi			- The image region.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument
+				 *  @throws std::out_of_range
+				 */
+				void accumulate( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads = 1 );
+
+				/** Returns the count of a bin.
+				 *  @param uiBin - The bin index. For a sparse histogram this is the pixel value.
+				 *  @return The bin count.
+				 *  @throws std::out_of_range
+				 */
+				std::uint64_t count( const std::uint64_t uiBin ) const;
+
+				/** Returns the total number of pixels counted, including underflow() and overflow().
+				 *  @return The total number of pixels counted.
+				 */
+				std::uint64_t total( void ) const noexcept;
+
+				/** Returns the number of pixels below the range of a binned histogram.
+				 *  @return The number of pixels below the first bin.
+				 */
+				std::uint64_t underflow( void ) const noexcept;
+
+				/** Returns the number of pixels above the range of a binned histogram.
+				 *  @return The number of pixels above the last bin.
+				 */
+				std::uint64_t overflow( void ) const noexcept;
+
+				/** Returns a percentile of the counted pixel values using the nearest rank method. Within bins wider
+				 *  than one value the result is interpolated assuming evenly spread values. Ranks that fall below or
+				 *  above the range of a binned histogram return the range limit.
+				 *  @param gPercent - The percentile, 0 to 100.
+				 *  @return The pixel value at the percentile.
+				 *  @throws std::invalid_argument if the percentile is out of range.
+				 *  @throws std::runtime_error if no pixels have been counted.
+				 */
+				double percentile( const double gPercent ) const;
+
+				/** Returns the median of the counted pixel values, i.e. percentile( 50 ).
+				 *  @return The median pixel value.
+				 *  @throws std::runtime_error if no pixels have been counted.
+				 */
+				double median( void ) const;
+
+				/** Returns the bin memory held by the engine, including the per-thread sub-histograms.
+				 *  @return The bin memory in bytes.
+				 */
+				std::uint64_t memoryBytes( void ) const noexcept;
+
+			private:
+
+				/** Sparse page table type */
+				using PageTable_t = std::vector<std::unique_ptr<std::uint32_t[]>>;
+
+				/** Counts the pixels of an image region. The parameters must have been verified.
+				 *  @param pBuf			- Pointer to the image buffer.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param tRoi			- The image region.
+				 *  @param uiThreads	- The number of threads.
+				 */
+				void countRegion( const T* pBuf, const std::uint32_t uiCols, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads );
+
+				/** Counts one row of pixels into a binned histogram.
+				 *  @param pRow		- Pointer to the first pixel.
+				 *  @param uiCount	- The number of pixels.
+				 *  @param pBins	- The bins to count into.
+				 *  @param uiUnder	- Incremented for each pixel below the range.
+				 *  @param uiOver	- Incremented for each pixel above the range.
+				 */
+				void countBinned( const T* pRow, const std::uint32_t uiCount, std::uint32_t* pBins, std::uint64_t& uiUnder, std::uint64_t& uiOver ) const noexcept;
+
+				/** Counts one row of pixels into a sparse histogram, allocating pages as needed.
+				 *  @param pRow		- Pointer to the first pixel.
+				 *  @param uiCount	- The number of pixels.
+				 *  @param vPages	- The page table to count into.
+				 */
+				static void countSparse( const T* pRow, const std::uint32_t uiCount, PageTable_t& vPages );
+
+				/** Verifies an image buffer and region.
+				 *  @param pBuf		- Pointer to the image buffer.
+				 *  @param uiCols	- The image column size ( in pixels ).
+				 *  @param uiRows	- The image row size ( in pixels ).
+				 *  @param tRoi		- The image region.
+				 *  @throws std::invalid_argument
+				 *  @throws std::out_of_range
+				 */
+				static void verifyRegion( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi );
+
+				/** Number of values per sparse page */
+				static constexpr std::uint64_t PAGE_SIZE = 65536;
+
+				/** Bin storage mode */
+				arc::gen3::image::e_HistMode m_eMode;
+
+				/** Number of bins ( binned mode ) */
+				std::uint32_t m_uiBins;
+
+				/** Lowest value of the first bin */
+				T m_tMin;
+
+				/** Highest value of the last bin */
+				T m_tMax;
+
+				/** Fixed point bin scale, 2^32 x bins / range. A value v is counted in bin ( ( v - min ) x scale ) >> 32 */
+				std::uint64_t m_uiScale;
+
+				/** Pixels counted below the range */
+				std::uint64_t m_uiUnder;
+
+				/** Pixels counted above the range */
+				std::uint64_t m_uiOver;
+
+				/** Total pixels counted */
+				std::uint64_t m_uiTotal;
+
+				/** Active bins; either m_vBins or a caller owned buffer */
+				std::uint32_t* m_pBins;
+
+				/** Internal bins */
+				std::vector<std::uint32_t> m_vBins;
+
+				/** Per-thread sub-histogram bins for threads other than the calling thread; zero between calls */
+				std::vector<std::uint32_t> m_vThreadBins;
+
+				/** Sparse page table */
+				PageTable_t m_vPages;
+
+				/** Per-thread sparse page tables for threads other than the calling thread; zero between calls */
+				std::vector<PageTable_t> m_vThreadPages;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCHISTOGRAM_H_
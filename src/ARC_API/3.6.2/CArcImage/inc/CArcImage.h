@@ -17,11 +17,16 @@
 #endif
 
 #include <stdexcept>
+#include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <cstring>
 #include <memory>
 #include <functional>
 #include <cmath>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <CArcImageDllMain.h>
 #include <CArcBase.h>
@@ -47,8 +52,406 @@ namespace arc
 			using BPP_32 = std::uint32_t;
 
 
+			/** @struct Roi_t
+			 *  Rectangular image region. The region covers columns uiCol1 up to but not including uiCol2, and rows
+			 *  uiRow1 up to but not including uiRow2.
+			 */
+			struct GEN3_CARCIMAGE_API Roi_t
+			{
+				std::uint32_t uiCol1;		/**< The start column */
+				std::uint32_t uiCol2;		/**< One past the end column */
+				std::uint32_t uiRow1;		/**< The start row */
+				std::uint32_t uiRow2;		/**< One past the end row */
+			};
+
+
+			/** @enum e_ArithMode
+			 *  Integer overflow handling of the image arithmetic kernels.
+			 */
+			enum class e_ArithMode : std::uint32_t
+			{
+				WRAP = 0,		/**< Results wrap modulo the data type range, as in the allocating add(), subtract() and divide() */
+				SATURATE		/**< Results are clamped to the data type range */
+			};
+
+
+			/** @enum e_BinMode
+			 *  Software binning output modes.
+			 */
+			enum class e_BinMode : std::uint32_t
+			{
+				SUM = 0,		/**< The sum of each block, clamped to the data type range */
+				MEAN			/**< The mean of each block, rounded to the nearest integer */
+			};
+
+
+			/** @enum e_ProfileAxis
+			 *  Profile directions.
+			 */
+			enum class e_ProfileAxis : std::uint32_t
+			{
+				ROW = 0,		/**< One value per row, averaged over the region columns, as in getRowArea() */
+				COLUMN			/**< One value per column, averaged over the region rows, as in getColArea() */
+			};
+
+
+			/** @struct Profile_t
+			 *  Averaged profile request for CArcImage::getProfiles(). The profile is written to a caller buffer of
+			 *  ( uiRow2 - uiRow1 ) values for a row profile or ( uiCol2 - uiCol1 ) values for a column profile.
+			 */
+			struct GEN3_CARCIMAGE_API Profile_t
+			{
+				Roi_t			tRoi;		/**< The region */
+				e_ProfileAxis	eAxis;		/**< The profile direction */
+				double*			pDst;		/**< The profile buffer */
+			};
+
+
+			/** @struct VerifyReport_t
+			 *  Result of a synthetic pattern check. The first mismatch fields are only valid if uiErrors is not zero.
+			 */
+			struct GEN3_CARCIMAGE_API VerifyReport_t
+			{
+				std::uint64_t	uiErrors;		/**< Number of pixels that differ from the pattern */
+				std::uint64_t	uiPixels;		/**< Number of pixels checked */
+				std::uint64_t	uiFrames;		/**< Number of complete frames checked */
+				std::uint64_t	uiFrame;		/**< Frame of the first mismatch */
+				std::uint32_t	uiCol;			/**< Column of the first mismatch */
+				std::uint32_t	uiRow;			/**< Row of the first mismatch */
+				std::uint32_t	uiExpected;		/**< Expected value of the first mismatch */
+				std::uint32_t	uiFound;		/**< Found value of the first mismatch */
+			};
+
+
+			/** @struct NoiseModel_t
+			 *  Detector model for CArcImage::fillWithNoise().
+			 */
+			struct GEN3_CARCIMAGE_API NoiseModel_t
+			{
+				double	gBias;			/**< Bias level ( ADU ) */
+				double	gGain;			/**< Gain ( electrons / ADU ) */
+				double	gReadNoise;		/**< Read noise ( electrons rms ) */
+				double	gSignal;		/**< Mean signal ( electrons / pixel ) */
+				double	gRowNoise;		/**< Row to row bias offset ( ADU rms ) */
+				double	gColumnNoise;	/**< Fixed column bias pattern ( ADU rms ) */
+			};
+
+
+			/** @class ImageView
+			 *  Non-owning view of a rectangular image region. A view holds a pointer to its first pixel, its column
+			 *  and row extent and the row stride of the image it refers to, so regions, rows and columns of an image
+			 *  can be passed to the CArcImage operations without being copied. Use T = const BPP_16 or
+			 *  const BPP_32 for read only views; a writable view converts to a read only view. The view is only
+			 *  valid while the image buffer it refers to is. Use CArcImage::copy() to make a contiguous copy.
+			 */
+			template <typename T>
+			class ImageView
+			{
+				public:
+
+					/** Default constructor
+					 *  Creates an empty view.
+					 */
+					ImageView( void ) noexcept : m_pData( nullptr ), m_uiCols( 0 ), m_uiRows( 0 ), m_uiStride( 0 )
+					{
+					}
+
+					/** Constructor
+					 *  Creates a view of a whole image.
+					 *  @param pBuf		- Pointer to the image buffer.
+					 *  @param uiCols	- The image column size ( in pixels ).
+					 *  @param uiRows	- The image row size ( in pixels ).
+					 */
+					ImageView( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows ) noexcept
+						: m_pData( pBuf ), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiStride( uiCols )
+					{
+					}
+
+					/** Constructor
+					 *  Creates a view from an origin pixel, extent and row stride.
+					 *  @param pOrigin	- Pointer to the first pixel of the view.
+					 *  @param uiCols	- The view column size ( in pixels ).
+					 *  @param uiRows	- The view row size ( in pixels ).
+					 *  @param uiStride	- The number of pixels between the starts of two rows; the parent image column size.
+					 */
+					ImageView( T* pOrigin, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiStride ) noexcept
+						: m_pData( pOrigin ), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiStride( uiStride )
+					{
+					}
+
+					/** Converts a writable view to a read only view.
+					 *  @param tView - The view to convert.
+					 */
+					template <typename U, typename = std::enable_if_t<std::is_same_v<const U, T> && !std::is_same_v<U, T>>>
+					ImageView( const ImageView<U>& tView ) noexcept
+						: m_pData( tView.data() ), m_uiCols( tView.cols() ), m_uiRows( tView.rows() ), m_uiStride( tView.stride() )
+					{
+					}
+
+					/** Returns a view of a region of this view. The region covers columns uiCol1 up to but not including
+					 *  uiCol2, and rows uiRow1 up to but not including uiRow2.
+					 *  @param uiCol1	- The start column.
+					 *  @param uiCol2	- One past the end column.
+					 *  @param uiRow1	- The start row.
+					 *  @param uiRow2	- One past the end row.
+					 *  @return The region view.
+					 *  @throws std::invalid_argument if the region is empty.
+					 *  @throws std::out_of_range if the region does not lie within the view.
+					 */
+					ImageView sub( const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2 ) const
+					{
+						if ( uiCol1 >= uiCol2 || uiRow1 >= uiRow2 )
+						{
+							throwArcGen3InvalidArgument( "Invalid region [ %u, %u ) x [ %u, %u ), the region is empty.", uiCol1, uiCol2, uiRow1, uiRow2 );
+						}
+
+						if ( uiCol2 > m_uiCols )
+						{
+							throwArcGen3OutOfRange( uiCol2, std::make_pair( static_cast< std::uint32_t >( 1 ), m_uiCols ) );
+						}
+
+						if ( uiRow2 > m_uiRows )
+						{
+							throwArcGen3OutOfRange( uiRow2, std::make_pair( static_cast< std::uint32_t >( 1 ), m_uiRows ) );
+						}
+
+						return ImageView( ( m_pData + static_cast< std::size_t >( uiRow1 ) * m_uiStride + uiCol1 ), ( uiCol2 - uiCol1 ), ( uiRow2 - uiRow1 ), m_uiStride );
+					}
+
+					/** Returns a view of a region of this view.
+					 *  @param tRoi - The region.
+					 *  @return The region view.
+					 *  @throws std::invalid_argument if the region is empty.
+					 *  @throws std::out_of_range if the region does not lie within the view.
+					 */
+					ImageView sub( const Roi_t& tRoi ) const
+					{
+						return sub( tRoi.uiCol1, tRoi.uiCol2, tRoi.uiRow1, tRoi.uiRow2 );
+					}
+
+					/** Returns a view of one row of this view.
+					 *  @param uiRow - The row.
+					 *  @return The row view; one row of cols() pixels.
+					 *  @throws std::out_of_range if the row does not lie within the view.
+					 */
+					ImageView row( const std::uint32_t uiRow ) const
+					{
+						return sub( 0, m_uiCols, uiRow, ( uiRow + 1 ) );
+					}
+
+					/** Returns a view of one column of this view.
+					 *  @param uiCol - The column.
+					 *  @return The column view; rows() rows of one pixel.
+					 *  @throws std::out_of_range if the column does not lie within the view.
+					 */
+					ImageView col( const std::uint32_t uiCol ) const
+					{
+						return sub( uiCol, ( uiCol + 1 ), 0, m_uiRows );
+					}
+
+					/** Returns a pointer to the first pixel of a row. The row is not checked.
+					 *  @param uiRow - The row.
+					 *  @return Pointer to cols() pixels.
+					 */
+					T* rowData( const std::uint32_t uiRow ) const noexcept
+					{
+						return ( m_pData + static_cast< std::size_t >( uiRow ) * m_uiStride );
+					}
+
+					/** Returns a pixel. The column and row are not checked.
+					 *  @param uiCol	- The column.
+					 *  @param uiRow	- The row.
+					 *  @return A reference to the pixel.
+					 */
+					T& operator()( const std::uint32_t uiCol, const std::uint32_t uiRow ) const noexcept
+					{
+						return m_pData[ static_cast< std::size_t >( uiRow ) * m_uiStride + uiCol ];
+					}
+
+					/** Returns a pointer to the first pixel of the view */
+					T* data( void ) const noexcept { return m_pData; }
+
+					/** Returns the view column size ( in pixels ) */
+					std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+					/** Returns the view row size ( in pixels ) */
+					std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+					/** Returns the number of pixels between the starts of two rows */
+					std::uint32_t stride( void ) const noexcept { return m_uiStride; }
+
+					/** Returns the number of pixels in the view */
+					std::size_t size( void ) const noexcept { return ( static_cast< std::size_t >( m_uiCols ) * m_uiRows ); }
+
+					/** Returns true if the view rows follow each other in memory without gaps */
+					bool contiguous( void ) const noexcept { return ( m_uiStride == m_uiCols || m_uiRows <= 1 ); }
+
+				private:
+
+					/** Pointer to the first pixel */
+					T* m_pData;
+
+					/** Column size ( in pixels ) */
+					std::uint32_t m_uiCols;
+
+					/** Row size ( in pixels ) */
+					std::uint32_t m_uiRows;
+
+					/** Row stride ( in pixels ) */
+					std::uint32_t m_uiStride;
+			};
+
+
+			/** @class CBitMask
+			 *  Packed per-pixel bit mask, e.g. of hot pixels and cosmic rays. Each row is packed into whole 64-bit
+			 *  words, with column c of a row in bit ( c % 64 ) of word ( c / 64 ), so rows can be processed on
+			 *  separate threads and a word with no bits set skips 64 pixels at a time.
+			 */
+			class GEN3_CARCIMAGE_API CBitMask
+			{
+				public:
+
+					/** Default constructor
+					 *  Creates an empty mask.
+					 */
+					CBitMask( void ) noexcept : m_uiCols( 0 ), m_uiRows( 0 ), m_uiWords( 0 )
+					{
+					}
+
+					/** Constructor
+					 *  Creates a mask with no bits set.
+					 *  @param uiCols	- The image column size ( in pixels ).
+					 *  @param uiRows	- The image row size ( in pixels ).
+					 */
+					CBitMask( const std::uint32_t uiCols, const std::uint32_t uiRows ) : CBitMask()
+					{
+						resize( uiCols, uiRows );
+					}
+
+					/** Resizes the mask and clears every bit.
+					 *  @param uiCols	- The image column size ( in pixels ).
+					 *  @param uiRows	- The image row size ( in pixels ).
+					 */
+					void resize( const std::uint32_t uiCols, const std::uint32_t uiRows )
+					{
+						m_uiCols = uiCols;
+						m_uiRows = uiRows;
+						m_uiWords = ( ( uiCols + 63 ) / 64 );
+
+						m_vWords.assign( ( static_cast< std::size_t >( m_uiWords ) * uiRows ), 0 );
+					}
+
+					/** Clears every bit.
+					 */
+					void clear( void ) noexcept
+					{
+						std::fill( m_vWords.begin(), m_vWords.end(), 0 );
+					}
+
+					/** Returns the bit of a pixel. The column and row are not checked.
+					 *  @param uiCol	- The column.
+					 *  @param uiRow	- The row.
+					 *  @return true if the pixel is masked.
+					 */
+					bool test( const std::uint32_t uiCol, const std::uint32_t uiRow ) const noexcept
+					{
+						return ( ( rowData( uiRow )[ uiCol / 64 ] >> ( uiCol % 64 ) ) & 1 ) != 0;
+					}
+
+					/** Sets or clears the bit of a pixel. The column and row are not checked.
+					 *  @param uiCol	- The column.
+					 *  @param uiRow	- The row.
+					 *  @param bValue	- true to mask the pixel ( default = true ).
+					 */
+					void set( const std::uint32_t uiCol, const std::uint32_t uiRow, const bool bValue = true ) noexcept
+					{
+						const std::uint64_t uiBit = ( static_cast< std::uint64_t >( 1 ) << ( uiCol % 64 ) );
+
+						std::uint64_t& rWord = rowData( uiRow )[ uiCol / 64 ];
+
+						rWord = ( bValue ? ( rWord | uiBit ) : ( rWord & ~uiBit ) );
+					}
+
+					/** Sets every bit that is set in another mask of the same size, e.g. to add a static bad pixel map
+					 *  to a detected defect mask.
+					 *  @param cOther - The mask to merge.
+					 *  @throws std::invalid_argument if the mask sizes differ.
+					 */
+					void merge( const CBitMask& cOther )
+					{
+						if ( cOther.m_uiCols != m_uiCols || cOther.m_uiRows != m_uiRows )
+						{
+							throwArcGen3InvalidArgument( "Mask size [ %u x %u ] does not match [ %u x %u ].", cOther.m_uiCols, cOther.m_uiRows, m_uiCols, m_uiRows );
+						}
+
+						for ( std::size_t i = 0; i < m_vWords.size(); i++ )
+						{
+							m_vWords[ i ] |= cOther.m_vWords[ i ];
+						}
+					}
+
+					/** Returns the number of bits set.
+					 *  @return The number of masked pixels.
+					 */
+					std::uint64_t count( void ) const noexcept
+					{
+						std::uint64_t uiCount = 0;
+
+						for ( const auto uiWord : m_vWords )
+						{
+							uiCount += static_cast< std::uint64_t >( std::popcount( uiWord ) );
+						}
+
+						return uiCount;
+					}
+
+					/** Returns a pointer to the words of a row. The row is not checked.
+					 *  @param uiRow - The row.
+					 *  @return Pointer to wordsPerRow() words.
+					 */
+					std::uint64_t* rowData( const std::uint32_t uiRow ) noexcept
+					{
+						return ( m_vWords.data() + static_cast< std::size_t >( uiRow ) * m_uiWords );
+					}
+
+					/** Returns a pointer to the words of a row. The row is not checked.
+					 *  @param uiRow - The row.
+					 *  @return Pointer to wordsPerRow() words.
+					 */
+					const std::uint64_t* rowData( const std::uint32_t uiRow ) const noexcept
+					{
+						return ( m_vWords.data() + static_cast< std::size_t >( uiRow ) * m_uiWords );
+					}
+
+					/** Returns the image column size ( in pixels ) */
+					std::uint32_t cols( void ) const noexcept { return m_uiCols; }
+
+					/** Returns the image row size ( in pixels ) */
+					std::uint32_t rows( void ) const noexcept { return m_uiRows; }
+
+					/** Returns the number of 64-bit words per row */
+					std::uint32_t wordsPerRow( void ) const noexcept { return m_uiWords; }
+
+				private:
+
+					/** Image column size */
+					std::uint32_t m_uiCols;
+
+					/** Image row size */
+					std::uint32_t m_uiRows;
+
+					/** Words per row */
+					std::uint32_t m_uiWords;
+
+					/** Mask words */
+					std::vector<std::uint64_t> m_vWords;
+			};
+
+
 			/** @class CAvgStats
-			 *  Average image statistics info class
+			 *  Average image statistics info class. Holds the per-channel statistics averaged over a sequence of
+			 *  images, as accumulated by CArcImage::accumulateChannelStats(). The "of means" members are taken across
+			 *  channels, e.g. gStdDevOfMeans is the standard deviation of the channel average means.
 			 */
 			class GEN3_CARCIMAGE_API CAvgStats
 			{
@@ -63,6 +466,8 @@ namespace arc
 
 						gMeanOfMeans = gStdDevOfMeans = gAvgAvgStdDev = 0;
 
+						uiImageCount = 0;
+
 						pAverageMin = new double[ uiChannelCount ];
 						pAverageMax = new double[ uiChannelCount ];
 						pAverageMean = new double[ uiChannelCount ];
@@ -219,14 +624,15 @@ namespace arc
 			static const std::string version( void );
 
 			/** Fills the specified buffer with the specified value.
-			 *  @param pBuf		- Pointer to the image buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
-			 *  @param uiValue	- The value to fill the buffer with.
+			 *  @param pBuf			- Pointer to the image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiValue		- The value to fill the buffer with.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
 			 *  @throws std::invalid_argument
 			 *  @throws std::out_of_range
 			 */
-			static void fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue );
+			static void fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue, const std::uint32_t uiThreads = 1 );
 
 			/** Fills the specified buffer with the specified value.
 			 *  @param pBuf		- Pointer to the image buffer.
@@ -238,28 +644,50 @@ namespace arc
 			static void fill( T* pBuf, const std::uint32_t uiBytes, const T uiValue );
 
 			/** Fills the specified buffer with a gradient pattern.
-			 *  @param pBuf		- Pointer to the image buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pBuf			- Pointer to the image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
 			 *  @throws std::invalid_argument
 			 */
-			static void fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			static void fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
 
 			/** Fills the specified buffer with zeroes and puts a smiley face at the center.
-			 *  @param pBuf		- Pointer to the image buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pBuf			- Pointer to the image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
 			 *  @throws std::invalid_argument
 			 */
-			static void fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			static void fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
 
 			/** Fills the specified buffer with a ramp image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....
-			 *  @param pBuf		- Pointer to the image buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pBuf			- Pointer to the image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
 			 *  @throws std::invalid_argument
 			 */
-			static void fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			static void fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Fills the specified buffer with a simulated frame:
+			 *
+			 *		pixel = bias + row offset + column offset + ( signal + noise ) / gain
+			 *
+			 *  The noise is gaussian with a variance of signal + read noise squared electrons, i.e. shot noise in the
+			 *  gaussian limit plus read noise. The column offsets are a fixed pattern and the row offsets change every
+			 *  row. Values are rounded and clamped to 0 to maxTVal() - 1. The random numbers are a counter based
+			 *  hash of the seed, row and column, so the frame depends only on the seed and not on the thread count.
+			 *  @param pBuf			- Pointer to the image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param tModel		- The noise model.
+			 *  @param uiSeed		- The random seed.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void fillWithNoise( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::NoiseModel_t& tModel,
+									   const std::uint64_t uiSeed, const std::uint32_t uiThreads = 1 );
 
 			/** Verify a ramp synthetic image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....
 			 *  @param pBuf		- Pointer to the image data buffer.
@@ -287,6 +715,51 @@ namespace arc
 			 */
 			static std::uint32_t countPixels( const T* pBuf, const std::uint32_t uiBufSize, const std::uint16_t uwValue );
 
+			/** Checks an image view against the ramp synthetic image, uiStart, uiStart + 1, ..., uiPeriod - 1, 0, 1, ...
+			 *  running across the rows of the view. Unlike containsValidRamp() every pixel is checked and nothing is
+			 *  thrown on a mismatch; the report holds the error count and the first mismatch.
+			 *  @param tView		- The image view.
+			 *  @param uiStart		- The value of the first pixel ( default = 0 ).
+			 *  @param uiPeriod		- The ramp period; fillWithRamp() repeats every maxTVal() pixels, as does the
+			 *						  16-bit controller synthetic image ( default = maxTVal() ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @return The check report.
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static arc::gen3::image::VerifyReport_t checkRamp( const arc::gen3::image::ImageView<const T>& tView, const std::uint32_t uiStart = 0,
+															   const std::uint64_t uiPeriod = maxTVal(), const std::uint32_t uiThreads = 1 );
+
+			/** Checks that every pixel of an image view has the same value.
+			 *  @param tView		- The image view.
+			 *  @param uiValue		- The expected value.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @return The check report.
+			 *  @throws std::invalid_argument
+			 */
+			static arc::gen3::image::VerifyReport_t checkConstant( const arc::gen3::image::ImageView<const T>& tView, const T uiValue, const std::uint32_t uiThreads = 1 );
+
+			/** Counts the pixels of a span that differ from a ramp that starts at uiValue and wraps to zero at
+			 *  uiPeriod. The span is compared in runs between wraps, so each run is a branch free loop the compiler
+			 *  vectorizes. This is the kernel of checkRamp() and CArcFrameVerifier.
+			 *  @param pBuf		- Pointer to the pixels.
+			 *  @param uiCount	- The number of pixels.
+			 *  @param uiValue	- The expected value of the first pixel; less than uiPeriod.
+			 *  @param uiPeriod	- The ramp period; at most maxTVal() for 16-bit data or 2^32.
+			 *  @param uiFirst	- Set to the index of the first mismatch, or uiCount if there is none.
+			 *  @return The number of mismatches.
+			 */
+			static std::uint64_t compareRamp( const T* pBuf, const std::size_t uiCount, const std::uint64_t uiValue, const std::uint64_t uiPeriod, std::size_t& uiFirst ) noexcept;
+
+			/** Counts the pixels of a span that differ from a value. See compareRamp().
+			 *  @param pBuf		- Pointer to the pixels.
+			 *  @param uiCount	- The number of pixels.
+			 *  @param uiValue	- The expected value.
+			 *  @param uiFirst	- Set to the index of the first mismatch, or uiCount if there is none.
+			 *  @return The number of mismatches.
+			 */
+			static std::uint64_t compareConstant( const T* pBuf, const std::size_t uiCount, const T uiValue, std::size_t& uiFirst ) noexcept;
+
 			/** Returns the value of a pixel at the specified row and column.
 			 *  @param pBuf		- Pointer to the image buffer.
 			 *  @param uiCol	- The pixel column number.
@@ -373,60 +846,149 @@ namespace arc
 																								 std::uint32_t& uiCount );
 
 			/** Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated
-			 *  pixel count over the specified image buffer cols and rows.
-			 *  @param pBuf		- Pointer to the image data buffer.
-			 *  @param uiCol1	- The start column.
-			 *  @param uiCol2	- The end column.
-			 *  @param uiRow1	- The start row.
-			 *  @param uiRow2	- The end row.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  pixel count over the specified image buffer cols and rows. The statistics are calculated in a single
+			 *  pass; the mean and variance match a two pass double precision calculation to within a relative
+			 *  error of about 1e-9, and 16-bit sums are exact.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCol1		- The start column.
+			 *  @param uiCol2		- The end column.
+			 *  @param uiRow1		- The start row.
+			 *  @param uiRow2		- The end row.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
 			 *  @return A std::unique_ptr to an arc::gen3::image::CStats object.
 			 *  @throws std::runtime_error
 			 */
 			static std::unique_ptr<arc::gen3::image::CStats>
-			getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+					  const std::uint32_t uiThreads = 1 );
 
 			/** Calculates the image min, max, mean, variance, standard deviation, total pixel count and
-			 *  saturated pixel count over the entire image.
-			 *  @param pBuf		- Pointer to the image data buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  saturated pixel count over the entire image in a single pass.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
 			 *  @return A std::unique_ptr to an arc::gen3::image::CStats object.
 			 *  @throws std::runtime_error
 			 */
-			static std::unique_ptr<arc::gen3::image::CStats> getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			static std::unique_ptr<arc::gen3::image::CStats> getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the statistics of every channel ( amplifier ) region of an image in a single pass over the
+			 *  image. The channel regions may be in any order, but must lie within the image.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param vChannels	- The channel regions.
+			 *  @param pStats		- Array of vChannels.size() statistics to fill, one per channel.
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void getChannelStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vChannels,
+										 arc::gen3::image::CStats* pStats, const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the statistics of every channel ( amplifier ) region of an image in a single pass and adds
+			 *  them to the running averages of a sequence of images. The per-channel averages are updated
+			 *  incrementally and uiImageCount is incremented, so the averages are available after every image.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param vChannels	- The channel regions. Must hold cAvgStats.uiChannelCount regions.
+			 *  @param cAvgStats	- The running averages to update. Zero uiImageCount to start a new sequence.
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void accumulateChannelStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vChannels,
+												arc::gen3::image::CAvgStats& cAvgStats, const std::uint32_t uiThreads = 1 );
+
+			/** Calculates many averaged row and column profiles in a single sweep over the image rows. Each image row
+			 *  is read once while it is in cache and added to every profile region that covers it; column profiles
+			 *  are summed in per-thread integer accumulators, so the sums are exact. No memory is allocated for the
+			 *  profiles themselves. Replaces repeated getRowArea() and getColArea() calls.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param vProfiles	- The profile requests. The regions may overlap.
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void getProfiles( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Profile_t>& vProfiles,
+									 const std::uint32_t uiThreads = 1 );
+
+			/** Calculates many averaged row and column profiles of an image view in a single sweep. The profile
+			 *  regions are relative to the view.
+			 *  @param tView		- The view.
+			 *  @param vProfiles	- The profile requests. The regions may overlap.
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void getProfiles( const arc::gen3::image::ImageView<const T>& tView, const std::vector<arc::gen3::image::Profile_t>& vProfiles, const std::uint32_t uiThreads = 1 );
+
+			/** Returns the channel regions of a detector read out by a regular grid of amplifiers, each reading an
+			 *  equal block of the image. Channels are listed row by row from the first image row.
+			 *  @param uiCols			- The image column size ( in pixels ).
+			 *  @param uiRows			- The image row size ( in pixels ).
+			 *  @param uiColChannels	- The number of channels across the columns. Must divide uiCols.
+			 *  @param uiRowChannels	- The number of channels across the rows. Must divide uiRows.
+			 *  @return The channel regions.
+			 *  @throws std::invalid_argument
+			 */
+			static std::vector<arc::gen3::image::Roi_t> channelGrid( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColChannels, const std::uint32_t uiRowChannels );
 
 			/** Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel count for
 			 *  each image as well as the difference mean, variance and standard deviation over the specified image buffer
 			 *  cols and rows. This is used for photon transfer curves ( PTC ). The two images MUST be the same size or the
 			 *  methods behavior is undefined as this cannot be verified using the given parameters.
-			 *  @param pBuf1	- Pointer to the first image buffer.
-			 *  @param pBuf2	- Pointer to the second image buffer.
-			 *  @param uiCol1	- The start column.
-			 *  @param uiCol2	- The end column.
-			 *  @param uiRow1	- The start row.
-			 *  @param uiRow2	- The end row.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCol1		- The start column.
+			 *  @param uiCol2		- The end column.
+			 *  @param uiRow1		- The start row.
+			 *  @param uiRow2		- The end row.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
 			 *  @return A std::unique_ptr to an arc::gen3::image::CDifStats object.
 			 *  @throws std::runtime_error
 			 */
 			static std::unique_ptr<arc::gen3::image::CDifStats>
-			getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+						  const std::uint32_t uiThreads = 1 );
 
 			/** Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel count for
 			 *  each image as well as the difference mean, variance and standard deviation for the entire image. This is used
 			 *  for photon transfer curves ( PTC ). The two images MUST be the same size or the methods behavior is undefined
 			 *  as this cannot be verified using the given parameters.
-			 *  @param pBuf1	- Pointer to the first image buffer.
-			 *  @param pBuf2	- Pointer to the second image buffer.
-			 *  @param uiCols	- The image column size ( in pixels ).
-			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
 			 *  @return A std::unique_ptr to an arc::gen3::image::CDifStats object.
 			 *  @throws std::runtime_error
 			 */
-			static std::unique_ptr<arc::gen3::image::CDifStats> getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows );
+			static std::unique_ptr<arc::gen3::image::CDifStats> getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the statistics of both images and of their difference ( image 1 - image 2 ) for every region
+			 *  in one fused pass that reads each pixel of both images once. This is the kernel for photon transfer
+			 *  curves ( PTC ); see CArcPtc. The two images MUST be the same size.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param vRois		- The regions.
+			 *  @param pStats		- Array of vRois.size() statistics to fill, one per region.
+			 *  @param uiThreads	- The number of threads to split the rows over. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vRois,
+									  arc::gen3::image::CDifStats* pStats, const std::uint32_t uiThreads = 1 );
 
 			/** Calculates the histogram over the specified image buffer columns and rows.
 			 *  @param pBuf		- Pointer to the image buffer.
@@ -438,6 +1000,7 @@ namespace arc
 			 *  @param uiRows	- The image row size ( in pixels ).
 			 *  @param uiCount	- The element count of the returned array.
 			 *  @return A std::unique_ptr to an array of unsigned integers. The size of the array depends on the image data type.
+			 *          32-bit values above the last bin are counted in the last bin; see CArcHistogram for configurable ranges.
 			 *  @throws std::runtime_error
 			 */
 			static std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
@@ -453,6 +1016,63 @@ namespace arc
 			 */
 			static std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>> histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount );
 
+			/** Detects hot pixels and cosmic rays. Each pixel is compared with the median of its 3 x 3 neighborhood,
+			 *  and is masked if it exceeds the median by more than gThreshold times the image noise. The noise is
+			 *  estimated from the median absolute deviation of the pixel to median residuals over a sample of rows,
+			 *  with a floor of one count. The median filter is a branch free sorting network applied across each
+			 *  row, which the compiler vectorizes; rows are split over threads.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param cMask		- The mask. Resized to the image and overwritten.
+			 *  @param gThreshold	- The detection threshold, in standard deviations ( default = 5 ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @return The number of masked pixels.
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint64_t detectDefects( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::image::CBitMask& cMask,
+												const double gThreshold = 5.0, const std::uint32_t uiThreads = 1 );
+
+			/** Replaces every masked pixel with the rounded mean of the unmasked pixels in its 3 x 3 neighborhood, or
+			 *  in its 5 x 5 neighborhood if the 3 x 3 neighborhood is fully masked. Pixels with no unmasked pixel in
+			 *  either neighborhood are left unchanged.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param cMask		- The mask. Must match the image size.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @return The number of pixels replaced.
+			 *  @throws std::invalid_argument
+			 */
+			static std::uint64_t interpolateMasked( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask,
+													const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the image statistics over the unmasked pixels in a single pass; see getStats(). Each row
+			 *  is split into the runs of unmasked pixels between its masked pixels, and the runs go through the
+			 *  same kernel as getStats(), so a sparse mask costs almost nothing.
+			 *  @param pBuf			- Pointer to the image data buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param cMask		- The mask. Must match the image size.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @return A std::unique_ptr to an arc::gen3::image::CStats object.
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<arc::gen3::image::CStats> getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask,
+																	   const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the histogram over the unmasked pixels of the entire image buffer; see histogram().
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cMask	- The mask. Must match the image size.
+			 *  @param uiCount	- The element count of the returned array.
+			 *  @return A std::unique_ptr to an array of unsigned integers. The size of the array depends on the image data type.
+			 *  @throws std::invalid_argument
+			 */
+			static std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask, std::uint32_t& uiCount );
+
 			/** Adds two buffers together pixel by pixel.
 			 *  @param pBuf1	- Pointer to the first image buffer.
 			 *  @param pBuf2	- Pointer to the second image buffer.
@@ -511,11 +1131,319 @@ namespace arc
 			 */
 			static void copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize );
 
+			/** Adds two image buffers pixel by pixel into a caller buffer. The destination may be either source
+			 *  buffer, so the kernel can operate in place. No memory is allocated.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void add( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+							 const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Adds two image buffers pixel by pixel into a caller 64-bit buffer. The sum is exact.
+			 *  @param pDstBuf		- Pointer to the destination buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void add( std::uint64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Subtracts two image buffers pixel by pixel into a caller buffer. Buffer two is subtracted from buffer
+			 *  one. The destination may be either source buffer. Saturated results below zero are zero.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void subtract( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								  const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Subtracts two image buffers pixel by pixel into a caller signed 64-bit buffer. The difference is exact.
+			 *  @param pDstBuf		- Pointer to the destination buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void subtract( std::int64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies two image buffers pixel by pixel into a caller buffer. The destination may be either source
+			 *  buffer.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void multiply( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								  const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies two image buffers pixel by pixel into a caller 64-bit buffer. The product is exact.
+			 *  @param pDstBuf		- Pointer to the destination buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void multiply( std::uint64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Divides two image buffers pixel by pixel into a caller buffer. Buffer one is divided by buffer two and
+			 *  the integer quotient is stored. Pixels with a zero divisor are set to zero. The destination may be
+			 *  either source buffer.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void divide( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Divides two image buffers pixel by pixel into a caller floating point buffer, e.g. to flat field an
+			 *  image. Pixels with a zero divisor are set to zero.
+			 *  @param pDstBuf		- Pointer to the destination buffer.
+			 *  @param pBuf1		- Pointer to the first image buffer.
+			 *  @param pBuf2		- Pointer to the second image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void divide( float* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies every pixel of an image buffer by a constant into a caller buffer. Results are rounded to
+			 *  the nearest integer and clamped to the data type range. The destination may be the source buffer.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pSrcBuf		- Pointer to the source image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param gFactor		- The scale factor.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void scale( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const double gFactor, const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies every pixel of an image buffer by a constant into a caller floating point buffer.
+			 *  @param pDstBuf		- Pointer to the destination buffer.
+			 *  @param pSrcBuf		- Pointer to the source image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param gFactor		- The scale factor.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void scale( float* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const double gFactor, const std::uint32_t uiThreads = 1 );
+
+			/** Adds a signed constant to every pixel of an image buffer into a caller buffer, e.g. to remove or
+			 *  restore a pedestal. The destination may be the source buffer.
+			 *  @param pDstBuf		- Pointer to the destination image buffer.
+			 *  @param pSrcBuf		- Pointer to the source image buffer.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiRows		- The image row size ( in pixels ).
+			 *  @param iOffset		- The offset.
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void offset( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::int64_t iOffset,
+								const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Fills an image view with the specified value.
+			 *  @param tView	- The view.
+			 *  @param uiValue	- The value to fill the view with.
+			 *  @throws std::invalid_argument
+			 */
+			static void fill( const arc::gen3::image::ImageView<T>& tView, const T uiValue );
+
+			/** Copies an image view to another view of the same extent, e.g. to a contiguous buffer to materialize a
+			 *  region. The views must not overlap.
+			 *  @param tDst - The destination view.
+			 *  @param tSrc - The source view.
+			 *  @throws std::invalid_argument
+			 */
+			static void copy( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc );
+
+			/** Calculates the statistics of an image view in a single pass; see getStats(). No memory is allocated.
+			 *  @param tView		- The view.
+			 *  @param cStats		- The statistics to fill.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void getStats( const arc::gen3::image::ImageView<const T>& tView, arc::gen3::image::CStats& cStats, const std::uint32_t uiThreads = 1 );
+
+			/** Calculates the histogram of an image view into a caller buffer; see histogram().
+			 *  @param tView	- The view.
+			 *  @param pHist	- Pointer to maxTVal() bins.
+			 *  @throws std::invalid_argument
+			 */
+			static void histogram( const arc::gen3::image::ImageView<const T>& tView, std::uint32_t* pHist );
+
+			/** Adds two image views pixel by pixel into a destination view; see add(). The views must have the same
+			 *  extent. The destination may be either source view.
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc1		- The first source view.
+			 *  @param tSrc2		- The second source view.
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void add( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+							 const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Subtracts two image views pixel by pixel into a destination view; see subtract(). The views must have
+			 *  the same extent. The destination may be either source view.
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc1		- The first source view.
+			 *  @param tSrc2		- The second source view, which is subtracted from the first.
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void subtract( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+								  const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies two image views pixel by pixel into a destination view; see multiply(). The views must have
+			 *  the same extent. The destination may be either source view.
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc1		- The first source view.
+			 *  @param tSrc2		- The second source view.
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void multiply( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+								  const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Divides two image views pixel by pixel into a destination view; see divide(). The views must have the
+			 *  same extent. The destination may be either source view.
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc1		- The first source view.
+			 *  @param tSrc2		- The second source view, which divides the first.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void divide( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+								const std::uint32_t uiThreads = 1 );
+
+			/** Multiplies every pixel of an image view by a constant into a destination view; see scale().
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc			- The source view.
+			 *  @param gFactor		- The scale factor.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void scale( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc, const double gFactor, const std::uint32_t uiThreads = 1 );
+
+			/** Adds a signed constant to every pixel of an image view into a destination view; see offset().
+			 *  @param tDst			- The destination view.
+			 *  @param tSrc			- The source view.
+			 *  @param iOffset		- The offset.
+			 *  @param eMode		- The overflow handling ( default = SATURATE ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 */
+			static void offset( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc, const std::int64_t iOffset,
+								const arc::gen3::image::e_ArithMode eMode = arc::gen3::image::e_ArithMode::SATURATE, const std::uint32_t uiThreads = 1 );
+
+			/** Bins an image view in uiFactor x uiFactor blocks into a caller buffer of exact 64-bit block sums, e.g.
+			 *  for a quicklook preview; unlike controller binning the science data is unchanged. The output is
+			 *  ( cols / uiFactor ) x ( rows / uiFactor ) values; a partial block at the right or bottom edge is
+			 *  dropped. The rows of each block are summed into a row of wide accumulators, a contiguous loop the
+			 *  compiler vectorizes, and the columns are then reduced.
+			 *  @param tSrc			- The source view.
+			 *  @param uiFactor		- The block size, 1 to 256.
+			 *  @param pDstBuf		- Pointer to the output buffer.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void bin( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, std::uint64_t* pDstBuf, const std::uint32_t uiThreads = 1 );
+
+			/** Bins an image view in uiFactor x uiFactor blocks into a caller image buffer. See the 64-bit bin().
+			 *  @param tSrc			- The source view.
+			 *  @param uiFactor		- The block size, 1 to 256.
+			 *  @param pDstBuf		- Pointer to the output buffer of ( cols / uiFactor ) x ( rows / uiFactor ) pixels.
+			 *  @param eMode		- The output mode ( default = MEAN ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void bin( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, T* pDstBuf,
+							 const arc::gen3::image::e_BinMode eMode = arc::gen3::image::e_BinMode::MEAN, const std::uint32_t uiThreads = 1 );
+
+			/** Decimates an image view, keeping the first pixel of every uiFactor x uiFactor block.
+			 *  @param tSrc			- The source view.
+			 *  @param uiFactor		- The block size, 1 to 256.
+			 *  @param pDstBuf		- Pointer to the output buffer of ( cols / uiFactor ) x ( rows / uiFactor ) pixels.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void decimate( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, T* pDstBuf, const std::uint32_t uiThreads = 1 );
+
+			/** Returns the number of threads used for a requested thread count.
+			 *  @param uiThreads - The requested number of threads. Zero requests one thread per thread of the library
+			 *					   executor, CArcThreadPool::executor().
+			 *  @return The number of threads.
+			 *  @throws std::runtime_error if the shared pool cannot be started.
+			 */
+			static std::uint32_t threadCount( const std::uint32_t uiThreads );
+
+			/** Splits a row range into at most threadCount( uiThreads ) contiguous blocks and calls a function for
+			 *  each block as a task on the library executor, CArcThreadPool::executor(). The calling thread
+			 *  processes the first block. The first exception thrown by a block is rethrown on the calling thread.
+			 *  @param uiRow1		- The start row.
+			 *  @param uiRow2		- One past the end row.
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread.
+			 *  @param fnBlock		- The block function, called as fnBlock( uiBlock, uiFirstRow, uiEndRow ).
+			 *  @return The number of blocks.
+			 *  @throws The first exception thrown by a block.
+			 */
+			static std::uint32_t forEachRowBlock( const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiThreads,
+												  const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBlock );
+
 			/** Determines the maximum value for a specific data type. Example, for std::uint16_t: 2^16 = 65536.
 			 *  @return The maximum value for the data type currently in use.
 			 */
 			static std::uint32_t maxTVal( void );
 
+			/** Verifies that neither image dimension is zero.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @throws std::invalid_argument
+			 */
+			static void verifyDimensions( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Verifies that a list of regions is not empty and that every region is non-empty and lies within
+			 *  the image.
+			 *  @param vRegions	- The regions to check.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
+			 */
+			static void verifyRegions( const std::vector<arc::gen3::image::Roi_t>& vRegions, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
 		private:
 
 			/** Verifies that the specified buffer is not equal to nullptr.
@@ -524,6 +1452,25 @@ namespace arc
 			 */
 			static constexpr void verifyBuffer( const T* pBuffer );
 
+			/** Verifies the buffers and dimensions of an arithmetic kernel.
+			 *  @param pDstBuf	- Pointer to the destination buffer.
+			 *  @param pBuf1	- Pointer to the first source buffer.
+			 *  @param pBuf2	- Pointer to the second source buffer. Unary kernels pass the first source buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @throws std::runtime_error if a buffer is nullptr or a dimension is zero.
+			 */
+			static void verifyOperands( const void* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+			/** Verifies that an image view is not empty and that every other view has the same extent.
+			 *  @param tView	- The view to check.
+			 *  @param tOther1	- A view that must match tView.
+			 *  @param tOther2	- A view that must match tView.
+			 *  @throws std::invalid_argument
+			 */
+			static void verifyViews( const arc::gen3::image::ImageView<const T>& tView, const arc::gen3::image::ImageView<const T>& tOther1,
+									 const arc::gen3::image::ImageView<const T>& tOther2 );
+
 			/** Verifies that the specified row value is less than the total number of rows.
 			 *  @param row  - The row to check.
 			 *  @param rows	- The total row length ( i.e. image row count ).
@@ -557,51 +1504,51 @@ namespace arc
 			 */
 			static constexpr void verifyRangeOrder( const std::uint32_t uiValue1, const std::uint32_t uiValue2 );
 
-			/** Draws a semi-circle on the specified buffer.
-			 *  @param uiXCenter	- x position of circle center point.
-			 *  @param uiYCenter	- y position of circle center point.
-			 *  @param uiRadius		- The radius of the circle.
-			 *  @param gStartAngle	- The start angle of the semi-circle.
-			 *  @param gEndAngle	- The end angle of the semi-circle.
-			 *  @param uiCols		- The image column size ( in pixels ).
-			 *  @param pBuf			- Pointer to the image data buffer.
-			 *  @param uiColor		- Color to draw circle ( default = 0 ).
+			/** Verifies an image buffer and that a mask matches the image size.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCols	- The image column size ( in pixels ).
+			 *  @param uiRows	- The image row size ( in pixels ).
+			 *  @param cMask	- The mask.
 			 *  @throws std::invalid_argument
 			 */
-			static void drawSemiCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter, const std::uint32_t uiRadius, const double gStartAngle,
-										const double gEndAngle, const std::uint32_t uiCols, T* pBuf, const T uiColor = 0 );
+			static void verifyMask( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask );
 
-			/** Draws a filled circle on the specified buffer.
-			 *  @param uiXCenter	- x position of circle center point.
-			 *  @param uiYCenter	- y position of circle center point.
-			 *  @param uiRadius		- The radius of the circle.
-			 *  @param uiCols		- The image column size ( in pixels ).
-			 *  @param pBuf			- Pointer to the image data buffer.
-			 *  @param uiColor		- Color to draw circle ( default = 0 ).
+			/** Verifies the source view, block size and output buffer of a binning kernel.
+			 *  @param tSrc		- The source view.
+			 *  @param uiFactor	- The block size.
+			 *  @param pDstBuf	- Pointer to the output buffer.
 			 *  @throws std::invalid_argument
+			 *  @throws std::out_of_range
 			 */
-			static void drawFillCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter, const std::uint32_t uiRadius, const std::uint32_t uiCols, T* pBuf, const T uiColor = 0 );
+			static void verifyBinning( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, const void* pDstBuf );
 
-			/** Draws a gradient filled circle on the specified buffer.
-			 *  @param uiRadius		- The radius of the circle.
-			 *  @param uiCols		- The image column size ( in pixels ).
-			 *  @param uiRows		- The image row size ( in pixels ).
-			 *  @param pBuf			- Pointer to the image data buffer.
-			 *  @param uiColor		- Color to draw circle ( default = 0 ).
-			 *  @throws std::invalid_argument
+			/** Zeroes a maxTVal() bin histogram and counts the pixels of the column range [ uiCol1, uiColEnd ) and
+			 *  row range [ uiRow1, uiRowEnd ) into it. Values above the last bin are counted in the last bin. The
+			 *  parameters are not verified.
+			 *  @param pHist	- The histogram, maxTVal() bins.
+			 *  @param pBuf		- Pointer to the image buffer.
+			 *  @param uiCol1	- The start column.
+			 *  @param uiColEnd	- One past the end column.
+			 *  @param uiRow1	- The start row.
+			 *  @param uiRowEnd	- One past the end row.
+			 *  @param uiCols	- The image column size ( in pixels ).
 			 */
-			static void drawGradientFillCircle( const std::uint32_t uiRadius, const std::uint32_t uiCols, const std::uint32_t uiRows, T* pBuf );
+			static void fillHistogram( std::uint32_t* pHist, const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiColEnd,
+									   const std::uint32_t uiRow1, const std::uint32_t uiRowEnd, const std::uint32_t uiCols );
 
-			/** Draws a gradient filled circle on the specified buffer.
-			 *  @param uiXCenter	- x position of circle center point.
-			 *  @param uiYCenter	- y position of circle center point.
-			 *  @param uiRadius		- The radius of the circle.
-			 *  @param uiCols		- The image column size ( in pixels ).
+			/** Single pass statistics kernel over the column range [ uiCol1, uiColEnd ) and row range
+			 *  [ uiRow1, uiRowEnd ). The parameters are not verified.
+			 *  @param cStats		- The statistics to fill.
 			 *  @param pBuf			- Pointer to the image data buffer.
-			 *  @param uiColor		- Color to draw circle ( default = 0 ).
-			 *  @throws std::invalid_argument
+			 *  @param uiCol1		- The start column.
+			 *  @param uiColEnd		- One past the end column.
+			 *  @param uiRow1		- The start row.
+			 *  @param uiRowEnd		- One past the end row.
+			 *  @param uiCols		- The image column size ( in pixels ).
+			 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread.
 			 */
-			static void drawCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter, const std::uint32_t uiRadius, const std::uint32_t uiCols, T* pBuf, const T uiColor = 0 );
+			static void calcStats( arc::gen3::image::CStats& cStats, const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiColEnd,
+								   const std::uint32_t uiRow1, const std::uint32_t uiRowEnd, const std::uint32_t uiCols, const std::uint32_t uiThreads );
 
 			/** version() text holder */
 			static const std::string m_sVersion;
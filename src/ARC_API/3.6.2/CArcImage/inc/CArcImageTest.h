@@ -0,0 +1,262 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcImageTest.h  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC image processing verification interface.                                     |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcImageTest.h */
+
+#ifndef _GEN3_CARCIMAGETEST_H_
+#define _GEN3_CARCIMAGETEST_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <string>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @class CArcImageTest
+		 *  Image processing correctness checker. Checks the CArcImage operations against brute force calculations
+		 *  on pseudo random frames, at several thread counts. The brute force results are computed pixel by pixel
+		 *  in double precision, independent of the optimized kernels, so that optimization work can be checked
+		 *  against them. Each method throws at the first mismatch.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcHistogram
+		 *  @see arc::gen3::CArcPtc
+		 *  @see arc::gen3::CArcStack
+		 *  @see arc::gen3::CArcCombine
+		 *  @see arc::gen3::CArcCalibrate
+		 *  @see arc::gen3::CArcDisplayScale
+		 *  @see arc::gen3::CArcCentroid
+		 *  @see arc::gen3::CArcFrameVerifier
+		 *  @see arc::gen3::CArcThreadPool
+		 *  @see arc::gen3::CArcRampFit
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcImageTest : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Verifies CArcImage::getStats() over the whole image.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcImage::getChannelStats() and CArcImage::accumulateChannelStats() over a channel grid
+				 *  and over overlapping channels of different sizes, accumulated over three frames.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyChannelStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcImage::histogram(), the exact and binned CArcHistogram modes and the exact
+				 *  CArcHistogram::percentile().
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyHistogram( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcImage::getDiffStats() and the CArcPtc table on a flat field pair with a known mean and
+				 *  variance, and on a pseudo random pair against brute force statistics.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyPtc( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the caller buffer CArcImage::add(), subtract(), multiply(), divide(), scale() and offset()
+				 *  kernels, including saturation at zero and at the data type maximum, wrapping, and in place use.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyArithmetic( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the CArcStack sum, mean and variance maps against brute force after one, two and five
+				 *  frames and after clear().
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyStack( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcCombine median and sigma clipped combines against brute force for odd and even frame
+				 *  counts, from memory and through a reader under a memory limit that forces row tiling.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyCombine( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcCalibrate against brute force for every overscan fit with and without bias, scaled
+				 *  dark and normalized or unnormalized flat masters, in float and integer output.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyCalibrate( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the ImageView overloads of getStats(), histogram(), copy(), fill() and the arithmetic on
+				 *  region, row and column views against brute force over the parent image.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyViews( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the row and column profiles of CArcImage::getProfiles() over the whole image, a region
+				 *  and a single pixel, for an image buffer and an image view.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyProfiles( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the masked CArcImage::getStats() and CArcImage::histogram() against the unmasked pixels.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyMaskedStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies that CArcImage::detectDefects() masks exactly the hot pixels of a flat image, and checks
+				 *  CArcImage::interpolateMasked() against brute force neighborhood means.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyDefects( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the 64-bit, sum and mean outputs of CArcImage::bin() for the whole image and a region.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiFactor		- The block size. Must not exceed either image dimension.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyBin( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiFactor, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the CArcDisplayScale percentile and zscale limits, the previews of every stretch and the
+				 *  lookup table caching reported by tableBuilds().
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyDisplayScale( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies CArcCentroid source finding, measurement and tracking on synthetic gaussian stars.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyCentroid( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Verifies that CArcImage::checkRamp() accepts the output of CArcImage::fillWithRamp(), including a
+				 *  view that starts part way through the ramp, and reports a single corrupted pixel. A short ramp and
+				 *  CArcImage::checkConstant() are checked on a strided view with two corrupted pixels.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyRamp( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the CArcFrameVerifier report for ramp and constant streams pushed in pieces that straddle
+				 *  rows and frames.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyFrameVerifier( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Verifies the fill, gradient, smiley face and noise pattern generators, including the noise model
+				 *  statistics, seed determinism and clamping to the data type range.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyGenerators( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies the block partitioning, exception propagation and block ordered reduction of the thread
+				 *  pool, and that CArcImage::threadCount() and CArcImage::forEachRowBlock() follow the executor set
+				 *  with CArcThreadPool::setExecutor().
+				 *  @throws std::runtime_error describing the first failure.
+				 */
+				static void verifyThreads( void );
+
+				/** Verifies the CArcRampFit slopes, intercepts and quality flags against a direct least-squares fit of
+				 *  each pixel's reads below the saturation level. Some pixels saturate part way up the ramp. A second
+				 *  ramp with jump detection checks the segment weighted slopes of pixels that step up part way.
+				 *  @param uiCols		- The number of image columns.
+				 *  @param uiRows		- The number of image rows.
+				 *  @param uiReads		- The number of reads.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error describing the first mismatch.
+				 */
+				static void verifyRampFit( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiReads, const std::uint32_t uiThreads = 1 );
+
+				/** Verifies that the operations reject images with zero rows or columns and that subtractHalves()
+				 *  leaves an empty image untouched.
+				 *  @throws std::runtime_error naming the first operation that accepts an empty image.
+				 */
+				static void verifyEmpty( void );
+
+				/** Runs every check over a grid of geometries, including single row and single column images, at
+				 *  several thread counts.
+				 *  @throws std::runtime_error describing the first failure.
+				 */
+				static void verifyAll( void );
+
+			private:
+
+				/** Compares two statistics. The counts, minimum and maximum must match exactly, the mean, variance
+				 *  and standard deviation to a relative error of 1e-9.
+				 *  @param cFound		- The statistics to check.
+				 *  @param cExpected	- The brute force statistics.
+				 *  @param sWhat		- Description of the tested method, used in the error message.
+				 *  @param uiCols		- The number of image columns, used in the error message.
+				 *  @param uiRows		- The number of image rows, used in the error message.
+				 *  @throws std::runtime_error describing the first mismatched value.
+				 */
+				static void compareStats( const arc::gen3::image::CStats& cFound, const arc::gen3::image::CStats& cExpected, const std::string& sWhat,
+										  const std::uint32_t uiCols, const std::uint32_t uiRows );
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCIMAGETEST_H_
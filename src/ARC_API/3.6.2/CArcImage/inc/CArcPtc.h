@@ -0,0 +1,177 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcPtc.h  ( Gen3 )                                                                                      |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC photon transfer curve ( PTC ) engine.                                        |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcPtc.h */
+
+#ifndef _GEN3_CARCPTC_H_
+#define _GEN3_CARCPTC_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** @struct PtcPoint_t
+			 *  One photon transfer curve point: the statistics of one region of one flat field pair. The signal is
+			 *  the mean of the two frame means less the bias level, and the variance is half the variance of the
+			 *  pair difference, which removes fixed pattern noise.
+			 */
+			struct GEN3_CARCIMAGE_API PtcPoint_t
+			{
+				std::uint32_t	uiPair;			/**< Pair index, in the order the pairs were added */
+				std::uint32_t	uiRoi;			/**< Region index */
+				double			gExposure;		/**< Pair exposure time, as given by the caller */
+				double			gSignal;		/**< Mean signal less bias ( ADU ) */
+				double			gVariance;		/**< Shot and read noise variance, half the difference variance ( ADU^2 ) */
+				double			gMean1;			/**< Frame 1 mean ( ADU ) */
+				double			gMean2;			/**< Frame 2 mean ( ADU ) */
+				double			gDiffMean;		/**< Absolute mean of the pair difference ( ADU ) */
+				double			gPixels;		/**< Number of pixels in the region */
+				double			gSaturated;		/**< Number of saturated pixels in both frames. Points with saturated pixels should not be fitted */
+			};
+
+		}	// end image namespace
+
+
+		/** @class CArcPtc
+		 *  Photon transfer curve engine. For every flat field pair the engine evaluates a set of regions in one
+		 *  fused pass over both frames ( see CArcImage::getDiffStats() ), and appends one signal and variance
+		 *  point per region to a table that is ready for fitting, e.g. the conversion gain is the slope of
+		 *  signal against variance. Pairs are normally added in order of increasing exposure.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcPtc : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  Creates a PTC engine that evaluates the whole image as a single region.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcPtc( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcPtc( void );
+
+				/** Sets the regions evaluated for every pair.
+				 *  @param vRois - The regions.
+				 *  @throws std::invalid_argument
+				 *  @throws std::out_of_range
+				 */
+				void setRois( const std::vector<arc::gen3::image::Roi_t>& vRois );
+
+				/** Sets the regions to a grid over the image. The image is divided into uiColCount x uiRowCount
+				 *  equal cells and a region of uiSize x uiSize pixels is centered in each cell. Regions are listed
+				 *  row by row from the first image row.
+				 *  @param uiColCount	- The number of cells across the columns.
+				 *  @param uiRowCount	- The number of cells across the rows.
+				 *  @param uiSize		- The region size ( in pixels ). Zero uses the whole cell ( default = 0 ).
+				 *  @throws std::invalid_argument if the grid or region does not fit the image.
+				 */
+				void setGrid( const std::uint32_t uiColCount, const std::uint32_t uiRowCount, const std::uint32_t uiSize = 0 );
+
+				/** Returns the regions evaluated for every pair.
+				 *  @return The regions.
+				 */
+				const std::vector<arc::gen3::image::Roi_t>& rois( void ) const noexcept;
+
+				/** Sets the bias level subtracted from the signal of every point added afterwards.
+				 *  @param gBias - The bias level ( ADU ).
+				 */
+				void setBias( const double gBias ) noexcept;
+
+				/** Sets the number of threads each pair is split over.
+				 *  @param uiThreads - The number of threads. Zero uses one per hardware thread.
+				 */
+				void setThreads( const std::uint32_t uiThreads ) noexcept;
+
+				/** Evaluates one flat field pair and appends a point per region to the table.
+				 *  @param pBuf1		- Pointer to the first image buffer.
+				 *  @param pBuf2		- Pointer to the second image buffer.
+				 *  @param gExposure	- The pair exposure time, copied to the table.
+				 *  @throws std::invalid_argument
+				 */
+				void addPair( const T* pBuf1, const T* pBuf2, const double gExposure );
+
+				/** Evaluates a sequence of flat field pairs, e.g. a PTC exposure series, and appends a point per pair
+				 *  and region to the table.
+				 *  @param vFrames		- The frames; frames 2k and 2k + 1 form pair k.
+				 *  @param vExposures	- The exposure time of each pair.
+				 *  @throws std::invalid_argument if the frame and exposure counts do not match.
+				 */
+				void addPairs( const std::vector<const T*>& vFrames, const std::vector<double>& vExposures );
+
+				/** Returns the table of points, ordered by pair and then region.
+				 *  @return The table of points.
+				 */
+				const std::vector<arc::gen3::image::PtcPoint_t>& table( void ) const noexcept;
+
+				/** Returns the table as text with one whitespace separated line per point and a '#' header line,
+				 *  suitable for plotting and fitting tools.
+				 *  @return The table text.
+				 */
+				std::string toString( void ) const;
+
+				/** Removes all points from the table.
+				 */
+				void clear( void ) noexcept;
+
+			private:
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** Number of threads per pair */
+				std::uint32_t m_uiThreads;
+
+				/** Number of pairs added */
+				std::uint32_t m_uiPairs;
+
+				/** Bias level */
+				double m_gBias;
+
+				/** Regions evaluated for every pair */
+				std::vector<arc::gen3::image::Roi_t> m_vRois;
+
+				/** Per-region statistics of the current pair, reused across pairs */
+				std::vector<arc::gen3::image::CDifStats> m_vStats;
+
+				/** Table of points */
+				std::vector<arc::gen3::image::PtcPoint_t> m_vTable;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCPTC_H_
@@ -0,0 +1,191 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcRampFit.h  ( Gen3 )                                                                                  |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC streaming up-the-ramp slope fitter.                                          |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcRampFit.h */
+
+#ifndef _GEN3_CARCRAMPFIT_H_
+#define _GEN3_CARCRAMPFIT_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+		namespace image
+		{
+
+			/** Up-the-ramp quality flags. See CArcRampFit::fit(). */
+			constexpr std::uint8_t RAMP_SATURATED	= static_cast<std::uint8_t>( 0x1 );		// A read reached the saturation level
+			constexpr std::uint8_t RAMP_JUMP		= static_cast<std::uint8_t>( 0x2 );		// At least one jump was detected
+			constexpr std::uint8_t RAMP_NO_SLOPE	= static_cast<std::uint8_t>( 0x4 );		// Fewer than two usable reads in every segment
+
+		}	// end image namespace
+
+
+		/** @class CArcRampFit
+		 *  Streaming up-the-ramp slope fitter for non-destructive IR readouts, e.g. each read of a continuous()
+		 *  sequence on a quadIR or HAWAII-RG array. Reads are added one at a time and each pixel accumulates the
+		 *  least-squares sums of its current ramp segment, so memory is a few accumulator planes regardless of the
+		 *  number of reads. A pixel stops accumulating at its first read at or above the saturation level. With jump
+		 *  detection enabled, a read whose difference from the previous read departs from the segment's mean
+		 *  difference by more than the threshold ends the segment, e.g. on a cosmic ray hit, and a new segment
+		 *  starts at that read. The slope of a pixel is the average of its segment slopes, weighted by
+		 *  n ( n^2 - 1 ) for a segment of n reads, the inverse of the read noise limited slope variance.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcRampFit : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Maximum number of reads per ramp */
+				static constexpr std::uint32_t READS_MAX = 65535;
+
+				/** Constructor
+				 *  Creates a fitter with a one second read interval, saturation at the data type maximum and jump
+				 *  detection disabled.
+				 *  @param uiCols - The image column size ( in pixels ).
+				 *  @param uiRows - The image row size ( in pixels ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcRampFit( const std::uint32_t uiCols, const std::uint32_t uiRows );
+
+				/** Destructor
+				 */
+				virtual ~CArcRampFit( void );
+
+				/** Sets the time between reads; slopes are given per this time unit.
+				 *  @param gSeconds - The read interval ( default = 1 ).
+				 *  @throws std::invalid_argument if the interval is not positive.
+				 */
+				void setReadTime( const double gSeconds );
+
+				/** Sets the saturation level.
+				 *  @param uiLevel - Reads at or above this value are saturated ( default = data type maximum ).
+				 */
+				void setSaturation( const T uiLevel ) noexcept;
+
+				/** Enables or disables jump detection. A read is a jump if its difference from the previous read
+				 *  departs from the segment's mean difference by more than gSigma standard deviations of that
+				 *  departure, from the read noise and the shot noise of the mean difference. Jumps are detected from
+				 *  the third read of a segment.
+				 *  @param gSigma		- The threshold. Zero disables jump detection.
+				 *  @param gReadNoise	- The read noise of a single read ( ADU rms ).
+				 *  @param gGain		- The gain ( electrons / ADU ) ( default = 1 ).
+				 *  @throws std::invalid_argument if a parameter is negative or the gain is zero.
+				 */
+				void setJumpDetection( const double gSigma, const double gReadNoise, const double gGain = 1.0 );
+
+				/** Adds the next read of the ramp.
+				 *  @param pBuf			- Pointer to the image buffer. Must match the fitter dimensions.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument if pBuf is nullptr.
+				 *  @throws std::length_error if READS_MAX reads have been added.
+				 */
+				void add( const T* pBuf, const std::uint32_t uiThreads = 1 );
+
+				/** Returns the number of reads added.
+				 *  @return The number of reads.
+				 */
+				std::uint32_t count( void ) const noexcept;
+
+				/** Writes the fit of the reads added so far. May be called at any point of the ramp.
+				 *  @param pSlope		- Pointer to a buffer of cols x rows slopes ( ADU per read time ). Pixels with
+				 *						  the RAMP_NO_SLOPE flag are zero.
+				 *  @param pIntercept	- Pointer to a buffer of cols x rows intercepts; the fitted value at the first
+				 *						  read ( ADU ), from the first segment. May be nullptr ( default = nullptr ).
+				 *  @param pQuality		- Pointer to a buffer of cols x rows quality flags, image::RAMP_*. May be
+				 *						  nullptr ( default = nullptr ).
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::invalid_argument if pSlope is nullptr.
+				 *  @throws std::runtime_error if no reads have been added.
+				 */
+				void fit( float* pSlope, float* pIntercept = nullptr, std::uint8_t* pQuality = nullptr, const std::uint32_t uiThreads = 1 ) const;
+
+				/** Starts a new ramp. The accumulators are kept for reuse.
+				 */
+				void clear( void ) noexcept;
+
+				/** Returns the accumulator memory held by the fitter.
+				 *  @return The accumulator memory in bytes.
+				 */
+				std::uint64_t memoryBytes( void ) const noexcept;
+
+			private:
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** Number of reads added */
+				std::uint32_t m_uiReads;
+
+				/** Read interval ( seconds ) */
+				double m_gReadTime;
+
+				/** Saturation level */
+				T m_uiSaturation;
+
+				/** Jump threshold ( standard deviations ); zero if disabled */
+				double m_gJumpSigma;
+
+				/** Read noise ( ADU rms ) */
+				double m_gReadNoise;
+
+				/** Gain ( electrons / ADU ) */
+				double m_gGain;
+
+				/** First read of the current segment */
+				std::vector<T> m_vRef;
+
+				/** Previous read */
+				std::vector<T> m_vPrev;
+
+				/** Number of reads in the current segment */
+				std::vector<std::uint16_t> m_vCount;
+
+				/** Current segment sum of ( read - first read ) */
+				std::vector<double> m_vSumY;
+
+				/** Current segment sum of segment read index x ( read - first read ) */
+				std::vector<double> m_vSumKY;
+
+				/** Weighted sum of the slopes of the ended segments */
+				std::vector<float> m_vSlopeSum;
+
+				/** Sum of the weights of the ended segments */
+				std::vector<float> m_vWeightSum;
+
+				/** Intercept of the first segment, once ended */
+				std::vector<float> m_vIntercept;
+
+				/** Quality flags */
+				std::vector<std::uint8_t> m_vQuality;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCRAMPFIT_H_
@@ -0,0 +1,144 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcStack.h  ( Gen3 )                                                                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file defines the ARC streaming frame stacker.                                                     |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+/**< @file CArcStack.h */
+
+#ifndef _GEN3_CARCSTACK_H_
+#define _GEN3_CARCSTACK_H_
+
+#ifdef _WINDOWS
+#pragma warning( disable: 4251 )
+#endif
+
+#include <cstdint>
+#include <vector>
+
+#include <CArcImageDllMain.h>
+#include <CArcImage.h>
+#include <CArcBase.h>
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		/** @class CArcStack
+		 *  Streaming frame stacker, e.g. for building master bias, dark and flat frames. Frames are added one at a
+		 *  time, typically straight from the device image buffer after each exposure, and are accumulated into
+		 *  per-pixel 64-bit integer sums that are exact for any practical frame count. When variance is enabled,
+		 *  the squared deviations from the first frame are also accumulated in double precision, which avoids the
+		 *  cancellation of a plain sum of squares. Memory use is fixed by the frame size and does not grow with
+		 *  the number of frames. The sum, mean and variance maps are written into caller buffers.
+		 *  @see arc::gen3::CArcImage
+		 *  @see arc::gen3::CArcBase
+		 */
+		template <typename T = arc::gen3::image::BPP_16>
+		class GEN3_CARCIMAGE_API CArcStack : public arc::gen3::CArcBase
+		{
+			public:
+
+				/** Constructor
+				 *  Allocates the accumulators for frames of the specified size.
+				 *  @param uiCols		- The image column size ( in pixels ).
+				 *  @param uiRows		- The image row size ( in pixels ).
+				 *  @param bVariance	- true to accumulate the per-pixel variance ( default = true ).
+				 *  @throws std::invalid_argument if either dimension is zero.
+				 */
+				CArcStack( const std::uint32_t uiCols, const std::uint32_t uiRows, const bool bVariance = true );
+
+				/** Destructor
+				 */
+				virtual ~CArcStack( void );
+
+				/** Adds a frame to the stack.
+				 *  @param pBuf			- Pointer to the image buffer. Must match the stack dimensions.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error
+				 */
+				void add( const T* pBuf, const std::uint32_t uiThreads = 1 );
+
+				/** Returns the number of frames added.
+				 *  @return The number of frames.
+				 */
+				std::uint32_t count( void ) const noexcept;
+
+				/** Returns the per-pixel sum of all frames. The buffer is owned by the stack and is valid until the
+				 *  stack is destroyed. The sums are only meaningful while count() is non-zero.
+				 *  @return Pointer to cols x rows sums.
+				 */
+				const std::uint64_t* sum( void ) const noexcept;
+
+				/** Writes the per-pixel mean of all frames.
+				 *  @param pDstBuf		- Pointer to a buffer of cols x rows values.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error if no frames have been added.
+				 */
+				void mean( float* pDstBuf, const std::uint32_t uiThreads = 1 ) const;
+
+				/** Writes the per-pixel mean of all frames rounded to the nearest integer, e.g. a master bias frame
+				 *  for CArcImage::subtract().
+				 *  @param pDstBuf		- Pointer to a buffer of cols x rows pixels.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error if no frames have been added.
+				 */
+				void mean( T* pDstBuf, const std::uint32_t uiThreads = 1 ) const;
+
+				/** Writes the per-pixel sample variance ( N - 1 denominator ) of all frames. The variance is zero if
+				 *  fewer than two frames have been added.
+				 *  @param pDstBuf		- Pointer to a buffer of cols x rows values.
+				 *  @param uiThreads	- The number of threads. Zero uses one per hardware thread ( default = 1 ).
+				 *  @throws std::runtime_error if variance was not enabled or no frames have been added.
+				 */
+				void variance( float* pDstBuf, const std::uint32_t uiThreads = 1 ) const;
+
+				/** Removes all frames from the stack. The accumulators are kept for reuse.
+				 */
+				void clear( void ) noexcept;
+
+				/** Returns the accumulator memory held by the stack.
+				 *  @return The accumulator memory in bytes.
+				 */
+				std::uint64_t memoryBytes( void ) const noexcept;
+
+			private:
+
+				/** Throws if no frames have been added.
+				 *  @throws std::runtime_error
+				 */
+				void verifyCount( void ) const;
+
+				/** Image column size */
+				std::uint32_t m_uiCols;
+
+				/** Image row size */
+				std::uint32_t m_uiRows;
+
+				/** Number of frames added */
+				std::uint32_t m_uiCount;
+
+				/** true if variance is accumulated */
+				bool m_bVariance;
+
+				/** Per-pixel sums */
+				std::vector<std::uint64_t> m_vSum;
+
+				/** First frame; the reference the squared deviations are taken from */
+				std::vector<T> m_vRef;
+
+				/** Per-pixel sums of squared deviations from the first frame */
+				std::vector<double> m_vSumSq;
+		};
+
+	}		// end gen3 namespace
+}			// end arc namespace
+
+
+#endif		// _GEN3_CARCSTACK_H_
@@ -14,6 +14,7 @@
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <vector>
 
 #include <ArcImageCAPI.h>
 #include <CArcImage.h>
@@ -668,6 +669,78 @@ GEN3_CARCIMAGE_API void ArcImage_getStats( struct CStats* pStats, const void* pB
 }
 
 
+// +------------------------------------------------------------------------------------------------------------------+
+// |  ArcImage_getChannelStats                                                                                        |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  Calculates the statistics of every channel ( amplifier ) region of an image in a single pass over the image.    |
+// |                                                                                                                  |
+// |  <OUT> -> pStats			- Array of uiChannelCount CStats structures, one per channel.                         |
+// |  <IN>  -> pBuf				- The image buffer data.                                                              |
+// |  <IN>  -> uiCols			- The number of columns in the image.                                                 |
+// |  <IN>  -> uiRows			- The number of rows in the image.                                                    |
+// |  <IN>  -> pChannels		- The channel regions, four values per channel ( col1, col2, row1, row2 ).            |
+// |  <IN>  -> uiChannelCount	- The number of channels.                                                             |
+// |  <OUT> -> pStatus			- Success state; equals ARC_STATUS_OK or ARC_STATUS_ERROR.                            |
+// +------------------------------------------------------------------------------------------------------------------+
+GEN3_CARCIMAGE_API void ArcImage_getChannelStats( struct CStats* pStats, const void* pBuf, unsigned int uiCols, unsigned int uiRows,
+	const unsigned int* pChannels, unsigned int uiChannelCount, ArcStatus_t* pStatus )
+{
+	INIT_STATUS( pStatus, ARC_STATUS_OK )
+
+	try
+	{
+		if ( pStats == nullptr )
+		{
+			throwArcGen3Error( "Invalid CStats pointer parameter [ NULL ]." );
+		}
+
+		if ( pChannels == nullptr )
+		{
+			throwArcGen3Error( "Invalid channel region pointer parameter [ NULL ]." );
+		}
+
+		std::vector<arc::gen3::image::Roi_t> vChannels( uiChannelCount );
+
+		for ( unsigned int c = 0; c < uiChannelCount; c++ )
+		{
+			vChannels[ c ] = { pChannels[ 4 * c ], pChannels[ 4 * c + 1 ], pChannels[ 4 * c + 2 ], pChannels[ 4 * c + 3 ] };
+		}
+
+		std::vector<arc::gen3::image::CStats> vStats( uiChannelCount );
+
+		if ( g_uiCurrentBpp == IMAGE_BPP16 )
+		{
+			arc::gen3::CArcImage<>::getChannelStats( static_cast< const std::uint16_t* >( pBuf ), uiCols, uiRows, vChannels, vStats.data() );
+		}
+
+		else if ( g_uiCurrentBpp == IMAGE_BPP32 )
+		{
+			arc::gen3::CArcImage<arc::gen3::image::BPP_32>::getChannelStats( static_cast< const std::uint32_t* >( pBuf ), uiCols, uiRows, vChannels, vStats.data() );
+		}
+
+		else
+		{
+			throwArcGen3Error( "Invalid bits-per-pixel setting [ %d ]. Must be IMAGE_BPP16 or IMAGE_BPP32. See ArcImage_selectInstance().", g_uiCurrentBpp );
+		}
+
+		for ( unsigned int c = 0; c < uiChannelCount; c++ )
+		{
+			pStats[ c ].gSaturatedCount = vStats[ c ].gSaturatedCount;
+			pStats[ c ].gTotalPixels = vStats[ c ].gTotalPixels;
+			pStats[ c ].gVariance = vStats[ c ].gVariance;
+			pStats[ c ].gMax = vStats[ c ].gMax;
+			pStats[ c ].gMin = vStats[ c ].gMin;
+			pStats[ c ].gMean = vStats[ c ].gMean;
+			pStats[ c ].gStdDev = vStats[ c ].gStdDev;
+		}
+	}
+	catch ( const std::exception& e )
+	{
+		SET_ERROR_STATUS( pStatus, e );
+	}
+}
+
+
 // +------------------------------------------------------------------------------------------------------------------+
 // |  ArcImage_getDiffStats                                                                                           |
 // +------------------------------------------------------------------------------------------------------------------+
@@ -844,22 +917,20 @@ GEN3_CARCIMAGE_API void ArcImage_add( unsigned long long* pAdd, const void* pBuf
 
 		if ( g_uiCurrentBpp == IMAGE_BPP16 )
 		{
-			auto pImgAdd = arc::gen3::CArcImage<>::add( static_cast< const std::uint16_t* >( pBuf1 ),
-														static_cast< const std::uint16_t* >( pBuf2 ),
-														uiCols,
-														uiRows );
-
-			std::memcpy( pAdd, pImgAdd.get(), ( uiCols * uiRows * sizeof( std::uint64_t ) ) );
+			arc::gen3::CArcImage<>::add( reinterpret_cast< std::uint64_t* >( pAdd ),
+										 static_cast< const std::uint16_t* >( pBuf1 ),
+										 static_cast< const std::uint16_t* >( pBuf2 ),
+										 uiCols,
+										 uiRows );
 		}
 
 		else if ( g_uiCurrentBpp == IMAGE_BPP32 )
 		{
-			auto pImgAdd = arc::gen3::CArcImage<arc::gen3::image::BPP_32>::add( static_cast< const std::uint32_t* >( pBuf1 ),
-																				static_cast< const std::uint32_t* >( pBuf2 ),
-																				uiCols,
-																				uiRows );
-
-			std::memcpy( pAdd, pImgAdd.get(), ( uiCols * uiRows * sizeof( std::uint64_t ) ) );
+			arc::gen3::CArcImage<arc::gen3::image::BPP_32>::add( reinterpret_cast< std::uint64_t* >( pAdd ),
+																 static_cast< const std::uint32_t* >( pBuf1 ),
+																 static_cast< const std::uint32_t* >( pBuf2 ),
+																 uiCols,
+																 uiRows );
 		}
 
 		else
@@ -899,22 +970,22 @@ GEN3_CARCIMAGE_API void ArcImage_subtract( void* pSub, const void* pBuf1, const
 
 		if ( g_uiCurrentBpp == IMAGE_BPP16 )
 		{
-			auto pImgSub = arc::gen3::CArcImage<>::subtract( static_cast< const std::uint16_t* >( pBuf1 ),
-															 static_cast< const std::uint16_t* >( pBuf2 ),
-															 uiCols,
-															 uiRows );
-
-			std::memcpy( pSub, pImgSub.get(), ( uiCols * uiRows * sizeof( std::uint16_t ) ) );
+			arc::gen3::CArcImage<>::subtract( static_cast< std::uint16_t* >( pSub ),
+											  static_cast< const std::uint16_t* >( pBuf1 ),
+											  static_cast< const std::uint16_t* >( pBuf2 ),
+											  uiCols,
+											  uiRows,
+											  arc::gen3::image::e_ArithMode::WRAP );
 		}
 
 		else if ( g_uiCurrentBpp == IMAGE_BPP32 )
 		{
-			auto pImgSub = arc::gen3::CArcImage<arc::gen3::image::BPP_32>::subtract( static_cast< const std::uint32_t* >( pBuf1 ),
-																					 static_cast< const std::uint32_t* >( pBuf2 ),
-																					 uiCols,
-																					 uiRows );
-
-			std::memcpy( pSub, pImgSub.get(), ( uiCols * uiRows * sizeof( std::uint32_t ) ) );
+			arc::gen3::CArcImage<arc::gen3::image::BPP_32>::subtract( static_cast< std::uint32_t* >( pSub ),
+																	  static_cast< const std::uint32_t* >( pBuf1 ),
+																	  static_cast< const std::uint32_t* >( pBuf2 ),
+																	  uiCols,
+																	  uiRows,
+																	  arc::gen3::image::e_ArithMode::WRAP );
 		}
 
 		else
@@ -987,22 +1058,20 @@ GEN3_CARCIMAGE_API void ArcImage_divide( void* pDiv, const void* pBuf1, const vo
 	{
 		if ( g_uiCurrentBpp == IMAGE_BPP16 )
 		{
-			auto pImgDiv = arc::gen3::CArcImage<>::divide( static_cast< const std::uint16_t* >( pBuf1 ),
-														   static_cast< const std::uint16_t* >( pBuf2 ),
-														   uiCols,
-														   uiRows );
-
-			std::memcpy( pDiv, pImgDiv.get(), ( uiCols * uiRows * sizeof( std::uint16_t ) ) );
+			arc::gen3::CArcImage<>::divide( static_cast< std::uint16_t* >( pDiv ),
+											static_cast< const std::uint16_t* >( pBuf1 ),
+											static_cast< const std::uint16_t* >( pBuf2 ),
+											uiCols,
+											uiRows );
 		}
 
 		else if ( g_uiCurrentBpp == IMAGE_BPP32 )
 		{
-			auto pImgDiv = arc::gen3::CArcImage<arc::gen3::image::BPP_32>::divide( static_cast< const std::uint32_t* >( pBuf1 ),
-																				   static_cast< const std::uint32_t* >( pBuf2 ),
-																				   uiCols,
-																				   uiRows );
-
-			std::memcpy( pDiv, pImgDiv.get(), ( uiCols * uiRows * sizeof( std::uint32_t ) ) );
+			arc::gen3::CArcImage<arc::gen3::image::BPP_32>::divide( static_cast< std::uint32_t* >( pDiv ),
+																	static_cast< const std::uint32_t* >( pBuf1 ),
+																	static_cast< const std::uint32_t* >( pBuf2 ),
+																	uiCols,
+																	uiRows );
 		}
 
 		else
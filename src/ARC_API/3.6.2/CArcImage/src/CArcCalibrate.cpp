@@ -0,0 +1,569 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCalibrate.cpp  ( Gen3 )                                                                              |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC image calibration stage.                                                  |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <CArcCalibrate.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace
+		{
+			// Floating point type that holds every pixel value exactly.
+			template <typename T>
+			using Real_t = std::conditional_t<( sizeof( T ) <= sizeof( std::uint16_t ) ), float, double>;
+
+			// Calls fnRun( std::true_type ) or fnRun( std::false_type ), so a run time flag selects a compile time
+			// specialization of a kernel.
+			template <typename F>
+			void withFlag( const bool bFlag, const F& fnRun )
+			{
+				if ( bFlag )
+				{
+					fnRun( std::true_type() );
+				}
+				else
+				{
+					fnRun( std::false_type() );
+				}
+			}
+
+			// Converts a calibrated value to the output type. Integer output is rounded to the nearest integer and
+			// clamped to the data type range.
+			template <typename T, typename U>
+			inline U toOutput( const Real_t<T> gValue )
+			{
+				if constexpr ( std::is_floating_point_v<U> )
+				{
+					return static_cast< U >( gValue );
+				}
+				else
+				{
+					constexpr Real_t<T> gMax = static_cast< Real_t<T> >( std::numeric_limits<U>::max() );
+
+					const Real_t<T> gRound = ( gValue + Real_t<T>( 0.5 ) );
+
+					return static_cast< U >( gRound < Real_t<T>( 0 ) ? Real_t<T>( 0 ) : ( gRound > gMax ? gMax : gRound ) );
+				}
+			}
+
+			// Calibrates a span of pixels. The corrections that are not in use are removed at compile time, so the
+			// loop has no branches and is vectorized by the compiler.
+			template <typename T, typename U, bool bBias, bool bDark, bool bFlat>
+			void calibrateSpan( const T* pSrc, U* pDst, const float* pBias, const float* pDark, const float* pFlatInv,
+								const std::size_t uiCount, const Real_t<T> gLevel, const Real_t<T> gDarkScale )
+			{
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					Real_t<T> gValue = ( static_cast< Real_t<T> >( pSrc[ i ] ) - gLevel );
+
+					if constexpr ( bBias )
+					{
+						gValue -= pBias[ i ];
+					}
+
+					if constexpr ( bDark )
+					{
+						gValue -= ( gDarkScale * pDark[ i ] );
+					}
+
+					if constexpr ( bFlat )
+					{
+						gValue *= pFlatInv[ i ];
+					}
+
+					pDst[ i ] = toOutput<T, U>( gValue );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a stage with no corrections.                                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCalibrate<T>::CArcCalibrate( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiThreads( 1 ), m_tOverscan( { 0, 0, 0, 0 } ),
+			  m_eFit( arc::gen3::image::e_OverscanFit::NONE ), m_uiOrder( 0 ), m_gDarkScale( 1.0 )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCalibrate<T>::~CArcCalibrate( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setOverscan                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the overscan region and fit. The region is not checked if the fit is e_OverscanFit::NONE.          |
+		// |                                                                                                          |
+		// |  <IN> -> tRegion - The overscan region.                                                                  |
+		// |  <IN> -> eFit    - The overscan level fit.                                                               |
+		// |  <IN> -> uiOrder - The polynomial order, for e_OverscanFit::POLYNOMIAL.                                  |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setOverscan( const arc::gen3::image::Roi_t& tRegion, const arc::gen3::image::e_OverscanFit eFit, const std::uint32_t uiOrder )
+		{
+			if ( eFit != arc::gen3::image::e_OverscanFit::NONE )
+			{
+				CArcImage<T>::verifyRegions( { tRegion }, m_uiCols, m_uiRows );
+			}
+
+			if ( eFit == arc::gen3::image::e_OverscanFit::POLYNOMIAL )
+			{
+				if ( uiOrder > ORDER_MAX )
+				{
+					throwArcGen3OutOfRange( uiOrder, std::make_pair( static_cast< std::uint32_t >( 0 ), ORDER_MAX ) );
+				}
+
+				if ( ( tRegion.uiRow2 - tRegion.uiRow1 ) <= uiOrder )
+				{
+					throwArcGen3InvalidArgument( "Overscan region has too few rows [ %u ] for polynomial order %u.",
+												 ( tRegion.uiRow2 - tRegion.uiRow1 ), uiOrder );
+				}
+			}
+
+			m_tOverscan = tRegion;
+
+			m_eFit = eFit;
+
+			m_uiOrder = uiOrder;
+
+			m_vLevels.clear();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setBias                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the master bias frame.                                                                             |
+		// |                                                                                                          |
+		// |  <IN> -> pBias - Pointer to cols x rows values, or nullptr to remove the bias.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setBias( const float* pBias )
+		{
+			if ( pBias == nullptr )
+			{
+				std::vector<float>().swap( m_vBias );
+			}
+			else
+			{
+				m_vBias.assign( pBias, pBias + static_cast< std::size_t >( m_uiCols ) * m_uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setDark                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the master dark frame.                                                                             |
+		// |                                                                                                          |
+		// |  <IN> -> pDark  - Pointer to cols x rows values, or nullptr to remove the dark.                          |
+		// |  <IN> -> gScale - The dark scale.                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setDark( const float* pDark, const double gScale )
+		{
+			if ( pDark == nullptr )
+			{
+				std::vector<float>().swap( m_vDark );
+			}
+			else
+			{
+				m_vDark.assign( pDark, pDark + static_cast< std::size_t >( m_uiCols ) * m_uiRows );
+			}
+
+			m_gDarkScale = gScale;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setDarkScale                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the dark scale.                                                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> gScale - The dark scale.                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setDarkScale( const double gScale ) noexcept
+		{
+			m_gDarkScale = gScale;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setFlat                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the master flat frame. The flat is stored as its reciprocal so that calibrate() multiplies rather  |
+		// |  than divides. Values that are not positive have a zero reciprocal, which zeroes the calibrated pixel.   |
+		// |                                                                                                          |
+		// |  <IN> -> pFlat      - Pointer to cols x rows values, or nullptr to remove the flat.                      |
+		// |  <IN> -> bNormalize - true to divide the flat by the mean of its positive values.                        |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setFlat( const float* pFlat, const bool bNormalize )
+		{
+			if ( pFlat == nullptr )
+			{
+				std::vector<float>().swap( m_vFlatInv );
+
+				return;
+			}
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( m_uiCols ) * m_uiRows );
+
+			double gSum = 0.0;
+
+			std::size_t uiPositive = 0;
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				if ( pFlat[ i ] > 0.0f )
+				{
+					gSum += pFlat[ i ];
+
+					uiPositive++;
+				}
+			}
+
+			if ( uiPositive == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid flat field, no positive values."s );
+			}
+
+			const double gNorm = ( bNormalize ? ( gSum / static_cast< double >( uiPositive ) ) : 1.0 );
+
+			m_vFlatInv.resize( uiPixels );
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				m_vFlatInv[ i ] = ( pFlat[ i ] > 0.0f ? static_cast< float >( gNorm / pFlat[ i ] ) : 0.0f );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setThreads                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the number of threads the image is split over.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::setThreads( const std::uint32_t uiThreads ) noexcept
+		{
+			m_uiThreads = uiThreads;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  calibrate                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calibrates a frame.                                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> pSrcBuf - Pointer to the image buffer.                                                          |
+		// |  <IN> -> pDstBuf - Pointer to a buffer of cols x rows values.                                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::calibrate( const T* pSrcBuf, float* pDstBuf )
+		{
+			apply( pSrcBuf, pDstBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  calibrate                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calibrates a frame. The values are rounded to the nearest integer and clamped to the data type range.   |
+		// |                                                                                                          |
+		// |  <IN> -> pSrcBuf - Pointer to the image buffer.                                                          |
+		// |  <IN> -> pDstBuf - Pointer to a buffer of cols x rows pixels. May be the source buffer.                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::calibrate( const T* pSrcBuf, T* pDstBuf )
+		{
+			apply( pSrcBuf, pDstBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  overscanLevels                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the overscan level subtracted from each row by the last calibrate() call.                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::vector<double>& CArcCalibrate<T>::overscanLevels( void ) const noexcept
+		{
+			return m_vLevels;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fitOverscan                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills m_vLevels with the overscan level of every row. The level of a region row is the median of its    |
+		// |  overscan pixels, which rejects cosmic rays and hot pixels. The polynomial fit is made in a row          |
+		// |  coordinate scaled to [ -1, 1 ] over the region, which keeps the normal equations well conditioned.      |
+		// |                                                                                                          |
+		// |  <IN> -> pSrcBuf - Pointer to the image buffer.                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCalibrate<T>::fitOverscan( const T* pSrcBuf )
+		{
+			const std::uint32_t uiRow1 = m_tOverscan.uiRow1;
+			const std::uint32_t uiRow2 = m_tOverscan.uiRow2;
+			const std::uint32_t uiWidth = ( m_tOverscan.uiCol2 - m_tOverscan.uiCol1 );
+
+			m_vLevels.resize( m_uiRows );
+
+			CArcImage<T>::forEachRowBlock( uiRow1, uiRow2, m_uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				std::vector<T> vValues( uiWidth );
+
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const T* pRow = ( pSrcBuf + static_cast< std::size_t >( uiRow ) * m_uiCols + m_tOverscan.uiCol1 );
+
+					std::copy( pRow, pRow + uiWidth, vValues.begin() );
+
+					auto itMid = ( vValues.begin() + uiWidth / 2 );
+
+					std::nth_element( vValues.begin(), itMid, vValues.end() );
+
+					double gMedian = static_cast< double >( *itMid );
+
+					if ( ( uiWidth % 2 ) == 0 )
+					{
+						gMedian = ( ( gMedian + static_cast< double >( *std::max_element( vValues.begin(), itMid ) ) ) / 2.0 );
+					}
+
+					m_vLevels[ uiRow ] = gMedian;
+				}
+			} );
+
+			double gMean = 0.0;
+
+			for ( std::uint32_t uiRow = uiRow1; uiRow < uiRow2; uiRow++ )
+			{
+				gMean += m_vLevels[ uiRow ];
+			}
+
+			gMean /= static_cast< double >( uiRow2 - uiRow1 );
+
+			if ( m_eFit == arc::gen3::image::e_OverscanFit::MEAN )
+			{
+				std::fill( m_vLevels.begin(), m_vLevels.end(), gMean );
+			}
+
+			else if ( m_eFit == arc::gen3::image::e_OverscanFit::ROW )
+			{
+				std::fill( m_vLevels.begin(), m_vLevels.begin() + uiRow1, gMean );
+
+				std::fill( m_vLevels.begin() + uiRow2, m_vLevels.end(), gMean );
+			}
+
+			else if ( m_eFit == arc::gen3::image::e_OverscanFit::POLYNOMIAL )
+			{
+				const std::uint32_t uiTerms = ( m_uiOrder + 1 );
+
+				const double gCenter = ( static_cast< double >( uiRow1 ) + static_cast< double >( uiRow2 - 1 ) ) / 2.0;
+
+				const double gHalfSpan = std::max( ( static_cast< double >( uiRow2 - 1 ) - static_cast< double >( uiRow1 ) ) / 2.0, 1.0 );
+
+				// Normal equations A c = b, with A[ j ][ k ] = sum( x^( j + k ) ) and b[ j ] = sum( x^j y )
+				double gA[ ORDER_MAX + 1 ][ ORDER_MAX + 2 ] = {};
+
+				for ( std::uint32_t uiRow = uiRow1; uiRow < uiRow2; uiRow++ )
+				{
+					const double gX = ( ( static_cast< double >( uiRow ) - gCenter ) / gHalfSpan );
+
+					double gPowers[ 2 * ORDER_MAX + 1 ];
+
+					gPowers[ 0 ] = 1.0;
+
+					for ( std::uint32_t k = 1; k < ( 2 * uiTerms - 1 ); k++ )
+					{
+						gPowers[ k ] = ( gPowers[ k - 1 ] * gX );
+					}
+
+					for ( std::uint32_t j = 0; j < uiTerms; j++ )
+					{
+						for ( std::uint32_t k = 0; k < uiTerms; k++ )
+						{
+							gA[ j ][ k ] += gPowers[ j + k ];
+						}
+
+						gA[ j ][ uiTerms ] += ( gPowers[ j ] * m_vLevels[ uiRow ] );
+					}
+				}
+
+				// Gaussian elimination with partial pivoting
+				for ( std::uint32_t j = 0; j < uiTerms; j++ )
+				{
+					std::uint32_t uiPivot = j;
+
+					for ( std::uint32_t k = ( j + 1 ); k < uiTerms; k++ )
+					{
+						if ( std::fabs( gA[ k ][ j ] ) > std::fabs( gA[ uiPivot ][ j ] ) )
+						{
+							uiPivot = k;
+						}
+					}
+
+					std::swap( gA[ j ], gA[ uiPivot ] );
+
+					for ( std::uint32_t k = ( j + 1 ); k < uiTerms; k++ )
+					{
+						const double gFactor = ( gA[ k ][ j ] / gA[ j ][ j ] );
+
+						for ( std::uint32_t m = j; m <= uiTerms; m++ )
+						{
+							gA[ k ][ m ] -= ( gFactor * gA[ j ][ m ] );
+						}
+					}
+				}
+
+				double gCoeffs[ ORDER_MAX + 1 ];
+
+				for ( std::uint32_t j = uiTerms; j-- > 0; )
+				{
+					double gValue = gA[ j ][ uiTerms ];
+
+					for ( std::uint32_t k = ( j + 1 ); k < uiTerms; k++ )
+					{
+						gValue -= ( gA[ j ][ k ] * gCoeffs[ k ] );
+					}
+
+					gCoeffs[ j ] = ( gValue / gA[ j ][ j ] );
+				}
+
+				for ( std::uint32_t uiRow = 0; uiRow < m_uiRows; uiRow++ )
+				{
+					const double gX = ( ( static_cast< double >( uiRow ) - gCenter ) / gHalfSpan );
+
+					double gValue = 0.0;
+
+					for ( std::uint32_t j = uiTerms; j-- > 0; )
+					{
+						gValue = ( gValue * gX + gCoeffs[ j ] );
+					}
+
+					m_vLevels[ uiRow ] = gValue;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  apply                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Applies the corrections to every row. The overscan levels are fitted first, as they only read the       |
+		// |  overscan region, then every pixel is read and written once, with the masters streamed alongside it.     |
+		// |                                                                                                          |
+		// |  <IN> -> pSrcBuf - Pointer to the image buffer.                                                          |
+		// |  <IN> -> pDstBuf - Pointer to the output buffer.                                                         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		template <typename U>
+		void CArcCalibrate<T>::apply( const T* pSrcBuf, U* pDstBuf )
+		{
+			if ( pSrcBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid destination buffer parameter ( nullptr )!"s );
+			}
+
+			if ( m_eFit == arc::gen3::image::e_OverscanFit::NONE )
+			{
+				m_vLevels.clear();
+			}
+			else
+			{
+				fitOverscan( pSrcBuf );
+			}
+
+			const Real_t<T> gDarkScale = static_cast< Real_t<T> >( m_gDarkScale );
+
+			withFlag( !m_vBias.empty(), [ & ]( auto tBias )
+			{
+				withFlag( !m_vDark.empty(), [ & ]( auto tDark )
+				{
+					withFlag( !m_vFlatInv.empty(), [ & ]( auto tFlat )
+					{
+						CArcImage<T>::forEachRowBlock( 0, m_uiRows, m_uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+						{
+							for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+							{
+								const std::size_t uiOffset = ( static_cast< std::size_t >( uiRow ) * m_uiCols );
+
+								const Real_t<T> gLevel = static_cast< Real_t<T> >( m_vLevels.empty() ? 0.0 : m_vLevels[ uiRow ] );
+
+								const float* pBias = ( decltype( tBias )::value ? ( m_vBias.data() + uiOffset ) : nullptr );
+								const float* pDark = ( decltype( tDark )::value ? ( m_vDark.data() + uiOffset ) : nullptr );
+								const float* pFlatInv = ( decltype( tFlat )::value ? ( m_vFlatInv.data() + uiOffset ) : nullptr );
+
+								calibrateSpan<T, U, decltype( tBias )::value, decltype( tDark )::value, decltype( tFlat )::value>(
+									( pSrcBuf + uiOffset ), ( pDstBuf + uiOffset ), pBias, pDark, pFlatInv, m_uiCols, gLevel, gDarkScale );
+							}
+						} );
+					} );
+				} );
+			} );
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcCalibrate<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcCalibrate<arc::gen3::image::BPP_32>;
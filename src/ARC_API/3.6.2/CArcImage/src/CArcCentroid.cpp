@@ -0,0 +1,518 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCentroid.cpp  ( Gen3 )                                                                               |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC star centroid, FWHM and guide star tracking engine.                       |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#include <CArcCentroid.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace
+		{
+			// Number of pixels sampled to estimate the frame background.
+			constexpr std::size_t SAMPLE_SIZE = 4096;
+
+			// Number of detection candidates kept per requested source.
+			constexpr std::uint32_t CANDIDATES_PER_SOURCE = 4;
+
+			// FWHM of a gaussian in standard deviations, 2 x sqrt( 2 x ln( 2 ) ).
+			constexpr double FWHM_PER_SIGMA = 2.3548200450309493;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates an engine with a 15 x 15 pixel box and a 5 sigma detection threshold.                           |
+		// |                                                                                                          |
+		// |  <IN> -> uiMaxSources - The largest number of sources returned by find().                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCentroid<T>::CArcCentroid( const std::uint32_t uiMaxSources )
+			: CArcBase(), m_uiMaxSources( uiMaxSources ), m_uiHalfWidth( 7 ), m_gThreshold( 5.0 )
+		{
+			if ( uiMaxSources == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid source count, must not be zero."s );
+			}
+
+			m_vPeaks.reserve( static_cast< std::size_t >( uiMaxSources ) * CANDIDATES_PER_SOURCE );
+
+			m_vSources.reserve( uiMaxSources );
+
+			m_vScratch.resize( std::max( SAMPLE_SIZE, static_cast< std::size_t >( 8 * HALF_WIDTH_MAX ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCentroid<T>::~CArcCentroid( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setBox                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the measurement box half width.                                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> uiHalfWidth - The box half width.                                                               |
+		// |                                                                                                          |
+		// |  Throws std::out_of_range                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCentroid<T>::setBox( const std::uint32_t uiHalfWidth )
+		{
+			if ( uiHalfWidth < 2 || uiHalfWidth > HALF_WIDTH_MAX )
+			{
+				throwArcGen3OutOfRange( uiHalfWidth, std::make_pair( static_cast< std::uint32_t >( 2 ), HALF_WIDTH_MAX ) );
+			}
+
+			m_uiHalfWidth = uiHalfWidth;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setThreshold                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the detection threshold.                                                                           |
+		// |                                                                                                          |
+		// |  <IN> -> gSigma - The threshold, in standard deviations of the background noise.                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCentroid<T>::setThreshold( const double gSigma )
+		{
+			if ( !( gSigma > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid threshold [ %f ], must be positive.", gSigma );
+			}
+
+			m_gThreshold = gSigma;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  find                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Finds and measures the brightest sources in a view. The frame background and noise are estimated from a |
+		// |  grid sample. The brightest local maxima above the threshold are kept in a fixed size heap, measured in  |
+		// |  order of peak value, and dropped if their centroid falls within the box of a source already found.      |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::vector<arc::gen3::image::Source_t>& CArcCentroid<T>::find( const arc::gen3::image::ImageView<const T>& tSrc )
+		{
+			verifyView( tSrc );
+
+			const std::uint32_t uiCols = tSrc.cols();
+			const std::uint32_t uiRows = tSrc.rows();
+
+			const std::uint32_t uiStep = std::max( static_cast< std::uint32_t >( 1 ),
+												   static_cast< std::uint32_t >( std::ceil( std::sqrt( static_cast< double >( tSrc.size() ) / SAMPLE_SIZE ) ) ) );
+
+			std::size_t uiCount = 0;
+
+			for ( std::uint32_t r = 0; r < uiRows && uiCount < m_vScratch.size(); r += uiStep )
+			{
+				const T* pRow = tSrc.rowData( r );
+
+				for ( std::uint32_t c = 0; c < uiCols && uiCount < m_vScratch.size(); c += uiStep )
+				{
+					m_vScratch[ uiCount++ ] = pRow[ c ];
+				}
+			}
+
+			const auto tLevel = robustLevel( uiCount );
+
+			const double gLevel = ( tLevel.first + m_gThreshold * tLevel.second );
+
+			const std::size_t uiCapacity = m_vPeaks.capacity();
+
+			auto fnGreater = []( const Peak_t& tA, const Peak_t& tB ) { return ( tA.gValue > tB.gValue ); };
+
+			m_vPeaks.clear();
+
+			for ( std::uint32_t r = 1; ( r + 1 ) < uiRows; r++ )
+			{
+				const T* pUp  = tSrc.rowData( r - 1 );
+				const T* pRow = tSrc.rowData( r );
+				const T* pDn  = tSrc.rowData( r + 1 );
+
+				for ( std::uint32_t c = 1; ( c + 1 ) < uiCols; c++ )
+				{
+					const T uiValue = pRow[ c ];
+
+					if ( static_cast< double >( uiValue ) <= gLevel )
+					{
+						continue;
+					}
+
+					// Ties go to the first pixel in raster order.
+					if ( uiValue <= pUp[ c - 1 ] || uiValue <= pUp[ c ] || uiValue <= pUp[ c + 1 ] || uiValue <= pRow[ c - 1 ] ||
+						 uiValue < pRow[ c + 1 ] || uiValue < pDn[ c - 1 ] || uiValue < pDn[ c ] || uiValue < pDn[ c + 1 ] )
+					{
+						continue;
+					}
+
+					if ( m_vPeaks.size() < uiCapacity )
+					{
+						m_vPeaks.push_back( { static_cast< double >( uiValue ), c, r } );
+
+						std::push_heap( m_vPeaks.begin(), m_vPeaks.end(), fnGreater );
+					}
+
+					else if ( static_cast< double >( uiValue ) > m_vPeaks.front().gValue )
+					{
+						std::pop_heap( m_vPeaks.begin(), m_vPeaks.end(), fnGreater );
+
+						m_vPeaks.back() = { static_cast< double >( uiValue ), c, r };
+
+						std::push_heap( m_vPeaks.begin(), m_vPeaks.end(), fnGreater );
+					}
+				}
+			}
+
+			std::sort_heap( m_vPeaks.begin(), m_vPeaks.end(), fnGreater );
+
+			m_vSources.clear();
+
+			const double gBox = static_cast< double >( m_uiHalfWidth );
+
+			for ( const auto& tPeak : m_vPeaks )
+			{
+				if ( m_vSources.size() == m_uiMaxSources )
+				{
+					break;
+				}
+
+				const auto tSource = measure( tSrc, tPeak.uiCol, tPeak.uiRow );
+
+				if ( !tSource.bValid )
+				{
+					continue;
+				}
+
+				const bool bDuplicate = std::any_of( m_vSources.begin(), m_vSources.end(), [ & ]( const arc::gen3::image::Source_t& tOther )
+				{
+					return ( std::abs( tOther.gX - tSource.gX ) <= gBox && std::abs( tOther.gY - tSource.gY ) <= gBox );
+				} );
+
+				if ( !bDuplicate )
+				{
+					m_vSources.push_back( tSource );
+				}
+			}
+
+			std::sort( m_vSources.begin(), m_vSources.end(), []( const arc::gen3::image::Source_t& tA, const arc::gen3::image::Source_t& tB )
+			{
+				return ( tA.gFlux > tB.gFlux );
+			} );
+
+			return m_vSources;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  measure                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Measures a source at a position. The box is clipped to the view. The background and noise are the       |
+		// |  median and scaled MAD of the box edge pixels. The centroid, flux and second moments are sums over the   |
+		// |  positive background subtracted pixels within the circle inscribed in the box. The box is recentered on  |
+		// |  the first centroid and the sums are repeated. The FWHM is that of a gaussian with the mean of the two   |
+		// |  principal second moments as its variance.                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// |  <IN> -> gX   - The approximate column.                                                                  |
+		// |  <IN> -> gY   - The approximate row.                                                                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::image::Source_t CArcCentroid<T>::measure( const arc::gen3::image::ImageView<const T>& tSrc, const double gX, const double gY )
+		{
+			verifyView( tSrc );
+
+			arc::gen3::image::Source_t tSource = { gX, gY, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, false };
+
+			const std::int64_t iHalf = static_cast< std::int64_t >( m_uiHalfWidth );
+			const std::int64_t iCols = static_cast< std::int64_t >( tSrc.cols() );
+			const std::int64_t iRows = static_cast< std::int64_t >( tSrc.rows() );
+
+			double gMxx = 0.0, gMyy = 0.0, gMxy = 0.0;
+
+			for ( std::uint32_t uiPass = 0; uiPass < 2; uiPass++ )
+			{
+				if ( !std::isfinite( tSource.gX ) || !std::isfinite( tSource.gY ) )
+				{
+					return tSource;
+				}
+
+				const std::int64_t iX = std::llround( tSource.gX );
+				const std::int64_t iY = std::llround( tSource.gY );
+
+				if ( iX < 0 || iY < 0 || iX >= iCols || iY >= iRows )
+				{
+					return tSource;
+				}
+
+				const std::int64_t iCol1 = std::max( static_cast< std::int64_t >( 0 ), ( iX - iHalf ) );
+				const std::int64_t iCol2 = std::min( ( iCols - 1 ), ( iX + iHalf ) );
+				const std::int64_t iRow1 = std::max( static_cast< std::int64_t >( 0 ), ( iY - iHalf ) );
+				const std::int64_t iRow2 = std::min( ( iRows - 1 ), ( iY + iHalf ) );
+
+				if ( ( iCol2 - iCol1 ) < 2 || ( iRow2 - iRow1 ) < 2 )
+				{
+					return tSource;
+				}
+
+				std::size_t uiCount = 0;
+
+				for ( std::int64_t c = iCol1; c <= iCol2; c++ )
+				{
+					m_vScratch[ uiCount++ ] = tSrc( static_cast< std::uint32_t >( c ), static_cast< std::uint32_t >( iRow1 ) );
+					m_vScratch[ uiCount++ ] = tSrc( static_cast< std::uint32_t >( c ), static_cast< std::uint32_t >( iRow2 ) );
+				}
+
+				for ( std::int64_t r = ( iRow1 + 1 ); r < iRow2; r++ )
+				{
+					m_vScratch[ uiCount++ ] = tSrc( static_cast< std::uint32_t >( iCol1 ), static_cast< std::uint32_t >( r ) );
+					m_vScratch[ uiCount++ ] = tSrc( static_cast< std::uint32_t >( iCol2 ), static_cast< std::uint32_t >( r ) );
+				}
+
+				const auto tLevel = robustLevel( uiCount );
+
+				double gSum = 0.0, gSumX = 0.0, gSumY = 0.0, gSumXX = 0.0, gSumYY = 0.0, gSumXY = 0.0, gPeak = 0.0;
+
+				for ( std::int64_t r = iRow1; r <= iRow2; r++ )
+				{
+					const T* pRow = tSrc.rowData( static_cast< std::uint32_t >( r ) );
+
+					const double gDy = static_cast< double >( r - iY );
+
+					for ( std::int64_t c = iCol1; c <= iCol2; c++ )
+					{
+						const double gDx = static_cast< double >( c - iX );
+
+						const double gValue = ( static_cast< double >( pRow[ c ] ) - tLevel.first );
+
+						if ( gValue <= 0.0 || ( gDx * gDx + gDy * gDy ) > static_cast< double >( iHalf * iHalf ) )
+						{
+							continue;
+						}
+
+						gPeak = std::max( gPeak, gValue );
+
+						gSum   += gValue;
+						gSumX  += ( gValue * gDx );
+						gSumY  += ( gValue * gDy );
+						gSumXX += ( gValue * gDx * gDx );
+						gSumYY += ( gValue * gDy * gDy );
+						gSumXY += ( gValue * gDx * gDy );
+					}
+				}
+
+				if ( gSum <= 0.0 )
+				{
+					return tSource;
+				}
+
+				const double gCx = ( gSumX / gSum );
+				const double gCy = ( gSumY / gSum );
+
+				gMxx = ( gSumXX / gSum - gCx * gCx );
+				gMyy = ( gSumYY / gSum - gCy * gCy );
+				gMxy = ( gSumXY / gSum - gCx * gCy );
+
+				tSource.gX = ( static_cast< double >( iX ) + gCx );
+				tSource.gY = ( static_cast< double >( iY ) + gCy );
+
+				tSource.gFlux = gSum;
+				tSource.gPeak = gPeak;
+				tSource.gBackground = tLevel.first;
+				tSource.gNoise = tLevel.second;
+			}
+
+			const double gMean = ( 0.5 * ( gMxx + gMyy ) );
+			const double gDiff = std::sqrt( 0.25 * ( gMxx - gMyy ) * ( gMxx - gMyy ) + gMxy * gMxy );
+
+			const double gMajor = ( gMean + gDiff );
+			const double gMinor = std::max( 0.0, ( gMean - gDiff ) );
+
+			tSource.gFwhm = ( FWHM_PER_SIGMA * std::sqrt( std::max( 0.0, gMean ) ) );
+			tSource.gEllipticity = ( gMajor > 0.0 ? ( 1.0 - std::sqrt( gMinor / gMajor ) ) : 0.0 );
+			tSource.bValid = ( tSource.gPeak > ( m_gThreshold * tSource.gNoise ) );
+
+			return tSource;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setGuideStars                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the guide stars and their reference positions.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> vPositions - The ( column, row ) reference positions.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCentroid<T>::setGuideStars( const std::vector<std::pair<double, double>>& vPositions )
+		{
+			m_vReference = vPositions;
+
+			m_vGuide.resize( vPositions.size() );
+
+			for ( std::size_t i = 0; i < vPositions.size(); i++ )
+			{
+				m_vGuide[ i ] = { vPositions[ i ].first, vPositions[ i ].second, 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, false };
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  track                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Measures every guide star at its last position. A star that is not valid keeps its last position.       |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::vector<arc::gen3::image::Source_t>& CArcCentroid<T>::track( const arc::gen3::image::ImageView<const T>& tSrc )
+		{
+			verifyView( tSrc );
+
+			for ( auto& tGuide : m_vGuide )
+			{
+				const auto tSource = measure( tSrc, tGuide.gX, tGuide.gY );
+
+				if ( tSource.bValid )
+				{
+					tGuide = tSource;
+				}
+				else
+				{
+					tGuide.bValid = false;
+				}
+			}
+
+			return m_vGuide;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  offset                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the mean offset of the valid guide stars from their reference positions.                        |
+		// |                                                                                                          |
+		// |  <OUT> -> gDx - The column offset.                                                                       |
+		// |  <OUT> -> gDy - The row offset.                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		bool CArcCentroid<T>::offset( double& gDx, double& gDy ) const noexcept
+		{
+			std::size_t uiValid = 0;
+
+			gDx = gDy = 0.0;
+
+			for ( std::size_t i = 0; i < m_vGuide.size(); i++ )
+			{
+				if ( m_vGuide[ i ].bValid )
+				{
+					gDx += ( m_vGuide[ i ].gX - m_vReference[ i ].first );
+					gDy += ( m_vGuide[ i ].gY - m_vReference[ i ].second );
+
+					uiValid++;
+				}
+			}
+
+			if ( uiValid == 0 )
+			{
+				return false;
+			}
+
+			gDx /= static_cast< double >( uiValid );
+			gDy /= static_cast< double >( uiValid );
+
+			return true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyView                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies a source view. Throws exception on error.                                                      |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCentroid<T>::verifyView( const arc::gen3::image::ImageView<const T>& tSrc ) const
+		{
+			if ( tSrc.data() == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			CArcImage<T>::verifyDimensions( tSrc.cols(), tSrc.rows() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  robustLevel                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the median and 1.4826 x MAD of the values in m_vScratch[ 0, uiCount ). The noise is floored at  |
+		// |  one so that a noiseless frame still has a finite threshold. The scratch values are reordered.           |
+		// |                                                                                                          |
+		// |  <IN> -> uiCount - The number of values; at least one.                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::pair<double, double> CArcCentroid<T>::robustLevel( const std::size_t uiCount )
+		{
+			const auto itBegin = m_vScratch.begin();
+			const auto itMiddle = ( itBegin + static_cast< std::ptrdiff_t >( uiCount / 2 ) );
+			const auto itEnd = ( itBegin + static_cast< std::ptrdiff_t >( uiCount ) );
+
+			std::nth_element( itBegin, itMiddle, itEnd );
+
+			const double gMedian = *itMiddle;
+
+			std::for_each( itBegin, itEnd, [ & ]( double& gValue ) { gValue = std::abs( gValue - gMedian ); } );
+
+			std::nth_element( itBegin, itMiddle, itEnd );
+
+			return std::make_pair( gMedian, std::max( 1.0, ( 1.4826 * *itMiddle ) ) );
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcCentroid<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcCentroid<arc::gen3::image::BPP_32>;
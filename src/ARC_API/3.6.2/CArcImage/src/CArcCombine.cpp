@@ -0,0 +1,561 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcCombine.cpp  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC tiled median and sigma clipped frame combiner.                            |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+
+#include <CArcThreadPool.h>
+#include <CArcCombine.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a median combiner with a 256 MB memory limit.                                                   |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCombine<T>::CArcCombine( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiThreads( 1 ), m_uiFrames( 0 ), m_eMethod( arc::gen3::image::e_CombineMethod::MEDIAN ),
+			  m_gLow( 3.0 ), m_gHigh( 3.0 ), m_uiIterations( 5 ), m_uiMemoryLimit( static_cast< std::uint64_t >( 256 ) << 20 )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcCombine<T>::~CArcCombine( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setMethod                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the combine method.                                                                                |
+		// |                                                                                                          |
+		// |  <IN> -> eMethod - The combine method.                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::setMethod( const arc::gen3::image::e_CombineMethod eMethod ) noexcept
+		{
+			m_eMethod = eMethod;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setSigmaClip                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the sigma clipping limits.                                                                         |
+		// |                                                                                                          |
+		// |  <IN> -> gLow         - The lower limit, in standard deviations.                                         |
+		// |  <IN> -> gHigh        - The upper limit, in standard deviations.                                         |
+		// |  <IN> -> uiIterations - The maximum number of iterations.                                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::setSigmaClip( const double gLow, const double gHigh, const std::uint32_t uiIterations )
+		{
+			if ( !( gLow > 0.0 ) || !( gHigh > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid sigma clip limits [ %f, %f ], must be positive.", gLow, gHigh );
+			}
+
+			m_gLow = gLow;
+
+			m_gHigh = gHigh;
+
+			m_uiIterations = uiIterations;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setMemoryLimit                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the memory limit for the tile and scratch buffers.                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiBytes - The memory limit ( in bytes ).                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::setMemoryLimit( const std::uint64_t uiBytes ) noexcept
+		{
+			m_uiMemoryLimit = uiBytes;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setThreads                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the number of threads each tile is split over.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::setThreads( const std::uint32_t uiThreads ) noexcept
+		{
+			m_uiThreads = uiThreads;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  tileRows                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of rows per tile used to combine a frame count under the memory limit. The limit     |
+		// |  covers the per-thread scratch and the tile buffers. A frame set that fits the limit in full is read as  |
+		// |  a single tile, otherwise two tiles are held so the next tile can be read while one is combined.         |
+		// |                                                                                                          |
+		// |  <IN> -> uiFrames - The number of frames.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcCombine<T>::tileRows( const std::uint32_t uiFrames ) const
+		{
+			const std::uint64_t uiRowBytes = ( static_cast< std::uint64_t >( uiFrames ) * m_uiCols * sizeof( T ) );
+
+			const std::uint64_t uiBlocks = CArcImage<T>::threadCount( m_uiThreads );
+
+			const std::uint64_t uiScratch = ( uiBlocks * ( ( uiFrames <= NETWORK_MAX ? uiRowBytes : 0 ) + uiFrames * sizeof( double ) ) );
+
+			const std::uint64_t uiAvail = ( m_uiMemoryLimit > uiScratch ? ( m_uiMemoryLimit - uiScratch ) : 0 );
+
+			if ( uiRowBytes > 0 && ( uiAvail / uiRowBytes ) >= m_uiRows )
+			{
+				return m_uiRows;
+			}
+
+			if ( uiAvail < ( 2 * uiRowBytes ) || uiRowBytes == 0 )
+			{
+				throwArcGen3InvalidArgument( "Memory limit [ %J bytes ] is too small to combine %u frames of %u columns.", m_uiMemoryLimit, uiFrames, m_uiCols );
+			}
+
+			return static_cast< std::uint32_t >( uiAvail / ( 2 * uiRowBytes ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  combine                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Combines frames held in memory.                                                                         |
+		// |                                                                                                          |
+		// |  <IN> -> vFrames - The frames.                                                                           |
+		// |  <IN> -> pDstBuf - Pointer to a buffer of cols x rows values.                                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::combine( const std::vector<const T*>& vFrames, float* pDstBuf )
+		{
+			if ( vFrames.empty() || pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid combine parameters, no frames or destination buffer specified."s );
+			}
+
+			if ( std::find( vFrames.begin(), vFrames.end(), nullptr ) != vFrames.end() )
+			{
+				throwArcGen3InvalidArgument( "Invalid frame buffer parameter ( nullptr )!"s );
+			}
+
+			prepare( static_cast< std::uint32_t >( vFrames.size() ) );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, m_uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				combineBlock( uiBlock, vFrames, uiFirst, uiLast, pDstBuf );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  combine                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Combines frames read in row tiles. The combine of one tile and the read of the next tile into the       |
+		// |  second tile buffer run as two tasks on the library executor, so the reads overlap the combine. The      |
+		// |  read is task 0, which CArcThreadPool runs on the calling thread. Other executors may run it on a        |
+		// |  worker thread.                                                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> uiFrames - The number of frames.                                                                |
+		// |  <IN> -> fnRead   - The frame reader.                                                                    |
+		// |  <IN> -> pDstBuf  - Pointer to a buffer of cols x rows values.                                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, and any exception thrown by the reader                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::combine( const std::uint32_t uiFrames, const Reader_t& fnRead, float* pDstBuf )
+		{
+			if ( uiFrames == 0 || !fnRead || pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid combine parameters, no frames, reader or destination buffer specified."s );
+			}
+
+			const std::uint32_t uiTileRows = tileRows( uiFrames );
+
+			const std::uint32_t uiBuffers = ( uiTileRows < m_uiRows ? 2 : 1 );
+
+			const std::size_t uiTilePixels = ( static_cast< std::size_t >( uiTileRows ) * m_uiCols );
+
+			prepare( uiFrames );
+
+			m_vTile.resize( uiBuffers * uiFrames * uiTilePixels );
+
+			std::vector<const T*> vTileFrames[ 2 ];
+
+			for ( std::uint32_t b = 0; b < uiBuffers; b++ )
+			{
+				for ( std::uint32_t f = 0; f < uiFrames; f++ )
+				{
+					vTileFrames[ b ].push_back( m_vTile.data() + ( static_cast< std::size_t >( b ) * uiFrames + f ) * uiTilePixels );
+				}
+			}
+
+			auto tileEnd = [ & ]( std::uint32_t uiRow1 )
+			{
+				return static_cast< std::uint32_t >( std::min<std::uint64_t>( static_cast< std::uint64_t >( uiRow1 ) + uiTileRows, m_uiRows ) );
+			};
+
+			auto readTile = [ & ]( std::uint32_t uiBuffer, std::uint32_t uiRow1 )
+			{
+				for ( std::uint32_t f = 0; f < uiFrames; f++ )
+				{
+					fnRead( f, uiRow1, tileEnd( uiRow1 ), const_cast< T* >( vTileFrames[ uiBuffer ][ f ] ) );
+				}
+			};
+
+			auto combineTile = [ & ]( std::uint32_t uiBuffer, std::uint32_t uiRow1 )
+			{
+				float* pDst = ( pDstBuf + static_cast< std::size_t >( uiRow1 ) * m_uiCols );
+
+				CArcImage<T>::forEachRowBlock( 0, ( tileEnd( uiRow1 ) - uiRow1 ), m_uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					combineBlock( uiBlock, vTileFrames[ uiBuffer ], uiFirst, uiLast, pDst );
+				} );
+			};
+
+			readTile( 0, 0 );
+
+			for ( std::uint32_t uiRow1 = 0, uiBuffer = 0; uiRow1 < m_uiRows; uiRow1 = tileEnd( uiRow1 ), uiBuffer ^= 1 )
+			{
+				if ( tileEnd( uiRow1 ) >= m_uiRows )
+				{
+					combineTile( uiBuffer, uiRow1 );
+
+					break;
+				}
+
+				arc::gen3::CArcThreadPool::executor().parallelFor( 2, [ & ]( std::uint32_t uiTask )
+				{
+					if ( uiTask == 0 )
+					{
+						readTile( ( uiBuffer ^ 1 ), tileEnd( uiRow1 ) );
+					}
+
+					else
+					{
+						combineTile( uiBuffer, uiRow1 );
+					}
+				} );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  memoryBytes                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the tile and scratch memory held by the engine.                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcCombine<T>::memoryBytes( void ) const noexcept
+		{
+			return ( ( m_vTile.capacity() + m_vScratch.capacity() ) * sizeof( T ) + m_vValues.capacity() * sizeof( double ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  prepare                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sizes the sorting network and the per-thread scratch buffers for a frame count. The network is          |
+		// |  Batcher's odd-even merge sort, with the compare-exchanges that would only touch padding above the       |
+		// |  frame count removed. The median network further drops the compare-exchanges that cannot reach the       |
+		// |  middle value(s).                                                                                        |
+		// |                                                                                                          |
+		// |  <IN> -> uiFrames - The number of frames.                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::prepare( const std::uint32_t uiFrames )
+		{
+			const std::size_t uiBlocks = CArcImage<T>::threadCount( m_uiThreads );
+
+			if ( uiFrames != m_uiFrames )
+			{
+				m_vNetwork.clear();
+
+				if ( uiFrames <= NETWORK_MAX )
+				{
+					for ( std::uint32_t p = 1; p < uiFrames; p <<= 1 )
+					{
+						for ( std::uint32_t k = p; k >= 1; k >>= 1 )
+						{
+							for ( std::uint32_t j = ( k % p ); ( j + k ) < uiFrames; j += ( 2 * k ) )
+							{
+								for ( std::uint32_t i = 0; i < k && ( i + j + k ) < uiFrames; i++ )
+								{
+									if ( ( ( i + j ) / ( 2 * p ) ) == ( ( i + j + k ) / ( 2 * p ) ) )
+									{
+										m_vNetwork.emplace_back( ( i + j ), ( i + j + k ) );
+									}
+								}
+							}
+						}
+					}
+				}
+
+				//
+				// The median only reads the middle value(s), so keep just the compare-exchanges they depend on
+				//
+				std::vector<bool> vNeeded( uiFrames, false );
+
+				if ( uiFrames > 0 )
+				{
+					vNeeded[ ( uiFrames - 1 ) / 2 ] = vNeeded[ uiFrames / 2 ] = true;
+				}
+
+				m_vMedianNetwork.clear();
+
+				for ( auto it = m_vNetwork.rbegin(); it != m_vNetwork.rend(); ++it )
+				{
+					if ( vNeeded[ it->first ] || vNeeded[ it->second ] )
+					{
+						vNeeded[ it->first ] = vNeeded[ it->second ] = true;
+
+						m_vMedianNetwork.push_back( *it );
+					}
+				}
+
+				std::reverse( m_vMedianNetwork.begin(), m_vMedianNetwork.end() );
+
+				m_uiFrames = uiFrames;
+			}
+
+			m_vScratch.resize( uiFrames <= NETWORK_MAX ? ( uiBlocks * uiFrames * m_uiCols ) : 0 );
+
+			m_vValues.resize( uiBlocks * uiFrames );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  combineBlock                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Combines a block of rows. For small frame counts the rows of every frame are copied into the thread     |
+		// |  scratch and sorted column-wise by the network; each compare-exchange is a min/max over a run of         |
+		// |  pixels, which the compiler vectorizes. The network is applied to CHUNK_SIZE columns at a time so the    |
+		// |  chunk of every frame stays in the L1 cache. After the sort, scratch row k holds the k-th smallest value |
+		// |  of every pixel, so the median is read straight from the middle row(s). Larger frame counts gather each  |
+		// |  pixel's values and select or sort them individually.                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> uiBlock - The thread block.                                                                     |
+		// |  <IN> -> vFrames - Pointer to the first row in every frame.                                              |
+		// |  <IN> -> uiFirst - The first row of the block.                                                           |
+		// |  <IN> -> uiLast  - One past the last row of the block.                                                   |
+		// |  <IN> -> pDst    - Pointer to the output value of the first row.                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcCombine<T>::combineBlock( const std::uint32_t uiBlock, const std::vector<const T*>& vFrames, const std::uint32_t uiFirst, const std::uint32_t uiLast, float* pDst )
+		{
+			const std::uint32_t uiFrames = static_cast< std::uint32_t >( vFrames.size() );
+			const std::size_t uiCols = m_uiCols;
+			const bool bMedian = ( m_eMethod == arc::gen3::image::e_CombineMethod::MEDIAN );
+
+			double* pValues = ( m_vValues.data() + static_cast< std::size_t >( uiBlock ) * uiFrames );
+
+			for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiRow ) * uiCols );
+
+				float* pOut = ( pDst + uiOffset );
+
+				if ( uiFrames <= NETWORK_MAX )
+				{
+					T* pScratch = ( m_vScratch.data() + static_cast< std::size_t >( uiBlock ) * uiFrames * uiCols );
+
+					for ( std::uint32_t f = 0; f < uiFrames; f++ )
+					{
+						std::copy( vFrames[ f ] + uiOffset, vFrames[ f ] + uiOffset + uiCols, pScratch + f * uiCols );
+					}
+
+					const auto& vNetwork = ( bMedian ? m_vMedianNetwork : m_vNetwork );
+
+					for ( std::size_t uiChunk = 0; uiChunk < uiCols; uiChunk += CHUNK_SIZE )
+					{
+						const std::size_t uiChunkEnd = std::min( ( uiChunk + CHUNK_SIZE ), uiCols );
+
+						for ( const auto& rPair : vNetwork )
+						{
+							T* __restrict pA = ( pScratch + rPair.first * uiCols );
+							T* __restrict pB = ( pScratch + rPair.second * uiCols );
+
+							for ( std::size_t x = uiChunk; x < uiChunkEnd; x++ )
+							{
+								const T tA = pA[ x ];
+								const T tB = pB[ x ];
+
+								pA[ x ] = ( tA < tB ? tA : tB );
+								pB[ x ] = ( tA < tB ? tB : tA );
+							}
+						}
+					}
+
+					if ( bMedian )
+					{
+						const T* pHigh = ( pScratch + ( uiFrames / 2 ) * uiCols );
+						const T* pLow = ( pScratch + ( ( uiFrames - 1 ) / 2 ) * uiCols );
+
+						for ( std::size_t x = 0; x < uiCols; x++ )
+						{
+							pOut[ x ] = static_cast< float >( 0.5 * ( static_cast< double >( pLow[ x ] ) + static_cast< double >( pHigh[ x ] ) ) );
+						}
+					}
+
+					else
+					{
+						for ( std::size_t x = 0; x < uiCols; x++ )
+						{
+							for ( std::uint32_t f = 0; f < uiFrames; f++ )
+							{
+								pValues[ f ] = static_cast< double >( pScratch[ f * uiCols + x ] );
+							}
+
+							pOut[ x ] = static_cast< float >( combineSorted( pValues, uiFrames ) );
+						}
+					}
+				}
+
+				else
+				{
+					for ( std::size_t x = 0; x < uiCols; x++ )
+					{
+						for ( std::uint32_t f = 0; f < uiFrames; f++ )
+						{
+							pValues[ f ] = static_cast< double >( vFrames[ f ][ uiOffset + x ] );
+						}
+
+						if ( bMedian )
+						{
+							double* pHigh = ( pValues + uiFrames / 2 );
+
+							std::nth_element( pValues, pHigh, pValues + uiFrames );
+
+							const double gLow = ( ( uiFrames % 2 ) != 0 ? *pHigh : *std::max_element( pValues, pHigh ) );
+
+							pOut[ x ] = static_cast< float >( 0.5 * ( gLow + *pHigh ) );
+						}
+
+						else
+						{
+							std::sort( pValues, pValues + uiFrames );
+
+							pOut[ x ] = static_cast< float >( combineSorted( pValues, uiFrames ) );
+						}
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  combineSorted                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sigma clips one pixel from its sorted values. The values kept are always a contiguous range of the      |
+		// |  sorted values, so each iteration only moves the range ends with a binary search.                        |
+		// |                                                                                                          |
+		// |  <IN> -> pValues - The sorted values.                                                                    |
+		// |  <IN> -> uiCount - The number of values.                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		double CArcCombine<T>::combineSorted( const double* pValues, const std::uint32_t uiCount ) const noexcept
+		{
+			const double* pLo = pValues;
+			const double* pHi = ( pValues + uiCount );
+
+			for ( std::uint32_t uiIteration = 0; uiIteration < m_uiIterations; uiIteration++ )
+			{
+				const std::size_t uiKept = static_cast< std::size_t >( pHi - pLo );
+
+				if ( uiKept < 3 )
+				{
+					break;
+				}
+
+				const double gMedian = ( 0.5 * ( pLo[ ( uiKept - 1 ) / 2 ] + pLo[ uiKept / 2 ] ) );
+
+				double gMean = 0.0;
+
+				for ( const double* p = pLo; p < pHi; p++ )
+				{
+					gMean += *p;
+				}
+
+				gMean /= static_cast< double >( uiKept );
+
+				double gM2 = 0.0;
+
+				for ( const double* p = pLo; p < pHi; p++ )
+				{
+					gM2 += ( ( *p - gMean ) * ( *p - gMean ) );
+				}
+
+				const double gStdDev = std::sqrt( gM2 / static_cast< double >( uiKept - 1 ) );
+
+				const double* pNewLo = std::lower_bound( pLo, pHi, ( gMedian - m_gLow * gStdDev ) );
+				const double* pNewHi = std::upper_bound( pLo, pHi, ( gMedian + m_gHigh * gStdDev ) );
+
+				if ( pNewLo == pLo && pNewHi == pHi )
+				{
+					break;
+				}
+
+				pLo = pNewLo;
+				pHi = pNewHi;
+			}
+
+			double gSum = 0.0;
+
+			for ( const double* p = pLo; p < pHi; p++ )
+			{
+				gSum += *p;
+			}
+
+			return ( gSum / static_cast< double >( pHi - pLo ) );
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcCombine<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcCombine<arc::gen3::image::BPP_32>;
@@ -0,0 +1,581 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcDisplayScale.cpp  ( Gen3 )                                                                           |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC display scaling engine.                                                   |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <CArcDisplayScale.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace
+		{
+			// Default LOG exponent, as used by ds9.
+			constexpr double LOG_EXPONENT = 1000.0;
+
+			// Default ASINH softening.
+			constexpr double ASINH_SOFTENING = 0.1;
+
+			// Applies a stretch function to a normalized value in [ 0, 1 ].
+			double stretch( const arc::gen3::image::e_Stretch eStretch, const double gParam, const double gValue )
+			{
+				switch ( eStretch )
+				{
+					case arc::gen3::image::e_Stretch::LOG:
+						return ( std::log1p( gParam * gValue ) / std::log1p( gParam ) );
+
+					case arc::gen3::image::e_Stretch::ASINH:
+						return ( std::asinh( gValue / gParam ) / std::asinh( 1.0 / gParam ) );
+
+					default:
+						return gValue;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates an engine with zscale limits and a linear stretch.                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcDisplayScale<T>::CArcDisplayScale( void )
+			: CArcBase(), m_eLimits( arc::gen3::image::e_ScaleLimits::ZSCALE ), m_eStretch( arc::gen3::image::e_Stretch::LINEAR ), m_gParam( 0.0 ),
+			  m_gContrast( 0.25 ), m_gLowPercent( 0.25 ), m_gHighPercent( 99.75 ), m_tManual( 0.0, 1.0 ), m_uiSamples( 10000 ), m_gTolerance( 0.002 ),
+			  m_uiThreads( 1 ), m_tLimits( 0.0, 0.0 ), m_bDirty( true ), m_uiBuilds( 0 )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcDisplayScale<T>::~CArcDisplayScale( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setZScale                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Selects zscale limits.                                                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> gContrast - The zscale contrast.                                                                |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setZScale( const double gContrast )
+		{
+			if ( !( gContrast > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid zscale contrast [ %f ], must be positive.", gContrast );
+			}
+
+			m_eLimits = arc::gen3::image::e_ScaleLimits::ZSCALE;
+
+			m_gContrast = gContrast;
+
+			m_bDirty = true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setPercentile                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Selects percentile limits.                                                                              |
+		// |                                                                                                          |
+		// |  <IN> -> gLow  - The lower percentile.                                                                   |
+		// |  <IN> -> gHigh - The upper percentile.                                                                   |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setPercentile( const double gLow, const double gHigh )
+		{
+			if ( !( gLow >= 0.0 && gLow < gHigh && gHigh <= 100.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid percentiles [ %f, %f ].", gLow, gHigh );
+			}
+
+			m_eLimits = arc::gen3::image::e_ScaleLimits::PERCENTILE;
+
+			m_gLowPercent = gLow;
+
+			m_gHighPercent = gHigh;
+
+			m_bDirty = true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setLimits                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Selects fixed limits.                                                                                   |
+		// |                                                                                                          |
+		// |  <IN> -> gLow  - The value shown as black.                                                               |
+		// |  <IN> -> gHigh - The value shown as white.                                                               |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setLimits( const double gLow, const double gHigh )
+		{
+			if ( !( gLow < gHigh ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid limits [ %f, %f ].", gLow, gHigh );
+			}
+
+			m_eLimits = arc::gen3::image::e_ScaleLimits::MANUAL;
+
+			m_tManual = std::make_pair( gLow, gHigh );
+
+			m_bDirty = true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setStretch                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the stretch function.                                                                              |
+		// |                                                                                                          |
+		// |  <IN> -> eStretch - The stretch function.                                                                |
+		// |  <IN> -> gParam   - The LOG exponent or the ASINH softening. Zero selects the default.                   |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setStretch( const arc::gen3::image::e_Stretch eStretch, const double gParam )
+		{
+			if ( !( gParam >= 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid stretch parameter [ %f ], must not be negative.", gParam );
+			}
+
+			m_eStretch = eStretch;
+
+			if ( gParam > 0.0 )
+			{
+				m_gParam = gParam;
+			}
+			else
+			{
+				m_gParam = ( eStretch == arc::gen3::image::e_Stretch::LOG ? LOG_EXPONENT : ASINH_SOFTENING );
+			}
+
+			m_bDirty = true;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setSampleSize                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the number of pixels sampled to estimate the limits.                                               |
+		// |                                                                                                          |
+		// |  <IN> -> uiSamples - The number of samples.                                                              |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setSampleSize( const std::uint32_t uiSamples )
+		{
+			if ( uiSamples == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid sample size, must not be zero."s );
+			}
+
+			m_uiSamples = uiSamples;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setTolerance                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets how far the limits may move, as a fraction of the current limit range, before the table is         |
+		// |  rebuilt. Zero rebuilds the table whenever the limits change.                                            |
+		// |                                                                                                          |
+		// |  <IN> -> gTolerance - The tolerance.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setTolerance( const double gTolerance ) noexcept
+		{
+			m_gTolerance = ( gTolerance > 0.0 ? gTolerance : 0.0 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setThreads                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the number of threads the frame is split over.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::setThreads( const std::uint32_t uiThreads ) noexcept
+		{
+			m_uiThreads = uiThreads;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  scale                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Scales a frame to an 8-bit preview. The limits are estimated first; the lookup table is rebuilt only if |
+		// |  the limits moved by more than the tolerance or a setting changed. 16-bit pixels index the table         |
+		// |  directly, 32-bit pixels are quantized to a table index between the limits.                              |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc    - The source view.                                                                      |
+		// |  <IN> -> pDstBuf - Pointer to a buffer of cols x rows bytes.                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::scale( const arc::gen3::image::ImageView<const T>& tSrc, std::uint8_t* pDstBuf )
+		{
+			if ( tSrc.data() == nullptr || pDstBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			CArcImage<T>::verifyDimensions( tSrc.cols(), tSrc.rows() );
+
+			const auto tLimits = estimateLimits( tSrc );
+
+			const double gRange = ( m_tLimits.second - m_tLimits.first );
+
+			if ( m_bDirty || std::abs( tLimits.first - m_tLimits.first ) > ( m_gTolerance * gRange ) ||
+							 std::abs( tLimits.second - m_tLimits.second ) > ( m_gTolerance * gRange ) )
+			{
+				m_tLimits = tLimits;
+
+				buildTable();
+			}
+
+			const std::uint8_t* pTable = m_vTable.data();
+
+			const std::uint32_t uiCols = tSrc.cols();
+
+			const double gLow = m_tLimits.first;
+
+			const double gIndex = ( static_cast< double >( TABLE_SIZE - 1 ) / ( m_tLimits.second - m_tLimits.first ) );
+
+			CArcImage<T>::forEachRowBlock( 0, tSrc.rows(), m_uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const T* pSrc = tSrc.rowData( uiRow );
+
+					std::uint8_t* pDst = ( pDstBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+					if constexpr ( sizeof( T ) <= sizeof( std::uint16_t ) )
+					{
+						for ( std::uint32_t i = 0; i < uiCols; i++ )
+						{
+							pDst[ i ] = pTable[ pSrc[ i ] ];
+						}
+					}
+					else
+					{
+						constexpr double gMax = static_cast< double >( TABLE_SIZE - 1 );
+
+						for ( std::uint32_t i = 0; i < uiCols; i++ )
+						{
+							const double gValue = ( ( static_cast< double >( pSrc[ i ] ) - gLow ) * gIndex + 0.5 );
+
+							pDst[ i ] = pTable[ static_cast< std::uint32_t >( gValue < 0.0 ? 0.0 : ( gValue > gMax ? gMax : gValue ) ) ];
+						}
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  scale                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Scales a frame to an 8-bit preview.                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> pSrcBuf - Pointer to the image buffer.                                                          |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> pDstBuf - Pointer to a buffer of cols x rows bytes.                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::scale( const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint8_t* pDstBuf )
+		{
+			scale( arc::gen3::image::ImageView<const T>( pSrcBuf, uiCols, uiRows ), pDstBuf );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  limits                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the limits used by the last scale() call.                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::pair<double, double> CArcDisplayScale<T>::limits( void ) const noexcept
+		{
+			return m_tLimits;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  tableBuilds                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of times the lookup table has been built.                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcDisplayScale<T>::tableBuilds( void ) const noexcept
+		{
+			return m_uiBuilds;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  estimateLimits                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Estimates the limits of a frame. The sample is a grid of about m_uiSamples pixels spread evenly over    |
+		// |  the frame, with the grid rows and columns in proportion to the frame shape. Limits that are equal are   |
+		// |  widened by one so the table has a non-zero range.                                                       |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::pair<double, double> CArcDisplayScale<T>::estimateLimits( const arc::gen3::image::ImageView<const T>& tSrc )
+		{
+			if ( m_eLimits == arc::gen3::image::e_ScaleLimits::MANUAL )
+			{
+				return m_tManual;
+			}
+
+			const double gCols = static_cast< double >( tSrc.cols() );
+			const double gRows = static_cast< double >( tSrc.rows() );
+
+			const std::uint32_t uiGridRows = static_cast< std::uint32_t >( std::clamp( std::round( std::sqrt( m_uiSamples * gRows / gCols ) ), 1.0, gRows ) );
+			const std::uint32_t uiGridCols = static_cast< std::uint32_t >( std::clamp( std::floor( m_uiSamples / static_cast< double >( uiGridRows ) ), 1.0, gCols ) );
+
+			m_vSample.resize( static_cast< std::size_t >( uiGridRows ) * uiGridCols );
+
+			std::size_t uiIndex = 0;
+
+			for ( std::uint32_t r = 0; r < uiGridRows; r++ )
+			{
+				const T* pRow = tSrc.rowData( static_cast< std::uint32_t >( ( r + 0.5 ) * gRows / uiGridRows ) );
+
+				for ( std::uint32_t c = 0; c < uiGridCols; c++ )
+				{
+					m_vSample[ uiIndex++ ] = pRow[ static_cast< std::uint32_t >( ( c + 0.5 ) * gCols / uiGridCols ) ];
+				}
+			}
+
+			std::sort( m_vSample.begin(), m_vSample.end() );
+
+			std::pair<double, double> tLimits;
+
+			if ( m_eLimits == arc::gen3::image::e_ScaleLimits::ZSCALE )
+			{
+				tLimits = zscale();
+			}
+			else
+			{
+				auto fnPercentile = [ & ]( const double gPercent )
+				{
+					const double gRank = ( gPercent / 100.0 * static_cast< double >( m_vSample.size() - 1 ) );
+
+					const std::size_t uiRank = static_cast< std::size_t >( gRank );
+
+					const std::size_t uiNext = std::min( ( uiRank + 1 ), ( m_vSample.size() - 1 ) );
+
+					return ( m_vSample[ uiRank ] + ( gRank - static_cast< double >( uiRank ) ) * ( m_vSample[ uiNext ] - m_vSample[ uiRank ] ) );
+				};
+
+				tLimits = std::make_pair( fnPercentile( m_gLowPercent ), fnPercentile( m_gHighPercent ) );
+			}
+
+			if ( !( tLimits.second > tLimits.first ) )
+			{
+				tLimits.second = ( tLimits.first + 1.0 );
+			}
+
+			return tLimits;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  zscale                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the zscale limits of the sorted sample, following IRAF. A line is fitted to the sample value    |
+		// |  against its rank; samples more than 2.5 standard deviations from the line, and their neighbours, are    |
+		// |  rejected and the line is refitted, up to five times or until fewer than half the samples remain. The    |
+		// |  limits are the median minus and plus the fitted slope divided by the contrast, times the ranks either   |
+		// |  side of the median, clipped to the sample range.                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::pair<double, double> CArcDisplayScale<T>::zscale( void ) const
+		{
+			constexpr double gReject = 2.5;
+
+			constexpr std::uint32_t uiIterations = 5;
+
+			const std::size_t uiCount = m_vSample.size();
+
+			const double gMin = m_vSample.front();
+			const double gMax = m_vSample.back();
+
+			const std::size_t uiMinGood = std::max( static_cast< std::size_t >( 5 ), ( uiCount / 2 ) );
+			const std::size_t uiGrow    = std::max( static_cast< std::size_t >( 1 ), ( uiCount / 100 ) );
+
+			if ( uiCount < uiMinGood )
+			{
+				return std::make_pair( gMin, gMax );
+			}
+
+			std::vector<std::uint8_t> vBad( uiCount, 0 );
+
+			std::size_t uiGood = uiCount;
+			std::size_t uiLastGood = ( uiCount + 1 );
+
+			double gSlope = 0.0;
+
+			for ( std::uint32_t uiIter = 0; uiIter < uiIterations && uiGood < uiLastGood && uiGood >= uiMinGood; uiIter++ )
+			{
+				double gSumX = 0.0, gSumY = 0.0, gSumXX = 0.0, gSumXY = 0.0;
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					if ( !vBad[ i ] )
+					{
+						const double gX = static_cast< double >( i );
+
+						gSumX  += gX;
+						gSumY  += m_vSample[ i ];
+						gSumXX += ( gX * gX );
+						gSumXY += ( gX * m_vSample[ i ] );
+					}
+				}
+
+				const double gN = static_cast< double >( uiGood );
+				const double gDenom = ( gN * gSumXX - gSumX * gSumX );
+
+				gSlope = ( gDenom != 0.0 ? ( ( gN * gSumXY - gSumX * gSumY ) / gDenom ) : 0.0 );
+
+				const double gIntercept = ( ( gSumY - gSlope * gSumX ) / gN );
+
+				double gSumSq = 0.0, gSumFlat = 0.0;
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					if ( !vBad[ i ] )
+					{
+						const double gFlat = ( m_vSample[ i ] - ( gIntercept + gSlope * static_cast< double >( i ) ) );
+
+						gSumFlat += gFlat;
+						gSumSq   += ( gFlat * gFlat );
+					}
+				}
+
+				const double gMean = ( gSumFlat / gN );
+				const double gThreshold = ( gReject * std::sqrt( std::max( 0.0, ( gSumSq / gN - gMean * gMean ) ) ) );
+
+				std::vector<std::uint8_t> vReject( uiCount, 0 );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					const double gFlat = ( m_vSample[ i ] - ( gIntercept + gSlope * static_cast< double >( i ) ) );
+
+					if ( vBad[ i ] || std::abs( gFlat ) > gThreshold )
+					{
+						const std::size_t uiFirst = ( i > ( uiGrow / 2 ) ? ( i - ( uiGrow / 2 ) ) : 0 );
+						const std::size_t uiLast  = std::min( uiCount, ( i + ( uiGrow - uiGrow / 2 ) ) );
+
+						std::fill( vReject.begin() + uiFirst, vReject.begin() + uiLast, 1 );
+					}
+				}
+
+				vBad.swap( vReject );
+
+				uiLastGood = uiGood;
+
+				uiGood = static_cast< std::size_t >( std::count( vBad.begin(), vBad.end(), 0 ) );
+			}
+
+			if ( uiGood < uiMinGood )
+			{
+				return std::make_pair( gMin, gMax );
+			}
+
+			const std::size_t uiCenter = ( ( uiCount - 1 ) / 2 );
+
+			const double gMedian = ( uiCount % 2 ? m_vSample[ uiCenter ] : ( 0.5 * ( m_vSample[ uiCenter ] + m_vSample[ uiCenter + 1 ] ) ) );
+
+			gSlope /= m_gContrast;
+
+			return std::make_pair( std::max( gMin, ( gMedian - ( static_cast< double >( uiCenter ) - 1.0 ) * gSlope ) ),
+								   std::min( gMax, ( gMedian + static_cast< double >( uiCount - uiCenter ) * gSlope ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  buildTable                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Builds the lookup table for the current limits and stretch. For 16-bit data entry v is the output for   |
+		// |  pixel value v; for 32-bit data the entries span the limits evenly.                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcDisplayScale<T>::buildTable( void )
+		{
+			m_vTable.resize( TABLE_SIZE );
+
+			const double gLow = m_tLimits.first;
+			const double gRange = ( m_tLimits.second - m_tLimits.first );
+
+			for ( std::uint32_t i = 0; i < TABLE_SIZE; i++ )
+			{
+				double gValue = 0.0;
+
+				if constexpr ( sizeof( T ) <= sizeof( std::uint16_t ) )
+				{
+					gValue = std::clamp( ( ( static_cast< double >( i ) - gLow ) / gRange ), 0.0, 1.0 );
+				}
+				else
+				{
+					gValue = ( static_cast< double >( i ) / static_cast< double >( TABLE_SIZE - 1 ) );
+				}
+
+				m_vTable[ i ] = static_cast< std::uint8_t >( std::lround( 255.0 * std::clamp( stretch( m_eStretch, m_gParam, gValue ), 0.0, 1.0 ) ) );
+			}
+
+			m_bDirty = false;
+
+			m_uiBuilds++;
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcDisplayScale<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcDisplayScale<arc::gen3::image::BPP_32>;
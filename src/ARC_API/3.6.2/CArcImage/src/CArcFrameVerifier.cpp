@@ -0,0 +1,200 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcFrameVerifier.cpp  ( Gen3 )                                                                          |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC streaming synthetic image verifier.                                       |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+#include <CArcFrameVerifier.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a verifier for the ramp synthetic image, with a period of maxTVal().                            |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcFrameVerifier<T>::CArcFrameVerifier( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_bRamp( true ), m_uiStart( 0 ), m_uiPeriod( CArcImage<T>::maxTVal() ), m_uiPosition( 0 ),
+			  m_tReport( { 0, 0, 0, 0, 0, 0, 0, 0 } )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcFrameVerifier<T>::~CArcFrameVerifier( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setRamp                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Selects a ramp pattern and resets the verifier.                                                         |
+		// |                                                                                                          |
+		// |  <IN> -> uiStart  - The value of the first pixel of every frame.                                         |
+		// |  <IN> -> uiPeriod - The ramp period.                                                                     |
+		// |                                                                                                          |
+		// |  Throws std::out_of_range                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFrameVerifier<T>::setRamp( const std::uint32_t uiStart, const std::uint64_t uiPeriod )
+		{
+			constexpr std::uint64_t uiPeriodMax = ( static_cast< std::uint64_t >( std::numeric_limits<T>::max() ) + 1 );
+
+			if ( uiPeriod == 0 || uiPeriod > uiPeriodMax )
+			{
+				throwArcGen3OutOfRange( uiPeriod, std::make_pair( static_cast< std::uint64_t >( 1 ), uiPeriodMax ) );
+			}
+
+			if ( uiStart >= uiPeriod )
+			{
+				throwArcGen3OutOfRange( uiStart, std::make_pair( static_cast< std::uint64_t >( 0 ), ( uiPeriod - 1 ) ) );
+			}
+
+			m_bRamp = true;
+
+			m_uiStart = uiStart;
+
+			m_uiPeriod = uiPeriod;
+
+			reset();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setConstant                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Selects a constant pattern and resets the verifier.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiValue - The expected value.                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFrameVerifier<T>::setConstant( const T uiValue )
+		{
+			m_bRamp = false;
+
+			m_uiStart = uiValue;
+
+			reset();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  push                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Checks the next pixels of the stream. The pixels are split at frame boundaries and each part is         |
+		// |  compared against the pattern from the current frame position.                                           |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf    - Pointer to the pixels.                                                                |
+		// |  <IN> -> uiCount - The number of pixels.                                                                 |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFrameVerifier<T>::push( const T* pBuf, const std::size_t uiCount )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			const std::uint64_t uiFrameSize = ( static_cast< std::uint64_t >( m_uiCols ) * m_uiRows );
+
+			for ( std::size_t i = 0; i < uiCount; )
+			{
+				const std::size_t uiPart = static_cast< std::size_t >( std::min( static_cast< std::uint64_t >( uiCount - i ), ( uiFrameSize - m_uiPosition ) ) );
+
+				const std::uint64_t uiValue = ( m_bRamp ? ( ( m_uiStart + m_uiPosition % m_uiPeriod ) % m_uiPeriod ) : m_uiStart );
+
+				std::size_t uiFirst = uiPart;
+
+				const std::uint64_t uiErrors = ( m_bRamp ? CArcImage<T>::compareRamp( ( pBuf + i ), uiPart, uiValue, m_uiPeriod, uiFirst ) :
+														   CArcImage<T>::compareConstant( ( pBuf + i ), uiPart, static_cast< T >( uiValue ), uiFirst ) );
+
+				if ( uiErrors > 0 && m_tReport.uiErrors == 0 )
+				{
+					const std::uint64_t uiPixel = ( m_uiPosition + uiFirst );
+
+					m_tReport.uiFrame = m_tReport.uiFrames;
+					m_tReport.uiCol = static_cast< std::uint32_t >( uiPixel % m_uiCols );
+					m_tReport.uiRow = static_cast< std::uint32_t >( uiPixel / m_uiCols );
+					m_tReport.uiExpected = static_cast< std::uint32_t >( m_bRamp ? ( ( uiValue + uiFirst ) % m_uiPeriod ) : uiValue );
+					m_tReport.uiFound = pBuf[ i + uiFirst ];
+				}
+
+				m_tReport.uiErrors += uiErrors;
+
+				m_tReport.uiPixels += uiPart;
+
+				m_uiPosition += uiPart;
+
+				if ( m_uiPosition == uiFrameSize )
+				{
+					m_tReport.uiFrames++;
+
+					m_uiPosition = 0;
+				}
+
+				i += uiPart;
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  report                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the accumulated report.                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const arc::gen3::image::VerifyReport_t& CArcFrameVerifier<T>::report( void ) const noexcept
+		{
+			return m_tReport;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  reset                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Clears the report and restarts at the first pixel of a frame.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcFrameVerifier<T>::reset( void ) noexcept
+		{
+			m_tReport = { 0, 0, 0, 0, 0, 0, 0, 0 };
+
+			m_uiPosition = 0;
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcFrameVerifier<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcFrameVerifier<arc::gen3::image::BPP_32>;
@@ -0,0 +1,771 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcHistogram.cpp  ( Gen3 )                                                                              |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC image histogram engine.                                                   |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <limits>
+#include <memory>
+
+#include <CArcHistogram.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates an exact histogram over the full data type range. 16-bit histograms are binned with one bin     |
+		// |  per value, 32-bit histograms are sparse.                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcHistogram<T>::CArcHistogram( void )
+			: CArcBase(), m_eMode( arc::gen3::image::e_HistMode::SPARSE ), m_uiBins( 0 ), m_tMin( 0 ), m_tMax( std::numeric_limits<T>::max() ),
+			  m_uiScale( 0 ), m_uiUnder( 0 ), m_uiOver( 0 ), m_uiTotal( 0 ), m_pBins( nullptr )
+		{
+			if constexpr ( sizeof( T ) == sizeof( arc::gen3::image::BPP_16 ) )
+			{
+				m_eMode = arc::gen3::image::e_HistMode::BINNED;
+				m_uiBins = ( static_cast< std::uint32_t >( std::numeric_limits<T>::max() ) + 1 );
+				m_uiScale = ( static_cast< std::uint64_t >( 1 ) << 32 );
+			}
+
+			else
+			{
+				m_vPages.resize( ( static_cast< std::uint64_t >( std::numeric_limits<T>::max() ) + 1 ) / PAGE_SIZE );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a binned histogram over the values tMin to tMax inclusive.                                      |
+		// |                                                                                                          |
+		// |  <IN> -> uiBins - The number of bins. Must not exceed the number of values in the range.                 |
+		// |  <IN> -> tMin   - The lowest value of the first bin.                                                     |
+		// |  <IN> -> tMax   - The highest value of the last bin.                                                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcHistogram<T>::CArcHistogram( const std::uint32_t uiBins, const T tMin, const T tMax )
+			: CArcBase(), m_eMode( arc::gen3::image::e_HistMode::BINNED ), m_uiBins( uiBins ), m_tMin( tMin ), m_tMax( tMax ),
+			  m_uiScale( 0 ), m_uiUnder( 0 ), m_uiOver( 0 ), m_uiTotal( 0 ), m_pBins( nullptr )
+		{
+			if ( tMin > tMax )
+			{
+				throwArcGen3InvalidArgument( "Invalid histogram range [ %u - %u ], the minimum exceeds the maximum.",
+											 static_cast< std::uint32_t >( tMin ), static_cast< std::uint32_t >( tMax ) );
+			}
+
+			const std::uint64_t uiRange = ( static_cast< std::uint64_t >( tMax ) - tMin + 1 );
+
+			if ( uiBins == 0 || uiBins > uiRange )
+			{
+				throwArcGen3InvalidArgument( "Invalid histogram bin count [ %u ], must be 1 to %J for the range [ %u - %u ].",
+											 uiBins, uiRange, static_cast< std::uint32_t >( tMin ), static_cast< std::uint32_t >( tMax ) );
+			}
+
+			m_uiScale = ( ( static_cast< std::uint64_t >( uiBins ) << 32 ) / uiRange );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcHistogram<T>::~CArcHistogram( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  mode                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the bin storage mode.                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::image::e_HistMode CArcHistogram<T>::mode( void ) const noexcept
+		{
+			return m_eMode;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  bins                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of bins. A sparse histogram has one bin per data type value.                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::bins( void ) const noexcept
+		{
+			if ( m_eMode == arc::gen3::image::e_HistMode::SPARSE )
+			{
+				return ( static_cast< std::uint64_t >( std::numeric_limits<T>::max() ) + 1 );
+			}
+
+			return m_uiBins;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  binLow                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the lowest value of a bin. Bin k holds the values v for which ( ( v - min ) x scale ) >> 32     |
+		// |  equals k, so its lowest value is min + ceil( k x 2^32 / scale ).                                        |
+		// |                                                                                                          |
+		// |  <IN> -> uiBin - The bin index.                                                                          |
+		// |                                                                                                          |
+		// |  Throws std::out_of_range                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		T CArcHistogram<T>::binLow( const std::uint64_t uiBin ) const
+		{
+			if ( uiBin >= bins() )
+			{
+				throwArcGen3OutOfRange( static_cast< std::uint32_t >( uiBin ), std::make_pair( static_cast< std::uint32_t >( 0 ), static_cast< std::uint32_t >( bins() - 1 ) ) );
+			}
+
+			if ( m_eMode == arc::gen3::image::e_HistMode::SPARSE )
+			{
+				return static_cast< T >( uiBin );
+			}
+
+			return static_cast< T >( m_tMin + ( ( uiBin << 32 ) + m_uiScale - 1 ) / m_uiScale );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  attach                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Directs a binned histogram to count into a caller owned buffer. The buffer contents are kept.           |
+		// |                                                                                                          |
+		// |  <IN> -> pBins - The bin buffer, bins() counts. nullptr reverts to the internal buffer.                  |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::attach( std::uint32_t* pBins )
+		{
+			if ( m_eMode != arc::gen3::image::e_HistMode::BINNED )
+			{
+				throwArcGen3InvalidArgument( "A caller owned bin buffer requires a binned histogram."s );
+			}
+
+			m_pBins = ( pBins != nullptr ? pBins : ( m_vBins.empty() ? nullptr : m_vBins.data() ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  data                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the counts of a binned histogram, or nullptr for a sparse histogram or before the first pass.   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::uint32_t* CArcHistogram<T>::data( void ) const noexcept
+		{
+			return m_pBins;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  clear                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Zeroes all counts. Sparse pages are kept for reuse by the next frame.                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::clear( void )
+		{
+			if ( m_eMode == arc::gen3::image::e_HistMode::BINNED )
+			{
+				if ( m_pBins == nullptr )
+				{
+					m_vBins.assign( m_uiBins, 0 );
+
+					m_pBins = m_vBins.data();
+				}
+
+				else
+				{
+					zeroMemory( m_pBins, ( static_cast< std::size_t >( m_uiBins ) * sizeof( std::uint32_t ) ) );
+				}
+			}
+
+			else
+			{
+				for ( auto& pPage : m_vPages )
+				{
+					if ( pPage != nullptr )
+					{
+						zeroMemory( pPage.get(), ( PAGE_SIZE * sizeof( std::uint32_t ) ) );
+					}
+				}
+			}
+
+			m_uiUnder = m_uiOver = m_uiTotal = 0;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compute                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Zeroes all counts and counts the pixels of an image.                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::compute( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			compute( pBuf, uiCols, uiRows, arc::gen3::image::Roi_t{ 0, uiCols, 0, uiRows }, uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compute                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Zeroes all counts and counts the pixels of an image region.                                             |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> tRoi      - The image region.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::compute( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads )
+		{
+			verifyRegion( pBuf, uiCols, uiRows, tRoi );
+
+			clear();
+
+			countRegion( pBuf, uiCols, tRoi, uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  accumulate                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds the pixels of an image to the counts.                                                              |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::accumulate( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			accumulate( pBuf, uiCols, uiRows, arc::gen3::image::Roi_t{ 0, uiCols, 0, uiRows }, uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  accumulate                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds the pixels of an image region to the counts.                                                       |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> tRoi      - The image region.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::accumulate( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads )
+		{
+			verifyRegion( pBuf, uiCols, uiRows, tRoi );
+
+			if ( m_eMode == arc::gen3::image::e_HistMode::BINNED && m_pBins == nullptr )
+			{
+				clear();
+			}
+
+			countRegion( pBuf, uiCols, tRoi, uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  count                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the count of a bin. For a sparse histogram the bin index is the pixel value.                    |
+		// |                                                                                                          |
+		// |  <IN> -> uiBin - The bin index.                                                                          |
+		// |                                                                                                          |
+		// |  Throws std::out_of_range                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::count( const std::uint64_t uiBin ) const
+		{
+			if ( uiBin >= bins() )
+			{
+				throwArcGen3OutOfRange( static_cast< std::uint32_t >( uiBin ), std::make_pair( static_cast< std::uint32_t >( 0 ), static_cast< std::uint32_t >( bins() - 1 ) ) );
+			}
+
+			if ( m_eMode == arc::gen3::image::e_HistMode::SPARSE )
+			{
+				const auto& pPage = m_vPages[ uiBin / PAGE_SIZE ];
+
+				return ( pPage != nullptr ? pPage[ uiBin % PAGE_SIZE ] : 0 );
+			}
+
+			return ( m_pBins != nullptr ? m_pBins[ uiBin ] : 0 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  total                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the total number of pixels counted, including underflow and overflow.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::total( void ) const noexcept
+		{
+			return m_uiTotal;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  underflow                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of pixels below the range of a binned histogram.                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::underflow( void ) const noexcept
+		{
+			return m_uiUnder;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  overflow                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of pixels above the range of a binned histogram.                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::overflow( void ) const noexcept
+		{
+			return m_uiOver;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  percentile                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns a percentile of the counted pixel values using the nearest rank method, i.e. the value of the   |
+		// |  ceil( p x N / 100 )th smallest pixel. Within bins wider than one value the result is interpolated       |
+		// |  assuming the bin's pixels are evenly spread over it. One walk over the bins; sparse pages without data  |
+		// |  are skipped.                                                                                            |
+		// |                                                                                                          |
+		// |  <IN> -> gPercent - The percentile, 0 to 100.                                                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::runtime_error                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		double CArcHistogram<T>::percentile( const double gPercent ) const
+		{
+			if ( !( gPercent >= 0.0 && gPercent <= 100.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid percentile [ %f ], must be 0 to 100.", gPercent );
+			}
+
+			if ( m_uiTotal == 0 )
+			{
+				throwArcGen3Error( "No pixels have been counted."s );
+			}
+
+			const std::uint64_t uiRank = std::max( static_cast< std::uint64_t >( 1 ),
+												   static_cast< std::uint64_t >( std::ceil( gPercent * static_cast< double >( m_uiTotal ) / 100.0 ) ) );
+
+			std::uint64_t uiCum = m_uiUnder;
+
+			if ( uiCum >= uiRank )
+			{
+				return static_cast< double >( m_tMin );
+			}
+
+			if ( m_eMode == arc::gen3::image::e_HistMode::SPARSE )
+			{
+				for ( std::size_t p = 0; p < m_vPages.size(); p++ )
+				{
+					const std::uint32_t* pPage = m_vPages[ p ].get();
+
+					if ( pPage == nullptr ) { continue; }
+
+					std::uint64_t uiPageSum = 0;
+
+					for ( std::uint64_t i = 0; i < PAGE_SIZE; i++ )
+					{
+						uiPageSum += pPage[ i ];
+					}
+
+					if ( uiCum + uiPageSum < uiRank )
+					{
+						uiCum += uiPageSum;
+
+						continue;
+					}
+
+					for ( std::uint64_t i = 0; i < PAGE_SIZE; i++ )
+					{
+						uiCum += pPage[ i ];
+
+						if ( uiCum >= uiRank )
+						{
+							return static_cast< double >( p * PAGE_SIZE + i );
+						}
+					}
+				}
+			}
+
+			else if ( m_pBins != nullptr )
+			{
+				for ( std::uint32_t k = 0; k < m_uiBins; k++ )
+				{
+					if ( uiCum + m_pBins[ k ] >= uiRank )
+					{
+						const double gLow = static_cast< double >( binLow( k ) );
+
+						const double gWidth = ( ( k + 1 < m_uiBins ? static_cast< double >( binLow( k + 1 ) ) : ( static_cast< double >( m_tMax ) + 1.0 ) ) - gLow );
+
+						if ( gWidth <= 1.0 )
+						{
+							return gLow;
+						}
+
+						return ( gLow + gWidth * ( static_cast< double >( uiRank - uiCum ) - 0.5 ) / static_cast< double >( m_pBins[ k ] ) );
+					}
+
+					uiCum += m_pBins[ k ];
+				}
+			}
+
+			return static_cast< double >( m_tMax );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  median                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the median of the counted pixel values.                                                         |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		double CArcHistogram<T>::median( void ) const
+		{
+			return percentile( 50.0 );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  memoryBytes                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the bin memory held by the engine, including the per-thread sub-histograms. A caller owned      |
+		// |  buffer is not included.                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcHistogram<T>::memoryBytes( void ) const noexcept
+		{
+			auto pageBytes = []( const PageTable_t& vPages )
+			{
+				std::uint64_t uiBytes = 0;
+
+				for ( const auto& pPage : vPages )
+				{
+					if ( pPage != nullptr ) { uiBytes += ( PAGE_SIZE * sizeof( std::uint32_t ) ); }
+				}
+
+				return uiBytes;
+			};
+
+			std::uint64_t uiBytes = ( ( m_vBins.capacity() + m_vThreadBins.capacity() ) * sizeof( std::uint32_t ) ) + pageBytes( m_vPages );
+
+			for ( const auto& vPages : m_vThreadPages )
+			{
+				uiBytes += pageBytes( vPages );
+			}
+
+			return uiBytes;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  countRegion                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Counts the pixels of an image region. The rows are split into blocks; the first block counts directly   |
+		// |  into the histogram and every other block into a private sub-histogram, so threads never write the same  |
+		// |  bins. A block is only added if the region has at least as many pixels per block as there are bins to    |
+		// |  merge, so small regions are counted on the calling thread alone. The sub-histograms are added into the  |
+		// |  histogram and zeroed in the same pass, so they are ready for the next frame without a clearing pass.    |
+		// |  Sparse sub-histogram pages that were not used by a frame are released.                                  |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> tRoi      - The image region.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads.                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::countRegion( const T* pBuf, const std::uint32_t uiCols, const arc::gen3::image::Roi_t& tRoi, const std::uint32_t uiThreads )
+		{
+			const std::uint32_t uiWidth = ( tRoi.uiCol2 - tRoi.uiCol1 );
+
+			const std::uint64_t uiPixels = ( static_cast< std::uint64_t >( uiWidth ) * ( tRoi.uiRow2 - tRoi.uiRow1 ) );
+
+			const std::uint64_t uiMergeBins = ( m_eMode == arc::gen3::image::e_HistMode::BINNED ? m_uiBins : PAGE_SIZE );
+
+			const std::uint32_t uiBlocks = static_cast< std::uint32_t >( std::max<std::uint64_t>( 1, std::min<std::uint64_t>( { CArcImage<T>::threadCount( uiThreads ),
+																																  ( tRoi.uiRow2 - tRoi.uiRow1 ),
+																																  ( uiPixels / uiMergeBins ) } ) ) );
+
+			std::vector<std::uint64_t> vUnder( uiBlocks, 0 );
+			std::vector<std::uint64_t> vOver( uiBlocks, 0 );
+
+			//
+			// The sub-histograms are all zero between calls; new ones start zeroed
+			//
+			if ( m_eMode == arc::gen3::image::e_HistMode::BINNED )
+			{
+				m_vThreadBins.resize( static_cast< std::size_t >( uiBlocks - 1 ) * m_uiBins, 0 );
+			}
+
+			else
+			{
+				m_vThreadPages.resize( uiBlocks - 1 );
+
+				for ( auto& vPages : m_vThreadPages )
+				{
+					vPages.resize( m_vPages.size() );
+				}
+			}
+
+			try
+			{
+				CArcImage<T>::forEachRowBlock( tRoi.uiRow1, tRoi.uiRow2, uiBlocks, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+					{
+						const T* pRow = pBuf + ( static_cast< std::uint64_t >( uiRow ) * uiCols + tRoi.uiCol1 );
+
+						if ( m_eMode == arc::gen3::image::e_HistMode::BINNED )
+						{
+							std::uint32_t* pBins = ( uiBlock == 0 ? m_pBins : &m_vThreadBins[ static_cast< std::size_t >( uiBlock - 1 ) * m_uiBins ] );
+
+							countBinned( pRow, uiWidth, pBins, vUnder[ uiBlock ], vOver[ uiBlock ] );
+						}
+
+						else
+						{
+							countSparse( pRow, uiWidth, ( uiBlock == 0 ? m_vPages : m_vThreadPages[ uiBlock - 1 ] ) );
+						}
+					}
+				} );
+			}
+			catch ( ... )
+			{
+				m_vThreadBins.clear();
+				m_vThreadPages.clear();
+
+				throw;
+			}
+
+			//
+			// Merge and zero the sub-histograms
+			//
+			for ( std::uint32_t b = 1; b < uiBlocks; b++ )
+			{
+				if ( m_eMode == arc::gen3::image::e_HistMode::BINNED )
+				{
+					std::uint32_t* pSub = &m_vThreadBins[ static_cast< std::size_t >( b - 1 ) * m_uiBins ];
+
+					for ( std::uint32_t k = 0; k < m_uiBins; k++ )
+					{
+						m_pBins[ k ] += pSub[ k ];
+						pSub[ k ] = 0;
+					}
+				}
+
+				else
+				{
+					auto& vPages = m_vThreadPages[ b - 1 ];
+
+					for ( std::size_t p = 0; p < vPages.size(); p++ )
+					{
+						if ( vPages[ p ] == nullptr ) { continue; }
+
+						std::uint32_t* pSub = vPages[ p ].get();
+						std::uint32_t uiUsed = 0;
+
+						for ( std::uint64_t i = 0; i < PAGE_SIZE; i++ )
+						{
+							uiUsed |= pSub[ i ];
+						}
+
+						if ( uiUsed == 0 )
+						{
+							vPages[ p ].reset();
+
+							continue;
+						}
+
+						if ( m_vPages[ p ] == nullptr )
+						{
+							m_vPages[ p ].reset( new std::uint32_t[ PAGE_SIZE ]() );
+						}
+
+						std::uint32_t* pDst = m_vPages[ p ].get();
+
+						for ( std::uint64_t i = 0; i < PAGE_SIZE; i++ )
+						{
+							pDst[ i ] += pSub[ i ];
+							pSub[ i ] = 0;
+						}
+					}
+				}
+			}
+
+			for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+			{
+				m_uiUnder += vUnder[ b ];
+				m_uiOver += vOver[ b ];
+			}
+
+			m_uiTotal += uiPixels;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  countBinned                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Counts one row of pixels into a binned histogram. The bin index is a fixed point multiply instead of a  |
+		// |  division. A histogram with one bin per value over the full data type range skips the range checks.      |
+		// |                                                                                                          |
+		// |  <IN>    -> pRow    - Pointer to the first pixel.                                                        |
+		// |  <IN>    -> uiCount - The number of pixels.                                                              |
+		// |  <INOUT> -> pBins   - The bins to count into.                                                            |
+		// |  <INOUT> -> uiUnder - Incremented for each pixel below the range.                                        |
+		// |  <INOUT> -> uiOver  - Incremented for each pixel above the range.                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::countBinned( const T* pRow, const std::uint32_t uiCount, std::uint32_t* pBins, std::uint64_t& uiUnder, std::uint64_t& uiOver ) const noexcept
+		{
+			const T tMin = m_tMin;
+			const T tMax = m_tMax;
+			const std::uint64_t uiScale = m_uiScale;
+
+			if ( tMin == 0 && tMax == std::numeric_limits<T>::max() && uiScale == ( static_cast< std::uint64_t >( 1 ) << 32 ) )
+			{
+				for ( std::uint32_t i = 0; i < uiCount; i++ )
+				{
+					pBins[ pRow[ i ] ]++;
+				}
+
+				return;
+			}
+
+			for ( std::uint32_t i = 0; i < uiCount; i++ )
+			{
+				const T tVal = pRow[ i ];
+
+				if ( tVal < tMin )
+				{
+					uiUnder++;
+				}
+
+				else if ( tVal > tMax )
+				{
+					uiOver++;
+				}
+
+				else
+				{
+					pBins[ ( static_cast< std::uint64_t >( tVal - tMin ) * uiScale ) >> 32 ]++;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  countSparse                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Counts one row of pixels into a sparse histogram, allocating zeroed pages on first use.                 |
+		// |                                                                                                          |
+		// |  <IN>    -> pRow    - Pointer to the first pixel.                                                        |
+		// |  <IN>    -> uiCount - The number of pixels.                                                              |
+		// |  <INOUT> -> vPages  - The page table to count into.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::countSparse( const T* pRow, const std::uint32_t uiCount, PageTable_t& vPages )
+		{
+			for ( std::uint32_t i = 0; i < uiCount; i++ )
+			{
+				const std::uint64_t uiVal = pRow[ i ];
+
+				auto& pPage = vPages[ uiVal / PAGE_SIZE ];
+
+				if ( pPage == nullptr )
+				{
+					pPage.reset( new std::uint32_t[ PAGE_SIZE ]() );
+				}
+
+				pPage[ uiVal % PAGE_SIZE ]++;
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyRegion                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies an image buffer and region. Throws exception on error.                                         |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf   - Pointer to the image buffer.                                                           |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> tRoi   - The image region.                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcHistogram<T>::verifyRegion( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::Roi_t& tRoi )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid image buffer parameter ( NULL )."s );
+			}
+
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+
+			CArcImage<T>::verifyRegions( { tRoi }, uiCols, uiRows );
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcHistogram<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcHistogram<arc::gen3::image::BPP_32>;
@@ -11,12 +11,17 @@
 #include <iostream>
 #include <type_traits>
 #include <algorithm>
+#include <bit>
 #include <cstdint>
 #include <cstddef>
 #include <cstring>
 #include <memory>
 #include <cstdlib>
+#include <cmath>
+#include <limits>
+#include <vector>
 
+#include <CArcThreadPool.h>
 #include <CArcImage.h>
 
 using namespace std::string_literals;
@@ -28,6 +33,538 @@ namespace arc
 	namespace gen3
 	{
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Local helpers                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		namespace
+		{
+			// Partial statistics over a set of pixels. Partials are combined with the parallel form of Welford's
+			// algorithm ( Chan et al. ), so rows and row blocks can be accumulated independently and in any split.
+			struct StatsAccum_t
+			{
+				std::uint64_t	uiCount = 0;
+				std::uint64_t	uiSaturated = 0;
+				std::uint32_t	uiMin = std::numeric_limits<std::uint32_t>::max();
+				std::uint32_t	uiMax = 0;
+				double			gMean = 0.0;
+				double			gM2 = 0.0;
+
+				void merge( const StatsAccum_t& rOther ) noexcept
+				{
+					if ( rOther.uiCount == 0 ) { return; }
+
+					if ( uiCount == 0 ) { *this = rOther; return; }
+
+					const double gCountA = static_cast< double >( uiCount );
+					const double gCountB = static_cast< double >( rOther.uiCount );
+					const double gTotal = ( gCountA + gCountB );
+					const double gDelta = ( rOther.gMean - gMean );
+
+					gMean += ( gDelta * gCountB / gTotal );
+					gM2 += ( rOther.gM2 + gDelta * gDelta * gCountA * gCountB / gTotal );
+
+					uiCount += rOther.uiCount;
+					uiSaturated += rOther.uiSaturated;
+					uiMin = std::min( uiMin, rOther.uiMin );
+					uiMax = std::max( uiMax, rOther.uiMax );
+				}
+			};
+
+			// Accumulates one row of pixels. The loops are branch free so that the compiler can vectorize them.
+			// 16-bit rows use exact integer sums of the deviations from the first pixel and of their squares, so
+			// the variance of values near saturation does not cancel away; 32-bit squares overflow 64 bits, so
+			// their rows take a second pass over the ( now cached ) row for the squared deviations.
+			template <typename T>
+			void accumulateRow( const T* pRow, const std::uint32_t uiCount, const T uiSatVal, StatsAccum_t& rAccum ) noexcept
+			{
+				T uiMin = std::numeric_limits<T>::max();
+				T uiMax = 0;
+
+				std::uint64_t uiSaturated = 0;
+				std::uint64_t uiSum = 0;
+
+				StatsAccum_t cRow;
+
+				if constexpr ( sizeof( T ) == sizeof( std::uint16_t ) )
+				{
+					const std::int32_t iShift = pRow[ 0 ];
+
+					std::int64_t iSumDevs = 0;
+					std::uint64_t uiSumSqrs = 0;
+
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const T uiVal = pRow[ i ];
+						const std::int32_t iDev = ( static_cast< std::int32_t >( uiVal ) - iShift );
+
+						uiMin = ( uiVal < uiMin ? uiVal : uiMin );
+						uiMax = ( uiVal > uiMax ? uiVal : uiMax );
+						uiSaturated += ( uiVal >= uiSatVal ? 1 : 0 );
+						iSumDevs += iDev;
+						uiSumSqrs += static_cast< std::uint64_t >( static_cast< std::int64_t >( iDev ) * iDev );
+					}
+
+					const double gMeanDev = ( static_cast< double >( iSumDevs ) / uiCount );
+
+					cRow.gMean = ( iShift + gMeanDev );
+					cRow.gM2 = std::max( 0.0, ( static_cast< double >( uiSumSqrs ) - static_cast< double >( iSumDevs ) * gMeanDev ) );
+				}
+
+				else
+				{
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const T uiVal = pRow[ i ];
+
+						uiMin = ( uiVal < uiMin ? uiVal : uiMin );
+						uiMax = ( uiVal > uiMax ? uiVal : uiMax );
+						uiSaturated += ( uiVal >= uiSatVal ? 1 : 0 );
+						uiSum += uiVal;
+					}
+
+					const double gMean = ( static_cast< double >( uiSum ) / uiCount );
+
+					double gM2 = 0.0;
+
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const double gDev = ( static_cast< double >( pRow[ i ] ) - gMean );
+
+						gM2 += ( gDev * gDev );
+					}
+
+					cRow.gMean = gMean;
+					cRow.gM2 = gM2;
+				}
+
+				cRow.uiCount = uiCount;
+				cRow.uiSaturated = uiSaturated;
+				cRow.uiMin = uiMin;
+				cRow.uiMax = uiMax;
+
+				rAccum.merge( cRow );
+			}
+
+			// Accumulates every channel region over the rows [ uiRow1, uiRow2 ), one partial per channel.
+			template <typename T>
+			void accumulateChannels( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									 const std::vector<arc::gen3::image::Roi_t>& vChannels, const T uiSatVal, StatsAccum_t* pAccum ) noexcept
+			{
+				for ( std::uint32_t uiRow = uiRow1; uiRow < uiRow2; uiRow++ )
+				{
+					const T* pRow = pBuf + static_cast< std::uint64_t >( uiRow ) * uiCols;
+
+					for ( std::size_t c = 0; c < vChannels.size(); c++ )
+					{
+						const auto& rRoi = vChannels[ c ];
+
+						if ( uiRow >= rRoi.uiRow1 && uiRow < rRoi.uiRow2 )
+						{
+							accumulateRow( pRow + rRoi.uiCol1, ( rRoi.uiCol2 - rRoi.uiCol1 ), uiSatVal, pAccum[ c ] );
+						}
+					}
+				}
+			}
+
+			// Accumulates one row of a frame pair: both frames and their difference ( frame 1 - frame 2 ), in one
+			// pass. The difference partial only tracks the count, mean and squared deviations. As in accumulateRow(),
+			// 16-bit rows are summed exactly in integers and 32-bit rows take a second pass over the cached rows.
+			template <typename T>
+			void accumulatePairRow( const T* pRow1, const T* pRow2, const std::uint32_t uiCount, const T uiSatVal,
+									StatsAccum_t& rAccum1, StatsAccum_t& rAccum2, StatsAccum_t& rAccumDiff ) noexcept
+			{
+				T uiMin1 = std::numeric_limits<T>::max(), uiMin2 = std::numeric_limits<T>::max();
+				T uiMax1 = 0, uiMax2 = 0;
+
+				std::uint64_t uiSat1 = 0, uiSat2 = 0;
+				std::uint64_t uiSum1 = 0, uiSum2 = 0;
+				std::int64_t  iSumDiff = 0;
+
+				StatsAccum_t cRow1, cRow2, cRowDiff;
+
+				const double gCount = static_cast< double >( uiCount );
+
+				if constexpr ( sizeof( T ) == sizeof( std::uint16_t ) )
+				{
+					std::uint64_t uiSqr1 = 0, uiSqr2 = 0, uiSqrDiff = 0;
+
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const T uiVal1 = pRow1[ i ];
+						const T uiVal2 = pRow2[ i ];
+						const std::int32_t iDiff = ( static_cast< std::int32_t >( uiVal1 ) - static_cast< std::int32_t >( uiVal2 ) );
+
+						uiMin1 = ( uiVal1 < uiMin1 ? uiVal1 : uiMin1 );
+						uiMax1 = ( uiVal1 > uiMax1 ? uiVal1 : uiMax1 );
+						uiMin2 = ( uiVal2 < uiMin2 ? uiVal2 : uiMin2 );
+						uiMax2 = ( uiVal2 > uiMax2 ? uiVal2 : uiMax2 );
+						uiSat1 += ( uiVal1 >= uiSatVal ? 1 : 0 );
+						uiSat2 += ( uiVal2 >= uiSatVal ? 1 : 0 );
+						uiSum1 += uiVal1;
+						uiSum2 += uiVal2;
+						iSumDiff += iDiff;
+						uiSqr1 += ( static_cast< std::uint64_t >( uiVal1 ) * uiVal1 );
+						uiSqr2 += ( static_cast< std::uint64_t >( uiVal2 ) * uiVal2 );
+						uiSqrDiff += static_cast< std::uint64_t >( static_cast< std::int64_t >( iDiff ) * iDiff );
+					}
+
+					cRow1.gMean = ( static_cast< double >( uiSum1 ) / gCount );
+					cRow2.gMean = ( static_cast< double >( uiSum2 ) / gCount );
+					cRowDiff.gMean = ( static_cast< double >( iSumDiff ) / gCount );
+
+					cRow1.gM2 = std::max( 0.0, ( static_cast< double >( uiSqr1 ) - static_cast< double >( uiSum1 ) * cRow1.gMean ) );
+					cRow2.gM2 = std::max( 0.0, ( static_cast< double >( uiSqr2 ) - static_cast< double >( uiSum2 ) * cRow2.gMean ) );
+					cRowDiff.gM2 = std::max( 0.0, ( static_cast< double >( uiSqrDiff ) - static_cast< double >( iSumDiff ) * cRowDiff.gMean ) );
+				}
+
+				else
+				{
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const T uiVal1 = pRow1[ i ];
+						const T uiVal2 = pRow2[ i ];
+
+						uiMin1 = ( uiVal1 < uiMin1 ? uiVal1 : uiMin1 );
+						uiMax1 = ( uiVal1 > uiMax1 ? uiVal1 : uiMax1 );
+						uiMin2 = ( uiVal2 < uiMin2 ? uiVal2 : uiMin2 );
+						uiMax2 = ( uiVal2 > uiMax2 ? uiVal2 : uiMax2 );
+						uiSat1 += ( uiVal1 >= uiSatVal ? 1 : 0 );
+						uiSat2 += ( uiVal2 >= uiSatVal ? 1 : 0 );
+						uiSum1 += uiVal1;
+						uiSum2 += uiVal2;
+					}
+
+					iSumDiff = ( static_cast< std::int64_t >( uiSum1 ) - static_cast< std::int64_t >( uiSum2 ) );
+
+					cRow1.gMean = ( static_cast< double >( uiSum1 ) / gCount );
+					cRow2.gMean = ( static_cast< double >( uiSum2 ) / gCount );
+					cRowDiff.gMean = ( static_cast< double >( iSumDiff ) / gCount );
+
+					double gM2_1 = 0.0, gM2_2 = 0.0, gM2Diff = 0.0;
+
+					for ( std::uint32_t i = 0; i < uiCount; i++ )
+					{
+						const double gDev1 = ( static_cast< double >( pRow1[ i ] ) - cRow1.gMean );
+						const double gDev2 = ( static_cast< double >( pRow2[ i ] ) - cRow2.gMean );
+						const double gDevDiff = ( gDev1 - gDev2 );
+
+						gM2_1 += ( gDev1 * gDev1 );
+						gM2_2 += ( gDev2 * gDev2 );
+						gM2Diff += ( gDevDiff * gDevDiff );
+					}
+
+					cRow1.gM2 = gM2_1;
+					cRow2.gM2 = gM2_2;
+					cRowDiff.gM2 = gM2Diff;
+				}
+
+				cRow1.uiCount = cRow2.uiCount = cRowDiff.uiCount = uiCount;
+				cRow1.uiSaturated = uiSat1;
+				cRow2.uiSaturated = uiSat2;
+				cRow1.uiMin = uiMin1;
+				cRow1.uiMax = uiMax1;
+				cRow2.uiMin = uiMin2;
+				cRow2.uiMax = uiMax2;
+
+				rAccum1.merge( cRow1 );
+				rAccum2.merge( cRow2 );
+				rAccumDiff.merge( cRowDiff );
+			}
+
+			// Converts a partial to the population statistics of its pixels.
+			void toStats( const StatsAccum_t& rAccum, const std::uint32_t uiMaxTVal, arc::gen3::image::CStats& cStats ) noexcept
+			{
+				cStats.gTotalPixels = static_cast< double >( rAccum.uiCount );
+				cStats.gMin = static_cast< double >( rAccum.uiCount > 0 ? rAccum.uiMin : uiMaxTVal );
+				cStats.gMax = static_cast< double >( rAccum.uiMax );
+				cStats.gMean = rAccum.gMean;
+				cStats.gVariance = ( rAccum.uiCount > 0 ? ( rAccum.gM2 / static_cast< double >( rAccum.uiCount ) ) : 0.0 );
+				cStats.gStdDev = std::sqrt( cStats.gVariance );
+				cStats.gSaturatedCount = static_cast< double >( rAccum.uiSaturated );
+			}
+
+			// Unsigned integer type that holds the exact product of two pixels.
+			template <typename T>
+			using Wide_t = std::conditional_t<( sizeof( T ) <= sizeof( std::uint16_t ) ), std::uint32_t, std::uint64_t>;
+
+			// Floating point type that holds every pixel value exactly.
+			template <typename T>
+			using Real_t = std::conditional_t<( sizeof( T ) <= sizeof( std::uint16_t ) ), float, double>;
+
+			// Splits a contiguous image into row blocks and calls fnSpan( uiFirst, uiCount ) for each block as a
+			// task on the library executor ( see forEachRowBlock() ), where uiFirst is the index of the first pixel
+			// and uiCount is the number of pixels. The arithmetic kernels are plain loops over a span without
+			// branches, so the compiler vectorizes them.
+			template <typename T, typename F>
+			void forEachSpan( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads, const F& fnSpan )
+			{
+				CArcImage<T>::forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					fnSpan( ( static_cast< std::size_t >( uiFirst ) * uiCols ), ( static_cast< std::size_t >( uiLast - uiFirst ) * uiCols ) );
+				} );
+			}
+
+			// Orders two values, smallest first, without branches.
+			template <typename T>
+			inline void sortPair( T& a, T& b ) noexcept
+			{
+				const T tMin = ( a < b ? a : b );
+
+				b = ( a < b ? b : a );
+				a = tMin;
+			}
+
+			// Returns the median of nine values with the 19 compare-exchange network of Paeth ( Graphics Gems ).
+			template <typename T>
+			inline T median9( T p0, T p1, T p2, T p3, T p4, T p5, T p6, T p7, T p8 ) noexcept
+			{
+				sortPair( p1, p2 ); sortPair( p4, p5 ); sortPair( p7, p8 );
+				sortPair( p0, p1 ); sortPair( p3, p4 ); sortPair( p6, p7 );
+				sortPair( p1, p2 ); sortPair( p4, p5 ); sortPair( p7, p8 );
+				sortPair( p0, p3 ); sortPair( p5, p8 ); sortPair( p4, p7 );
+				sortPair( p3, p6 ); sortPair( p1, p4 ); sortPair( p2, p5 );
+				sortPair( p4, p7 ); sortPair( p4, p2 ); sortPair( p6, p4 );
+				sortPair( p4, p2 );
+
+				return p4;
+			}
+
+			// Writes the 3 x 3 median of every pixel in a row. The image edges are extended by repeating the edge
+			// pixels. The interior loop has no branches and is vectorized by the compiler.
+			template <typename T>
+			void medianRow( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiRow, T* pMedian ) noexcept
+			{
+				const T* pA = ( pBuf + static_cast< std::size_t >( uiRow > 0 ? ( uiRow - 1 ) : 0 ) * uiCols );
+				const T* pB = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+				const T* pC = ( pBuf + static_cast< std::size_t >( ( uiRow + 1 ) < uiRows ? ( uiRow + 1 ) : uiRow ) * uiCols );
+
+				for ( std::uint32_t c = 1; ( c + 1 ) < uiCols; c++ )
+				{
+					pMedian[ c ] = median9( pA[ c - 1 ], pA[ c ], pA[ c + 1 ], pB[ c - 1 ], pB[ c ], pB[ c + 1 ], pC[ c - 1 ], pC[ c ], pC[ c + 1 ] );
+				}
+
+				for ( const std::uint32_t c : { 0U, ( uiCols - 1 ) } )
+				{
+					const std::uint32_t l = ( c > 0 ? ( c - 1 ) : 0 );
+					const std::uint32_t r = ( ( c + 1 ) < uiCols ? ( c + 1 ) : c );
+
+					pMedian[ c ] = median9( pA[ l ], pA[ c ], pA[ r ], pB[ l ], pB[ c ], pB[ r ], pC[ l ], pC[ c ], pC[ r ] );
+				}
+			}
+
+			// Calls fnPixel( uiCol ) for every set bit of a mask row.
+			template <typename F>
+			void forEachMaskedPixel( const std::uint64_t* pWords, const std::uint32_t uiWords, const F& fnPixel )
+			{
+				for ( std::uint32_t w = 0; w < uiWords; w++ )
+				{
+					for ( std::uint64_t uiBits = pWords[ w ]; uiBits != 0; uiBits &= ( uiBits - 1 ) )
+					{
+						fnPixel( w * 64 + static_cast< std::uint32_t >( std::countr_zero( uiBits ) ) );
+					}
+				}
+			}
+
+			// Calls fnRun( uiCol1, uiCol2 ) for every run of unmasked columns [ uiCol1, uiCol2 ) of a mask row.
+			template <typename F>
+			void forEachUnmaskedRun( const std::uint64_t* pWords, const std::uint32_t uiCols, const F& fnRun )
+			{
+				std::uint32_t uiStart = 0;
+
+				forEachMaskedPixel( pWords, ( ( uiCols + 63 ) / 64 ), [ & ]( std::uint32_t uiCol )
+				{
+					if ( uiCol > uiStart )
+					{
+						fnRun( uiStart, uiCol );
+					}
+
+					uiStart = ( uiCol + 1 );
+				} );
+
+				if ( uiStart < uiCols )
+				{
+					fnRun( uiStart, uiCols );
+				}
+			}
+
+			// Applies a buffer kernel, called as fnKernel( pDst, pSrc1, pSrc2, uiCols, uiRows, uiThreads ), to image
+			// views of the same extent. Contiguous views are passed to the kernel whole; otherwise the kernel is
+			// called once per row, with the rows split over threads.
+			template <typename T, typename F>
+			void forEachViewRows( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1,
+								  const arc::gen3::image::ImageView<const T>& tSrc2, const std::uint32_t uiThreads, const F& fnKernel )
+			{
+				if ( tDst.contiguous() && tSrc1.contiguous() && tSrc2.contiguous() )
+				{
+					fnKernel( tDst.data(), tSrc1.data(), tSrc2.data(), tDst.cols(), tDst.rows(), uiThreads );
+
+					return;
+				}
+
+				CArcImage<T>::forEachRowBlock( 0, tDst.rows(), uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+					{
+						fnKernel( tDst.rowData( uiRow ), tSrc1.rowData( uiRow ), tSrc2.rowData( uiRow ), tDst.cols(), 1, 1 );
+					}
+				} );
+			}
+
+			// Checks every row of a view with fnRow( uiRow, pRow, uiFirst ), which returns the row mismatch count and
+			// sets uiFirst to the column of the first mismatch. The rows are split over threads and the report holds
+			// the total count and the first mismatch in row order; the caller fills in the expected value.
+			template <typename T, typename F>
+			arc::gen3::image::VerifyReport_t checkViewRows( const arc::gen3::image::ImageView<const T>& tView, const std::uint32_t uiThreads, const F& fnRow )
+			{
+				struct Block_t
+				{
+					std::uint64_t uiErrors;
+					std::uint32_t uiCol;
+					std::uint32_t uiRow;
+				};
+
+				std::vector<Block_t> vBlocks( CArcImage<T>::threadCount( uiThreads ), { 0, 0, 0 } );
+
+				const std::uint32_t uiBlocks = CArcImage<T>::forEachRowBlock( 0, tView.rows(), uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					Block_t& rBlock = vBlocks[ uiBlock ];
+
+					for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+					{
+						std::size_t uiCol = 0;
+
+						const std::uint64_t uiErrors = fnRow( uiRow, tView.rowData( uiRow ), uiCol );
+
+						if ( uiErrors > 0 && rBlock.uiErrors == 0 )
+						{
+							rBlock.uiCol = static_cast< std::uint32_t >( uiCol );
+							rBlock.uiRow = uiRow;
+						}
+
+						rBlock.uiErrors += uiErrors;
+					}
+				} );
+
+				arc::gen3::image::VerifyReport_t tReport = { 0, tView.size(), 1, 0, 0, 0, 0, 0 };
+
+				for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+				{
+					if ( vBlocks[ b ].uiErrors > 0 && tReport.uiErrors == 0 )
+					{
+						tReport.uiCol = vBlocks[ b ].uiCol;
+						tReport.uiRow = vBlocks[ b ].uiRow;
+						tReport.uiFound = tView( tReport.uiCol, tReport.uiRow );
+					}
+
+					tReport.uiErrors += vBlocks[ b ].uiErrors;
+				}
+
+				return tReport;
+			}
+
+			// Hashes a 32-bit value to a uniformly distributed 32-bit value ( the "lowbias32" integer hash of
+			// C. Wellons ). Only 32-bit multiplies are used, so loops over it vectorize.
+			inline std::uint32_t hash32( std::uint32_t uiValue ) noexcept
+			{
+				uiValue ^= ( uiValue >> 16 );
+				uiValue *= 0x7FEB352DU;
+				uiValue ^= ( uiValue >> 15 );
+				uiValue *= 0x846CA68BU;
+				uiValue ^= ( uiValue >> 16 );
+
+				return uiValue;
+			}
+
+			// Fills pNormal with uiCount standard normal values from the counter based stream uiKey, two values per
+			// Box-Muller pair of uniforms. Hashing the counter before mixing in the key keeps nearby keys unrelated.
+			inline void fillNormals( float* pNormal, const std::uint32_t uiCount, const std::uint32_t uiKey ) noexcept
+			{
+				constexpr float gTwoPi = 6.28318530717958647692f;
+				constexpr float gUnit = ( 1.0f / 16777216.0f );
+
+				for ( std::uint32_t i = 0; i < uiCount; i += 2 )
+				{
+					const float gU1 = ( ( static_cast< float >( hash32( hash32( i ) ^ uiKey ) >> 8 ) + 0.5f ) * gUnit );
+					const float gU2 = ( static_cast< float >( hash32( hash32( i + 1 ) ^ uiKey ) >> 8 ) * gUnit );
+
+					const float gRadius = std::sqrt( -2.0f * std::log( gU1 ) );
+
+					pNormal[ i ] = ( gRadius * std::cos( gTwoPi * gU2 ) );
+					pNormal[ i + 1 ] = ( gRadius * std::sin( gTwoPi * gU2 ) );
+				}
+			}
+
+			// Sums groups of F adjacent accumulators. A compile time group size lets the compiler vectorize the
+			// common 2, 4 and 8 pixel blocks.
+			template <std::uint32_t F, typename W>
+			void reduceGroups( const W* pAcc, W* pSum, const std::uint32_t uiCount, const std::uint32_t uiFactor )
+			{
+				const std::uint32_t uiGroup = ( F > 0 ? F : uiFactor );
+
+				for ( std::uint32_t i = 0; i < uiCount; i++ )
+				{
+					W uiSum = 0;
+
+					for ( std::uint32_t k = 0; k < uiGroup; k++ )
+					{
+						uiSum += pAcc[ ( static_cast< std::size_t >( i ) * uiGroup ) + k ];
+					}
+
+					pSum[ i ] = uiSum;
+				}
+			}
+
+			// Bins a view in uiFactor x uiFactor blocks, calling fnStore( uiOutRow, pSums, uiOutCols ) with the block
+			// sums of every output row. The rows of a block are summed into a row of wide accumulators and the
+			// accumulators are then reduced in groups of uiFactor.
+			template <typename T, typename F>
+			void binBlocks( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, const std::uint32_t uiThreads, const F& fnStore )
+			{
+				const std::uint32_t uiOutCols = ( tSrc.cols() / uiFactor );
+				const std::uint32_t uiOutRows = ( tSrc.rows() / uiFactor );
+				const std::size_t   uiWidth   = ( static_cast< std::size_t >( uiOutCols ) * uiFactor );
+
+				CArcImage<T>::forEachRowBlock( 0, uiOutRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					std::vector<Wide_t<T>> vAcc( uiWidth );
+					std::vector<Wide_t<T>> vSum( uiOutCols );
+
+					Wide_t<T>* pAcc = vAcc.data();
+
+					for ( std::uint32_t uiOutRow = uiFirst; uiOutRow < uiLast; uiOutRow++ )
+					{
+						const T* pRow = tSrc.rowData( uiOutRow * uiFactor );
+
+						for ( std::size_t i = 0; i < uiWidth; i++ )
+						{
+							pAcc[ i ] = pRow[ i ];
+						}
+
+						for ( std::uint32_t k = 1; k < uiFactor; k++ )
+						{
+							pRow = tSrc.rowData( ( uiOutRow * uiFactor ) + k );
+
+							for ( std::size_t i = 0; i < uiWidth; i++ )
+							{
+								pAcc[ i ] += pRow[ i ];
+							}
+						}
+
+						switch ( uiFactor )
+						{
+							case 2:  reduceGroups<2>( pAcc, vSum.data(), uiOutCols, uiFactor ); break;
+							case 4:  reduceGroups<4>( pAcc, vSum.data(), uiOutCols, uiFactor ); break;
+							case 8:  reduceGroups<8>( pAcc, vSum.data(), uiOutCols, uiFactor ); break;
+							default: reduceGroups<0>( pAcc, vSum.data(), uiOutCols, uiFactor ); break;
+						}
+
+						fnStore( uiOutRow, static_cast< const Wide_t<T>* >( vSum.data() ), uiOutCols );
+					}
+				} );
+			}
+		}
+
+
 
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  verifyBuffer                                                                                            |
@@ -44,6 +581,68 @@ namespace arc
 			}
 		}
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyOperands                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies the buffers and dimensions of an arithmetic kernel. Throws exception if a buffer is nullptr    |
+		// |  or a dimension is zero.                                                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf - Pointer to the destination buffer.                                                    |
+		// |  <IN> -> pBuf1   - Pointer to the first source buffer.                                                   |
+		// |  <IN> -> pBuf2   - Pointer to the second source buffer.                                                  |
+		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
+		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::verifyOperands( const void* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid destination buffer parameter ( nullptr )!"s );
+			}
+
+			verifyBuffer( pBuf1 );
+
+			verifyBuffer( pBuf2 );
+
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+		}
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyViews                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Verifies that an image view is not empty and that every other view has the same extent. Throws          |
+		// |  exception on error.                                                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> tView   - The view to check.                                                                    |
+		// |  <IN> -> tOther1 - A view that must match tView.                                                         |
+		// |  <IN> -> tOther2 - A view that must match tView.                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::verifyViews( const arc::gen3::image::ImageView<const T>& tView, const arc::gen3::image::ImageView<const T>& tOther1,
+										const arc::gen3::image::ImageView<const T>& tOther2 )
+		{
+			if ( tView.data() == nullptr || tOther1.data() == nullptr || tOther2.data() == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			if ( tView.cols() == 0 || tView.rows() == 0 || ( tView.rows() > 1 && tView.stride() < tView.cols() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid view [ %u x %u ] with row stride %u.", tView.cols(), tView.rows(), tView.stride() );
+			}
+
+			for ( const auto& rOther : { tOther1, tOther2 } )
+			{
+				if ( rOther.cols() != tView.cols() || rOther.rows() != tView.rows() || ( rOther.rows() > 1 && rOther.stride() < rOther.cols() ) )
+				{
+					throwArcGen3InvalidArgument( "View [ %u x %u ] with row stride %u does not match view [ %u x %u ].",
+												 rOther.cols(), rOther.rows(), rOther.stride(), tView.cols(), tView.rows() );
+				}
+			}
+		}
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  verifyRow                                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -126,14 +725,6 @@ namespace arc
 		}
 
 
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Constant - DEG2RAD                                                                                      |
-		// +----------------------------------------------------------------------------------------------------------+
-		// |  Degree to radian conversion factor.                                                                     |
-		// +----------------------------------------------------------------------------------------------------------+
-		constexpr auto DEG2RAD = ( 3.14159 / 180.0 );
-
-
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  GenIII image channel type                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -192,10 +783,11 @@ namespace arc
 		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
 		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
 		// |  <IN> -> uiValue - The value to fill the buffer with.                                                    |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::invalid_argument, std::invalid_argument                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue )
+		template <typename T> void CArcImage<T>::fill( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const T uiValue, const std::uint32_t uiThreads )
 		{
 			if ( uiValue >= maxTVal() )
 			{
@@ -204,10 +796,10 @@ namespace arc
 
 			if ( pBuf != nullptr )
 			{
-				for ( std::uint32_t i = 0; i < ( uiCols * uiRows ); i++ )
+				forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
 				{
-					pBuf[ i ] = uiValue;
-				}
+					std::fill_n( ( pBuf + uiFirst ), uiCount, uiValue );
+				} );
 			}
 
 			else
@@ -237,10 +829,7 @@ namespace arc
 
 			if ( pBuf != nullptr )
 			{
-				for ( std::uint32_t i = 0; i < ( uiBytes / sizeof( T ) ); i++ )
-				{
-					pBuf[ i ] = uiValue;
-				}
+				std::fill_n( pBuf, ( uiBytes / sizeof( T ) ), uiValue );
 			}
 
 			else
@@ -253,31 +842,34 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  fillWithGradient                                                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with a gradient pattern.                                                     |
+		// |  Fills the specified buffer with a gradient pattern. Row r is r x ( ( maxTVal() - 1 ) / rows ), where    |
+		// |  the division is an integer division, so the last row is at most maxTVal() - 1.                          |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
 		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
 		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcImage<T>::fillWithGradient( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
 			if ( pBuf != nullptr )
 			{
-				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
+				if ( uiCols == 0 || uiRows == 0 )
+				{
+					return;
+				}
 
-				T uiValue = 0;
+				const T uiStep = static_cast< T >( ( maxTVal() - 1 ) / uiRows );
 
-				for ( std::remove_const_t<decltype( uiRows )> r = 0; r < uiRows; r++ )
+				forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
 				{
-					for ( std::remove_const_t<decltype( uiCols )> c = 0; c < uiCols; c++ )
+					for ( std::uint32_t r = uiFirst; r < uiLast; r++ )
 					{
-						pBuf[ c + r * uiCols ] = uiValue;
+						std::fill_n( ( pBuf + static_cast< std::size_t >( r ) * uiCols ), uiCols, static_cast< T >( uiStep * r ) );
 					}
-
-					uiValue += static_cast< T >( ( maxTVal() - 1 ) / uiRows );
-				}
+				} );
 			}
 
 			else
@@ -290,65 +882,85 @@ namespace arc
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  fillWithSmiley                                                                                          |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Fills the specified buffer with zeroes and puts a smiley face at the center.                            |
+		// |  Fills the specified buffer with zeroes and puts a smiley face at the center. Every pixel is             |
+		// |  computed from its distance to the head, eye and mouth centers, so rows are independent and              |
+		// |  can be split over threads.                                                                              |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf	  - Pointer to the image data buffer.                                                     |
 		// |  <IN> -> uiCols  - The image column size ( in pixels ).                                                  |
 		// |  <IN> -> uiRows  - The image row size ( in pixels ).                                                     |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcImage<T>::fillWithSmiley( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			if ( pBuf != nullptr )
+			if ( pBuf == nullptr )
 			{
-				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
-
-				std::uint32_t uiRadius = static_cast<std::uint32_t>( std::fmin( ( uiRows / 2.0 ), ( uiCols / 2.0 ) ) - 10.0 );
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
 
-				//  Draw Head
-				// +---------------------------------------------------------------------------- +
-				drawGradientFillCircle(	uiRadius,
-										uiCols,
-										uiRows,
-										pBuf );
+			const double gHead = ( std::fmin( ( uiRows / 2.0 ), ( uiCols / 2.0 ) ) - 10.0 );
 
-				//  Draw Left Eye
-				// +---------------------------------------------------------------------------- +
-				std::uint32_t uiRowFactor = static_cast< std::uint32_t >( uiRadius / 2.5 );
+			const std::uint32_t uiRadius = ( gHead >= 1.0 ? static_cast< std::uint32_t >( gHead ) : 0 );
 
-				drawFillCircle( ( uiCols / 2 ) - uiRowFactor,
-								( uiRows / 2 ) + uiRowFactor,
-								( uiRadius / 5 ),
-								uiCols,
-								pBuf );
-
-				//  Draw Right Eye
-				// +---------------------------------------------------------------------------- +
-				drawFillCircle( ( uiCols / 2 ) + uiRowFactor,
-								( uiRows / 2 ) + uiRowFactor,
-								( uiRadius / 5 ),
-								uiCols,
-								pBuf );
+			if ( uiRadius == 0 )
+			{
+				zeroMemory( pBuf, ( static_cast< std::size_t >( uiCols ) * static_cast< std::size_t >( uiRows ) * sizeof( T ) ) );
 
-				//  Draw Mouth
-				// +---------------------------------------------------------------------------- +
-				for ( decltype( uiRadius ) i = 0; i < ( uiRadius / 2 ); i++ )
-				{
-					drawSemiCircle( ( uiCols / 2 ),
-									( uiRows / 2 ) - ( uiRowFactor / 2 ),
-									i,
-									180,
-									360,
-									uiCols,
-									pBuf );
-				}
+				return;
 			}
 
-			else
+			//  The head, eyes and mouth are filled circles, tested per pixel: a pixel belongs to a circle of radius
+			//  r about ( x, y ) if its center lies within r of ( x, y ). The head is shaded by the distance from
+			//  the center and the mouth is the half of its circle at or below its center row.
+			// +---------------------------------------------------------------------------- +
+			const std::uint32_t uiRowFactor = static_cast< std::uint32_t >( uiRadius / 2.5 );
+
+			const float gCx = static_cast< float >( uiCols / 2 );
+			const float gCy = static_cast< float >( uiRows / 2 );
+
+			const float gHeadSq = static_cast< float >( uiRadius ) * static_cast< float >( uiRadius );
+			const float gEyeSq  = static_cast< float >( uiRadius / 5 ) * static_cast< float >( uiRadius / 5 );
+			const float gEyeDx  = static_cast< float >( uiRowFactor );
+			const float gEyeY   = ( gCy + static_cast< float >( uiRowFactor ) );
+			const float gMouthSq = static_cast< float >( uiRadius / 2 ) * static_cast< float >( uiRadius / 2 );
+			const float gMouthY = ( gCy - static_cast< float >( uiRowFactor / 2 ) );
+
+			const std::uint32_t uiShade = ( uiRadius + ( maxTVal() - 1 ) / uiRadius );
+
+			forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
-			}
+				for ( std::uint32_t r = uiFirst; r < uiLast; r++ )
+				{
+					T* pRow = ( pBuf + static_cast< std::size_t >( r ) * uiCols );
+
+					const float gY = ( static_cast< float >( r ) + 0.5f );
+
+					const float gHeadDy = ( ( gY - gCy ) * ( gY - gCy ) );
+					const float gEyeDy = ( ( gY - gEyeY ) * ( gY - gEyeY ) );
+					const float gMouthDy = ( gY <= gMouthY ? ( ( gY - gMouthY ) * ( gY - gMouthY ) ) : gMouthSq );
+
+					for ( std::uint32_t c = 0; c < uiCols; c++ )
+					{
+						const float gDx = ( ( static_cast< float >( c ) + 0.5f ) - gCx );
+
+						const float gHeadDist = ( gDx * gDx + gHeadDy );
+
+						const float gLeftDx = ( gDx + gEyeDx );
+						const float gRightDx = ( gDx - gEyeDx );
+
+						const bool bFace = ( gHeadDist < gHeadSq && ( gLeftDx * gLeftDx + gEyeDy ) >= gEyeSq &&
+											 ( gRightDx * gRightDx + gEyeDy ) >= gEyeSq && ( gDx * gDx + gMouthDy ) >= gMouthSq );
+
+						const float gRing = std::sqrt( gHeadDist );
+
+						const std::uint32_t uiRing = ( gRing >= 1.0f ? static_cast< std::uint32_t >( gRing ) : 1U );
+
+						pRow[ c ] = ( bFace ? static_cast< T >( uiShade - uiRing ) : T( 0 ) );
+					}
+				}
+			} );
 		}
 
 
@@ -356,29 +968,43 @@ namespace arc
 		// |  fillWithRamp                                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  Fills the specified buffer with a ramp image. Data has the form 0, 1, 2, ..., 65535, 0, 1, ....         |
+		// |  Each span is written in runs between wraps, a loop the compiler vectorizes.                             |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
 		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
 		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T> void CArcImage<T>::fillWithRamp( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
 			if ( pBuf != nullptr )
 			{
-				T uiValue = 0;
+				const std::uint64_t uiPeriod = maxTVal();
 
-				for ( std::uint32_t i = 0; i < ( uiCols * uiRows ); i++ )
+				forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
 				{
-					pBuf[ i ] = uiValue;
+					std::uint64_t uiNext = ( uiFirst % uiPeriod );
 
-					uiValue++;
+					for ( std::size_t i = 0; i < uiCount; )
+					{
+						const std::size_t uiRun = static_cast< std::size_t >( std::min( static_cast< std::uint64_t >( uiCount - i ), ( uiPeriod - uiNext ) ) );
 
-					if ( uiValue >= maxTVal() ) { uiValue = 0; }
-				}
+						T* pRun = ( pBuf + uiFirst + i );
+
+						const T uiBase = static_cast< T >( uiNext );
+
+						for ( std::size_t k = 0; k < uiRun; k++ )
+						{
+							pRun[ k ] = static_cast< T >( uiBase + k );
+						}
 
-				containsValidRamp( pBuf, uiCols, uiRows );
+						uiNext = 0;
+
+						i += uiRun;
+					}
+				} );
 			}
 
 			else
@@ -388,6 +1014,91 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillWithNoise                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills the specified buffer with a simulated frame of bias, row and column patterns, signal and noise.   |
+		// |  The normal values of each row, the row offsets and the column pattern are drawn from separate counter   |
+		// |  based streams keyed by the seed, so rows can be generated in any order on any number of threads. The    |
+		// |  noise is gaussian with variance signal + read noise squared, the gaussian limit of shot noise.          |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> tModel    - The noise model.                                                                    |
+		// |  <IN> -> uiSeed    - The random seed.                                                                    |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::fillWithNoise( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::NoiseModel_t& tModel,
+										  const std::uint64_t uiSeed, const std::uint32_t uiThreads )
+		{
+			verifyBuffer( pBuf );
+
+			if ( !( tModel.gGain > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid gain [ %f ], must be positive.", tModel.gGain );
+			}
+
+			if ( !( tModel.gReadNoise >= 0.0 && tModel.gSignal >= 0.0 && tModel.gRowNoise >= 0.0 && tModel.gColumnNoise >= 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid noise model, the noise and signal levels must not be negative."s );
+			}
+
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				return;
+			}
+
+			// One key per stream; the column pattern, row offsets and pixel rows never share a counter.
+			const std::uint32_t uiKey = hash32( static_cast< std::uint32_t >( uiSeed ) ^ hash32( static_cast< std::uint32_t >( uiSeed >> 32 ) ^ 0x9E3779B9U ) );
+
+			const std::uint32_t uiPadded = ( ( uiCols + 1 ) & ~1U );
+
+			std::vector<float> vColumns( uiPadded );
+
+			fillNormals( vColumns.data(), uiPadded, hash32( uiKey ^ 0x68E31DA4U ) );
+
+			std::vector<float> vRowOffsets( ( uiRows + 1 ) & ~1U );
+
+			fillNormals( vRowOffsets.data(), static_cast< std::uint32_t >( vRowOffsets.size() ), hash32( uiKey ^ 0xB5297A4DU ) );
+
+			for ( auto& gValue : vColumns )
+			{
+				gValue *= static_cast< float >( tModel.gColumnNoise );
+			}
+
+			const Real_t<T> gMax = static_cast< Real_t<T> >( maxTVal() - 1 );
+			const Real_t<T> gScale = static_cast< Real_t<T> >( std::sqrt( tModel.gSignal + tModel.gReadNoise * tModel.gReadNoise ) / tModel.gGain );
+
+			forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				std::vector<float> vNormal( uiPadded );
+
+				const float* pColumns = vColumns.data();
+				const float* pNormal = vNormal.data();
+
+				for ( std::uint32_t r = uiFirst; r < uiLast; r++ )
+				{
+					fillNormals( vNormal.data(), uiPadded, hash32( uiKey ^ hash32( r ^ 0x1B56C4E9U ) ) );
+
+					const Real_t<T> gLevel = static_cast< Real_t<T> >( tModel.gBias + tModel.gRowNoise * vRowOffsets[ r ] + tModel.gSignal / tModel.gGain ) + Real_t<T>( 0.5 );
+
+					T* pRow = ( pBuf + static_cast< std::size_t >( r ) * uiCols );
+
+					for ( std::uint32_t c = 0; c < uiCols; c++ )
+					{
+						const Real_t<T> gValue = ( gLevel + pColumns[ c ] + gScale * pNormal[ c ] );
+
+						pRow[ c ] = static_cast< T >( gValue < Real_t<T>( 0 ) ? Real_t<T>( 0 ) : ( gValue > gMax ? gMax : gValue ) );
+					}
+				}
+			} );
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  containsValidRamp                                                                                       |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -490,6 +1201,166 @@ namespace arc
 		}
 
 
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  checkRamp                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Checks an image view against the ramp synthetic image. The ramp runs across the rows of the view, so    |
+		// |  row r starts at ( uiStart + r x cols ) mod uiPeriod.                                                    |
+		// |                                                                                                          |
+		// |  <IN> -> tView     - The image view.                                                                     |
+		// |  <IN> -> uiStart   - The value of the first pixel.                                                       |
+		// |  <IN> -> uiPeriod  - The ramp period.                                                                    |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument or std::out_of_range on error.                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::image::VerifyReport_t CArcImage<T>::checkRamp( const arc::gen3::image::ImageView<const T>& tView, const std::uint32_t uiStart, const std::uint64_t uiPeriod,
+																  const std::uint32_t uiThreads )
+		{
+			constexpr std::uint64_t uiPeriodMax = ( static_cast< std::uint64_t >( std::numeric_limits<T>::max() ) + 1 );
+
+			verifyBuffer( tView.data() );
+
+			verifyDimensions( tView.cols(), tView.rows() );
+
+			if ( uiPeriod == 0 || uiPeriod > uiPeriodMax )
+			{
+				throwArcGen3OutOfRange( uiPeriod, std::make_pair( static_cast< std::uint64_t >( 1 ), uiPeriodMax ) );
+			}
+
+			if ( uiStart >= uiPeriod )
+			{
+				throwArcGen3OutOfRange( uiStart, std::make_pair( static_cast< std::uint64_t >( 0 ), ( uiPeriod - 1 ) ) );
+			}
+
+			auto fnRowStart = [ & ]( std::uint32_t uiRow )
+			{
+				return ( ( uiStart + ( static_cast< std::uint64_t >( uiRow ) * tView.cols() ) % uiPeriod ) % uiPeriod );
+			};
+
+			auto tReport = checkViewRows( tView, uiThreads, [ & ]( std::uint32_t uiRow, const T* pRow, std::size_t& uiFirst )
+			{
+				return compareRamp( pRow, tView.cols(), fnRowStart( uiRow ), uiPeriod, uiFirst );
+			} );
+
+			tReport.uiExpected = static_cast< std::uint32_t >( ( fnRowStart( tReport.uiRow ) + tReport.uiCol ) % uiPeriod );
+
+			return tReport;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  checkConstant                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Checks that every pixel of an image view has the same value.                                            |
+		// |                                                                                                          |
+		// |  <IN> -> tView     - The image view.                                                                     |
+		// |  <IN> -> uiValue   - The expected value.                                                                 |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		arc::gen3::image::VerifyReport_t CArcImage<T>::checkConstant( const arc::gen3::image::ImageView<const T>& tView, const T uiValue, const std::uint32_t uiThreads )
+		{
+			verifyBuffer( tView.data() );
+
+			verifyDimensions( tView.cols(), tView.rows() );
+
+			auto tReport = checkViewRows( tView, uiThreads, [ & ]( std::uint32_t, const T* pRow, std::size_t& uiFirst )
+			{
+				return compareConstant( pRow, tView.cols(), uiValue, uiFirst );
+			} );
+
+			tReport.uiExpected = uiValue;
+
+			return tReport;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compareRamp                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Counts the pixels of a span that differ from a wrapping ramp. The span is split into runs between       |
+		// |  wraps; within a run the expected value is the run base plus the index, so the mismatch count is a       |
+		// |  branch free loop. The first mismatch is only searched for in the first run that has one.                |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf     - Pointer to the pixels.                                                              |
+		// |  <IN>  -> uiCount  - The number of pixels.                                                               |
+		// |  <IN>  -> uiValue  - The expected value of the first pixel.                                              |
+		// |  <IN>  -> uiPeriod - The ramp period.                                                                    |
+		// |  <OUT> -> uiFirst  - The index of the first mismatch, or uiCount if there is none.                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::compareRamp( const T* pBuf, const std::size_t uiCount, const std::uint64_t uiValue, const std::uint64_t uiPeriod, std::size_t& uiFirst ) noexcept
+		{
+			std::uint64_t uiErrors = 0;
+
+			std::uint64_t uiNext = uiValue;
+
+			uiFirst = uiCount;
+
+			for ( std::size_t i = 0; i < uiCount; )
+			{
+				const std::size_t uiRun = static_cast< std::size_t >( std::min( static_cast< std::uint64_t >( uiCount - i ), ( uiPeriod - uiNext ) ) );
+
+				const T* pRun = ( pBuf + i );
+
+				const T uiBase = static_cast< T >( uiNext );
+
+				std::size_t uiRunErrors = 0;
+
+				for ( std::size_t k = 0; k < uiRun; k++ )
+				{
+					uiRunErrors += ( pRun[ k ] != static_cast< T >( uiBase + k ) );
+				}
+
+				if ( uiRunErrors > 0 && uiFirst == uiCount )
+				{
+					uiFirst = ( i + static_cast< std::size_t >( std::find_if( pRun, ( pRun + uiRun ), [ & ]( const T& rValue )
+					{
+						return ( rValue != static_cast< T >( uiBase + static_cast< std::size_t >( &rValue - pRun ) ) );
+					} ) - pRun ) );
+				}
+
+				uiErrors += uiRunErrors;
+
+				uiNext = ( ( uiNext + uiRun ) == uiPeriod ? 0 : ( uiNext + uiRun ) );
+
+				i += uiRun;
+			}
+
+			return uiErrors;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  compareConstant                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Counts the pixels of a span that differ from a value.                                                   |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf    - Pointer to the pixels.                                                               |
+		// |  <IN>  -> uiCount - The number of pixels.                                                                |
+		// |  <IN>  -> uiValue - The expected value.                                                                  |
+		// |  <OUT> -> uiFirst - The index of the first mismatch, or uiCount if there is none.                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::compareConstant( const T* pBuf, const std::size_t uiCount, const T uiValue, std::size_t& uiFirst ) noexcept
+		{
+			std::size_t uiErrors = 0;
+
+			for ( std::size_t i = 0; i < uiCount; i++ )
+			{
+				uiErrors += ( pBuf[ i ] != uiValue );
+			}
+
+			uiFirst = ( uiErrors > 0 ? static_cast< std::size_t >( std::find_if( pBuf, ( pBuf + uiCount ), [ & ]( const T& rValue ) { return ( rValue != uiValue ); } ) - pBuf ) : uiCount );
+
+			return uiErrors;
+		}
+
+
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  getPixel                                                                                                |
 		// +----------------------------------------------------------------------------------------------------------+
@@ -785,23 +1656,21 @@ namespace arc
 		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
 		// |  pixel count over the specified image buffer cols and rows.                                              |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> pBuf	    - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCol1	- The start column.                                                                   |
+		// |  <IN> -> uiCol2	- The end column.                                                                     |
+		// |  <IN> -> uiRow1	- The start row.                                                                      |
+		// |  <IN> -> uiRow2	- The end row.                                                                        |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error on error.                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> std::unique_ptr<arc::gen3::image::CStats>
-		CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+								const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			double gDevSqrdSum = 0.0;
-			double gVal = 0.0;
-			double gSum = 0.0;
-
 			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
 			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
 
@@ -819,8 +1688,6 @@ namespace arc
 
 			verifyBuffer( pBuf );
 
-			double gMaxBpp = maxTVal();
-
 			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats() );
 
 			if ( pStats == nullptr )
@@ -828,62 +1695,10 @@ namespace arc
 				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
 			}
 
-			pStats->gMin = gMaxBpp;
-			
 			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
 			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
 
-			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast< double >( uiLocalCol2 - uiCol1 ) );
-
-			pStats->gTotalPixels = gTotalPixelCount;
-
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
-				{
-					gVal = static_cast< double >( pBuf[ j + i * uiCols ] );
-
-					//
-					// Determine min/max values
-					//
-					if ( gVal < pStats->gMin )
-					{
-						pStats->gMin = gVal;
-					}
-
-					else if ( gVal > pStats->gMax )
-					{
-						pStats->gMax = gVal;
-					}
-
-					//
-					// Monitor for saturated pixels
-					//
-					//if ( gVal >= ( T_SIZE( T ) - 1 ) )
-					if ( gVal >= ( maxTVal() - 1 ) )
-					{
-						pStats->gSaturatedCount++;
-					}
-
-					gSum += gVal;
-				}
-			}
-
-			// Calculate mean
-			pStats->gMean = gSum / gTotalPixelCount;
-
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
-				{
-					double gPixVal = static_cast< double >( pBuf[ j + i * uiCols ] );
-					
-					gDevSqrdSum += std::pow( ( gPixVal - pStats->gMean ), 2 );
-				}
-			}
-
-			pStats->gVariance = gDevSqrdSum / gTotalPixelCount;
-			pStats->gStdDev = std::sqrt( pStats->gVariance );
+			calcStats( *pStats, pBuf, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiThreads );
 
 			return pStats;
 		}
@@ -895,99 +1710,355 @@ namespace arc
 		// |  Calculates the image min, max, mean, variance, standard deviation, total pixel count and saturated      |
 		// |  pixel count over the entire image.                                                                      |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image data buffer.                                                      |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> pBuf	    - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error on error.                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
 		{
-			return getStats( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows );
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			verifyBuffer( pBuf );
+
+			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats() );
+
+			if ( pStats == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate stats data buffer!"s );
+			}
+
+			calcStats( *pStats, pBuf, 0, uiCols, 0, uiRows, uiCols, uiThreads );
+
+			return pStats;
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  getDiffStats                                                                                            |
+		// |  getChannelStats                                                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
-		// |  count for each image as well as the difference mean, variance and standard deviation over the specified |
-		// |  image buffer cols and rows. This is used for photon transfer curves( PTC ).The two images MUST be the   |
-		// |  same size or the methods behavior is undefined as this cannot be verified using the given parameters.   |
+		// |  Calculates the statistics of every channel ( amplifier ) region of an image in a single pass over the   |
+		// |  image.                                                                                                  |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCol1 - The start column.                                                                      |
-		// |  <IN> -> uiCol2 - The end column.                                                                        |
-		// |  <IN> -> uiRow1 - The start row.                                                                         |
-		// |  <IN> -> uiRow2 - The end row.                                                                           |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN>  -> pBuf      - Pointer to the image data buffer.                                                  |
+		// |  <IN>  -> uiCols    - The image column size ( in pixels ).                                               |
+		// |  <IN>  -> uiRows    - The image row size ( in pixels ).                                                  |
+		// |  <IN>  -> vChannels - The channel regions.                                                               |
+		// |  <OUT> -> pStats    - Array of vChannels.size() statistics to fill, one per channel.                     |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per hardware thread.                          |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
-		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::getChannelStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vChannels,
+											arc::gen3::image::CStats* pStats, const std::uint32_t uiThreads )
 		{
-			double gSum		= 0.0;
-			double gDifSum	= 0.0;
-			double gVal1	= 0.0;
-			double gVal2	= 0.0;
+			verifyBuffer( pBuf );
 
-			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
-			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+			verifyRegions( vChannels, uiCols, uiRows );
 
-			verifyRow( uiRow1, uiRows );
+			if ( pStats == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid statistics array parameter ( NULL )."s );
+			}
 
-			verifyRow( uiRow2, uiRows );
+			const auto uiSatVal = static_cast< T >( maxTVal() - 1 );
 
-			verifyColumn( uiCol1, uiCols );
+			const std::size_t uiChannels = vChannels.size();
 
-			verifyColumn( uiCol2, uiCols );
+			std::uint32_t uiRow1 = uiRows;
+			std::uint32_t uiRow2 = 0;
 
-			verifyRangeOrder( uiCol1, uiCol2 );
+			for ( const auto& rRoi : vChannels )
+			{
+				uiRow1 = std::min( uiRow1, rRoi.uiRow1 );
+				uiRow2 = std::max( uiRow2, rRoi.uiRow2 );
+			}
 
-			verifyRangeOrder( uiRow1, uiRow2 );
+			//
+			// One partial per channel per row block, stored block major
+			//
+			std::vector<StatsAccum_t> vBlocks( uiChannels * threadCount( uiThreads ) );
 
-			verifyBuffer( pBuf1 );
+			auto uiBlocks = forEachRowBlock( uiRow1, uiRow2, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				accumulateChannels( pBuf, uiCols, uiFirst, uiLast, vChannels, uiSatVal, &vBlocks[ uiBlock * uiChannels ] );
+			} );
 
-			verifyBuffer( pBuf2 );
+			for ( std::size_t c = 0; c < uiChannels; c++ )
+			{
+				StatsAccum_t cTotal;
 
-			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
-			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+				for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+				{
+					cTotal.merge( vBlocks[ b * uiChannels + c ] );
+				}
 
-			double gTotalPixelCount = ( static_cast< double >( uiLocalRow2 - uiRow1 ) * static_cast<double>( uiLocalCol2 - uiCol1 ) );
+				toStats( cTotal, maxTVal(), pStats[ c ] );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  accumulateChannelStats                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics of every channel ( amplifier ) region of an image in a single pass and adds   |
+		// |  them to the running averages of a sequence of images. The channel averages are updated with a running   |
+		// |  mean, so no per-image history is kept. The "of means" members are then recalculated across channels.    |
+		// |                                                                                                          |
+		// |  <IN>    -> pBuf      - Pointer to the image data buffer.                                                |
+		// |  <IN>    -> uiCols    - The image column size ( in pixels ).                                             |
+		// |  <IN>    -> uiRows    - The image row size ( in pixels ).                                                |
+		// |  <IN>    -> vChannels - The channel regions. Must hold cAvgStats.uiChannelCount regions.                 |
+		// |  <INOUT> -> cAvgStats - The running averages to update.                                                  |
+		// |  <IN>    -> uiThreads - The number of threads. Zero uses one per hardware thread.                        |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::accumulateChannelStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vChannels,
+												   arc::gen3::image::CAvgStats& cAvgStats, const std::uint32_t uiThreads )
+		{
+			if ( vChannels.size() != cAvgStats.uiChannelCount )
+			{
+				throwArcGen3InvalidArgument( "Channel region count [ %u ] does not match the average statistics channel count [ %u ].",
+											 static_cast< std::uint32_t >( vChannels.size() ), cAvgStats.uiChannelCount );
+			}
+
+			std::vector<arc::gen3::image::CStats> vStats( vChannels.size() );
+
+			getChannelStats( pBuf, uiCols, uiRows, vChannels, vStats.data(), uiThreads );
+
+			cAvgStats.uiImageCount++;
+
+			const double gWeight = ( 1.0 / static_cast< double >( cAvgStats.uiImageCount ) );
+
+			double gMeanSum = 0.0;
+			double gMeanSqrSum = 0.0;
+			double gStdDevSum = 0.0;
+
+			for ( std::uint32_t c = 0; c < cAvgStats.uiChannelCount; c++ )
+			{
+				cAvgStats.pAverageMin[ c ] += ( ( vStats[ c ].gMin - cAvgStats.pAverageMin[ c ] ) * gWeight );
+				cAvgStats.pAverageMax[ c ] += ( ( vStats[ c ].gMax - cAvgStats.pAverageMax[ c ] ) * gWeight );
+				cAvgStats.pAverageMean[ c ] += ( ( vStats[ c ].gMean - cAvgStats.pAverageMean[ c ] ) * gWeight );
+				cAvgStats.pAverageStdDev[ c ] += ( ( vStats[ c ].gStdDev - cAvgStats.pAverageStdDev[ c ] ) * gWeight );
+
+				gMeanSum += cAvgStats.pAverageMean[ c ];
+				gMeanSqrSum += ( cAvgStats.pAverageMean[ c ] * cAvgStats.pAverageMean[ c ] );
+				gStdDevSum += cAvgStats.pAverageStdDev[ c ];
+			}
+
+			const double gChannels = static_cast< double >( cAvgStats.uiChannelCount );
+
+			cAvgStats.gMeanOfMeans = ( gMeanSum / gChannels );
+			cAvgStats.gStdDevOfMeans = std::sqrt( std::max( 0.0, ( gMeanSqrSum / gChannels ) - ( cAvgStats.gMeanOfMeans * cAvgStats.gMeanOfMeans ) ) );
+			cAvgStats.gAvgAvgStdDev = ( gStdDevSum / gChannels );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  channelGrid                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the channel regions of a detector read out by a regular grid of amplifiers, each reading an     |
+		// |  equal block of the image. Channels are listed row by row from the first image row.                      |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols        - The image column size ( in pixels ).                                            |
+		// |  <IN> -> uiRows        - The image row size ( in pixels ).                                               |
+		// |  <IN> -> uiColChannels - The number of channels across the columns. Must divide uiCols.                  |
+		// |  <IN> -> uiRowChannels - The number of channels across the rows. Must divide uiRows.                     |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::vector<arc::gen3::image::Roi_t> CArcImage<T>::channelGrid( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiColChannels, const std::uint32_t uiRowChannels )
+		{
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			if ( uiColChannels == 0 || uiRowChannels == 0 || ( uiCols % uiColChannels ) != 0 || ( uiRows % uiRowChannels ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid channel grid [ %u x %u ] for image [ %u x %u ]. The grid must divide the image evenly.",
+											 uiColChannels, uiRowChannels, uiCols, uiRows );
+			}
+
+			const std::uint32_t uiWidth = ( uiCols / uiColChannels );
+			const std::uint32_t uiHeight = ( uiRows / uiRowChannels );
+
+			std::vector<arc::gen3::image::Roi_t> vChannels;
+
+			vChannels.reserve( static_cast< std::size_t >( uiColChannels ) * uiRowChannels );
+
+			for ( std::uint32_t r = 0; r < uiRowChannels; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiColChannels; c++ )
+				{
+					vChannels.push_back( { ( c * uiWidth ), ( ( c + 1 ) * uiWidth ), ( r * uiHeight ), ( ( r + 1 ) * uiHeight ) } );
+				}
+			}
+
+			return vChannels;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getProfiles                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates many averaged row and column profiles in a single sweep over the image rows.                 |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> vProfiles - The profile requests.                                                               |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getProfiles( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Profile_t>& vProfiles,
+										const std::uint32_t uiThreads )
+		{
+			getProfiles( arc::gen3::image::ImageView<const T>( pBuf, uiCols, uiRows ), vProfiles, uiThreads );
+		}
 
-			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
 
-			pDifStats->cStats1.set( *getStats( pBuf1, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getProfiles                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates many averaged row and column profiles of an image view in a single sweep. Each thread takes  |
+		// |  a block of rows and visits every profile region that covers each row while the row is in cache. A row   |
+		// |  profile value is the sum of one row segment. A column profile adds its row segment to an integer        |
+		// |  accumulator per thread, a loop the compiler vectorizes; the thread accumulators are then merged.        |
+		// |                                                                                                          |
+		// |  <IN> -> tView     - The view.                                                                           |
+		// |  <IN> -> vProfiles - The profile requests.                                                               |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getProfiles( const arc::gen3::image::ImageView<const T>& tView, const std::vector<arc::gen3::image::Profile_t>& vProfiles, const std::uint32_t uiThreads )
+		{
+			verifyViews( tView, tView, tView );
+
+			std::vector<arc::gen3::image::Roi_t> vRegions;
 
-			pDifStats->cStats2.set( *getStats( pBuf2, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols, uiRows ).get() );
+			vRegions.reserve( vProfiles.size() );
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
+			for ( const auto& rProfile : vProfiles )
 			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
+				if ( rProfile.pDst == nullptr )
 				{
-					gVal1 = static_cast< double >( pBuf1[ j + i * uiCols ] );
+					throwArcGen3InvalidArgument( "Invalid profile buffer reference ( nullptr )."s );
+				}
+
+				vRegions.push_back( rProfile.tRoi );
+			}
+
+			verifyRegions( vRegions, tView.cols(), tView.rows() );
 
-					gVal2 = static_cast< double >( pBuf2[ j + i * uiCols ] );
+			// Column profile accumulator offsets, and the row range covered by any profile
+			std::vector<std::size_t> vOffsets( vProfiles.size(), 0 );
+
+			std::size_t uiAccumSize = 0;
+
+			std::uint32_t uiRow1 = tView.rows();
+			std::uint32_t uiRow2 = 0;
+
+			for ( std::size_t i = 0; i < vProfiles.size(); i++ )
+			{
+				const auto& rRoi = vProfiles[ i ].tRoi;
 
-					gSum += ( gVal1 - gVal2 );
+				if ( vProfiles[ i ].eAxis == arc::gen3::image::e_ProfileAxis::COLUMN )
+				{
+					vOffsets[ i ] = uiAccumSize;
 
-					gDifSum += ( std::pow( ( pDifStats->cStats2.gMean - gVal2 ) - ( pDifStats->cStats1.gMean - gVal1 ), 2 ) );
+					uiAccumSize += ( rRoi.uiCol2 - rRoi.uiCol1 );
 				}
+
+				uiRow1 = ( rRoi.uiRow1 < uiRow1 ? rRoi.uiRow1 : uiRow1 );
+				uiRow2 = ( rRoi.uiRow2 > uiRow2 ? rRoi.uiRow2 : uiRow2 );
 			}
 
-			pDifStats->cDiffStats.gMean = std::fabs( gSum / gTotalPixelCount );
-			pDifStats->cDiffStats.gVariance = gDifSum / gTotalPixelCount;
-			pDifStats->cDiffStats.gStdDev = std::sqrt( pDifStats->cDiffStats.gVariance );
+			std::vector<std::uint64_t> vAccum( static_cast< std::size_t >( threadCount( uiThreads ) ) * uiAccumSize, 0 );
 
-			return pDifStats;
+			const auto uiBlocks = forEachRowBlock( uiRow1, uiRow2, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				std::uint64_t* pAccum = ( vAccum.data() + uiBlock * uiAccumSize );
+
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const T* pRow = tView.rowData( uiRow );
+
+					for ( std::size_t i = 0; i < vProfiles.size(); i++ )
+					{
+						const auto& rProfile = vProfiles[ i ];
+
+						if ( uiRow < rProfile.tRoi.uiRow1 || uiRow >= rProfile.tRoi.uiRow2 )
+						{
+							continue;
+						}
+
+						const T* pSrc = ( pRow + rProfile.tRoi.uiCol1 );
+
+						const std::uint32_t uiWidth = ( rProfile.tRoi.uiCol2 - rProfile.tRoi.uiCol1 );
+
+						if ( rProfile.eAxis == arc::gen3::image::e_ProfileAxis::COLUMN )
+						{
+							std::uint64_t* pSum = ( pAccum + vOffsets[ i ] );
+
+							for ( std::uint32_t c = 0; c < uiWidth; c++ )
+							{
+								pSum[ c ] += pSrc[ c ];
+							}
+						}
+
+						else
+						{
+							std::uint64_t uiSum = 0;
+
+							for ( std::uint32_t c = 0; c < uiWidth; c++ )
+							{
+								uiSum += pSrc[ c ];
+							}
+
+							rProfile.pDst[ uiRow - rProfile.tRoi.uiRow1 ] = ( static_cast< double >( uiSum ) / static_cast< double >( uiWidth ) );
+						}
+					}
+				}
+			} );
+
+			for ( std::size_t i = 0; i < vProfiles.size(); i++ )
+			{
+				const auto& rProfile = vProfiles[ i ];
+
+				if ( rProfile.eAxis != arc::gen3::image::e_ProfileAxis::COLUMN )
+				{
+					continue;
+				}
+
+				const std::uint32_t uiWidth = ( rProfile.tRoi.uiCol2 - rProfile.tRoi.uiCol1 );
+
+				const double gHeight = static_cast< double >( rProfile.tRoi.uiRow2 - rProfile.tRoi.uiRow1 );
+
+				for ( std::uint32_t c = 0; c < uiWidth; c++ )
+				{
+					std::uint64_t uiSum = 0;
+
+					for ( std::uint32_t uiBlock = 0; uiBlock < uiBlocks; uiBlock++ )
+					{
+						uiSum += vAccum[ uiBlock * uiAccumSize + vOffsets[ i ] + c ];
+					}
+
+					rProfile.pDst[ c ] = ( static_cast< double >( uiSum ) / gHeight );
+				}
+			}
 		}
 
 
@@ -995,21 +2066,180 @@ namespace arc
 		// |  getDiffStats                                                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
 		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
-		// |  count for each image as well as the difference mean, variance and standard deviation over the entire    |
-		// |  image buffer. This is used for photon transfer curves( PTC ).The two images MUST be the same size or    |
-		// |  the methods behavior is undefined as this cannot be verified using the given parameters.                |
+		// |  count for each image as well as the difference mean, variance and standard deviation over the specified |
+		// |  image buffer cols and rows. This is used for photon transfer curves( PTC ).The two images MUST be the   |
+		// |  same size or the methods behavior is undefined as this cannot be verified using the given parameters.   |
 		// |                                                                                                          |
 		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
 		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCol1 - The start column.                                                                      |
+		// |  <IN> -> uiCol2 - The end column.                                                                        |
+		// |  <IN> -> uiRow1 - The start row.                                                                         |
+		// |  <IN> -> uiRow2 - The end row.                                                                           |
 		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
 		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
+		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCol1, const std::uint32_t uiCol2, const std::uint32_t uiRow1, const std::uint32_t uiRow2,
+									const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			std::remove_const_t<decltype( uiRow2 )> uiLocalRow2 = uiRow2;
+			std::remove_const_t<decltype( uiCol2 )> uiLocalCol2 = uiCol2;
+
+			verifyRow( uiRow1, uiRows );
+
+			verifyRow( uiRow2, uiRows );
+
+			verifyColumn( uiCol1, uiCols );
+
+			verifyColumn( uiCol2, uiCols );
+
+			verifyRangeOrder( uiCol1, uiCol2 );
+
+			verifyRangeOrder( uiRow1, uiRow2 );
+
+			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
+			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
+
+			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
+
+			getDiffStats( pBuf1, pBuf2, uiCols, uiRows, { { uiCol1, uiLocalCol2, uiRow1, uiLocalRow2 } }, pDifStats.get(), uiThreads );
+
+			return pDifStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getDiffStats                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the min, max, mean, variance, standard deviation, total pixel count and saturated pixel      |
+		// |  count for each image as well as the difference mean, variance and standard deviation over the entire    |
+		// |  image buffer. This is used for photon transfer curves( PTC ).The two images MUST be the same size or    |
+		// |  the methods behavior is undefined as this cannot be verified using the given parameters.                |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	    - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2	    - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
 		// |  Throws std::runtime_error on error.                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T> std::unique_ptr<arc::gen3::image::CDifStats>
-		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			std::unique_ptr<arc::gen3::image::CDifStats> pDifStats( new arc::gen3::image::CDifStats() );
+
+			getDiffStats( pBuf1, pBuf2, uiCols, uiRows, { { 0, uiCols, 0, uiRows } }, pDifStats.get(), uiThreads );
+
+			return pDifStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getDiffStats                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics of both images and of their difference ( image 1 - image 2 ) for every        |
+		// |  region in one fused pass over the two images. Each difference row is formed in registers, so the        |
+		// |  pass reads every pixel of both images once. The difference mean is the absolute mean difference and     |
+		// |  the difference variance is the population variance of the pixel differences, as for the single          |
+		// |  region methods.                                                                                         |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf1     - Pointer to the first image buffer.                                                 |
+		// |  <IN>  -> pBuf2     - Pointer to the second image buffer.                                                |
+		// |  <IN>  -> uiCols    - The image column size ( in pixels ).                                               |
+		// |  <IN>  -> uiRows    - The image row size ( in pixels ).                                                  |
+		// |  <IN>  -> vRois     - The regions.                                                                       |
+		// |  <OUT> -> pStats    - Array of vRois.size() statistics to fill, one per region.                          |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per hardware thread.                          |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getDiffStats( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::vector<arc::gen3::image::Roi_t>& vRois,
+										 arc::gen3::image::CDifStats* pStats, const std::uint32_t uiThreads )
 		{
-			return getDiffStats( pBuf1, pBuf2, 0, uiCols, 0, uiRows, uiCols, uiRows );
+			verifyBuffer( pBuf1 );
+
+			verifyBuffer( pBuf2 );
+
+			verifyRegions( vRois, uiCols, uiRows );
+
+			if ( pStats == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid statistics array parameter ( NULL )."s );
+			}
+
+			const auto uiSatVal = static_cast< T >( maxTVal() - 1 );
+
+			const std::size_t uiRois = vRois.size();
+
+			std::uint32_t uiRow1 = uiRows;
+			std::uint32_t uiRow2 = 0;
+
+			for ( const auto& rRoi : vRois )
+			{
+				uiRow1 = std::min( uiRow1, rRoi.uiRow1 );
+				uiRow2 = std::max( uiRow2, rRoi.uiRow2 );
+			}
+
+			//
+			// Three partials ( image 1, image 2, difference ) per region per row block, stored block major
+			//
+			std::vector<StatsAccum_t> vBlocks( 3 * uiRois * threadCount( uiThreads ) );
+
+			auto uiBlocks = forEachRowBlock( uiRow1, uiRow2, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				StatsAccum_t* pAccum = &vBlocks[ 3 * uiRois * uiBlock ];
+
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const std::uint64_t uiOffset = ( static_cast< std::uint64_t >( uiRow ) * uiCols );
+
+					for ( std::size_t r = 0; r < uiRois; r++ )
+					{
+						const auto& rRoi = vRois[ r ];
+
+						if ( uiRow >= rRoi.uiRow1 && uiRow < rRoi.uiRow2 )
+						{
+							accumulatePairRow( pBuf1 + uiOffset + rRoi.uiCol1, pBuf2 + uiOffset + rRoi.uiCol1, ( rRoi.uiCol2 - rRoi.uiCol1 ), uiSatVal,
+											   pAccum[ 3 * r ], pAccum[ 3 * r + 1 ], pAccum[ 3 * r + 2 ] );
+						}
+					}
+				}
+			} );
+
+			for ( std::size_t r = 0; r < uiRois; r++ )
+			{
+				StatsAccum_t cTotal[ 3 ];
+
+				for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+				{
+					for ( std::size_t k = 0; k < 3; k++ )
+					{
+						cTotal[ k ].merge( vBlocks[ 3 * ( uiRois * b + r ) + k ] );
+					}
+				}
+
+				toStats( cTotal[ 0 ], maxTVal(), pStats[ r ].cStats1 );
+
+				toStats( cTotal[ 1 ], maxTVal(), pStats[ r ].cStats2 );
+
+				auto& rDiff = pStats[ r ].cDiffStats;
+
+				rDiff.set( arc::gen3::image::CStats() );
+				rDiff.gTotalPixels = static_cast< double >( cTotal[ 2 ].uiCount );
+				rDiff.gMean = std::fabs( cTotal[ 2 ].gMean );
+				rDiff.gVariance = ( cTotal[ 2 ].gM2 / static_cast< double >( cTotal[ 2 ].uiCount ) );
+				rDiff.gStdDev = std::sqrt( rDiff.gVariance );
+			}
 		}
 
 
@@ -1061,18 +2291,10 @@ namespace arc
 
 			uiCount = maxTVal();
 
-			zeroMemory( pHist.get(), uiCount * sizeof( std::uint32_t ) );
-
 			if ( uiRow1 == uiRow2 ) { uiLocalRow2++; }
 			if ( uiCol1 == uiCol2 ) { uiLocalCol2++; }
 
-			for ( std::uint32_t i = uiRow1; i < uiLocalRow2; i++ )
-			{
-				for ( std::uint32_t j = uiCol1; j < uiLocalCol2; j++ )
-				{
-					pHist.get()[ pBuf[ j + i * uiCols ] ]++;
-				}
-			}
+			fillHistogram( pHist.get(), pBuf, uiCol1, uiLocalCol2, uiRow1, uiLocalRow2, uiCols );
 			
 			return pHist;
 		}
@@ -1094,363 +2316,1619 @@ namespace arc
 		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
 		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, std::uint32_t& uiCount )
 		{
-			return histogram( pBuf, 0, uiCols, 0, uiRows, uiCols, uiRows, uiCount );
+			verifyColumns( uiCols );
+
+			verifyRows( uiRows );
+
+			verifyBuffer( pBuf );
+
+			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			pHist( new std::uint32_t[ maxTVal() ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+
+			uiCount = maxTVal();
+
+			fillHistogram( pHist.get(), pBuf, 0, uiCols, 0, uiRows, uiCols );
+
+			return pHist;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fillHistogram                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Zeroes a maxTVal() bin histogram and counts the pixels of a region into it. 32-bit pixel values can     |
+		// |  exceed the bin count; they are counted in the last bin. See CArcHistogram for configurable ranges.      |
+		// |                                                                                                          |
+		// |  <OUT> -> pHist    - The maxTVal() bin histogram.                                                        |
+		// |  <IN>  -> pBuf     - Pointer to the image buffer.                                                        |
+		// |  <IN>  -> uiCol1   - The start column.                                                                   |
+		// |  <IN>  -> uiColEnd - One past the end column.                                                            |
+		// |  <IN>  -> uiRow1   - The start row.                                                                      |
+		// |  <IN>  -> uiRowEnd - One past the end row.                                                               |
+		// |  <IN>  -> uiCols   - The image column size ( in pixels ).                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::fillHistogram( std::uint32_t* pHist, const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiColEnd,
+										  const std::uint32_t uiRow1, const std::uint32_t uiRowEnd, const std::uint32_t uiCols )
+		{
+			const std::uint32_t uiLastBin = ( maxTVal() - 1 );
+
+			zeroMemory( pHist, ( static_cast< std::size_t >( maxTVal() ) * sizeof( std::uint32_t ) ) );
+
+			for ( std::uint32_t i = uiRow1; i < uiRowEnd; i++ )
+			{
+				const T* pRow = pBuf + ( static_cast< std::uint64_t >( i ) * uiCols );
+
+				for ( std::uint32_t j = uiCol1; j < uiColEnd; j++ )
+				{
+					pHist[ std::min<std::uint32_t>( pRow[ j ], uiLastBin ) ]++;
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  detectDefects                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Detects hot pixels and cosmic rays. A pixel is masked if it exceeds the median of its 3 x 3             |
+		// |  neighborhood by more than gThreshold times the noise. The noise is 1.4826 times the median absolute     |
+		// |  residual from the median over a sample of about 128 rows, with a floor of one count. The comparison is  |
+		// |  made in a type wide enough to hold the median plus the limit, so it has no branches.                    |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf       - Pointer to the image data buffer.                                                 |
+		// |  <IN>  -> uiCols     - The image column size ( in pixels ).                                              |
+		// |  <IN>  -> uiRows     - The image row size ( in pixels ).                                                 |
+		// |  <OUT> -> cMask      - The mask. Resized to the image and overwritten.                                   |
+		// |  <IN>  -> gThreshold - The detection threshold, in standard deviations.                                  |
+		// |  <IN>  -> uiThreads  - The number of threads. Zero uses one per hardware thread.                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::detectDefects( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, arc::gen3::image::CBitMask& cMask,
+												   const double gThreshold, const std::uint32_t uiThreads )
+		{
+			if ( !( gThreshold > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid detection threshold [ %f ], must be positive.", gThreshold );
+			}
+
+			if ( cMask.cols() != uiCols || cMask.rows() != uiRows )
+			{
+				cMask.resize( uiCols, uiRows );
+			}
+
+			verifyMask( pBuf, uiCols, uiRows, cMask );
+
+			// Noise estimate from a sample of rows
+			const std::uint32_t uiStep = std::max<std::uint32_t>( ( uiRows / 128 ), 1 );
+
+			std::vector<T> vMedian( uiCols );
+
+			std::vector<T> vResiduals;
+
+			vResiduals.reserve( static_cast< std::size_t >( ( uiRows + uiStep - 1 ) / uiStep ) * uiCols );
+
+			for ( std::uint32_t uiRow = ( uiStep / 2 ); uiRow < uiRows; uiRow += uiStep )
+			{
+				const T* pRow = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+				medianRow( pBuf, uiCols, uiRows, uiRow, vMedian.data() );
+
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					vResiduals.push_back( pRow[ c ] > vMedian[ c ] ? static_cast< T >( pRow[ c ] - vMedian[ c ] ) : static_cast< T >( vMedian[ c ] - pRow[ c ] ) );
+				}
+			}
+
+			auto itMid = ( vResiduals.begin() + vResiduals.size() / 2 );
+
+			std::nth_element( vResiduals.begin(), itMid, vResiduals.end() );
+
+			const double gSigma = std::max( ( 1.4826 * static_cast< double >( *itMid ) ), 1.0 );
+
+			const Wide_t<T> uiLimit = static_cast< Wide_t<T> >( std::min( std::floor( gThreshold * gSigma ), static_cast< double >( std::numeric_limits<T>::max() ) ) );
+
+			// Detection pass
+			std::vector<std::uint64_t> vCounts( threadCount( uiThreads ), 0 );
+
+			const auto uiBlocks = forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				std::vector<T> vBlockMedian( uiCols );
+
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const T* pRow = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+					const T* pMedian = vBlockMedian.data();
+
+					medianRow( pBuf, uiCols, uiRows, uiRow, vBlockMedian.data() );
+
+					std::uint64_t* pWords = cMask.rowData( uiRow );
+
+					for ( std::uint32_t w = 0; w < cMask.wordsPerRow(); w++ )
+					{
+						const std::uint32_t uiCol1 = ( w * 64 );
+						const std::uint32_t uiBits = std::min<std::uint32_t>( ( uiCols - uiCol1 ), 64 );
+
+						std::uint64_t uiWord = 0;
+
+						for ( std::uint32_t b = 0; b < uiBits; b++ )
+						{
+							const bool bDefect = ( static_cast< Wide_t<T> >( pRow[ uiCol1 + b ] ) > ( static_cast< Wide_t<T> >( pMedian[ uiCol1 + b ] ) + uiLimit ) );
+
+							uiWord |= ( static_cast< std::uint64_t >( bDefect ) << b );
+						}
+
+						pWords[ w ] = uiWord;
+
+						vCounts[ uiBlock ] += static_cast< std::uint64_t >( std::popcount( uiWord ) );
+					}
+				}
+			} );
+
+			std::uint64_t uiCount = 0;
+
+			for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+			{
+				uiCount += vCounts[ b ];
+			}
+
+			return uiCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  interpolateMasked                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Replaces every masked pixel with the rounded mean of the unmasked pixels around it. Only masked pixels  |
+		// |  are written and only unmasked pixels are read, so the rows can be split over threads in place. The      |
+		// |  masked pixels of a row are found a mask word at a time.                                                 |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> cMask     - The mask.                                                                           |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcImage<T>::interpolateMasked( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask,
+													   const std::uint32_t uiThreads )
+		{
+			verifyMask( pBuf, uiCols, uiRows, cMask );
+
+			std::vector<std::uint64_t> vCounts( threadCount( uiThreads ), 0 );
+
+			const auto uiBlocks = forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					forEachMaskedPixel( cMask.rowData( uiRow ), cMask.wordsPerRow(), [ & ]( std::uint32_t uiCol )
+					{
+						for ( std::uint32_t uiRadius = 1; uiRadius <= 2; uiRadius++ )
+						{
+							const std::uint32_t uiRowA = ( uiRow > uiRadius ? ( uiRow - uiRadius ) : 0 );
+							const std::uint32_t uiRowB = std::min( ( uiRow + uiRadius + 1 ), uiRows );
+							const std::uint32_t uiColA = ( uiCol > uiRadius ? ( uiCol - uiRadius ) : 0 );
+							const std::uint32_t uiColB = std::min( ( uiCol + uiRadius + 1 ), uiCols );
+
+							std::uint64_t uiSum = 0;
+							std::uint64_t uiCount = 0;
+
+							for ( std::uint32_t r = uiRowA; r < uiRowB; r++ )
+							{
+								for ( std::uint32_t c = uiColA; c < uiColB; c++ )
+								{
+									if ( !cMask.test( c, r ) )
+									{
+										uiSum += pBuf[ static_cast< std::size_t >( r ) * uiCols + c ];
+
+										uiCount++;
+									}
+								}
+							}
+
+							if ( uiCount > 0 )
+							{
+								pBuf[ static_cast< std::size_t >( uiRow ) * uiCols + uiCol ] = static_cast< T >( ( uiSum + uiCount / 2 ) / uiCount );
+
+								vCounts[ uiBlock ]++;
+
+								break;
+							}
+						}
+					} );
+				}
+			} );
+
+			std::uint64_t uiCount = 0;
+
+			for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+			{
+				uiCount += vCounts[ b ];
+			}
+
+			return uiCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the image statistics over the unmasked pixels. Each row is split into the runs of unmasked   |
+		// |  pixels between its masked pixels, and every run is accumulated by the getStats() row kernel.            |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image data buffer.                                                   |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> cMask     - The mask.                                                                           |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::unique_ptr<arc::gen3::image::CStats> CArcImage<T>::getStats( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask,
+																		  const std::uint32_t uiThreads )
+		{
+			verifyMask( pBuf, uiCols, uiRows, cMask );
+
+			std::unique_ptr<arc::gen3::image::CStats> pStats( new arc::gen3::image::CStats() );
+
+			const auto uiSatVal = static_cast< T >( maxTVal() - 1 );
+
+			std::vector<StatsAccum_t> vBlocks( threadCount( uiThreads ) );
+
+			const auto uiBlocks = forEachRowBlock( 0, uiRows, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					const T* pRow = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+					forEachUnmaskedRun( cMask.rowData( uiRow ), uiCols, [ & ]( std::uint32_t uiCol1, std::uint32_t uiCol2 )
+					{
+						accumulateRow( ( pRow + uiCol1 ), ( uiCol2 - uiCol1 ), uiSatVal, vBlocks[ uiBlock ] );
+					} );
+				}
+			} );
+
+			StatsAccum_t cTotal;
+
+			for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+			{
+				cTotal.merge( vBlocks[ b ] );
+			}
+
+			toStats( cTotal, maxTVal(), *pStats );
+
+			return pStats;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  histogram                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the histogram over the unmasked pixels of the entire image buffer.                           |
+		// |                                                                                                          |
+		// |  <IN>  -> pBuf    - Pointer to the image buffer.                                                         |
+		// |  <IN>  -> uiCols  - The image column size ( in pixels ).                                                 |
+		// |  <IN>  -> uiRows  - The image row size ( in pixels ).                                                    |
+		// |  <IN>  -> cMask   - The mask.                                                                            |
+		// |  <OUT> -> uiCount - The element count of the returned array.                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+		CArcImage<T>::histogram( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask, std::uint32_t& uiCount )
+		{
+			verifyMask( pBuf, uiCols, uiRows, cMask );
+
+			std::unique_ptr<std::uint32_t[], arc::gen3::image::ArrayDeleter<std::uint32_t>>
+			pHist( new std::uint32_t[ maxTVal() ], arc::gen3::image::ArrayDeleter<std::uint32_t>() );
+
+			uiCount = maxTVal();
+
+			const std::uint32_t uiLastBin = ( maxTVal() - 1 );
+
+			std::uint32_t* pBins = pHist.get();
+
+			zeroMemory( pBins, ( static_cast< std::size_t >( maxTVal() ) * sizeof( std::uint32_t ) ) );
+
+			for ( std::uint32_t uiRow = 0; uiRow < uiRows; uiRow++ )
+			{
+				const T* pRow = ( pBuf + static_cast< std::size_t >( uiRow ) * uiCols );
+
+				forEachUnmaskedRun( cMask.rowData( uiRow ), uiCols, [ & ]( std::uint32_t uiCol1, std::uint32_t uiCol2 )
+				{
+					for ( std::uint32_t c = uiCol1; c < uiCol2; c++ )
+					{
+						pBins[ std::min<std::uint32_t>( pRow[ c ], uiLastBin ) ]++;
+					}
+				} );
+			}
+
+			return pHist;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image buffers together pixel by pixel. The result is a pointer to a 64-bit buffer.             |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>>
+		CArcImage<T>::add( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::uint32_t uiLength = ( uiCols * uiRows );
+
+			std::unique_ptr< std::uint64_t[], arc::gen3::image::ArrayDeleter< std::uint64_t > > pAdd( new std::uint64_t[ uiLength ], arc::gen3::image::ArrayDeleter< std::uint64_t >() );
+
+			if ( pAdd == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate addition data buffer!"s );
+			}
+
+			add( pAdd.get(), pBuf1, pBuf2, uiCols, uiRows );
+
+			return pAdd;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image buffers pixel by pixel. The result is a pointer to a buffer with the same data      |
+		// |  type as the two images being subtracted. Buffer two is subtracted from buffer one.                      |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::subtract( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::uint32_t uiLength = ( uiCols * uiRows );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pSub( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pSub == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate subtraction data buffer!"s );
+			}
+
+			subtract( pSub.get(), pBuf1, pBuf2, uiCols, uiRows, arc::gen3::image::e_ArithMode::WRAP );
+
+			return pSub;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtractHalves                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts one half of an image from the other. The first half of the image buffer is replaced with      |
+		// |  the new image. An empty image is left unchanged.                                                        |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf	 - Pointer to the image buffer. Result is placed in this buffer.                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::subtractHalves( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf );
+
+			if ( ( uiRows % 2 ) != 0 )
+			{
+				throwArcGen3InvalidArgument( "Image must have an even number of rows [ %u ]", uiRows );
+			}
+
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				return;
+			}
+
+			T* pBuf1 = pBuf;
+
+			T* pBuf2 = pBuf + ( static_cast< std::uint64_t >( ( uiRows / 2 ) ) * static_cast<std::uint64_t>( uiCols ) );
+
+			subtract( pBuf1, pBuf1, pBuf2, uiCols, ( uiRows / 2 ), arc::gen3::image::e_ArithMode::WRAP );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  divide                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Divides two image buffers pixel by pixel.                                                               |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1	 - Pointer to the first image buffer. Result is placed in this buffer.                    |
+		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
+		CArcImage<T>::divide( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pBuf1 );
+	
+			verifyBuffer( pBuf2 );
+
+			std::uint32_t uiLength = ( uiCols * uiRows );
+
+			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pDiv( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+
+			if ( pDiv == nullptr )
+			{
+				throwArcGen3Error( "Failed to allocate division data buffer!"s );
+			}
+
+			divide( pDiv.get(), pBuf1, pBuf2, uiCols, uiRows );
+
+			return pDiv;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
+		// |  equal in dimensions to the destination buffer.                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf - Pointer to the destination image buffer. Result is placed in this buffer.             |
+		// |  <IN> -> pSrcBuf - Pointer to the source image buffer.                                                   |
+		// |  <IN> -> uiCols  - The number of image columns to copy ( in pixels ).                                    |
+		// |  <IN> -> uiRows  - The number of image rows to copy ( in pixels ).                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			verifyBuffer( pDstBuf );
+
+			verifyBuffer( pSrcBuf );
+
+			copy( pDstBuf, pSrcBuf, ( uiCols * uiRows * static_cast< std::uint32_t >( sizeof( T ) ) ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
+		// |  equal in dimensions to the destination buffer.                                                          |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf	- Pointer to the destination image buffer. Result is placed in this buffer.           |
+		// |  <IN> -> pSrcBuf	- Pointer to the source image buffer.                                                 |
+		// |  <IN> -> uiSize	- The number of image bytes to copy.                                                  |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize )
+		{
+			verifyBuffer( pDstBuf );
+	
+			verifyBuffer( pSrcBuf );
+
+			copyMemory( pDstBuf, const_cast< T* >( pSrcBuf ), uiSize );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image buffers pixel by pixel into a caller buffer. The destination may be either source        |
+		// |  buffer. A saturated sum is detected by the wrapped sum being less than an operand.                      |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::add( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+								const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			const bool bSaturate = ( eMode == arc::gen3::image::e_ArithMode::SATURATE );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				if ( bSaturate )
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const T tSum = static_cast< T >( pSrc1[ i ] + pSrc2[ i ] );
+
+						pDst[ i ] = ( tSum < pSrc1[ i ] ? std::numeric_limits<T>::max() : tSum );
+					}
+				}
+
+				else
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						pDst[ i ] = static_cast< T >( pSrc1[ i ] + pSrc2[ i ] );
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image buffers pixel by pixel into a caller 64-bit buffer.                                      |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination buffer.                                                  |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::add( std::uint64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				std::uint64_t* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = ( static_cast< std::uint64_t >( pSrc1[ i ] ) + static_cast< std::uint64_t >( pSrc2[ i ] ) );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image buffers pixel by pixel into a caller buffer. Buffer two is subtracted from buffer   |
+		// |  one. The destination may be either source buffer.                                                       |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtract( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+									 const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			const bool bSaturate = ( eMode == arc::gen3::image::e_ArithMode::SATURATE );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				if ( bSaturate )
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const T tDiff = static_cast< T >( pSrc1[ i ] - pSrc2[ i ] );
+
+						pDst[ i ] = ( pSrc1[ i ] < pSrc2[ i ] ? T( 0 ) : tDiff );
+					}
+				}
+
+				else
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						pDst[ i ] = static_cast< T >( pSrc1[ i ] - pSrc2[ i ] );
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image buffers pixel by pixel into a caller signed 64-bit buffer.                          |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination buffer.                                                  |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtract( std::int64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				std::int64_t* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = ( static_cast< std::int64_t >( pSrc1[ i ] ) - static_cast< std::int64_t >( pSrc2[ i ] ) );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  multiply                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Multiplies two image buffers pixel by pixel into a caller buffer. The destination may be either source  |
+		// |  buffer. The product is formed in a type twice the pixel width, then clamped or truncated.               |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::multiply( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows,
+									 const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			const bool bSaturate = ( eMode == arc::gen3::image::e_ArithMode::SATURATE );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				if ( bSaturate )
+				{
+					constexpr Wide_t<T> uiMax = std::numeric_limits<T>::max();
+
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const Wide_t<T> uiProduct = ( static_cast< Wide_t<T> >( pSrc1[ i ] ) * pSrc2[ i ] );
+
+						pDst[ i ] = static_cast< T >( uiProduct > uiMax ? uiMax : uiProduct );
+					}
+				}
+
+				else
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						pDst[ i ] = static_cast< T >( static_cast< Wide_t<T> >( pSrc1[ i ] ) * pSrc2[ i ] );
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  multiply                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Multiplies two image buffers pixel by pixel into a caller 64-bit buffer.                                |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination buffer.                                                  |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::multiply( std::uint64_t* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				std::uint64_t* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = ( static_cast< std::uint64_t >( pSrc1[ i ] ) * static_cast< std::uint64_t >( pSrc2[ i ] ) );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  divide                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Divides two image buffers pixel by pixel into a caller buffer. The destination may be either source     |
+		// |  buffer. Pixels with a zero divisor are set to zero. The quotient is formed in double precision, which   |
+		// |  is exact after truncation for both pixel types and, unlike integer division, vectorizes.                |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::divide( T* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					const double gDivisor = ( pSrc2[ i ] != 0 ? static_cast< double >( pSrc2[ i ] ) : 1.0 );
+
+					const T tQuotient = static_cast< T >( static_cast< double >( pSrc1[ i ] ) / gDivisor );
+
+					pDst[ i ] = ( pSrc2[ i ] != 0 ? tQuotient : T( 0 ) );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  divide                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Divides two image buffers pixel by pixel into a caller floating point buffer. Pixels with a zero        |
+		// |  divisor are set to zero.                                                                                |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination buffer.                                                  |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::divide( float* pDstBuf, const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pBuf1, pBuf2, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				float* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc1 = ( pBuf1 + uiFirst );
+				const T* pSrc2 = ( pBuf2 + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					const Real_t<T> gDivisor = ( pSrc2[ i ] != 0 ? static_cast< Real_t<T> >( pSrc2[ i ] ) : Real_t<T>( 1 ) );
+
+					const float fQuotient = static_cast< float >( static_cast< Real_t<T> >( pSrc1[ i ] ) / gDivisor );
+
+					pDst[ i ] = ( pSrc2[ i ] != 0 ? fQuotient : 0.0f );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  scale                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Multiplies every pixel of an image buffer by a constant into a caller buffer. Results are rounded to    |
+		// |  the nearest integer and clamped to the data type range. The destination may be the source buffer.       |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pSrcBuf   - Pointer to the source image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> gFactor   - The scale factor.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::scale( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const double gFactor, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pSrcBuf, pSrcBuf, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				constexpr double gMax = static_cast< double >( std::numeric_limits<T>::max() );
+
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc = ( pSrcBuf + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					const double gValue = ( static_cast< double >( pSrc[ i ] ) * gFactor + 0.5 );
+
+					pDst[ i ] = static_cast< T >( gValue < 0.0 ? 0.0 : ( gValue > gMax ? gMax : gValue ) );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  scale                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Multiplies every pixel of an image buffer by a constant into a caller floating point buffer.            |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination buffer.                                                  |
+		// |  <IN> -> pSrcBuf   - Pointer to the source image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> gFactor   - The scale factor.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::scale( float* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const double gFactor, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pSrcBuf, pSrcBuf, uiCols, uiRows );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				const Real_t<T> gScale = static_cast< Real_t<T> >( gFactor );
+
+				float* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc = ( pSrcBuf + uiFirst );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = static_cast< float >( static_cast< Real_t<T> >( pSrc[ i ] ) * gScale );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  offset                                                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds a signed constant to every pixel of an image buffer into a caller buffer. The destination may be   |
+		// |  the source buffer. A saturating offset is applied as a saturating add or subtract of its magnitude; an  |
+		// |  offset whose magnitude exceeds the data type range sets every pixel to the range limit.                 |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to the destination image buffer.                                            |
+		// |  <IN> -> pSrcBuf   - Pointer to the source image buffer.                                                 |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> iOffset   - The offset.                                                                         |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error on error.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::offset( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const std::int64_t iOffset,
+								   const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyOperands( pDstBuf, pSrcBuf, pSrcBuf, uiCols, uiRows );
+
+			constexpr std::uint64_t uiMax = std::numeric_limits<T>::max();
+
+			const std::uint64_t uiMagnitude = ( iOffset < 0 ? ( 0 - static_cast< std::uint64_t >( iOffset ) ) : static_cast< std::uint64_t >( iOffset ) );
+
+			if ( eMode == arc::gen3::image::e_ArithMode::SATURATE && uiMagnitude > uiMax )
+			{
+				const T tLimit = ( iOffset < 0 ? T( 0 ) : std::numeric_limits<T>::max() );
+
+				forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+				{
+					std::fill_n( pDstBuf + uiFirst, uiCount, tLimit );
+				} );
+
+				return;
+			}
+
+			const bool bSaturate = ( eMode == arc::gen3::image::e_ArithMode::SATURATE );
+
+			const T tOffset = static_cast< T >( static_cast< std::uint64_t >( iOffset ) );
+
+			const T tMagnitude = static_cast< T >( uiMagnitude );
+
+			forEachSpan<T>( uiCols, uiRows, uiThreads, [ & ]( std::size_t uiFirst, std::size_t uiCount )
+			{
+				T* pDst = ( pDstBuf + uiFirst );
+				const T* pSrc = ( pSrcBuf + uiFirst );
+
+				if ( !bSaturate )
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						pDst[ i ] = static_cast< T >( pSrc[ i ] + tOffset );
+					}
+				}
+
+				else if ( iOffset >= 0 )
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const T tSum = static_cast< T >( pSrc[ i ] + tMagnitude );
+
+						pDst[ i ] = ( tSum < pSrc[ i ] ? std::numeric_limits<T>::max() : tSum );
+					}
+				}
+
+				else
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const T tDiff = static_cast< T >( pSrc[ i ] - tMagnitude );
+
+						pDst[ i ] = ( pSrc[ i ] < tMagnitude ? T( 0 ) : tDiff );
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fill                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Fills an image view with the specified value.                                                           |
+		// |                                                                                                          |
+		// |  <IN> -> tView   - The view.                                                                             |
+		// |  <IN> -> uiValue - The value to fill the view with.                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::fill( const arc::gen3::image::ImageView<T>& tView, const T uiValue )
+		{
+			verifyViews( tView, tView, tView );
+
+			if ( tView.contiguous() )
+			{
+				std::fill_n( tView.data(), tView.size(), uiValue );
+
+				return;
+			}
+
+			for ( std::uint32_t uiRow = 0; uiRow < tView.rows(); uiRow++ )
+			{
+				std::fill_n( tView.rowData( uiRow ), tView.cols(), uiValue );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  copy                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Copies an image view to another view of the same extent. Copying to a view of a contiguous buffer       |
+		// |  materializes a region.                                                                                  |
+		// |                                                                                                          |
+		// |  <IN> -> tDst - The destination view.                                                                    |
+		// |  <IN> -> tSrc - The source view.                                                                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::copy( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc )
+		{
+			verifyViews( tDst, tSrc, tSrc );
+
+			if ( tDst.contiguous() && tSrc.contiguous() )
+			{
+				std::copy_n( tSrc.data(), tSrc.size(), tDst.data() );
+
+				return;
+			}
+
+			for ( std::uint32_t uiRow = 0; uiRow < tSrc.rows(); uiRow++ )
+			{
+				std::copy_n( tSrc.rowData( uiRow ), tSrc.cols(), tDst.rowData( uiRow ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  getStats                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the statistics of an image view in a single pass. The view stride is the row pitch of the    |
+		// |  statistics kernel, so no pixels are copied.                                                             |
+		// |                                                                                                          |
+		// |  <IN>  -> tView     - The view.                                                                          |
+		// |  <OUT> -> cStats    - The statistics.                                                                    |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per hardware thread.                          |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::getStats( const arc::gen3::image::ImageView<const T>& tView, arc::gen3::image::CStats& cStats, const std::uint32_t uiThreads )
+		{
+			verifyViews( tView, tView, tView );
+
+			calcStats( cStats, tView.data(), 0, tView.cols(), 0, tView.rows(), tView.stride(), uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  histogram                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Calculates the histogram of an image view into a caller buffer.                                         |
+		// |                                                                                                          |
+		// |  <IN>  -> tView - The view.                                                                              |
+		// |  <OUT> -> pHist - Pointer to maxTVal() bins.                                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::histogram( const arc::gen3::image::ImageView<const T>& tView, std::uint32_t* pHist )
+		{
+			verifyViews( tView, tView, tView );
+
+			if ( pHist == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid histogram reference ( nullptr )."s );
+			}
+
+			fillHistogram( pHist, tView.data(), 0, tView.cols(), 0, tView.rows(), tView.stride() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds two image views pixel by pixel into a destination view.                                            |
+		// |                                                                                                          |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc1     - The first source view.                                                              |
+		// |  <IN> -> tSrc2     - The second source view.                                                             |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::add( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+								const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyViews( tDst, tSrc1, tSrc2 );
+
+			forEachViewRows( tDst, tSrc1, tSrc2, uiThreads, [ & ]( T* pDst, const T* pSrc1, const T* pSrc2, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
+			{
+				add( pDst, pSrc1, pSrc2, uiCols, uiRows, eMode, uiBlockThreads );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  subtract                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Subtracts two image views pixel by pixel into a destination view.                                       |
+		// |                                                                                                          |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc1     - The first source view.                                                              |
+		// |  <IN> -> tSrc2     - The second source view, which is subtracted from the first.                         |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::subtract( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+									 const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyViews( tDst, tSrc1, tSrc2 );
+
+			forEachViewRows( tDst, tSrc1, tSrc2, uiThreads, [ & ]( T* pDst, const T* pSrc1, const T* pSrc2, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
+			{
+				subtract( pDst, pSrc1, pSrc2, uiCols, uiRows, eMode, uiBlockThreads );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  multiply                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Multiplies two image views pixel by pixel into a destination view.                                      |
+		// |                                                                                                          |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc1     - The first source view.                                                              |
+		// |  <IN> -> tSrc2     - The second source view.                                                             |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument on error.                                                                  |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::multiply( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+									 const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
+		{
+			verifyViews( tDst, tSrc1, tSrc2 );
+
+			forEachViewRows( tDst, tSrc1, tSrc2, uiThreads, [ & ]( T* pDst, const T* pSrc1, const T* pSrc2, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
+			{
+				multiply( pDst, pSrc1, pSrc2, uiCols, uiRows, eMode, uiBlockThreads );
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  add                                                                                                     |
+		// |  divide                                                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Adds two image buffers together pixel by pixel. The result is a pointer to a 64-bit buffer.             |
+		// |  Divides two image views pixel by pixel into a destination view.                                         |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc1     - The first source view.                                                              |
+		// |  <IN> -> tSrc2     - The second source view, which divides the first.                                    |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<std::uint64_t[], arc::gen3::image::ArrayDeleter<std::uint64_t>>
-		CArcImage<T>::add( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::divide( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc1, const arc::gen3::image::ImageView<const T>& tSrc2,
+								   const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
-
-			std::uint32_t uiLength = ( uiCols * uiRows );
-
-			std::unique_ptr< std::uint64_t[], arc::gen3::image::ArrayDeleter< std::uint64_t > > pAdd( new std::uint64_t[ uiLength ], arc::gen3::image::ArrayDeleter< std::uint64_t >() );
-
-			if ( pAdd == nullptr )
-			{
-				throwArcGen3Error( "Failed to allocate addition data buffer!"s );
-			}
+			verifyViews( tDst, tSrc1, tSrc2 );
 
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
+			forEachViewRows( tDst, tSrc1, tSrc2, uiThreads, [ & ]( T* pDst, const T* pSrc1, const T* pSrc2, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
 			{
-				pAdd.get()[ i ] = static_cast< std::uint64_t >( pBuf1[ i ] ) + static_cast< std::uint64_t >( pBuf2[ i ] );
-			}
-
-			return pAdd;
+				divide( pDst, pSrc1, pSrc2, uiCols, uiRows, uiBlockThreads );
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  subtract                                                                                                |
+		// |  scale                                                                                                   |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Subtracts two image buffers pixel by pixel. The result is a pointer to a buffer with the same data      |
-		// |  type as the two images being subtracted. Buffer two is subtracted from buffer one.                      |
+		// |  Multiplies every pixel of an image view by a constant into a destination view.                          |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer.                                                     |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc      - The source view.                                                                    |
+		// |  <IN> -> gFactor   - The scale factor.                                                                   |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::subtract( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::scale( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc, const double gFactor, const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
-
-			std::uint32_t uiLength = ( uiCols * uiRows );
+			verifyViews( tDst, tSrc, tSrc );
 
-			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pSub( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
-
-			if ( pSub == nullptr )
-			{
-				throwArcGen3Error( "Failed to allocate subtraction data buffer!"s );
-			}
-
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
+			forEachViewRows( tDst, tSrc, tSrc, uiThreads, [ & ]( T* pDst, const T* pSrc, const T*, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
 			{
-				pSub.get()[ i ] = pBuf1[ i ] - pBuf2[ i ];
-			}
-
-			return pSub;
+				scale( pDst, pSrc, uiCols, uiRows, gFactor, uiBlockThreads );
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  subtractHalves                                                                                          |
+		// |  offset                                                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Subtracts one half of an image from the other. The first half of the image buffer is replaced with      |
-		// |  the new image.                                                                                          |
+		// |  Adds a signed constant to every pixel of an image view into a destination view.                         |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf	 - Pointer to the image buffer. Result is placed in this buffer.                          |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> tDst      - The destination view.                                                               |
+		// |  <IN> -> tSrc      - The source view.                                                                    |
+		// |  <IN> -> iOffset   - The offset.                                                                         |
+		// |  <IN> -> eMode     - The overflow handling.                                                              |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error, std::invalid_argument                                                        |
+		// |  Throws std::invalid_argument on error.                                                                  |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::subtractHalves( T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::offset( const arc::gen3::image::ImageView<T>& tDst, const arc::gen3::image::ImageView<const T>& tSrc, const std::int64_t iOffset,
+								   const arc::gen3::image::e_ArithMode eMode, const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pBuf );
+			verifyViews( tDst, tSrc, tSrc );
 
-			if ( ( uiRows % 2 ) != 0 )
+			forEachViewRows( tDst, tSrc, tSrc, uiThreads, [ & ]( T* pDst, const T* pSrc, const T*, std::uint32_t uiCols, std::uint32_t uiRows, std::uint32_t uiBlockThreads )
 			{
-				throwArcGen3InvalidArgument( "Image must have an even number of rows [ %u ]", uiRows );
-			}
+				offset( pDst, pSrc, uiCols, uiRows, iOffset, eMode, uiBlockThreads );
+			} );
+		}
 
-			T* pBuf1 = pBuf;
 
-			T* pBuf2 = pBuf + ( static_cast< std::uint64_t >( ( uiRows / 2 ) ) * static_cast<std::uint64_t>( uiCols ) );
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  bin                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Bins an image view in uiFactor x uiFactor blocks into exact 64-bit block sums. The output is            |
+		// |  ( cols / uiFactor ) x ( rows / uiFactor ) values; partial blocks at the right and bottom edges are      |
+		// |  dropped.                                                                                                |
+		// |                                                                                                          |
+		// |  <IN> -> tSrc      - The source view.                                                                    |
+		// |  <IN> -> uiFactor  - The block size, 1 to 256.                                                           |
+		// |  <IN> -> pDstBuf   - Pointer to the output buffer.                                                       |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument or std::out_of_range on error.                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImage<T>::bin( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, std::uint64_t* pDstBuf, const std::uint32_t uiThreads )
+		{
+			verifyBinning( tSrc, uiFactor, pDstBuf );
 
-			for ( std::uint32_t i = 0; i < ( ( uiRows / 2 ) * uiCols ); i++ )
+			binBlocks( tSrc, uiFactor, uiThreads, [ & ]( std::uint32_t uiOutRow, const Wide_t<T>* pSum, std::uint32_t uiOutCols )
 			{
-				pBuf1[ i ] -= pBuf2[ i ];
-			}
+				std::uint64_t* pDst = ( pDstBuf + ( static_cast< std::size_t >( uiOutRow ) * uiOutCols ) );
+
+				for ( std::uint32_t i = 0; i < uiOutCols; i++ )
+				{
+					pDst[ i ] = pSum[ i ];
+				}
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  divide                                                                                                  |
+		// |  bin                                                                                                     |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Divides two image buffers pixel by pixel.                                                               |
+		// |  Bins an image view in uiFactor x uiFactor blocks into an image buffer. Block sums are clamped to the    |
+		// |  data type range; block means are rounded to the nearest integer, with a shift for power of two blocks.  |
 		// |                                                                                                          |
-		// |  <IN> -> pBuf1	 - Pointer to the first image buffer. Result is placed in this buffer.                    |
-		// |  <IN> -> pBuf2	 - Pointer to the second image buffer.                                                    |
-		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
-		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> tSrc      - The source view.                                                                    |
+		// |  <IN> -> uiFactor  - The block size, 1 to 256.                                                           |
+		// |  <IN> -> pDstBuf   - Pointer to the output buffer.                                                       |
+		// |  <IN> -> eMode     - The output mode.                                                                    |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument or std::out_of_range on error.                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::unique_ptr<T[], arc::gen3::image::ArrayDeleter<T>>
-		CArcImage<T>::divide( const T* pBuf1, const T* pBuf2, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::bin( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, T* pDstBuf, const arc::gen3::image::e_BinMode eMode,
+								const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pBuf1 );
-	
-			verifyBuffer( pBuf2 );
-
-			std::uint32_t uiLength = ( uiCols * uiRows );
+			verifyBinning( tSrc, uiFactor, pDstBuf );
 
-			std::unique_ptr< T[], arc::gen3::image::ArrayDeleter< T > > pDiv( new T[ uiLength ], arc::gen3::image::ArrayDeleter< T >() );
+			// A 256 x 256 block sum plus half the block area still fits in the wide type.
+			const Wide_t<T> uiArea  = ( static_cast< Wide_t<T> >( uiFactor ) * uiFactor );
+			const Wide_t<T> uiHalf  = ( uiArea / 2 );
+			const bool      bShift  = std::has_single_bit( uiArea );
+			const int       iShift  = std::countr_zero( uiArea );
 
-			if ( pDiv == nullptr )
+			binBlocks( tSrc, uiFactor, uiThreads, [ & ]( std::uint32_t uiOutRow, const Wide_t<T>* pSum, std::uint32_t uiOutCols )
 			{
-				throwArcGen3Error( "Failed to allocate division data buffer!"s );
-			}
+				T* pDst = ( pDstBuf + ( static_cast< std::size_t >( uiOutRow ) * uiOutCols ) );
 
-			for ( decltype( uiLength ) i = 0; i < uiLength; i++ )
-			{
-				if ( pBuf2[ i ] != 0 )
+				if ( eMode == arc::gen3::image::e_BinMode::SUM )
 				{
-					pDiv.get()[ i ] = pBuf1[ i ] / pBuf2[ i ];
+					constexpr Wide_t<T> uiMax = std::numeric_limits<T>::max();
+
+					for ( std::uint32_t i = 0; i < uiOutCols; i++ )
+					{
+						pDst[ i ] = static_cast< T >( pSum[ i ] < uiMax ? pSum[ i ] : uiMax );
+					}
 				}
 
-				else
+				else if ( bShift )
 				{
-					pDiv.get()[ i ] = 0;
+					for ( std::uint32_t i = 0; i < uiOutCols; i++ )
+					{
+						pDst[ i ] = static_cast< T >( ( pSum[ i ] + uiHalf ) >> iShift );
+					}
 				}
-			}
 
-			return pDiv;
+				else
+				{
+					for ( std::uint32_t i = 0; i < uiOutCols; i++ )
+					{
+						pDst[ i ] = static_cast< T >( ( pSum[ i ] + uiHalf ) / uiArea );
+					}
+				}
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  copy                                                                                                    |
+		// |  decimate                                                                                                |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
-		// |  equal in dimensions to the destination buffer.                                                          |
+		// |  Decimates an image view, keeping the first pixel of every uiFactor x uiFactor block.                    |
 		// |                                                                                                          |
-		// |  <IN> -> pDstBuf - Pointer to the destination image buffer. Result is placed in this buffer.             |
-		// |  <IN> -> pSrcBuf - Pointer to the source image buffer.                                                   |
-		// |  <IN> -> uiCols  - The number of image columns to copy ( in pixels ).                                    |
-		// |  <IN> -> uiRows  - The number of image rows to copy ( in pixels ).                                       |
+		// |  <IN> -> tSrc      - The source view.                                                                    |
+		// |  <IN> -> uiFactor  - The block size, 1 to 256.                                                           |
+		// |  <IN> -> pDstBuf   - Pointer to the output buffer.                                                       |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
 		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  Throws std::invalid_argument or std::out_of_range on error.                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiCols, const std::uint32_t uiRows )
+		template <typename T>
+		void CArcImage<T>::decimate( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, T* pDstBuf, const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pDstBuf );
+			verifyBinning( tSrc, uiFactor, pDstBuf );
 
-			verifyBuffer( pSrcBuf );
+			const std::uint32_t uiOutCols = ( tSrc.cols() / uiFactor );
+			const std::uint32_t uiOutRows = ( tSrc.rows() / uiFactor );
 
-			copy( pDstBuf, pSrcBuf, ( uiCols * uiRows * static_cast< std::uint32_t >( sizeof( T ) ) ) );
+			forEachRowBlock( 0, uiOutRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint32_t uiOutRow = uiFirst; uiOutRow < uiLast; uiOutRow++ )
+				{
+					const T* pRow = tSrc.rowData( uiOutRow * uiFactor );
+					T*       pDst = ( pDstBuf + ( static_cast< std::size_t >( uiOutRow ) * uiOutCols ) );
+
+					if ( uiFactor == 1 )
+					{
+						std::memcpy( pDst, pRow, ( uiOutCols * sizeof( T ) ) );
+
+						continue;
+					}
+
+					for ( std::uint32_t i = 0; i < uiOutCols; i++ )
+					{
+						pDst[ i ] = pRow[ static_cast< std::size_t >( i ) * uiFactor ];
+					}
+				}
+			} );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  copy                                                                                                    |
+		// |  calcStats                                                                                               |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Copies the source image buffer to the destination image buffer. The source buffer must be less than or  |
-		// |  equal in dimensions to the destination buffer.                                                          |
+		// |  Single pass statistics kernel. Each row is reduced to a partial ( count, mean, sum of squared           |
+		// |  deviations, min, max, saturated count ) and the partials are merged with Chan's parallel form of        |
+		// |  Welford's algorithm, first within each row block and then across row blocks. 16-bit rows are summed     |
+		// |  exactly in 64-bit integers. The result matches a two pass double precision calculation to within a      |
+		// |  relative error of about 1e-9 for the mean and variance; min, max and the counts are exact.              |
 		// |                                                                                                          |
-		// |  <IN> -> pDstBuf	- Pointer to the destination image buffer. Result is placed in this buffer.           |
-		// |  <IN> -> pSrcBuf	- Pointer to the source image buffer.                                                 |
-		// |  <IN> -> uiSize	- The number of image bytes to copy.                                                  |
-		// |                                                                                                          |
-		// |  Throws std::runtime_error on error.                                                                     |
+		// |  <OUT> -> cStats	 - The statistics.                                                                    |
+		// |  <IN>  -> pBuf	     - Pointer to the image data buffer. Must not be nullptr.                             |
+		// |  <IN>  -> uiCol1	 - The start column.                                                                  |
+		// |  <IN>  -> uiColEnd	 - One past the end column.                                                           |
+		// |  <IN>  -> uiRow1	 - The start row.                                                                     |
+		// |  <IN>  -> uiRowEnd	 - One past the end row.                                                              |
+		// |  <IN>  -> uiCols	 - The image column size ( in pixels ).                                               |
+		// |  <IN>  -> uiThreads - The number of threads. Zero uses one per hardware thread.                          |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::copy( T* pDstBuf, const T* pSrcBuf, const std::uint32_t uiSize )
+		template <typename T>
+		void CArcImage<T>::calcStats( arc::gen3::image::CStats& cStats, const T* pBuf, const std::uint32_t uiCol1, const std::uint32_t uiColEnd,
+									  const std::uint32_t uiRow1, const std::uint32_t uiRowEnd, const std::uint32_t uiCols, const std::uint32_t uiThreads )
 		{
-			verifyBuffer( pDstBuf );
-	
-			verifyBuffer( pSrcBuf );
+			const auto uiSatVal = static_cast< T >( maxTVal() - 1 );
 
-			copyMemory( pDstBuf, const_cast< T* >( pSrcBuf ), uiSize );
+			const std::uint32_t uiWidth = ( uiColEnd - uiCol1 );
+
+			std::vector<StatsAccum_t> vBlocks( threadCount( uiThreads ) );
+
+			auto uiBlocks = forEachRowBlock( uiRow1, uiRowEnd, uiThreads, [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				for ( std::uint32_t uiRow = uiFirst; uiRow < uiLast; uiRow++ )
+				{
+					accumulateRow( pBuf + ( static_cast< std::uint64_t >( uiRow ) * uiCols + uiCol1 ), uiWidth, uiSatVal, vBlocks[ uiBlock ] );
+				}
+			} );
+
+			StatsAccum_t cTotal;
+
+			for ( std::uint32_t b = 0; b < uiBlocks; b++ )
+			{
+				cTotal.merge( vBlocks[ b ] );
+			}
+
+			toStats( cTotal, maxTVal(), cStats );
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  maxTVal                                                                                                 |
+		// |  verifyDimensions                                                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Determines the maximum value for the data type currently in use.                                        |
+		// |  Verifies that neither image dimension is zero. Throws exception on error.                               |
 		// |                                                                                                          |
-		// |  Example, for std::uint16_t: 2^16 = 65536.                                                               |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> std::uint32_t CArcImage<T>::maxTVal()
+		template <typename T>
+		void CArcImage<T>::verifyDimensions( const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			auto gExponent = ( ( sizeof( T ) == sizeof( arc::gen3::image::BPP_32 ) ) ? 20 : ( sizeof( T ) * 8 ) );
-
-			return static_cast< std::uint32_t >( std::pow( 2.0, gExponent ) );
+			if ( uiCols == 0 || uiRows == 0 )
+			{
+				throwArcGen3InvalidArgument( "Invalid image dimensions [ %u x %u ].", uiCols, uiRows );
+			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  drawSemiCircle                                                                                          |
+		// |  verifyRegions                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Draws a semi-circle on the specified buffer.                                                            |
-		// |                                                                                                          |
-		// |  <IN> -> uiXCenter		- uiX position of circle center point.                                            |
-		// |  <IN> -> uiYCenter		- uiY position of circle center point.                                            |
-		// |  <IN> -> uiRadius		- The radius of the circle.                                                       |
-		// |  <IN> -> gStartAngle	- The start angle of the semi-circle.                                             |
-		// |  <IN> -> gEndAngle		- The end angle of the semi-circle.                                               |
-		// |  <IN> -> uiCols		- The image column size ( in pixels ).                                            |
-		// |  <IN> -> pBuf			- Pointer to the image data buffer.                                               |
-		// |  <IN> -> uiColor		- Color to draw circle ( default = 0 ).                                           |
+		// |  Verifies that a list of regions is not empty and that every region is non-empty and lies within the     |
+		// |  image. Throws exception on error.                                                                       |
 		// |                                                                                                          |
-		// |  Throws std::invalid_argument                                                                            |
+		// |  <IN> -> vRegions - The regions to check.                                                                |
+		// |  <IN> -> uiCols   - The image column size ( in pixels ).                                                 |
+		// |  <IN> -> uiRows   - The image row size ( in pixels ).                                                    |
 		// +----------------------------------------------------------------------------------------------------------+
-		template <typename T> void CArcImage<T>::drawSemiCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter,
-																 const std::uint32_t uiRadius, const double gStartAngle, const double gEndAngle,
-																 const std::uint32_t uiCols, T* pBuf, const T uiColor )
+		template <typename T>
+		void CArcImage<T>::verifyRegions( const std::vector<arc::gen3::image::Roi_t>& vRegions, const std::uint32_t uiCols, const std::uint32_t uiRows )
 		{
-			if ( pBuf != nullptr )
+			if ( vRegions.empty() )
+			{
+				throwArcGen3InvalidArgument( "Invalid region list, no regions specified."s );
+			}
+
+			for ( const auto& rRoi : vRegions )
 			{
-				for ( double angle = gStartAngle; angle < gEndAngle; angle += 0.1 )
+				if ( rRoi.uiCol1 >= rRoi.uiCol2 || rRoi.uiRow1 >= rRoi.uiRow2 )
 				{
-					std::uint32_t uiX = static_cast< std::uint32_t >( uiRadius * std::cos( angle * DEG2RAD ) + uiXCenter );
-					std::uint32_t uiY = static_cast< std::uint32_t >( uiRadius * std::sin( angle * DEG2RAD ) + uiYCenter );
+					throwArcGen3InvalidArgument( "Invalid region [ %u, %u ) x [ %u, %u ), the region is empty.",
+												 rRoi.uiCol1, rRoi.uiCol2, rRoi.uiRow1, rRoi.uiRow2 );
+				}
 
-					pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
+				if ( rRoi.uiCol2 > uiCols )
+				{
+					throwArcGen3OutOfRange( rRoi.uiCol2, std::make_pair( static_cast< std::uint32_t >( 1 ), uiCols ) );
 				}
-			}
 
-			else
-			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				if ( rRoi.uiRow2 > uiRows )
+				{
+					throwArcGen3OutOfRange( rRoi.uiRow2, std::make_pair( static_cast< std::uint32_t >( 1 ), uiRows ) );
+				}
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  drawFillCircle                                                                                          |
+		// |  verifyMask                                                                                              |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Draws a filled circle on the specified buffer.                                                          |
+		// |  Verifies an image buffer and that a mask matches the image size. Throws exception on error.             |
 		// |                                                                                                          |
-		// |  <IN> -> uiXCenter	- uiX position of circle center point.                                                |
-		// |  <IN> -> uiYCenter	- uiY position of circle center point.                                                |
-		// |  <IN> -> uiRadius	- The radius of the circle.                                                           |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |  <IN> -> uiColor	- Color to draw circle ( default = 0 ).                                               |
-		// |                                                                                                          |
-		// |  Throws std::invalid_argument                                                                            |
+		// |  <IN> -> pBuf   - Pointer to the image buffer.                                                           |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |  <IN> -> cMask  - The mask.                                                                              |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcImage<T>::drawFillCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter, const std::uint32_t uiRadius, const std::uint32_t uiCols, T* pBuf, const T uiColor )
+		void CArcImage<T>::verifyMask( const T* pBuf, const std::uint32_t uiCols, const std::uint32_t uiRows, const arc::gen3::image::CBitMask& cMask )
 		{
-			if ( pBuf != nullptr )
+			if ( pBuf == nullptr )
 			{
-				for ( std::remove_const_t<decltype( uiRadius )> r = 0; r < uiRadius; r++ )
-				{
-					for ( double angle = 0; angle < 360; angle += 0.1 )
-					{
-						std::uint32_t uiX = static_cast< std::uint32_t >( r * std::cos( angle * DEG2RAD ) + uiXCenter );
-						std::uint32_t uiY = static_cast< std::uint32_t >( r * std::sin( angle * DEG2RAD ) + uiYCenter );
-
-						pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
-					}
-				}
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
 			}
 
-			else
+			verifyDimensions( uiCols, uiRows );
+
+			if ( cMask.cols() != uiCols || cMask.rows() != uiRows )
 			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+				throwArcGen3InvalidArgument( "Mask size [ %u x %u ] does not match image [ %u x %u ].", cMask.cols(), cMask.rows(), uiCols, uiRows );
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  drawGradientFillCircle                                                                                  |
+		// |  verifyBinning                                                                                           |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Draws a gradient filled circle on the specified buffer.                                                 |
-		// |                                                                                                          |
-		// |  <IN> -> uiRadius	- The radius of the circle.                                                           |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> uiRows	- The image row size ( in pixels ).                                                   |
-		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
+		// |  Verifies the source view, block size and output buffer of a binning kernel. Throws exception on error.  |
 		// |                                                                                                          |
-		// |  Throws std::invalid_argument                                                                            |
+		// |  <IN> -> tSrc     - The source view.                                                                     |
+		// |  <IN> -> uiFactor - The block size.                                                                      |
+		// |  <IN> -> pDstBuf  - Pointer to the output buffer.                                                        |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcImage<T>::drawGradientFillCircle( const std::uint32_t uiRadius, const std::uint32_t uiCols, const std::uint32_t uiRows, T* pBuf )
+		void CArcImage<T>::verifyBinning( const arc::gen3::image::ImageView<const T>& tSrc, const std::uint32_t uiFactor, const void* pDstBuf )
 		{
-			if ( pBuf == nullptr )
+			if ( tSrc.data() == nullptr || pDstBuf == nullptr )
 			{
 				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
 			}
 
-			for ( std::remove_const_t<decltype( uiRadius )> r = 0; r < uiRadius; r++ )
+			if ( uiFactor < 1 || uiFactor > 256 )
 			{
-				drawCircle( ( uiCols / 2 ),
-							( uiRows / 2 ),
-							( uiRadius - r ),
-							uiCols,
-							pBuf,
-							static_cast< std::uint32_t >( r + ( ( maxTVal() - 1 ) / uiRadius ) ) );
+				throwArcGen3OutOfRange( uiFactor, std::make_pair( static_cast< std::uint32_t >( 1 ), static_cast< std::uint32_t >( 256 ) ) );
+			}
+
+			if ( tSrc.rows() > 1 && tSrc.stride() < tSrc.cols() )
+			{
+				throwArcGen3InvalidArgument( "Invalid view [ %u x %u ] with row stride %u.", tSrc.cols(), tSrc.rows(), tSrc.stride() );
+			}
+
+			if ( tSrc.cols() < uiFactor || tSrc.rows() < uiFactor )
+			{
+				throwArcGen3InvalidArgument( "Image view [ %u x %u ] is smaller than the block size %u.", tSrc.cols(), tSrc.rows(), uiFactor );
 			}
 		}
 
 
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  drawCircle                                                                                              |
+		// |  threadCount                                                                                             |
 		// +----------------------------------------------------------------------------------------------------------+
-		// |  Draws a circle on the specified buffer.                                                                 |
+		// |  Returns the number of threads to use for a requested thread count. Zero requests one thread per         |
+		// |  executor thread, CArcThreadPool::executor().concurrency(), which for the shared pool is one per CPU.    |
 		// |                                                                                                          |
-		// |  <IN> -> uiXCenter	- uiX position of circle center point.                                                |
-		// |  <IN> -> uiYCenter	- uiY position of circle center point.                                                |
-		// |  <IN> -> uiRadius	- The radius of the circle.                                                           |
-		// |  <IN> -> uiCols	- The image column size ( in pixels ).                                                |
-		// |  <IN> -> pBuf		- Pointer to the image data buffer.                                                   |
-		// |  <IN> -> uiColor	- Color to draw circle ( default = 0 ).                                               |
+		// |  <IN> -> uiThreads - The requested number of threads.                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcImage<T>::threadCount( const std::uint32_t uiThreads )
+		{
+			return ( uiThreads == 0 ? std::max( 1U, CArcThreadPool::executor().concurrency() ) : uiThreads );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  forEachRowBlock                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Splits the row range [ uiRow1, uiRow2 ) into at most threadCount( uiThreads ) contiguous blocks and     |
+		// |  runs fnBlock( uiBlock, uiFirst, uiLast ) for each block as a task on the library executor, so no thread |
+		// |  is created per call. The calling thread processes the first block. Returns the number of blocks.        |
 		// |                                                                                                          |
-		// |  Throws std::invalid_argument                                                                            |
+		// |  <IN> -> uiRow1    - The start row.                                                                      |
+		// |  <IN> -> uiRow2    - One past the end row.                                                               |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |  <IN> -> fnBlock   - The block function.                                                                 |
+		// |                                                                                                          |
+		// |  Throws the first exception thrown by a block                                                            |
 		// +----------------------------------------------------------------------------------------------------------+
 		template <typename T>
-		void CArcImage<T>::drawCircle( const std::uint32_t uiXCenter, const std::uint32_t uiYCenter, const std::uint32_t uiRadius, const std::uint32_t uiCols, T* pBuf, const T uiColor )
+		std::uint32_t CArcImage<T>::forEachRowBlock( const std::uint32_t uiRow1, const std::uint32_t uiRow2, const std::uint32_t uiThreads,
+													 const std::function<void( std::uint32_t, std::uint32_t, std::uint32_t )>& fnBlock )
 		{
-			if ( pBuf != nullptr )
+			const std::uint32_t uiBlocks = threadCount( uiThreads );
+
+			if ( uiBlocks == 1 )
 			{
-				for ( double angle = 0; angle < 360; angle += 0.1 )
-				{
-					std::uint32_t uiX = static_cast< std::uint32_t >( uiRadius * std::cos( angle * DEG2RAD ) + uiXCenter );
-					std::uint32_t uiY = static_cast< std::uint32_t >( uiRadius * std::sin( angle * DEG2RAD ) + uiYCenter );
+				fnBlock( 0, uiRow1, uiRow2 );
 
-					pBuf[ uiX + uiY * uiCols ] = static_cast< T >( uiColor );
-				}
+				return 1;
 			}
 
-			else
-			{
-				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
-			}
+			return CArcThreadPool::executor().parallelForBlocks( uiRow1, uiRow2, uiBlocks, fnBlock );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  maxTVal                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Determines the maximum value for the data type currently in use.                                        |
+		// |                                                                                                          |
+		// |  Example, for std::uint16_t: 2^16 = 65536.                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> std::uint32_t CArcImage<T>::maxTVal()
+		{
+			auto gExponent = ( ( sizeof( T ) == sizeof( arc::gen3::image::BPP_32 ) ) ? 20 : ( sizeof( T ) * 8 ) );
+
+			return static_cast< std::uint32_t >( std::pow( 2.0, gExponent ) );
 		}
 
 
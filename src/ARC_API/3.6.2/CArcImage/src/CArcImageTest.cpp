@@ -0,0 +1,3650 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcImageTest.cpp  ( Gen3 )                                                                              |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC image processing verification interface.                                  |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include <cmath>
+#include <map>
+#include <numbers>
+#include <tuple>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <stdexcept>
+
+#include <CArcImageTest.h>
+#include <CArcHistogram.h>
+#include <CArcPtc.h>
+#include <CArcStack.h>
+#include <CArcCombine.h>
+#include <CArcCalibrate.h>
+#include <CArcDisplayScale.h>
+#include <CArcCentroid.h>
+#include <CArcFrameVerifier.h>
+#include <CArcThreadPool.h>
+#include <CArcRampFit.h>
+
+
+using namespace std::string_literals;
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Local helpers                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		namespace
+		{
+			// Returns a pseudo random test pixel. About one pixel in nine is clamped to the data type maximum, so
+			// saturated pixels are counted, and 32-bit values run past the last CArcImage::histogram() bin. About
+			// one pixel in thirty is at or just below the saturation threshold.
+			template <typename T>
+			T testValue( const std::uint64_t uiIndex, const std::uint64_t uiSeed )
+			{
+				const std::uint64_t uiRange = ( static_cast< std::uint64_t >( CArcImage<T>::maxTVal() ) * 9 / 8 );
+
+				std::uint64_t uiHash = ( ( uiIndex + 1 ) ^ ( uiSeed * 0xD1B54A32D192ED03ULL ) ) * 0x9E3779B97F4A7C15ULL;
+
+				uiHash ^= ( uiHash >> 29 );
+
+				if ( ( uiHash % 31 ) == 0 )
+				{
+					return static_cast< T >( CArcImage<T>::maxTVal() - 1 - ( ( uiHash >> 8 ) % 2 ) );
+				}
+
+				return static_cast< T >( std::min<std::uint64_t>( ( uiHash % uiRange ), std::numeric_limits<T>::max() ) );
+			}
+
+			// Fills an image with test pixels.
+			template <typename T>
+			std::vector<T> testImage( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint64_t uiSeed )
+			{
+				std::vector<T> vBuf( static_cast< std::size_t >( uiCols ) * uiRows );
+
+				for ( std::size_t i = 0; i < vBuf.size(); i++ )
+				{
+					vBuf[ i ] = testValue<T>( i, uiSeed );
+				}
+
+				return vBuf;
+			}
+
+			// Returns frame uiFrame of a stack test. Every third pixel is a flat level just below saturation with a
+			// few counts of noise, where a plain sum of squares loses the variance to cancellation.
+			template <typename T>
+			std::vector<T> stackFrame( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint64_t uiFrame )
+			{
+				std::vector<T> vBuf = testImage<T>( uiCols, uiRows, ( 20 + uiFrame ) );
+
+				for ( std::size_t i = 0; i < vBuf.size(); i += 3 )
+				{
+					vBuf[ i ] = static_cast< T >( CArcImage<T>::maxTVal() - 1 - ( vBuf[ i ] % 5 ) );
+				}
+
+				return vBuf;
+			}
+
+			// Returns frame uiFrame of a combine test: a shared sky level with a few counts of per-frame noise, and
+			// about one pixel in nine hit by a saturated cosmic ray, so sigma clipping has outliers to reject.
+			template <typename T>
+			std::vector<T> combineFrame( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint64_t uiFrame )
+			{
+				std::vector<T> vBuf( static_cast< std::size_t >( uiCols ) * uiRows );
+
+				for ( std::size_t i = 0; i < vBuf.size(); i++ )
+				{
+					if ( ( testValue<T>( i, ( 60 + uiFrame ) ) % 9 ) == 0 )
+					{
+						vBuf[ i ] = static_cast< T >( CArcImage<T>::maxTVal() - 1 );
+					}
+
+					else
+					{
+						vBuf[ i ] = static_cast< T >( ( testValue<T>( i, 40 ) % ( CArcImage<T>::maxTVal() / 2 ) ) + ( testValue<T>( i, ( 41 + uiFrame ) ) % 64 ) );
+					}
+				}
+
+				return vBuf;
+			}
+
+			// Brute force combine of one pixel. The values are sorted in place, then clipped about their median
+			// until nothing is rejected, fewer than three values remain, or uiIterations is reached.
+			double bruteCombine( std::vector<double>& vValues, const arc::gen3::image::e_CombineMethod eMethod, const double gLow, const double gHigh, const std::uint32_t uiIterations )
+			{
+				std::sort( vValues.begin(), vValues.end() );
+
+				std::size_t uiLo = 0;
+				std::size_t uiHi = vValues.size();
+
+				const auto fnMedian = [ & ]()
+				{
+					return ( 0.5 * ( vValues[ uiLo + ( uiHi - uiLo - 1 ) / 2 ] + vValues[ uiLo + ( uiHi - uiLo ) / 2 ] ) );
+				};
+
+				if ( eMethod == arc::gen3::image::e_CombineMethod::MEDIAN )
+				{
+					return fnMedian();
+				}
+
+				for ( std::uint32_t uiIteration = 0; uiIteration < uiIterations && ( uiHi - uiLo ) >= 3; uiIteration++ )
+				{
+					const double gMedian = fnMedian();
+
+					double gMean = 0.0;
+
+					for ( std::size_t i = uiLo; i < uiHi; i++ )
+					{
+						gMean += vValues[ i ];
+					}
+
+					gMean /= static_cast< double >( uiHi - uiLo );
+
+					double gM2 = 0.0;
+
+					for ( std::size_t i = uiLo; i < uiHi; i++ )
+					{
+						gM2 += ( ( vValues[ i ] - gMean ) * ( vValues[ i ] - gMean ) );
+					}
+
+					const double gStdDev = std::sqrt( gM2 / static_cast< double >( uiHi - uiLo - 1 ) );
+
+					std::size_t uiNewLo = uiLo;
+					std::size_t uiNewHi = uiHi;
+
+					while ( uiNewLo < uiNewHi && vValues[ uiNewLo ] < ( gMedian - gLow * gStdDev ) )
+					{
+						uiNewLo++;
+					}
+
+					while ( uiNewHi > uiNewLo && vValues[ uiNewHi - 1 ] > ( gMedian + gHigh * gStdDev ) )
+					{
+						uiNewHi--;
+					}
+
+					if ( uiNewLo == uiLo && uiNewHi == uiHi )
+					{
+						break;
+					}
+
+					uiLo = uiNewLo;
+					uiHi = uiNewHi;
+				}
+
+				double gSum = 0.0;
+
+				for ( std::size_t i = uiLo; i < uiHi; i++ )
+				{
+					gSum += vValues[ i ];
+				}
+
+				return ( gSum / static_cast< double >( uiHi - uiLo ) );
+			}
+
+			// Returns a region inside an image that starts and ends away from the image edges where the image is
+			// large enough.
+			arc::gen3::image::Roi_t innerRoi( const std::uint32_t uiCols, const std::uint32_t uiRows ) noexcept
+			{
+				return { ( uiCols / 4 ), ( uiCols - ( uiCols / 8 ) ), ( uiRows / 4 ), ( uiRows - ( uiRows / 8 ) ) };
+			}
+
+			// Returns true if two values agree to a relative error of gTolerance, or an absolute error of
+			// gTolerance for values smaller than one.
+			bool isClose( const double gFound, const double gExpected, const double gTolerance ) noexcept
+			{
+				return ( std::fabs( gFound - gExpected ) <= ( gTolerance * std::max( 1.0, std::fabs( gExpected ) ) ) );
+			}
+
+			// Brute force population statistics of the region pixels for which fnUse( col, row ) is true, in two
+			// passes.
+			template <typename T, typename F>
+			arc::gen3::image::CStats bruteStats( const T* pBuf, const std::uint32_t uiCols, const arc::gen3::image::Roi_t& tRoi, const F& fnUse )
+			{
+				arc::gen3::image::CStats cStats;
+
+				const double gSatVal = static_cast< double >( CArcImage<T>::maxTVal() - 1 );
+
+				double gSum = 0.0;
+
+				cStats.gMin = std::numeric_limits<double>::max();
+
+				for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+				{
+					for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+					{
+						if ( fnUse( c, r ) )
+						{
+							const double gVal = static_cast< double >( pBuf[ static_cast< std::size_t >( r ) * uiCols + c ] );
+
+							cStats.gMin = std::min( cStats.gMin, gVal );
+							cStats.gMax = std::max( cStats.gMax, gVal );
+							cStats.gSaturatedCount += ( gVal >= gSatVal ? 1.0 : 0.0 );
+							cStats.gTotalPixels += 1.0;
+
+							gSum += gVal;
+						}
+					}
+				}
+
+				if ( cStats.gTotalPixels == 0.0 )
+				{
+					cStats.gMin = static_cast< double >( CArcImage<T>::maxTVal() );
+				}
+
+				else
+				{
+					cStats.gMean = ( gSum / cStats.gTotalPixels );
+
+					for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+					{
+						for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+						{
+							if ( fnUse( c, r ) )
+							{
+								const double gDev = ( static_cast< double >( pBuf[ static_cast< std::size_t >( r ) * uiCols + c ] ) - cStats.gMean );
+
+								cStats.gVariance += ( gDev * gDev );
+							}
+						}
+					}
+
+					cStats.gVariance /= cStats.gTotalPixels;
+					cStats.gStdDev = std::sqrt( cStats.gVariance );
+				}
+
+				return cStats;
+			}
+
+			// Brute force statistics of every pixel of a region.
+			template <typename T>
+			arc::gen3::image::CStats bruteStats( const T* pBuf, const std::uint32_t uiCols, const arc::gen3::image::Roi_t& tRoi )
+			{
+				return bruteStats( pBuf, uiCols, tRoi, []( std::uint32_t, std::uint32_t ) { return true; } );
+			}
+
+			// Compares two histograms bin by bin.
+			void compareBins( const std::uint32_t* pFound, const std::vector<std::uint64_t>& vExpected, const std::string& sWhat,
+							  const std::uint32_t uiCols, const std::uint32_t uiRows )
+			{
+				for ( std::size_t i = 0; i < vExpected.size(); i++ )
+				{
+					if ( pFound[ i ] != vExpected[ i ] )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] mismatch at bin %u! Expected: %J Found: %u", sWhat.c_str(), uiCols, uiRows,
+										   static_cast< std::uint32_t >( i ), static_cast< unsigned long long >( vExpected[ i ] ), pFound[ i ] );
+					}
+				}
+			}
+
+			// Compares the pixels of a kernel output with fnExpected( i ). Integer outputs must match exactly,
+			// floating point outputs to a relative error of 1e-6.
+			template <typename U, typename F>
+			void comparePixels( const std::vector<U>& vFound, const F& fnExpected, const std::string& sWhat, const std::uint32_t uiCols, const std::uint32_t uiRows )
+			{
+				for ( std::size_t i = 0; i < vFound.size(); i++ )
+				{
+					const U tExpected = static_cast< U >( fnExpected( i ) );
+
+					bool bMatch = ( vFound[ i ] == tExpected );
+
+					if constexpr ( std::is_floating_point_v<U> )
+					{
+						bMatch = isClose( vFound[ i ], tExpected, 1e-6 );
+					}
+
+					if ( !bMatch )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] mismatch at pixel %J! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+										   static_cast< unsigned long long >( i ), static_cast< double >( tExpected ), static_cast< double >( vFound[ i ] ) );
+					}
+				}
+			}
+
+			// Checks that a call throws.
+			template <typename F>
+			void expectThrow( const std::string& sWhat, const F& fnCall )
+			{
+				bool bThrown = false;
+
+				try
+				{
+					fnCall();
+				}
+				catch ( const std::exception& )
+				{
+					bThrown = true;
+				}
+
+				if ( !bThrown )
+				{
+					throwArcGen3Error( "%s did not throw!", sWhat.c_str() );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyStats                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the whole image statistics against brute force statistics.                                      |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 1 );
+
+			const arc::gen3::image::Roi_t tFull = { 0, uiCols, 0, uiRows };
+
+			auto pStats = CArcImage<T>::getStats( vBuf.data(), uiCols, uiRows, uiThreads );
+
+			compareStats( *pStats, bruteStats( vBuf.data(), uiCols, tFull ), "CArcImage::getStats()"s, uiCols, uiRows );
+
+			//
+			// A narrow spread of values just below the saturation threshold, where
+			// a sum of squares about zero would lose the variance
+			// ---------------------------------------------------------------------------
+			std::vector<T> vFlat( vBuf.size() );
+
+			for ( std::size_t i = 0; i < vFlat.size(); i++ )
+			{
+				vFlat[ i ] = static_cast< T >( CArcImage<T>::maxTVal() - 2 - ( i % 3 ) );
+			}
+
+			pStats = CArcImage<T>::getStats( vFlat.data(), uiCols, uiRows, uiThreads );
+
+			compareStats( *pStats, bruteStats( vFlat.data(), uiCols, tFull ), "CArcImage::getStats( flat )"s, uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyChannelStats                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the per-channel statistics and their running averages over three frames against brute force     |
+		// | statistics. The channels are the largest grid of up to 4 x 2 channels that divides the image, and a set  |
+		// | of overlapping channels: the whole image, the first column and the center pixel.                         |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyChannelStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::uint32_t uiColChannels = ( ( uiCols % 4 ) == 0 ? 4 : ( ( uiCols % 2 ) == 0 ? 2 : 1 ) );
+			const std::uint32_t uiRowChannels = ( ( uiRows % 2 ) == 0 ? 2 : 1 );
+
+			const std::vector<arc::gen3::image::Roi_t> vChannelSets[] =
+			{
+				CArcImage<T>::channelGrid( uiCols, uiRows, uiColChannels, uiRowChannels ),
+				{ { 0, uiCols, 0, uiRows }, { 0, 1, 0, uiRows }, { ( uiCols / 2 ), ( uiCols / 2 + 1 ), ( uiRows / 2 ), ( uiRows / 2 + 1 ) } }
+			};
+
+			for ( const auto& vChannels : vChannelSets )
+			{
+				const std::uint32_t uiChannels = static_cast< std::uint32_t >( vChannels.size() );
+
+				std::vector<arc::gen3::image::CStats> vStats( uiChannels );
+				std::vector<arc::gen3::image::CStats> vSum( uiChannels );
+
+				arc::gen3::image::CAvgStats cAvgStats( uiChannels );
+
+				const std::uint32_t uiFrames = 3;
+
+				for ( std::uint32_t f = 0; f < uiFrames; f++ )
+				{
+					const std::vector<T> vFrame = testImage<T>( uiCols, uiRows, ( f + 1 ) );
+
+					CArcImage<T>::getChannelStats( vFrame.data(), uiCols, uiRows, vChannels, vStats.data(), uiThreads );
+
+					CArcImage<T>::accumulateChannelStats( vFrame.data(), uiCols, uiRows, vChannels, cAvgStats, uiThreads );
+
+					for ( std::uint32_t c = 0; c < uiChannels; c++ )
+					{
+						const arc::gen3::image::CStats cExpected = bruteStats( vFrame.data(), uiCols, vChannels[ c ] );
+
+						compareStats( vStats[ c ], cExpected, CArcBase::formatString( "CArcImage::getChannelStats() channel %u", c ), uiCols, uiRows );
+
+						vSum[ c ].gMin += cExpected.gMin;
+						vSum[ c ].gMax += cExpected.gMax;
+						vSum[ c ].gMean += cExpected.gMean;
+						vSum[ c ].gStdDev += cExpected.gStdDev;
+					}
+				}
+
+				if ( cAvgStats.uiImageCount != uiFrames )
+				{
+					throwArcGen3Error( "CArcImage::accumulateChannelStats() [ %u x %u ] image count mismatch! Expected: %u Found: %u",
+									   uiCols, uiRows, uiFrames, cAvgStats.uiImageCount );
+				}
+
+				double gMeanSum = 0.0, gMeanSqrSum = 0.0, gStdDevSum = 0.0;
+
+				for ( std::uint32_t c = 0; c < uiChannels; c++ )
+				{
+					const double gMin = ( vSum[ c ].gMin / uiFrames );
+					const double gMax = ( vSum[ c ].gMax / uiFrames );
+					const double gMean = ( vSum[ c ].gMean / uiFrames );
+					const double gStdDev = ( vSum[ c ].gStdDev / uiFrames );
+
+					if ( !isClose( cAvgStats.pAverageMin[ c ], gMin, 1e-9 ) || !isClose( cAvgStats.pAverageMax[ c ], gMax, 1e-9 ) ||
+						 !isClose( cAvgStats.pAverageMean[ c ], gMean, 1e-9 ) || !isClose( cAvgStats.pAverageStdDev[ c ], gStdDev, 1e-9 ) )
+					{
+						throwArcGen3Error( "CArcImage::accumulateChannelStats() [ %u x %u ] channel %u average mismatch! Expected mean: %f Found: %f",
+										   uiCols, uiRows, c, gMean, cAvgStats.pAverageMean[ c ] );
+					}
+
+					gMeanSum += gMean;
+					gMeanSqrSum += ( gMean * gMean );
+					gStdDevSum += gStdDev;
+				}
+
+				const double gMeanOfMeans = ( gMeanSum / uiChannels );
+				const double gStdDevOfMeans = std::sqrt( std::max( 0.0, ( gMeanSqrSum / uiChannels ) - ( gMeanOfMeans * gMeanOfMeans ) ) );
+
+				if ( !isClose( cAvgStats.gMeanOfMeans, gMeanOfMeans, 1e-9 ) || !isClose( cAvgStats.gStdDevOfMeans, gStdDevOfMeans, 1e-6 ) ||
+					 !isClose( cAvgStats.gAvgAvgStdDev, ( gStdDevSum / uiChannels ), 1e-9 ) )
+				{
+					throwArcGen3Error( "CArcImage::accumulateChannelStats() [ %u x %u ] channel summary mismatch! Expected mean of means: %f Found: %f",
+									   uiCols, uiRows, gMeanOfMeans, cAvgStats.gMeanOfMeans );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyHistogram                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcImage::histogram() and the exact and binned CArcHistogram modes against brute force counts, |
+		// | and the exact percentiles against the sorted pixel values.                                               |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyHistogram( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 2 );
+
+			const arc::gen3::image::Roi_t tRoi = innerRoi( uiCols, uiRows );
+
+			const std::uint32_t uiBins = CArcImage<T>::maxTVal();
+
+			//
+			// CArcImage::histogram() counts values above the last bin in the last bin
+			// ---------------------------------------------------------------------------
+			std::vector<std::uint64_t> vExpected( uiBins, 0 );
+
+			std::map<T, std::uint64_t> mExact;
+
+			for ( const T uiVal : vBuf )
+			{
+				vExpected[ std::min<std::uint64_t>( uiVal, ( uiBins - 1 ) ) ]++;
+
+				mExact[ uiVal ]++;
+			}
+
+			std::uint32_t uiCount = 0;
+
+			auto pHist = CArcImage<T>::histogram( vBuf.data(), uiCols, uiRows, uiCount );
+
+			if ( uiCount != uiBins )
+			{
+				throwArcGen3Error( "CArcImage::histogram() [ %u x %u ] bin count mismatch! Expected: %u Found: %u", uiCols, uiRows, uiBins, uiCount );
+			}
+
+			compareBins( pHist.get(), vExpected, "CArcImage::histogram()"s, uiCols, uiRows );
+
+			//
+			// The default CArcHistogram counts every value exactly. The percentiles
+			// are the sorted values at the nearest rank.
+			// ---------------------------------------------------------------------------
+			CArcHistogram<T> cExact;
+
+			cExact.compute( vBuf.data(), uiCols, uiRows, uiThreads );
+
+			for ( const auto& tBin : mExact )
+			{
+				if ( cExact.count( tBin.first ) != tBin.second )
+				{
+					throwArcGen3Error( "CArcHistogram::compute() [ %u x %u ] mismatch at value %u! Expected: %J Found: %J", uiCols, uiRows,
+									   static_cast< std::uint32_t >( tBin.first ), static_cast< unsigned long long >( tBin.second ),
+									   static_cast< unsigned long long >( cExact.count( tBin.first ) ) );
+				}
+			}
+
+			if ( cExact.total() != vBuf.size() )
+			{
+				throwArcGen3Error( "CArcHistogram::compute() [ %u x %u ] total mismatch! Expected: %J Found: %J", uiCols, uiRows,
+								   static_cast< unsigned long long >( vBuf.size() ), static_cast< unsigned long long >( cExact.total() ) );
+			}
+
+			std::vector<T> vSorted( vBuf );
+
+			std::sort( vSorted.begin(), vSorted.end() );
+
+			for ( const double gPercent : { 0.0, 10.0, 50.0, 99.5, 100.0 } )
+			{
+				const auto uiRank = std::max<std::size_t>( 1, static_cast< std::size_t >( std::ceil( gPercent * vSorted.size() / 100.0 ) ) );
+
+				const double gExpected = static_cast< double >( vSorted[ uiRank - 1 ] );
+
+				if ( cExact.percentile( gPercent ) != gExpected )
+				{
+					throwArcGen3Error( "CArcHistogram::percentile() [ %u x %u ] mismatch at percentile %f! Expected: %f Found: %f", uiCols, uiRows, gPercent,
+									   gExpected, cExact.percentile( gPercent ) );
+				}
+			}
+
+			//
+			// Accumulating a region on top of the image counts its pixels twice
+			// ---------------------------------------------------------------------------
+			cExact.accumulate( vBuf.data(), uiCols, uiRows, tRoi, uiThreads );
+
+			std::map<T, std::uint64_t> mTwice( mExact );
+
+			for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+			{
+				for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+				{
+					mTwice[ vBuf[ static_cast< std::size_t >( r ) * uiCols + c ] ]++;
+				}
+			}
+
+			for ( const auto& tBin : mTwice )
+			{
+				if ( cExact.count( tBin.first ) != tBin.second )
+				{
+					throwArcGen3Error( "CArcHistogram::accumulate() [ %u x %u ] mismatch at value %u! Expected: %J Found: %J", uiCols, uiRows,
+									   static_cast< std::uint32_t >( tBin.first ), static_cast< unsigned long long >( tBin.second ),
+									   static_cast< unsigned long long >( cExact.count( tBin.first ) ) );
+				}
+			}
+
+			//
+			// A binned CArcHistogram of a region; each value is counted in the last
+			// bin whose lowest value it reaches
+			// ---------------------------------------------------------------------------
+			const T uiMin = static_cast< T >( uiBins / 16 );
+			const T uiMax = static_cast< T >( uiBins / 2 );
+
+			CArcHistogram<T> cBinned( 100, uiMin, uiMax );
+
+			cBinned.compute( vBuf.data(), uiCols, uiRows, tRoi, uiThreads );
+
+			std::vector<T> vLow( 100 );
+
+			for ( std::uint32_t b = 0; b < 100; b++ )
+			{
+				vLow[ b ] = cBinned.binLow( b );
+			}
+
+			std::vector<std::uint64_t> vBinned( 100, 0 );
+
+			std::uint64_t uiUnder = 0, uiOver = 0;
+
+			for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+			{
+				for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+				{
+					const T uiVal = vBuf[ static_cast< std::size_t >( r ) * uiCols + c ];
+
+					if ( uiVal < uiMin )
+					{
+						uiUnder++;
+					}
+
+					else if ( uiVal > uiMax )
+					{
+						uiOver++;
+					}
+
+					else
+					{
+						vBinned[ static_cast< std::size_t >( std::upper_bound( vLow.begin(), vLow.end(), uiVal ) - vLow.begin() ) - 1 ]++;
+					}
+				}
+			}
+
+			for ( std::uint32_t b = 0; b < 100; b++ )
+			{
+				if ( cBinned.count( b ) != vBinned[ b ] )
+				{
+					throwArcGen3Error( "CArcHistogram::compute( binned ) [ %u x %u ] mismatch at bin %u! Expected: %J Found: %J", uiCols, uiRows, b,
+									   static_cast< unsigned long long >( vBinned[ b ] ), static_cast< unsigned long long >( cBinned.count( b ) ) );
+				}
+			}
+
+			if ( cBinned.underflow() != uiUnder || cBinned.overflow() != uiOver )
+			{
+				throwArcGen3Error( "CArcHistogram::compute( binned ) [ %u x %u ] range mismatch! Expected: %J below, %J above Found: %J below, %J above",
+								   uiCols, uiRows, static_cast< unsigned long long >( uiUnder ), static_cast< unsigned long long >( uiOver ),
+								   static_cast< unsigned long long >( cBinned.underflow() ), static_cast< unsigned long long >( cBinned.overflow() ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyPtc                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcImage::getDiffStats() and the CArcPtc table. A 64 x 32 pair of checkerboard flats near      |
+		// | saturation, with a known mean and variance in each of a 2 x 2 grid of regions, is checked against the    |
+		// | exact values. A pseudo random pair of the given size is checked against brute force statistics over the  |
+		// | whole image, a region and a single pixel.                                                                |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyPtc( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			//
+			// Frame 1 is L1 + a and frame 2 is L2 - a on the white squares, and the
+			// signs swap on the black squares. Each region holds as many white as
+			// black squares, so the frame variances are a^2 and the difference is
+			// L1 - L2 +/- 2a, with a variance of 4a^2.
+			// ---------------------------------------------------------------------------
+			{
+				const std::uint32_t uiKnownCols = 64;
+				const std::uint32_t uiKnownRows = 32;
+
+				const double gLevel1 = static_cast< double >( CArcImage<T>::maxTVal() - 10 );
+				const double gLevel2 = static_cast< double >( CArcImage<T>::maxTVal() - 14 );
+				const double gAmp = 3.0;
+				const double gBias = 100.0;
+
+				std::vector<T> vFlat1( uiKnownCols * uiKnownRows );
+				std::vector<T> vFlat2( vFlat1.size() );
+
+				for ( std::uint32_t r = 0; r < uiKnownRows; r++ )
+				{
+					for ( std::uint32_t c = 0; c < uiKnownCols; c++ )
+					{
+						const double gSign = ( ( ( c + r ) % 2 ) == 0 ? 1.0 : -1.0 );
+
+						vFlat1[ r * uiKnownCols + c ] = static_cast< T >( gLevel1 + gSign * gAmp );
+						vFlat2[ r * uiKnownCols + c ] = static_cast< T >( gLevel2 - gSign * gAmp );
+					}
+				}
+
+				CArcPtc<T> cPtc( uiKnownCols, uiKnownRows );
+
+				cPtc.setGrid( 2, 2 );
+
+				cPtc.setBias( gBias );
+
+				cPtc.setThreads( uiThreads );
+
+				cPtc.addPair( vFlat1.data(), vFlat2.data(), 1.5 );
+
+				if ( cPtc.table().size() != 4 )
+				{
+					throwArcGen3Error( "CArcPtc::addPair() point count mismatch! Expected: 4 Found: %u", static_cast< std::uint32_t >( cPtc.table().size() ) );
+				}
+
+				for ( const auto& tPoint : cPtc.table() )
+				{
+					if ( tPoint.uiPair != 0 || tPoint.gExposure != 1.5 || tPoint.gPixels != 512.0 || tPoint.gSaturated != 0.0 ||
+						 !isClose( tPoint.gMean1, gLevel1, 1e-12 ) || !isClose( tPoint.gMean2, gLevel2, 1e-12 ) ||
+						 !isClose( tPoint.gSignal, ( 0.5 * ( gLevel1 + gLevel2 ) - gBias ), 1e-12 ) ||
+						 !isClose( tPoint.gDiffMean, ( gLevel1 - gLevel2 ), 1e-12 ) || !isClose( tPoint.gVariance, ( 2.0 * gAmp * gAmp ), 1e-9 ) )
+					{
+						throwArcGen3Error( "CArcPtc::addPair() region %u mismatch! Expected signal: %f variance: %f Found signal: %f variance: %f", tPoint.uiRoi,
+										   ( 0.5 * ( gLevel1 + gLevel2 ) - gBias ), ( 2.0 * gAmp * gAmp ), tPoint.gSignal, tPoint.gVariance );
+					}
+				}
+			}
+
+			//
+			// A pseudo random pair against brute force statistics
+			// ---------------------------------------------------------------------------
+			const std::vector<T> vBuf1 = testImage<T>( uiCols, uiRows, 8 );
+			const std::vector<T> vBuf2 = testImage<T>( uiCols, uiRows, 9 );
+
+			const std::vector<arc::gen3::image::Roi_t> vRois = { { 0, uiCols, 0, uiRows }, innerRoi( uiCols, uiRows ),
+																 { ( uiCols / 2 ), ( uiCols / 2 + 1 ), ( uiRows / 2 ), ( uiRows / 2 + 1 ) } };
+
+			std::vector<arc::gen3::image::CDifStats> vStats( vRois.size() );
+
+			CArcImage<T>::getDiffStats( vBuf1.data(), vBuf2.data(), uiCols, uiRows, vRois, vStats.data(), uiThreads );
+
+			auto pWhole = CArcImage<T>::getDiffStats( vBuf1.data(), vBuf2.data(), uiCols, uiRows, uiThreads );
+
+			const double gBias = 10.0;
+
+			CArcPtc<T> cPtc( uiCols, uiRows );
+
+			cPtc.setRois( vRois );
+
+			cPtc.setBias( gBias );
+
+			cPtc.setThreads( uiThreads );
+
+			cPtc.addPairs( { vBuf1.data(), vBuf2.data(), vBuf2.data(), vBuf1.data() }, { 1.0, 2.0 } );
+
+			for ( std::size_t i = 0; i < vRois.size(); i++ )
+			{
+				const arc::gen3::image::Roi_t& tRoi = vRois[ i ];
+
+				const arc::gen3::image::CStats cExpected1 = bruteStats( vBuf1.data(), uiCols, tRoi );
+				const arc::gen3::image::CStats cExpected2 = bruteStats( vBuf2.data(), uiCols, tRoi );
+
+				double gDiffSum = 0.0, gDiffSqrSum = 0.0;
+
+				for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+				{
+					for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+					{
+						const std::size_t uiPixel = ( static_cast< std::size_t >( r ) * uiCols + c );
+
+						gDiffSum += ( static_cast< double >( vBuf1[ uiPixel ] ) - static_cast< double >( vBuf2[ uiPixel ] ) );
+					}
+				}
+
+				const double gDiffMean = ( gDiffSum / cExpected1.gTotalPixels );
+
+				for ( std::uint32_t r = tRoi.uiRow1; r < tRoi.uiRow2; r++ )
+				{
+					for ( std::uint32_t c = tRoi.uiCol1; c < tRoi.uiCol2; c++ )
+					{
+						const std::size_t uiPixel = ( static_cast< std::size_t >( r ) * uiCols + c );
+
+						const double gDev = ( static_cast< double >( vBuf1[ uiPixel ] ) - static_cast< double >( vBuf2[ uiPixel ] ) - gDiffMean );
+
+						gDiffSqrSum += ( gDev * gDev );
+					}
+				}
+
+				const double gDiffVariance = ( gDiffSqrSum / cExpected1.gTotalPixels );
+
+				const std::string sWhat = CArcBase::formatString( "CArcImage::getDiffStats() region %u", static_cast< std::uint32_t >( i ) );
+
+				const arc::gen3::image::CDifStats& cFound = ( i == 0 ? *pWhole : vStats[ i ] );
+
+				if ( i == 0 )
+				{
+					compareStats( vStats[ 0 ].cDiffStats, pWhole->cDiffStats, sWhat + " whole image overload", uiCols, uiRows );
+				}
+
+				compareStats( cFound.cStats1, cExpected1, sWhat + " image 1", uiCols, uiRows );
+				compareStats( cFound.cStats2, cExpected2, sWhat + " image 2", uiCols, uiRows );
+
+				if ( cFound.cDiffStats.gTotalPixels != cExpected1.gTotalPixels || !isClose( cFound.cDiffStats.gMean, std::fabs( gDiffMean ), 1e-9 ) ||
+					 !isClose( cFound.cDiffStats.gVariance, gDiffVariance, 1e-9 ) || !isClose( cFound.cDiffStats.gStdDev, std::sqrt( gDiffVariance ), 1e-9 ) )
+				{
+					throwArcGen3Error( "%s [ %u x %u ] difference mismatch! Expected mean: %f variance: %f Found mean: %f variance: %f", sWhat.c_str(),
+									   uiCols, uiRows, std::fabs( gDiffMean ), gDiffVariance, cFound.cDiffStats.gMean, cFound.cDiffStats.gVariance );
+				}
+
+				//
+				// Both pairs give the same point apart from the swapped frame means
+				// ---------------------------------------------------------------------
+				for ( std::uint32_t uiPair = 0; uiPair < 2; uiPair++ )
+				{
+					const arc::gen3::image::PtcPoint_t& tPoint = cPtc.table()[ uiPair * vRois.size() + i ];
+
+					const double gMean1 = ( uiPair == 0 ? cExpected1.gMean : cExpected2.gMean );
+					const double gMean2 = ( uiPair == 0 ? cExpected2.gMean : cExpected1.gMean );
+
+					if ( tPoint.uiPair != uiPair || tPoint.uiRoi != i || tPoint.gExposure != ( uiPair + 1.0 ) || tPoint.gPixels != cExpected1.gTotalPixels ||
+						 tPoint.gSaturated != ( cExpected1.gSaturatedCount + cExpected2.gSaturatedCount ) ||
+						 !isClose( tPoint.gMean1, gMean1, 1e-9 ) || !isClose( tPoint.gMean2, gMean2, 1e-9 ) ||
+						 !isClose( tPoint.gSignal, ( 0.5 * ( gMean1 + gMean2 ) - gBias ), 1e-9 ) ||
+						 !isClose( tPoint.gDiffMean, std::fabs( gDiffMean ), 1e-9 ) || !isClose( tPoint.gVariance, ( 0.5 * gDiffVariance ), 1e-9 ) )
+					{
+						throwArcGen3Error( "CArcPtc::addPairs() [ %u x %u ] pair %u region %u mismatch! Expected signal: %f variance: %f Found signal: %f variance: %f",
+										   uiCols, uiRows, uiPair, static_cast< std::uint32_t >( i ), ( 0.5 * ( gMean1 + gMean2 ) - gBias ), ( 0.5 * gDiffVariance ),
+										   tPoint.gSignal, tPoint.gVariance );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyArithmetic                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the caller buffer arithmetic kernels against 64-bit arithmetic. About a third of the pixels of  |
+		// | each operand are zero or at the top of the data type range, so sums, differences, products and offsets   |
+		// | saturate at zero and at the data type maximum ( maxTVal() - 1 for 16-bit data ), and wrap in WRAP mode.  |
+		// | add() is also run in place.                                                                              |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyArithmetic( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			using arc::gen3::image::e_ArithMode;
+
+			constexpr std::uint64_t uiMax = std::numeric_limits<T>::max();
+			constexpr std::uint64_t uiMask = uiMax;
+
+			std::vector<T> vA = testImage<T>( uiCols, uiRows, 10 );
+			std::vector<T> vB = testImage<T>( uiCols, uiRows, 11 );
+
+			for ( std::size_t i = 0; i < vA.size(); i++ )
+			{
+				vA[ i ] = ( ( i % 7 ) == 0 ? T( 0 ) : ( ( i % 7 ) == 1 ? static_cast< T >( uiMax ) : vA[ i ] ) );
+				vB[ i ] = ( ( i % 5 ) == 0 ? static_cast< T >( uiMax - ( i % 3 ) ) : ( ( i % 5 ) == 1 ? T( 0 ) : vB[ i ] ) );
+			}
+
+			const auto fnA = [ & ]( std::size_t i ) { return static_cast< std::uint64_t >( vA[ i ] ); };
+			const auto fnB = [ & ]( std::size_t i ) { return static_cast< std::uint64_t >( vB[ i ] ); };
+
+			std::vector<T> vDst( vA.size() );
+			std::vector<std::uint64_t> vWide( vA.size() );
+			std::vector<std::int64_t> vSigned( vA.size() );
+			std::vector<float> vReal( vA.size() );
+
+			//
+			// add
+			// ---------------------------------------------------------------------------
+			CArcImage<T>::add( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::SATURATE, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return std::min( fnA( i ) + fnB( i ), uiMax ); }, "CArcImage::add( SATURATE )"s, uiCols, uiRows );
+
+			CArcImage<T>::add( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::WRAP, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return ( ( fnA( i ) + fnB( i ) ) & uiMask ); }, "CArcImage::add( WRAP )"s, uiCols, uiRows );
+
+			CArcImage<T>::add( vWide.data(), vA.data(), vB.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vWide, [ & ]( std::size_t i ) { return ( fnA( i ) + fnB( i ) ); }, "CArcImage::add( 64-bit )"s, uiCols, uiRows );
+
+			vDst = vA;
+
+			CArcImage<T>::add( vDst.data(), vDst.data(), vB.data(), uiCols, uiRows, e_ArithMode::SATURATE, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return std::min( fnA( i ) + fnB( i ), uiMax ); }, "CArcImage::add( in place )"s, uiCols, uiRows );
+
+			//
+			// subtract
+			// ---------------------------------------------------------------------------
+			CArcImage<T>::subtract( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::SATURATE, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return ( fnA( i ) > fnB( i ) ? ( fnA( i ) - fnB( i ) ) : 0 ); }, "CArcImage::subtract( SATURATE )"s, uiCols, uiRows );
+
+			CArcImage<T>::subtract( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::WRAP, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return ( ( fnA( i ) - fnB( i ) ) & uiMask ); }, "CArcImage::subtract( WRAP )"s, uiCols, uiRows );
+
+			CArcImage<T>::subtract( vSigned.data(), vA.data(), vB.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vSigned, [ & ]( std::size_t i ) { return ( static_cast< std::int64_t >( fnA( i ) ) - static_cast< std::int64_t >( fnB( i ) ) ); },
+						   "CArcImage::subtract( 64-bit )"s, uiCols, uiRows );
+
+			//
+			// multiply; the products of 32-bit pixels fit in 64 bits
+			// ---------------------------------------------------------------------------
+			CArcImage<T>::multiply( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::SATURATE, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return std::min( fnA( i ) * fnB( i ), uiMax ); }, "CArcImage::multiply( SATURATE )"s, uiCols, uiRows );
+
+			CArcImage<T>::multiply( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, e_ArithMode::WRAP, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return ( ( fnA( i ) * fnB( i ) ) & uiMask ); }, "CArcImage::multiply( WRAP )"s, uiCols, uiRows );
+
+			CArcImage<T>::multiply( vWide.data(), vA.data(), vB.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vWide, [ & ]( std::size_t i ) { return ( fnA( i ) * fnB( i ) ); }, "CArcImage::multiply( 64-bit )"s, uiCols, uiRows );
+
+			//
+			// divide; zero divisors give zero
+			// ---------------------------------------------------------------------------
+			CArcImage<T>::divide( vDst.data(), vA.data(), vB.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vDst, [ & ]( std::size_t i ) { return ( fnB( i ) == 0 ? 0 : ( fnA( i ) / fnB( i ) ) ); }, "CArcImage::divide()"s, uiCols, uiRows );
+
+			CArcImage<T>::divide( vReal.data(), vA.data(), vB.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vReal, [ & ]( std::size_t i ) { return ( fnB( i ) == 0 ? 0.0 : ( static_cast< double >( fnA( i ) ) / static_cast< double >( fnB( i ) ) ) ); },
+						   "CArcImage::divide( float )"s, uiCols, uiRows );
+
+			//
+			// scale; results are rounded half up and clamped to the data type range
+			// ---------------------------------------------------------------------------
+			for ( const double gFactor : { 0.5, 1.7, 3.0, -1.0 } )
+			{
+				const std::string sFactor = CArcBase::formatString( " factor %f", gFactor );
+
+				CArcImage<T>::scale( vDst.data(), vA.data(), uiCols, uiRows, gFactor, uiThreads );
+
+				comparePixels( vDst, [ & ]( std::size_t i ) { return std::clamp( std::floor( static_cast< double >( fnA( i ) ) * gFactor + 0.5 ), 0.0, static_cast< double >( uiMax ) ); },
+							   "CArcImage::scale()"s + sFactor, uiCols, uiRows );
+
+				CArcImage<T>::scale( vReal.data(), vA.data(), uiCols, uiRows, gFactor, uiThreads );
+
+				comparePixels( vReal, [ & ]( std::size_t i ) { return ( static_cast< double >( fnA( i ) ) * gFactor ); }, "CArcImage::scale( float )"s + sFactor, uiCols, uiRows );
+			}
+
+			//
+			// offset; offsets beyond the data type range saturate every pixel
+			// ---------------------------------------------------------------------------
+			const std::int64_t iMax = static_cast< std::int64_t >( uiMax );
+
+			for ( const std::int64_t iOffset : { std::int64_t( 1000 ), std::int64_t( -1000 ), iMax, -iMax, ( iMax + 1 ), -( iMax + 1 ) } )
+			{
+				const std::string sOffset = CArcBase::formatString( " offset %f", static_cast< double >( iOffset ) );
+
+				CArcImage<T>::offset( vDst.data(), vA.data(), uiCols, uiRows, iOffset, e_ArithMode::SATURATE, uiThreads );
+
+				comparePixels( vDst, [ & ]( std::size_t i ) { return std::clamp<std::int64_t>( ( static_cast< std::int64_t >( fnA( i ) ) + iOffset ), 0, iMax ); },
+							   "CArcImage::offset( SATURATE )"s + sOffset, uiCols, uiRows );
+
+				CArcImage<T>::offset( vDst.data(), vA.data(), uiCols, uiRows, iOffset, e_ArithMode::WRAP, uiThreads );
+
+				comparePixels( vDst, [ & ]( std::size_t i ) { return ( ( fnA( i ) + static_cast< std::uint64_t >( iOffset ) ) & uiMask ); },
+							   "CArcImage::offset( WRAP )"s + sOffset, uiCols, uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyStack                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the CArcStack sum, mean and sample variance maps against two pass brute force after one, two    |
+		// | and five frames, and again after clear(). A stack without variance must give the same sums and refuse    |
+		// | variance().                                                                                              |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyStack( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			CArcStack<T> cStack( uiCols, uiRows );
+
+			CArcStack<T> cSumOnly( uiCols, uiRows, false );
+
+			std::vector<std::vector<T>> vFrames;
+
+			std::vector<T> vMean( uiPixels );
+			std::vector<float> vRealMean( uiPixels );
+			std::vector<float> vVariance( uiPixels );
+
+			const auto fnCheck = [ & ]( const std::string& sWhat )
+			{
+				const double gCount = static_cast< double >( vFrames.size() );
+
+				if ( cStack.count() != vFrames.size() )
+				{
+					throwArcGen3Error( "%s [ %u x %u ] count mismatch! Expected: %J Found: %u", sWhat.c_str(), uiCols, uiRows,
+									   static_cast< unsigned long long >( vFrames.size() ), cStack.count() );
+				}
+
+				const auto fnSum = [ & ]( std::size_t i )
+				{
+					std::uint64_t uiSum = 0;
+
+					for ( const auto& vFrame : vFrames )
+					{
+						uiSum += vFrame[ i ];
+					}
+
+					return uiSum;
+				};
+
+				const auto fnVariance = [ & ]( std::size_t i )
+				{
+					const double gMean = ( static_cast< double >( fnSum( i ) ) / gCount );
+
+					double gSumSq = 0.0;
+
+					for ( const auto& vFrame : vFrames )
+					{
+						gSumSq += ( ( vFrame[ i ] - gMean ) * ( vFrame[ i ] - gMean ) );
+					}
+
+					return ( vFrames.size() > 1 ? ( gSumSq / ( gCount - 1.0 ) ) : 0.0 );
+				};
+
+				cStack.mean( vMean.data(), uiThreads );
+				cStack.mean( vRealMean.data(), uiThreads );
+				cStack.variance( vVariance.data(), uiThreads );
+
+				comparePixels( std::vector<std::uint64_t>( cStack.sum(), cStack.sum() + uiPixels ), fnSum, sWhat + " sum", uiCols, uiRows );
+				comparePixels( std::vector<std::uint64_t>( cSumOnly.sum(), cSumOnly.sum() + uiPixels ), fnSum, sWhat + " sum without variance", uiCols, uiRows );
+				comparePixels( vMean, [ & ]( std::size_t i ) { return std::floor( static_cast< double >( fnSum( i ) ) / gCount + 0.5 ); }, sWhat + " mean", uiCols, uiRows );
+				comparePixels( vRealMean, [ & ]( std::size_t i ) { return ( static_cast< double >( fnSum( i ) ) / gCount ); }, sWhat + " float mean", uiCols, uiRows );
+
+				for ( std::size_t i = 0; i < uiPixels; i++ )
+				{
+					if ( !isClose( vVariance[ i ], fnVariance( i ), 1e-5 ) )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] variance mismatch at pixel %J! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+										   static_cast< unsigned long long >( i ), fnVariance( i ), static_cast< double >( vVariance[ i ] ) );
+					}
+				}
+			};
+
+			for ( std::uint64_t uiFrame = 0; uiFrame < 5; uiFrame++ )
+			{
+				vFrames.push_back( stackFrame<T>( uiCols, uiRows, uiFrame ) );
+
+				cStack.add( vFrames.back().data(), uiThreads );
+				cSumOnly.add( vFrames.back().data(), uiThreads );
+
+				if ( vFrames.size() != 3 && vFrames.size() != 4 )
+				{
+					fnCheck( CArcBase::formatString( "CArcStack [ %J frames ]", static_cast< unsigned long long >( vFrames.size() ) ) );
+				}
+			}
+
+			expectThrow( "CArcStack::variance() without variance"s, [ & ] { cSumOnly.variance( vVariance.data(), uiThreads ); } );
+
+			cStack.clear();
+			cSumOnly.clear();
+
+			vFrames.clear();
+
+			for ( std::uint64_t uiFrame = 7; uiFrame < 9; uiFrame++ )
+			{
+				vFrames.push_back( stackFrame<T>( uiCols, uiRows, uiFrame ) );
+
+				cStack.add( vFrames.back().data(), uiThreads );
+				cSumOnly.add( vFrames.back().data(), uiThreads );
+			}
+
+			fnCheck( "CArcStack after clear()"s );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyCombine                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcCombine median and sigma clipped combines against brute force for odd and even frame        |
+		// | counts on both sides of NETWORK_MAX, the latter on images of up to 4096 pixels. Frames are combined      |
+		// | from memory, and through a reader with a memory limit of three rows per tile, which must give the same   |
+		// | result.                                                                                                  |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyCombine( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			using arc::gen3::image::e_CombineMethod;
+
+			const std::uint32_t uiFrameCounts[] = { 1, 2, 3, 4, 7, CArcCombine<T>::NETWORK_MAX, ( CArcCombine<T>::NETWORK_MAX + 1 ), ( CArcCombine<T>::NETWORK_MAX + 2 ) };
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			const std::uint64_t uiTileRows = 3;
+
+			std::vector<std::vector<T>> vFrames;
+
+			for ( std::uint64_t uiFrame = 0; uiFrame < ( CArcCombine<T>::NETWORK_MAX + 2 ); uiFrame++ )
+			{
+				vFrames.push_back( combineFrame<T>( uiCols, uiRows, uiFrame ) );
+			}
+
+			std::vector<float> vFound( uiPixels );
+			std::vector<float> vTiled( uiPixels );
+
+			std::vector<double> vValues;
+
+			for ( const std::uint32_t uiFrames : uiFrameCounts )
+			{
+				// The largest frame counts only add coverage of the network and selection paths, which the
+				// smaller images already give, so they are skipped for large images to keep verifyAll() fast.
+				if ( uiFrames > 7 && uiPixels > 4096 )
+				{
+					continue;
+				}
+
+				std::vector<const T*> vPtrs;
+
+				for ( std::uint32_t f = 0; f < uiFrames; f++ )
+				{
+					vPtrs.push_back( vFrames[ f ].data() );
+				}
+
+				const std::uint64_t uiRowBytes = ( static_cast< std::uint64_t >( uiFrames ) * uiCols * sizeof( T ) );
+
+				const std::uint64_t uiScratch = ( CArcImage<T>::threadCount( uiThreads ) * ( ( uiFrames <= CArcCombine<T>::NETWORK_MAX ? uiRowBytes : 0 ) + uiFrames * sizeof( double ) ) );
+
+				const struct { e_CombineMethod eMethod; double gLow; double gHigh; std::uint32_t uiIterations; } tCases[] =
+				{
+					{ e_CombineMethod::MEDIAN, 3.0, 3.0, 5 },
+					{ e_CombineMethod::SIGMA_CLIP, 3.0, 3.0, 5 },
+					{ e_CombineMethod::SIGMA_CLIP, 1.0, 2.5, 1 }
+				};
+
+				for ( const auto& tCase : tCases )
+				{
+					const std::string sWhat = CArcBase::formatString( "CArcCombine [ %u frames, %s %f %f %u ]", uiFrames,
+																	  ( tCase.eMethod == e_CombineMethod::MEDIAN ? "median" : "sigma clip" ),
+																	  tCase.gLow, tCase.gHigh, tCase.uiIterations );
+
+					CArcCombine<T> cCombine( uiCols, uiRows );
+
+					cCombine.setMethod( tCase.eMethod );
+					cCombine.setSigmaClip( tCase.gLow, tCase.gHigh, tCase.uiIterations );
+					cCombine.setThreads( uiThreads );
+					cCombine.combine( vPtrs, vFound.data() );
+
+					comparePixels( vFound, [ & ]( std::size_t i )
+					{
+						vValues.clear();
+
+						for ( std::uint32_t f = 0; f < uiFrames; f++ )
+						{
+							vValues.push_back( vFrames[ f ][ i ] );
+						}
+
+						return bruteCombine( vValues, tCase.eMethod, tCase.gLow, tCase.gHigh, tCase.uiIterations );
+					}, sWhat, uiCols, uiRows );
+
+					//
+					// Combine again through a reader under a memory limit of three rows per tile
+					// ---------------------------------------------------------------------------
+					cCombine.setMemoryLimit( uiScratch + 2 * uiTileRows * uiRowBytes );
+
+					const std::uint32_t uiExpectedRows = ( uiRows <= ( 2 * uiTileRows ) ? uiRows : static_cast< std::uint32_t >( uiTileRows ) );
+
+					if ( cCombine.tileRows( uiFrames ) != uiExpectedRows )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] tile rows mismatch! Expected: %u Found: %u", sWhat.c_str(), uiCols, uiRows,
+										   uiExpectedRows, cCombine.tileRows( uiFrames ) );
+					}
+
+					std::vector<std::uint32_t> vRowsRead( uiRows );
+
+					std::fill( vTiled.begin(), vTiled.end(), -1.0f );
+
+					cCombine.combine( uiFrames, [ & ]( std::uint32_t uiFrame, std::uint32_t uiRow1, std::uint32_t uiRow2, T* pDst )
+					{
+						if ( uiFrame >= uiFrames || uiRow1 >= uiRow2 || uiRow2 > uiRows || ( uiRow2 - uiRow1 ) > uiExpectedRows )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] invalid read of frame %u rows %u - %u!", sWhat.c_str(), uiCols, uiRows, uiFrame, uiRow1, uiRow2 );
+						}
+
+						for ( std::uint32_t r = uiRow1; r < uiRow2; r++ )
+						{
+							vRowsRead[ r ]++;
+						}
+
+						std::copy_n( vFrames[ uiFrame ].data() + static_cast< std::size_t >( uiRow1 ) * uiCols, static_cast< std::size_t >( uiRow2 - uiRow1 ) * uiCols, pDst );
+					}, vTiled.data() );
+
+					if ( std::any_of( vRowsRead.begin(), vRowsRead.end(), [ & ]( std::uint32_t uiCount ) { return ( uiCount != uiFrames ); } ) )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] reader did not read every row of every frame once!", sWhat.c_str(), uiCols, uiRows );
+					}
+
+					comparePixels( vTiled, [ & ]( std::size_t i ) { return vFound[ i ]; }, sWhat + " tiled", uiCols, uiRows );
+				}
+			}
+
+			//
+			// A limit that does not hold two rows of every frame is refused, and reader exceptions reach the caller
+			// ------------------------------------------------------------------------------------------------------
+			CArcCombine<T> cCombine( uiCols, uiRows );
+
+			cCombine.setThreads( uiThreads );
+			cCombine.setMemoryLimit( 1 );
+
+			expectThrow( "CArcCombine::tileRows() under a one byte limit"s, [ & ] { cCombine.tileRows( 3 ); } );
+
+			cCombine.setMemoryLimit( 256 * 1024 * 1024 );
+
+			expectThrow( "CArcCombine::combine() with a failing reader"s, [ & ]
+			{
+				cCombine.combine( 3, [ & ]( std::uint32_t uiFrame, std::uint32_t, std::uint32_t, T* )
+				{
+					if ( uiFrame == 1 )
+					{
+						throwArcGen3Error( "Read failed!"s );
+					}
+				}, vTiled.data() );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyCalibrate                                                                                          |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcCalibrate against a double precision brute force calibration for every overscan fit and     |
+		// | several master combinations, including a scaled dark and normalized and unnormalized flats with pixels   |
+		// | that are not positive. The row medians of the overscan are computed by sorting. The polynomial fit is    |
+		// | checked by its residuals, which must be orthogonal to every power of the row up to the fit order.        |
+		// | Integer output must be the rounded and clamped float result, also when calibrated in place.              |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyCalibrate( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			using arc::gen3::image::e_OverscanFit;
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			const arc::gen3::image::Roi_t tInner = innerRoi( uiCols, uiRows );
+
+			const arc::gen3::image::Roi_t tOverscan = { ( uiCols - std::max<std::uint32_t>( 1, uiCols / 8 ) ), uiCols, tInner.uiRow1, tInner.uiRow2 };
+
+			const std::uint32_t uiOrder = 2;
+
+			const std::vector<T> vSrc = testImage<T>( uiCols, uiRows, 70 );
+
+			std::vector<float> vBias( uiPixels );
+			std::vector<float> vDark( uiPixels );
+			std::vector<float> vFlat( uiPixels );
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				vBias[ i ] = ( 100.0f + static_cast< float >( i % 13 ) * 0.25f );
+				vDark[ i ] = ( 5.0f + static_cast< float >( i % 7 ) * 0.5f );
+				vFlat[ i ] = ( 0.5f + static_cast< float >( testValue<T>( i, 71 ) % 1000 ) / 1000.0f );
+
+				if ( ( i % 17 ) == 5 )
+				{
+					vFlat[ i ] = ( ( i % 2 ) == 0 ? 0.0f : -1.0f );
+				}
+			}
+
+			//
+			// Brute force row medians of the overscan region
+			// ---------------------------------------------------------------------------
+			std::vector<double> vMedians( uiRows );
+
+			double gMeanMedian = 0.0;
+
+			for ( std::uint32_t r = tOverscan.uiRow1; r < tOverscan.uiRow2; r++ )
+			{
+				std::vector<double> vRow( vSrc.begin() + r * uiCols + tOverscan.uiCol1, vSrc.begin() + r * uiCols + tOverscan.uiCol2 );
+
+				std::sort( vRow.begin(), vRow.end() );
+
+				vMedians[ r ] = ( 0.5 * ( vRow[ ( vRow.size() - 1 ) / 2 ] + vRow[ vRow.size() / 2 ] ) );
+
+				gMeanMedian += vMedians[ r ];
+			}
+
+			gMeanMedian /= static_cast< double >( tOverscan.uiRow2 - tOverscan.uiRow1 );
+
+			//
+			// Brute force flat reciprocals
+			// ---------------------------------------------------------------------------
+			double gFlatSum = 0.0;
+
+			std::size_t uiPositive = 0;
+
+			for ( const float fValue : vFlat )
+			{
+				if ( fValue > 0.0f )
+				{
+					gFlatSum += fValue;
+					uiPositive++;
+				}
+			}
+
+			const struct { bool bBias; bool bDark; double gDarkScale; bool bFlat; bool bNormalize; } tMasters[] =
+			{
+				{ false, false, 1.0, false, false },
+				{ true, false, 1.0, false, false },
+				{ true, true, 2.5, true, true },
+				{ false, true, 0.5, true, false }
+			};
+
+			const e_OverscanFit eFits[] = { e_OverscanFit::NONE, e_OverscanFit::MEAN, e_OverscanFit::ROW, e_OverscanFit::POLYNOMIAL };
+
+			std::vector<float> vFound( uiPixels );
+			std::vector<T> vFoundT( uiPixels );
+			std::vector<T> vInPlace( uiPixels );
+
+			for ( const auto eFit : eFits )
+			{
+				if ( eFit == e_OverscanFit::POLYNOMIAL && ( tOverscan.uiRow2 - tOverscan.uiRow1 ) <= uiOrder )
+				{
+					continue;
+				}
+
+				for ( const auto& tMaster : tMasters )
+				{
+					const std::string sWhat = CArcBase::formatString( "CArcCalibrate [ fit %u, bias %b, dark %b x %f, flat %b, normalized %b ]",
+																	  static_cast< std::uint32_t >( eFit ), tMaster.bBias, tMaster.bDark, tMaster.gDarkScale,
+																	  tMaster.bFlat, tMaster.bNormalize );
+
+					CArcCalibrate<T> cCalibrate( uiCols, uiRows );
+
+					cCalibrate.setThreads( uiThreads );
+					cCalibrate.setOverscan( tOverscan, eFit, uiOrder );
+					cCalibrate.setBias( tMaster.bBias ? vBias.data() : nullptr );
+					cCalibrate.setDark( tMaster.bDark ? vDark.data() : nullptr );
+					cCalibrate.setDarkScale( tMaster.gDarkScale );
+					cCalibrate.setFlat( tMaster.bFlat ? vFlat.data() : nullptr, tMaster.bNormalize );
+
+					cCalibrate.calibrate( vSrc.data(), vFound.data() );
+					cCalibrate.calibrate( vSrc.data(), vFoundT.data() );
+
+					vInPlace = vSrc;
+
+					cCalibrate.calibrate( vInPlace.data(), vInPlace.data() );
+
+					//
+					// Overscan levels
+					// ---------------------------------------------------------------------------
+					const std::vector<double>& vLevels = cCalibrate.overscanLevels();
+
+					if ( vLevels.size() != ( eFit == e_OverscanFit::NONE ? 0 : uiRows ) )
+					{
+						throwArcGen3Error( "%s [ %u x %u ] overscan level count mismatch! Found: %J", sWhat.c_str(), uiCols, uiRows,
+										   static_cast< unsigned long long >( vLevels.size() ) );
+					}
+
+					for ( std::uint32_t r = 0; r < vLevels.size(); r++ )
+					{
+						const bool bInRegion = ( r >= tOverscan.uiRow1 && r < tOverscan.uiRow2 );
+
+						if ( ( eFit == e_OverscanFit::MEAN || ( eFit == e_OverscanFit::ROW && !bInRegion ) ) && !isClose( vLevels[ r ], gMeanMedian, 1e-12 ) )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] mean overscan level mismatch in row %u! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+											   r, gMeanMedian, vLevels[ r ] );
+						}
+
+						if ( eFit == e_OverscanFit::ROW && bInRegion && vLevels[ r ] != vMedians[ r ] )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] row overscan level mismatch in row %u! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+											   r, vMedians[ r ], vLevels[ r ] );
+						}
+					}
+
+					if ( eFit == e_OverscanFit::POLYNOMIAL )
+					{
+						const double gCenter = ( 0.5 * ( tOverscan.uiRow1 + tOverscan.uiRow2 - 1 ) );
+
+						for ( std::uint32_t j = 0; j <= uiOrder; j++ )
+						{
+							double gDot = 0.0;
+							double gScale = 0.0;
+
+							for ( std::uint32_t r = tOverscan.uiRow1; r < tOverscan.uiRow2; r++ )
+							{
+								const double gPower = std::pow( ( r - gCenter ), static_cast< double >( j ) );
+
+								gDot += ( ( vMedians[ r ] - vLevels[ r ] ) * gPower );
+								gScale += std::fabs( vMedians[ r ] * gPower );
+							}
+
+							if ( std::fabs( gDot ) > ( 1e-9 * std::max( 1.0, gScale ) ) )
+							{
+								throwArcGen3Error( "%s [ %u x %u ] polynomial residuals are not orthogonal to power %u! Residual: %f", sWhat.c_str(),
+												   uiCols, uiRows, j, gDot );
+							}
+						}
+					}
+
+					//
+					// Calibrated pixels
+					// ---------------------------------------------------------------------------
+					for ( std::size_t i = 0; i < uiPixels; i++ )
+					{
+						const double gLevel = ( vLevels.empty() ? 0.0 : vLevels[ i / uiCols ] );
+						const double gBias = ( tMaster.bBias ? vBias[ i ] : 0.0 );
+						const double gDark = ( tMaster.bDark ? ( tMaster.gDarkScale * vDark[ i ] ) : 0.0 );
+
+						double gGain = 1.0;
+
+						if ( tMaster.bFlat )
+						{
+							gGain = ( vFlat[ i ] > 0.0f ? ( ( tMaster.bNormalize ? ( gFlatSum / uiPositive ) : 1.0 ) / vFlat[ i ] ) : 0.0 );
+						}
+
+						const double gExpected = ( ( vSrc[ i ] - gLevel - gBias - gDark ) * gGain );
+
+						// 16-bit images are calibrated in single precision
+						const double gTolerance = ( 1e-6 * ( vSrc[ i ] + std::fabs( gLevel ) + gBias + std::fabs( gDark ) ) * gGain + 1e-6 );
+
+						if ( std::fabs( vFound[ i ] - gExpected ) > gTolerance )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] mismatch at pixel %J! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+											   static_cast< unsigned long long >( i ), gExpected, static_cast< double >( vFound[ i ] ) );
+						}
+
+						const auto fnRound = []( double gValue )
+						{
+							return std::clamp( std::floor( gValue + 0.5 ), 0.0, static_cast< double >( std::numeric_limits<T>::max() ) );
+						};
+
+						if ( vFoundT[ i ] < fnRound( gExpected - gTolerance ) || vFoundT[ i ] > fnRound( gExpected + gTolerance ) )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] integer mismatch at pixel %J! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+											   static_cast< unsigned long long >( i ), fnRound( gExpected ), static_cast< double >( vFoundT[ i ] ) );
+						}
+					}
+
+					comparePixels( vInPlace, [ & ]( std::size_t i ) { return vFoundT[ i ]; }, sWhat + " in place", uiCols, uiRows );
+				}
+			}
+
+			//
+			// Invalid settings
+			// ---------------------------------------------------------------------------
+			CArcCalibrate<T> cCalibrate( uiCols, uiRows );
+
+			const std::vector<float> vNoFlat( uiPixels, 0.0f );
+
+			expectThrow( "CArcCalibrate::setFlat() without positive values"s, [ & ] { cCalibrate.setFlat( vNoFlat.data() ); } );
+			expectThrow( "CArcCalibrate::setOverscan() past ORDER_MAX"s, [ & ] { cCalibrate.setOverscan( tOverscan, e_OverscanFit::POLYNOMIAL, ( CArcCalibrate<T>::ORDER_MAX + 1 ) ); } );
+			expectThrow( "CArcCalibrate::setOverscan() outside the image"s, [ & ] { cCalibrate.setOverscan( { 0, ( uiCols + 1 ), 0, uiRows }, e_OverscanFit::MEAN ); } );
+			expectThrow( "CArcCalibrate::setOverscan() with too few rows"s, [ & ]
+			{
+				cCalibrate.setOverscan( { tOverscan.uiCol1, tOverscan.uiCol2, 0, 1 }, e_OverscanFit::POLYNOMIAL, 1 );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyViews                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the ImageView overloads on strided region, row and column views. Statistics and histograms must |
+		// | match brute force over the region of the parent image, copy() must materialize the region, and fill()    |
+		// | and the view arithmetic must give the caller buffer results inside the region and leave every pixel      |
+		// | outside it untouched.                                                                                    |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyViews( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			using arc::gen3::image::ImageView;
+			using arc::gen3::image::e_ArithMode;
+
+			const std::vector<T> vBuf1 = testImage<T>( uiCols, uiRows, 80 );
+			const std::vector<T> vBuf2 = testImage<T>( uiCols, uiRows, 81 );
+
+			const arc::gen3::image::Roi_t tRoi = innerRoi( uiCols, uiRows );
+
+			const std::uint32_t uiRoiCols = ( tRoi.uiCol2 - tRoi.uiCol1 );
+			const std::uint32_t uiRoiRows = ( tRoi.uiRow2 - tRoi.uiRow1 );
+
+			const ImageView<const T> tView1 = ImageView<const T>( vBuf1.data(), uiCols, uiRows ).sub( tRoi );
+			const ImageView<const T> tView2 = ImageView<const T>( vBuf2.data(), uiCols, uiRows ).sub( tRoi );
+
+			const auto fnInRoi = [ & ]( std::size_t i )
+			{
+				const std::size_t uiCol = ( i % uiCols );
+				const std::size_t uiRow = ( i / uiCols );
+
+				return ( uiCol >= tRoi.uiCol1 && uiCol < tRoi.uiCol2 && uiRow >= tRoi.uiRow1 && uiRow < tRoi.uiRow2 );
+			};
+
+			if ( tView1.cols() != uiRoiCols || tView1.rows() != uiRoiRows || tView1.stride() != uiCols || tView1.contiguous() != ( uiRoiCols == uiCols || uiRoiRows == 1 ) )
+			{
+				throwArcGen3Error( "ImageView::sub() [ %u x %u ] geometry mismatch! Found: %u x %u stride %u", uiCols, uiRows, tView1.cols(), tView1.rows(), tView1.stride() );
+			}
+
+			//
+			// copy() materializes the region
+			// ---------------------------------------------------------------------------
+			std::vector<T> vCopy1( tView1.size() );
+			std::vector<T> vCopy2( tView2.size() );
+
+			CArcImage<T>::copy( ImageView<T>( vCopy1.data(), uiRoiCols, uiRoiRows ), tView1 );
+			CArcImage<T>::copy( ImageView<T>( vCopy2.data(), uiRoiCols, uiRoiRows ), tView2 );
+
+			comparePixels( vCopy1, [ & ]( std::size_t i ) { return vBuf1[ ( tRoi.uiRow1 + i / uiRoiCols ) * uiCols + tRoi.uiCol1 + ( i % uiRoiCols ) ]; },
+						   "CArcImage::copy( ImageView )"s, uiCols, uiRows );
+
+			//
+			// Statistics and histograms of the region, a row and a column
+			// ---------------------------------------------------------------------------
+			arc::gen3::image::CStats cStats;
+
+			CArcImage<T>::getStats( tView1, cStats, uiThreads );
+
+			compareStats( cStats, bruteStats( vBuf1.data(), uiCols, tRoi ), "CArcImage::getStats( ImageView )"s, uiCols, uiRows );
+
+			CArcImage<T>::getStats( tView1.row( uiRoiRows - 1 ), cStats, uiThreads );
+
+			compareStats( cStats, bruteStats( vBuf1.data(), uiCols, { tRoi.uiCol1, tRoi.uiCol2, ( tRoi.uiRow2 - 1 ), tRoi.uiRow2 } ),
+						  "CArcImage::getStats( ImageView::row() )"s, uiCols, uiRows );
+
+			CArcImage<T>::getStats( tView1.col( 0 ), cStats, uiThreads );
+
+			compareStats( cStats, bruteStats( vBuf1.data(), uiCols, { tRoi.uiCol1, ( tRoi.uiCol1 + 1 ), tRoi.uiRow1, tRoi.uiRow2 } ),
+						  "CArcImage::getStats( ImageView::col() )"s, uiCols, uiRows );
+
+			std::vector<std::uint64_t> vExpected( CArcImage<T>::maxTVal(), 0 );
+
+			for ( const T uiVal : vCopy1 )
+			{
+				vExpected[ std::min<std::uint64_t>( uiVal, ( CArcImage<T>::maxTVal() - 1 ) ) ]++;
+			}
+
+			std::vector<std::uint32_t> vHist( CArcImage<T>::maxTVal(), 1 );
+
+			CArcImage<T>::histogram( tView1, vHist.data() );
+
+			compareBins( vHist.data(), vExpected, "CArcImage::histogram( ImageView )"s, uiCols, uiRows );
+
+			//
+			// fill() and the view arithmetic write the region only
+			// ---------------------------------------------------------------------------
+			const T tSentinel = static_cast< T >( 12345 );
+
+			std::vector<T> vDst( vBuf1.size() );
+			std::vector<T> vExpectedRoi( tView1.size() );
+
+			const ImageView<T> tDstView = ImageView<T>( vDst.data(), uiCols, uiRows ).sub( tRoi );
+
+			const auto fnCheck = [ & ]( const std::string& sWhat, const auto& fnView, const auto& fnBuffer )
+			{
+				std::fill( vDst.begin(), vDst.end(), tSentinel );
+
+				fnView();
+
+				fnBuffer( vExpectedRoi.data() );
+
+				comparePixels( vDst, [ & ]( std::size_t i )
+				{
+					return ( fnInRoi( i ) ? vExpectedRoi[ ( i / uiCols - tRoi.uiRow1 ) * uiRoiCols + ( i % uiCols ) - tRoi.uiCol1 ] : tSentinel );
+				}, sWhat, uiCols, uiRows );
+			};
+
+			fnCheck( "CArcImage::fill( ImageView )"s, [ & ] { CArcImage<T>::fill( tDstView, static_cast< T >( 7 ) ); },
+					 [ & ]( T* pDst ) { std::fill_n( pDst, tView1.size(), static_cast< T >( 7 ) ); } );
+
+			for ( const auto eMode : { e_ArithMode::SATURATE, e_ArithMode::WRAP } )
+			{
+				const std::string sMode = ( eMode == e_ArithMode::SATURATE ? " SATURATE"s : " WRAP"s );
+
+				fnCheck( "CArcImage::add( ImageView )"s + sMode, [ & ] { CArcImage<T>::add( tDstView, tView1, tView2, eMode, uiThreads ); },
+						 [ & ]( T* pDst ) { CArcImage<T>::add( pDst, vCopy1.data(), vCopy2.data(), uiRoiCols, uiRoiRows, eMode ); } );
+
+				fnCheck( "CArcImage::subtract( ImageView )"s + sMode, [ & ] { CArcImage<T>::subtract( tDstView, tView1, tView2, eMode, uiThreads ); },
+						 [ & ]( T* pDst ) { CArcImage<T>::subtract( pDst, vCopy1.data(), vCopy2.data(), uiRoiCols, uiRoiRows, eMode ); } );
+
+				fnCheck( "CArcImage::multiply( ImageView )"s + sMode, [ & ] { CArcImage<T>::multiply( tDstView, tView1, tView2, eMode, uiThreads ); },
+						 [ & ]( T* pDst ) { CArcImage<T>::multiply( pDst, vCopy1.data(), vCopy2.data(), uiRoiCols, uiRoiRows, eMode ); } );
+
+				fnCheck( "CArcImage::offset( ImageView )"s + sMode, [ & ] { CArcImage<T>::offset( tDstView, tView1, -1000, eMode, uiThreads ); },
+						 [ & ]( T* pDst ) { CArcImage<T>::offset( pDst, vCopy1.data(), uiRoiCols, uiRoiRows, -1000, eMode ); } );
+			}
+
+			fnCheck( "CArcImage::divide( ImageView )"s, [ & ] { CArcImage<T>::divide( tDstView, tView1, tView2, uiThreads ); },
+					 [ & ]( T* pDst ) { CArcImage<T>::divide( pDst, vCopy1.data(), vCopy2.data(), uiRoiCols, uiRoiRows ); } );
+
+			fnCheck( "CArcImage::scale( ImageView )"s, [ & ] { CArcImage<T>::scale( tDstView, tView1, 1.7, uiThreads ); },
+					 [ & ]( T* pDst ) { CArcImage<T>::scale( pDst, vCopy1.data(), uiRoiCols, uiRoiRows, 1.7 ); } );
+
+			//
+			// Views of mismatched extent and regions outside the view are refused
+			// ---------------------------------------------------------------------------
+			const ImageView<const T> tWhole( vBuf1.data(), uiCols, uiRows );
+
+			expectThrow( "ImageView::sub() past the last column"s, [ & ] { tWhole.sub( 0, ( uiCols + 1 ), 0, uiRows ); } );
+			expectThrow( "ImageView::sub() past the last row"s, [ & ] { tWhole.sub( 0, uiCols, 0, ( uiRows + 1 ) ); } );
+			expectThrow( "ImageView::sub() of an empty region"s, [ & ] { tWhole.sub( 0, 0, 0, uiRows ); } );
+			std::vector<T> vWider( static_cast< std::size_t >( uiCols + 1 ) * uiRows );
+
+			expectThrow( "CArcImage::add() of mismatched views"s, [ & ]
+			{
+				CArcImage<T>::add( ImageView<T>( vWider.data(), ( uiCols + 1 ), uiRows ), tWhole, tWhole, e_ArithMode::SATURATE, uiThreads );
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyProfiles                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies row and column profiles against brute force averages.                                           |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyProfiles( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 3 );
+
+			const arc::gen3::image::Roi_t tRegions[] = { { 0, uiCols, 0, uiRows }, innerRoi( uiCols, uiRows ),
+														 { ( uiCols / 2 ), ( uiCols / 2 + 1 ), ( uiRows / 2 ), ( uiRows / 2 + 1 ) } };
+
+			const arc::gen3::image::e_ProfileAxis eAxes[] = { arc::gen3::image::e_ProfileAxis::ROW, arc::gen3::image::e_ProfileAxis::COLUMN };
+
+			std::vector<arc::gen3::image::Profile_t> vProfiles;
+			std::vector<std::vector<double>> vValues;
+
+			for ( const auto& tRoi : tRegions )
+			{
+				for ( auto eAxis : eAxes )
+				{
+					vValues.emplace_back( ( eAxis == arc::gen3::image::e_ProfileAxis::ROW ? ( tRoi.uiRow2 - tRoi.uiRow1 ) : ( tRoi.uiCol2 - tRoi.uiCol1 ) ), -1.0 );
+
+					vProfiles.push_back( { tRoi, eAxis, nullptr } );
+				}
+			}
+
+			for ( std::size_t p = 0; p < vProfiles.size(); p++ )
+			{
+				vProfiles[ p ].pDst = vValues[ p ].data();
+			}
+
+			for ( int iPass = 0; iPass < 2; iPass++ )
+			{
+				const std::string sWhat = ( iPass == 0 ? "CArcImage::getProfiles()"s : "CArcImage::getProfiles( view )"s );
+
+				if ( iPass == 0 )
+				{
+					CArcImage<T>::getProfiles( vBuf.data(), uiCols, uiRows, vProfiles, uiThreads );
+				}
+
+				else
+				{
+					CArcImage<T>::getProfiles( arc::gen3::image::ImageView<const T>( vBuf.data(), uiCols, uiRows ), vProfiles, uiThreads );
+				}
+
+				for ( std::size_t p = 0; p < vProfiles.size(); p++ )
+				{
+					const arc::gen3::image::Roi_t& tRoi = vProfiles[ p ].tRoi;
+
+					const bool bRow = ( vProfiles[ p ].eAxis == arc::gen3::image::e_ProfileAxis::ROW );
+
+					for ( std::uint32_t i = 0; i < vValues[ p ].size(); i++ )
+					{
+						const arc::gen3::image::Roi_t tLine = ( bRow ? arc::gen3::image::Roi_t { tRoi.uiCol1, tRoi.uiCol2, ( tRoi.uiRow1 + i ), ( tRoi.uiRow1 + i + 1 ) }
+																	 : arc::gen3::image::Roi_t { ( tRoi.uiCol1 + i ), ( tRoi.uiCol1 + i + 1 ), tRoi.uiRow1, tRoi.uiRow2 } );
+
+						const double gExpected = bruteStats( vBuf.data(), uiCols, tLine ).gMean;
+
+						if ( !isClose( vValues[ p ][ i ], gExpected, 1e-9 ) )
+						{
+							throwArcGen3Error( "%s [ %u x %u ] %s profile %u mismatch at index %u! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows,
+											   ( bRow ? "row" : "column" ), static_cast< std::uint32_t >( p ), i, gExpected, vValues[ p ][ i ] );
+						}
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyMaskedStats                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the masked statistics and histogram against brute force over the unmasked pixels. The mask      |
+		// | holds scattered pixels, a whole row and a whole 64 pixel word.                                           |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyMaskedStats( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 5 );
+
+			arc::gen3::image::CBitMask cMask( uiCols, uiRows );
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					const bool bWord = ( r == 0 && uiCols >= 128 && c >= 64 && c < 128 );
+					const bool bRow = ( uiRows > 2 && r == ( uiRows / 2 ) );
+
+					if ( bWord || bRow || ( testValue<T>( ( static_cast< std::uint64_t >( r ) * uiCols + c ), 6 ) % 5 ) == 0 )
+					{
+						cMask.set( c, r );
+					}
+				}
+			}
+
+			const auto fnUnmasked = [ & ]( std::uint32_t c, std::uint32_t r ) { return !cMask.test( c, r ); };
+
+			const arc::gen3::image::CStats cExpected = bruteStats( vBuf.data(), uiCols, { 0, uiCols, 0, uiRows }, fnUnmasked );
+
+			auto pStats = CArcImage<T>::getStats( vBuf.data(), uiCols, uiRows, cMask, uiThreads );
+
+			compareStats( *pStats, cExpected, "CArcImage::getStats( masked )"s, uiCols, uiRows );
+
+			std::uint64_t uiMasked = 0;
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					uiMasked += ( fnUnmasked( c, r ) ? 0 : 1 );
+				}
+			}
+
+			if ( cMask.count() != uiMasked )
+			{
+				throwArcGen3Error( "CBitMask::count() [ %u x %u ] mismatch! Expected: %J Found: %J", uiCols, uiRows,
+								   static_cast< unsigned long long >( uiMasked ), static_cast< unsigned long long >( cMask.count() ) );
+			}
+
+			std::vector<std::uint64_t> vExpected( CArcImage<T>::maxTVal(), 0 );
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					if ( fnUnmasked( c, r ) )
+					{
+						vExpected[ std::min<std::uint64_t>( vBuf[ static_cast< std::size_t >( r ) * uiCols + c ], ( vExpected.size() - 1 ) ) ]++;
+					}
+				}
+			}
+
+			std::uint32_t uiCount = 0;
+
+			auto pHist = CArcImage<T>::histogram( vBuf.data(), uiCols, uiRows, cMask, uiCount );
+
+			compareBins( pHist.get(), vExpected, "CArcImage::histogram( masked )"s, uiCols, uiRows );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyDefects                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcImage::detectDefects() and interpolateMasked(). The image is a flat level with a pattern    |
+		// | of 0, 2 and 4 counts, which sets the noise to about 3 counts and the 5 sigma limit to 14 counts. Warm    |
+		// | pixels 10 counts above the level must not be masked, and isolated hot pixels over 1000 counts above it   |
+		// | must be, so the mask must hold exactly the hot pixels.                                                   |
+		// | The interpolation is checked against a brute force neighborhood mean for a mask that also holds a fully  |
+		// | masked 3 x 3 block, whose center falls back to the 5 x 5 neighborhood.                                   |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyDefects( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const T tLevel = static_cast< T >( CArcImage<T>::maxTVal() / 4 );
+
+			std::vector<T> vBuf( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			arc::gen3::image::CBitMask cExpected( uiCols, uiRows );
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					const std::size_t i = ( static_cast< std::size_t >( r ) * uiCols + c );
+
+					vBuf[ i ] = static_cast< T >( tLevel + 2 * ( ( c + r ) % 3 ) );
+
+					if ( ( c % 5 ) == 4 && ( r % 4 ) == 3 )
+					{
+						vBuf[ i ] = static_cast< T >( tLevel + 12 );
+					}
+
+					if ( ( c % 5 ) == 2 && ( r % 4 ) == 1 && ( testValue<T>( i, 90 ) % 3 ) == 0 )
+					{
+						vBuf[ i ] = static_cast< T >( tLevel + 1000 + ( testValue<T>( i, 91 ) % 1000 ) );
+
+						cExpected.set( c, r );
+					}
+				}
+			}
+
+			//
+			// detectDefects() masks the hot pixels and nothing else
+			// ---------------------------------------------------------------------------
+			arc::gen3::image::CBitMask cMask;
+
+			const std::uint64_t uiCount = CArcImage<T>::detectDefects( vBuf.data(), uiCols, uiRows, cMask, 5.0, uiThreads );
+
+			if ( uiCount != cExpected.count() || cMask.count() != cExpected.count() )
+			{
+				throwArcGen3Error( "CArcImage::detectDefects() [ %u x %u ] count mismatch! Expected: %J Found: %J", uiCols, uiRows,
+								   static_cast< unsigned long long >( cExpected.count() ), static_cast< unsigned long long >( uiCount ) );
+			}
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					if ( cMask.test( c, r ) != cExpected.test( c, r ) )
+					{
+						throwArcGen3Error( "CArcImage::detectDefects() [ %u x %u ] mask mismatch at column %u row %u!", uiCols, uiRows, c, r );
+					}
+				}
+			}
+
+			//
+			// interpolateMasked() with a fully masked 3 x 3 block added to the mask
+			// ---------------------------------------------------------------------------
+			if ( uiCols >= 5 && uiRows >= 5 )
+			{
+				for ( std::uint32_t r = ( uiRows / 2 - 1 ); r <= ( uiRows / 2 + 1 ); r++ )
+				{
+					for ( std::uint32_t c = ( uiCols / 2 - 1 ); c <= ( uiCols / 2 + 1 ); c++ )
+					{
+						cMask.set( c, r );
+					}
+				}
+			}
+
+			const std::vector<T> vOriginal = testImage<T>( uiCols, uiRows, 92 );
+
+			std::vector<T> vFixed = vOriginal;
+
+			std::uint64_t uiReplaced = 0;
+
+			const auto fnExpected = [ & ]( std::size_t i )
+			{
+				const std::uint32_t uiCol = static_cast< std::uint32_t >( i % uiCols );
+				const std::uint32_t uiRow = static_cast< std::uint32_t >( i / uiCols );
+
+				if ( !cMask.test( uiCol, uiRow ) )
+				{
+					return vOriginal[ i ];
+				}
+
+				for ( std::int64_t iRadius = 1; iRadius <= 2; iRadius++ )
+				{
+					std::uint64_t uiSum = 0;
+					std::uint64_t uiUsed = 0;
+
+					for ( std::int64_t r = ( uiRow - iRadius ); r <= ( uiRow + iRadius ); r++ )
+					{
+						for ( std::int64_t c = ( uiCol - iRadius ); c <= ( uiCol + iRadius ); c++ )
+						{
+							if ( r >= 0 && r < uiRows && c >= 0 && c < uiCols && !cMask.test( static_cast< std::uint32_t >( c ), static_cast< std::uint32_t >( r ) ) )
+							{
+								uiSum += vOriginal[ static_cast< std::size_t >( r ) * uiCols + static_cast< std::size_t >( c ) ];
+
+								uiUsed++;
+							}
+						}
+					}
+
+					if ( uiUsed > 0 )
+					{
+						return static_cast< T >( std::floor( static_cast< double >( uiSum ) / static_cast< double >( uiUsed ) + 0.5 ) );
+					}
+				}
+
+				return vOriginal[ i ];
+			};
+
+			for ( std::size_t i = 0; i < vOriginal.size(); i++ )
+			{
+				uiReplaced += ( cMask.test( static_cast< std::uint32_t >( i % uiCols ), static_cast< std::uint32_t >( i / uiCols ) ) ? 1 : 0 );
+			}
+
+			const std::uint64_t uiFound = CArcImage<T>::interpolateMasked( vFixed.data(), uiCols, uiRows, cMask, uiThreads );
+
+			if ( uiFound != uiReplaced )
+			{
+				throwArcGen3Error( "CArcImage::interpolateMasked() [ %u x %u ] count mismatch! Expected: %J Found: %J", uiCols, uiRows,
+								   static_cast< unsigned long long >( uiReplaced ), static_cast< unsigned long long >( uiFound ) );
+			}
+
+			comparePixels( vFixed, fnExpected, "CArcImage::interpolateMasked()"s, uiCols, uiRows );
+
+			//
+			// A fully masked image has nothing to interpolate from
+			// ---------------------------------------------------------------------------
+			arc::gen3::image::CBitMask cFull( uiCols, uiRows );
+
+			for ( std::uint32_t r = 0; r < uiRows; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiCols; c++ )
+				{
+					cFull.set( c, r );
+				}
+			}
+
+			vFixed = vOriginal;
+
+			if ( CArcImage<T>::interpolateMasked( vFixed.data(), uiCols, uiRows, cFull, uiThreads ) != 0 || vFixed != vOriginal )
+			{
+				throwArcGen3Error( "CArcImage::interpolateMasked() [ %u x %u ] modified a fully masked image!", uiCols, uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyBin                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the 64-bit sums and the clamped sum and rounded mean outputs of bin() against brute force block |
+		// | sums, and decimate() against the first pixel of each block, for the whole image and a region.            |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiFactor	- The block size.                                                                     |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyBin( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiFactor, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 4 );
+
+			const arc::gen3::image::Roi_t tRegions[] = { { 0, uiCols, 0, uiRows }, innerRoi( uiCols, uiRows ) };
+
+			const std::uint64_t uiArea = ( static_cast< std::uint64_t >( uiFactor ) * uiFactor );
+
+			for ( const auto& tRoi : tRegions )
+			{
+				const std::uint32_t uiOutCols = ( ( tRoi.uiCol2 - tRoi.uiCol1 ) / uiFactor );
+				const std::uint32_t uiOutRows = ( ( tRoi.uiRow2 - tRoi.uiRow1 ) / uiFactor );
+
+				if ( uiOutCols == 0 || uiOutRows == 0 )
+				{
+					continue;
+				}
+
+				const arc::gen3::image::ImageView<const T> tView = arc::gen3::image::ImageView<const T>( vBuf.data(), uiCols, uiRows ).sub( tRoi );
+
+				std::vector<std::uint64_t> vSum( static_cast< std::size_t >( uiOutCols ) * uiOutRows );
+				std::vector<T> vClamped( vSum.size() );
+				std::vector<T> vMean( vSum.size() );
+				std::vector<T> vDecimated( vSum.size() );
+
+				CArcImage<T>::bin( tView, uiFactor, vSum.data(), uiThreads );
+				CArcImage<T>::bin( tView, uiFactor, vClamped.data(), arc::gen3::image::e_BinMode::SUM, uiThreads );
+				CArcImage<T>::bin( tView, uiFactor, vMean.data(), arc::gen3::image::e_BinMode::MEAN, uiThreads );
+				CArcImage<T>::decimate( tView, uiFactor, vDecimated.data(), uiThreads );
+
+				for ( std::uint32_t r = 0; r < uiOutRows; r++ )
+				{
+					for ( std::uint32_t c = 0; c < uiOutCols; c++ )
+					{
+						std::uint64_t uiExpected = 0;
+
+						for ( std::uint32_t y = 0; y < uiFactor; y++ )
+						{
+							for ( std::uint32_t x = 0; x < uiFactor; x++ )
+							{
+								uiExpected += vBuf[ static_cast< std::size_t >( tRoi.uiRow1 + r * uiFactor + y ) * uiCols + ( tRoi.uiCol1 + c * uiFactor + x ) ];
+							}
+						}
+
+						const std::size_t i = ( static_cast< std::size_t >( r ) * uiOutCols + c );
+
+						const std::uint64_t uiClamped = std::min<std::uint64_t>( uiExpected, std::numeric_limits<T>::max() );
+						const std::uint64_t uiMean = ( ( uiExpected + uiArea / 2 ) / uiArea );
+
+						const T tFirst = vBuf[ static_cast< std::size_t >( tRoi.uiRow1 + r * uiFactor ) * uiCols + ( tRoi.uiCol1 + c * uiFactor ) ];
+
+						if ( vDecimated[ i ] != tFirst )
+						{
+							throwArcGen3Error( "CArcImage::decimate() [ %u x %u ] factor %u mismatch at block [ %u, %u ]! Expected: %u Found: %u",
+											   uiCols, uiRows, uiFactor, c, r, static_cast< std::uint32_t >( tFirst ), static_cast< std::uint32_t >( vDecimated[ i ] ) );
+						}
+
+						if ( vSum[ i ] != uiExpected || vClamped[ i ] != uiClamped || vMean[ i ] != uiMean )
+						{
+							throwArcGen3Error( "CArcImage::bin() [ %u x %u ] factor %u mismatch at block [ %u, %u ]! Expected: %J, %J, %J Found: %J, %u, %u",
+											   uiCols, uiRows, uiFactor, c, r, static_cast< unsigned long long >( uiExpected ),
+											   static_cast< unsigned long long >( uiClamped ), static_cast< unsigned long long >( uiMean ),
+											   static_cast< unsigned long long >( vSum[ i ] ), static_cast< std::uint32_t >( vClamped[ i ] ),
+											   static_cast< std::uint32_t >( vMean[ i ] ) );
+						}
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyDisplayScale                                                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the CArcDisplayScale limits and previews. Every pixel is sampled, so the percentile limits are  |
+		// | checked against the interpolated ranks of the sorted image and the zscale limits of a ramp against the   |
+		// | fitted unit slope. The previews of the whole image and a region are checked pixel by pixel against the   |
+		// | stretch formulas, and tableBuilds() is checked to count only the rebuilds the settings call for.         |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyDisplayScale( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::vector<T> vBuf = testImage<T>( uiCols, uiRows, 5 );
+
+			const std::size_t uiPixels = vBuf.size();
+
+			std::vector<T> vSorted( vBuf );
+
+			std::sort( vSorted.begin(), vSorted.end() );
+
+			auto fnPercentile = [ & ]( const double gPercent )
+			{
+				const double gRank = ( gPercent / 100.0 * static_cast< double >( uiPixels - 1 ) );
+				const std::size_t uiRank = static_cast< std::size_t >( gRank );
+				const double gNext = static_cast< double >( vSorted[ std::min( ( uiRank + 1 ), ( uiPixels - 1 ) ) ] );
+
+				return ( vSorted[ uiRank ] + ( gRank - static_cast< double >( uiRank ) ) * ( gNext - vSorted[ uiRank ] ) );
+			};
+
+			auto fnCheckLimits = [ & ]( const CArcDisplayScale<T>& cScale, std::pair<double, double> tExpected, const std::string& sWhat )
+			{
+				if ( !( tExpected.second > tExpected.first ) )
+				{
+					tExpected.second = ( tExpected.first + 1.0 );
+				}
+
+				const auto tFound = cScale.limits();
+
+				if ( !isClose( tFound.first, tExpected.first, 1e-9 ) || !isClose( tFound.second, tExpected.second, 1e-9 ) )
+				{
+					throwArcGen3Error( "CArcDisplayScale %s limits [ %u x %u ] mismatch! Expected: %f, %f Found: %f, %f", sWhat.c_str(), uiCols,
+									   uiRows, tExpected.first, tExpected.second, tFound.first, tFound.second );
+				}
+			};
+
+			// The brute force preview of one pixel. 32-bit pixels are first quantized to a table index.
+			auto fnPreview = [] ( const double gValue, const std::pair<double, double>& tLimits, const arc::gen3::image::e_Stretch eStretch,
+								  const double gParam )
+			{
+				double gNorm = std::clamp( ( ( gValue - tLimits.first ) / ( tLimits.second - tLimits.first ) ), 0.0, 1.0 );
+
+				if constexpr ( sizeof( T ) > sizeof( std::uint16_t ) )
+				{
+					constexpr double gMax = static_cast< double >( CArcDisplayScale<T>::TABLE_SIZE - 1 );
+
+					const double gIndex = ( ( gValue - tLimits.first ) * ( gMax / ( tLimits.second - tLimits.first ) ) + 0.5 );
+
+					gNorm = ( std::floor( std::clamp( gIndex, 0.0, gMax ) ) / gMax );
+				}
+
+				double gOut = gNorm;
+
+				if ( eStretch == arc::gen3::image::e_Stretch::LOG )
+				{
+					gOut = ( std::log1p( gParam * gNorm ) / std::log1p( gParam ) );
+				}
+
+				else if ( eStretch == arc::gen3::image::e_Stretch::ASINH )
+				{
+					gOut = ( std::asinh( gNorm / gParam ) / std::asinh( 1.0 / gParam ) );
+				}
+
+				return static_cast< std::uint8_t >( std::lround( 255.0 * std::clamp( gOut, 0.0, 1.0 ) ) );
+			};
+
+			const double gMin = static_cast< double >( vSorted.front() );
+			const double gMax = static_cast< double >( vSorted.back() );
+
+			const struct { arc::gen3::image::e_Stretch eStretch; double gParam; double gDefault; const char* pszName; } tStretches[] =
+			{
+				{ arc::gen3::image::e_Stretch::LINEAR,	0.0,	0.0,	"linear"	},
+				{ arc::gen3::image::e_Stretch::LOG,		0.0,	1000.0,	"log"		},
+				{ arc::gen3::image::e_Stretch::LOG,		10.0,	10.0,	"log"		},
+				{ arc::gen3::image::e_Stretch::ASINH,	0.0,	0.1,	"asinh"		},
+				{ arc::gen3::image::e_Stretch::ASINH,	0.5,	0.5,	"asinh"		}
+			};
+
+			const std::pair<double, double> tManual( ( gMin + ( gMax - gMin ) / 8.0 ), ( gMax - ( gMax - gMin ) / 4.0 + 1.0 ) );
+
+			const arc::gen3::image::Roi_t tRegions[] = { { 0, uiCols, 0, uiRows }, innerRoi( uiCols, uiRows ) };
+
+			for ( const auto& tStretch : tStretches )
+			{
+				for ( const bool bManual : { true, false } )
+				{
+					CArcDisplayScale<T> cScale;
+
+					cScale.setThreads( uiThreads );
+					cScale.setSampleSize( static_cast< std::uint32_t >( uiPixels ) );
+					cScale.setStretch( tStretch.eStretch, tStretch.gParam );
+
+					if ( bManual )
+					{
+						cScale.setLimits( tManual.first, tManual.second );
+					}
+
+					else
+					{
+						cScale.setPercentile( 1.0, 95.5 );
+					}
+
+					const std::string sWhat = CArcBase::formatString( "%s %s", ( bManual ? "manual" : "percentile" ), tStretch.pszName );
+
+					for ( const auto& tRoi : tRegions )
+					{
+						const arc::gen3::image::ImageView<const T> tView = arc::gen3::image::ImageView<const T>( vBuf.data(), uiCols, uiRows ).sub( tRoi );
+
+						std::vector<std::uint8_t> vPreview( static_cast< std::size_t >( tView.cols() ) * tView.rows() );
+
+						if ( vPreview.empty() )
+						{
+							continue;
+						}
+
+						cScale.scale( tView, vPreview.data() );
+
+						if ( bManual )
+						{
+							fnCheckLimits( cScale, tManual, sWhat );
+						}
+
+						else if ( tView.cols() == uiCols && tView.rows() == uiRows )
+						{
+							fnCheckLimits( cScale, std::make_pair( fnPercentile( 1.0 ), fnPercentile( 95.5 ) ), sWhat );
+						}
+
+						const auto tLimits = cScale.limits();
+
+						comparePixels( vPreview, [ & ]( std::size_t i )
+						{
+							const T tValue = tView.rowData( static_cast< std::uint32_t >( i / tView.cols() ) )[ i % tView.cols() ];
+
+							return fnPreview( static_cast< double >( tValue ), tLimits, tStretch.eStretch, tStretch.gDefault );
+						}, "CArcDisplayScale::scale() "s + sWhat, uiCols, uiRows );
+					}
+				}
+			}
+
+			// zscale of a reversed ramp. The fitted slope is exactly one, so the limits are the median less and plus the ranks
+			// either side of it divided by the contrast, clipped to the ramp. Fewer than five samples use the range.
+			if ( ( uiPixels + 1000 ) <= CArcImage<T>::maxTVal() )
+			{
+				std::vector<T> vRamp( uiPixels );
+
+				for ( std::size_t i = 0; i < uiPixels; i++ )
+				{
+					vRamp[ i ] = static_cast< T >( 1000 + ( uiPixels - 1 - i ) );
+				}
+
+				std::vector<std::uint8_t> vPreview( uiPixels );
+
+				CArcDisplayScale<T> cScale;
+
+				cScale.setThreads( uiThreads );
+				cScale.setSampleSize( static_cast< std::uint32_t >( uiPixels ) );
+				cScale.setZScale( 4.0 );
+				cScale.scale( vRamp.data(), uiCols, uiRows, vPreview.data() );
+
+				const double gLast = static_cast< double >( 1000 + uiPixels - 1 );
+				const std::size_t uiCenter = ( ( uiPixels - 1 ) / 2 );
+				const double gMedian = ( 1000.0 + static_cast< double >( uiPixels - 1 ) / 2.0 );
+
+				std::pair<double, double> tExpected( 1000.0, gLast );
+
+				if ( uiPixels >= 5 )
+				{
+					tExpected = std::make_pair( std::max( 1000.0, ( gMedian - ( static_cast< double >( uiCenter ) - 1.0 ) / 4.0 ) ),
+												std::min( gLast, ( gMedian + static_cast< double >( uiPixels - uiCenter ) / 4.0 ) ) );
+				}
+
+				fnCheckLimits( cScale, tExpected, "zscale ramp"s );
+			}
+
+			// zscale of the test image must bracket the median and stay within the image range.
+			{
+				std::vector<std::uint8_t> vPreview( uiPixels );
+
+				CArcDisplayScale<T> cScale;
+
+				cScale.setThreads( uiThreads );
+				cScale.setSampleSize( static_cast< std::uint32_t >( uiPixels ) );
+				cScale.scale( vBuf.data(), uiCols, uiRows, vPreview.data() );
+
+				const auto tFound = cScale.limits();
+
+				const double gMedian = ( 0.5 * ( static_cast< double >( vSorted[ ( uiPixels - 1 ) / 2 ] ) + vSorted[ uiPixels / 2 ] ) );
+
+				if ( gMin == gMax ? ( tFound.first != gMin || tFound.second != ( gMin + 1.0 ) )
+								  : ( tFound.first < gMin || tFound.first > gMedian || tFound.second < gMedian || tFound.second > gMax ) )
+				{
+					throwArcGen3Error( "CArcDisplayScale zscale limits [ %u x %u ] out of range! Found: %f, %f Image: %f, %f, %f", uiCols, uiRows,
+									   tFound.first, tFound.second, gMin, gMedian, gMax );
+				}
+			}
+
+			// The table is rebuilt when a setting changes or the limits move by more than the tolerance, and only then.
+			{
+				std::vector<T> vHalf( uiPixels );
+				std::vector<T> vShift( uiPixels );
+
+				for ( std::size_t i = 0; i < uiPixels; i++ )
+				{
+					vHalf[ i ] = static_cast< T >( vBuf[ i ] / 2 );
+					vShift[ i ] = static_cast< T >( vHalf[ i ] + 1 );
+				}
+
+				std::vector<std::uint8_t> vPreview( uiPixels );
+
+				CArcDisplayScale<T> cScale;
+
+				std::uint64_t uiBuilds = 0;
+
+				auto fnScale = [ & ]( const std::vector<T>& vSrc, const std::uint64_t uiAdded, const char* pszWhen )
+				{
+					cScale.scale( vSrc.data(), uiCols, uiRows, vPreview.data() );
+
+					uiBuilds += uiAdded;
+
+					if ( cScale.tableBuilds() != uiBuilds )
+					{
+						throwArcGen3Error( "CArcDisplayScale::tableBuilds() [ %u x %u ] mismatch %s! Expected: %J Found: %J", uiCols, uiRows, pszWhen,
+										   static_cast< unsigned long long >( uiBuilds ), static_cast< unsigned long long >( cScale.tableBuilds() ) );
+					}
+				};
+
+				cScale.setThreads( uiThreads );
+				cScale.setSampleSize( static_cast< std::uint32_t >( uiPixels ) );
+				cScale.setPercentile( 0.0, 100.0 );
+				cScale.setTolerance( 0.5 );
+
+				fnScale( vHalf, 1, "on the first frame" );
+				fnScale( vHalf, 0, "on a repeated frame" );
+
+				const auto tLimits = cScale.limits();
+
+				if ( ( tLimits.second - tLimits.first ) >= 2.0 )
+				{
+					fnScale( vShift, 0, "within the tolerance" );
+
+					if ( cScale.limits() != tLimits )
+					{
+						throwArcGen3Error( "CArcDisplayScale::limits() [ %u x %u ] moved without a table rebuild!", uiCols, uiRows );
+					}
+
+					cScale.setTolerance( 0.0 );
+
+					fnScale( vShift, 1, "beyond the tolerance" );
+					fnScale( vHalf, 1, "beyond the tolerance" );
+				}
+
+				cScale.setStretch( arc::gen3::image::e_Stretch::ASINH );
+
+				fnScale( vHalf, 1, "after a stretch change" );
+				fnScale( vHalf, 0, "on a repeated frame" );
+
+				cScale.setLimits( 0.0, 100.0 );
+
+				fnScale( vShift, 1, "after a limits change" );
+				fnScale( vHalf, 0, "with fixed limits" );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyCentroid                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcCentroid on a row of synthetic gaussian stars of different brightness over a noisy flat     |
+		// | background, seen through a view into a wider buffer. find() must return every star, brightest first, at  |
+		// | the true positions, fluxes and FWHM; fewer sources must keep the brightest. track() must follow a shift  |
+		// | of the frame, and neither find() nor track() may reallocate their results. A flat frame has no sources.  |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyCentroid( const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			constexpr double gSigma = 1.5;
+			constexpr double gLevel = 1000.0;
+			constexpr std::uint32_t uiPad = 4;
+
+			const std::uint32_t uiStride = ( uiCols + uiPad );
+
+			const std::uint32_t uiStars = ( ( uiCols >= 50 && uiRows >= 24 ) ? std::min( 8U, ( ( uiCols - 26 ) / 24 + 1 ) ) : 0 );
+
+			// Star k is at ( 16 + 24 k, rows / 2 ) plus a sub-pixel offset, with its brightness out of raster order.
+			auto fnStar = [ & ]( const std::uint32_t k )
+			{
+				return std::make_tuple( ( 16.0 + 24.0 * k + 0.15 * k ), ( uiRows / 2 + 0.1 * k - 0.35 ), ( 3000.0 + 2000.0 * ( ( k * 5 ) % 8 ) ) );
+			};
+
+			std::vector<T> vBuf( static_cast< std::size_t >( uiStride ) * uiRows );
+
+			auto fnRender = [ & ]( const double gDx, const double gDy )
+			{
+				for ( std::uint32_t r = 0; r < uiRows; r++ )
+				{
+					for ( std::uint32_t c = 0; c < uiCols; c++ )
+					{
+						const std::size_t i = ( static_cast< std::size_t >( r ) * uiStride + uiPad + c );
+
+						double gValue = ( gLevel + static_cast< double >( testValue<T>( i, 6 ) % 5 ) );
+
+						for ( std::uint32_t k = 0; k < uiStars; k++ )
+						{
+							const auto [ gX, gY, gAmp ] = fnStar( k );
+
+							if ( std::fabs( c - gX - gDx ) > 12.0 )
+							{
+								continue;
+							}
+
+							const double gR2 = ( ( c - gX - gDx ) * ( c - gX - gDx ) + ( r - gY - gDy ) * ( r - gY - gDy ) );
+
+							gValue += ( gAmp * std::exp( -gR2 / ( 2.0 * gSigma * gSigma ) ) );
+						}
+
+						vBuf[ i ] = static_cast< T >( std::lround( gValue ) );
+					}
+				}
+
+				return arc::gen3::image::ImageView<const T>( vBuf.data(), uiStride, uiRows ).sub( { uiPad, uiStride, 0, uiRows } );
+			};
+
+			// The stars sorted brightest first.
+			std::vector<std::uint32_t> vOrder( uiStars );
+
+			for ( std::uint32_t k = 0; k < uiStars; k++ )
+			{
+				vOrder[ k ] = k;
+			}
+
+			std::sort( vOrder.begin(), vOrder.end(), [ & ]( std::uint32_t a, std::uint32_t b ) { return ( std::get<2>( fnStar( a ) ) > std::get<2>( fnStar( b ) ) ); } );
+
+			auto fnCheck = [ & ]( const arc::gen3::image::Source_t& tSource, const std::uint32_t k, const double gDx, const double gDy, const std::string& sWhat )
+			{
+				const auto [ gX, gY, gAmp ] = fnStar( k );
+
+				const double gFlux = ( 2.0 * std::numbers::pi * gSigma * gSigma * gAmp );
+
+				if ( !tSource.bValid || std::fabs( tSource.gX - gX - gDx ) > 0.05 || std::fabs( tSource.gY - gY - gDy ) > 0.05 ||
+					 !isClose( tSource.gFlux, gFlux, 0.02 ) || !isClose( tSource.gFwhm, ( 2.3548200450309493 * gSigma ), 0.05 ) ||
+					 tSource.gEllipticity > 0.05 || std::fabs( tSource.gBackground - gLevel - 2.0 ) > 1.0 )
+				{
+					throwArcGen3Error( "CArcCentroid::%s [ %u x %u ] star %u mismatch! Expected: %f, %f, %f Found: %f, %f, %f FWHM: %f Valid: %d",
+									   sWhat.c_str(), uiCols, uiRows, k, ( gX + gDx ), ( gY + gDy ), gFlux, tSource.gX, tSource.gY, tSource.gFlux,
+									   tSource.gFwhm, static_cast< int >( tSource.bValid ) );
+				}
+			};
+
+			auto fnCheckFound = [ & ]( const std::vector<arc::gen3::image::Source_t>& vFound, const std::uint32_t uiMax, const double gDx, const double gDy )
+			{
+				const std::uint32_t uiExpected = std::min( uiStars, uiMax );
+
+				if ( vFound.size() != uiExpected )
+				{
+					throwArcGen3Error( "CArcCentroid::find() [ %u x %u ] of at most %u sources found %u! Expected: %u", uiCols, uiRows, uiMax,
+									   static_cast< std::uint32_t >( vFound.size() ), uiExpected );
+				}
+
+				for ( std::uint32_t i = 0; i < uiExpected; i++ )
+				{
+					fnCheck( vFound[ i ], vOrder[ i ], gDx, gDy, CArcBase::formatString( "find() source %u of at most %u", i, uiMax ) );
+				}
+			};
+
+			for ( const std::uint32_t uiMax : { 1U, 3U, 16U } )
+			{
+				CArcCentroid<T> cCentroid( uiMax );
+
+				std::fill( vBuf.begin(), vBuf.end(), 0 );
+
+				const arc::gen3::image::Source_t* pFound = cCentroid.find( arc::gen3::image::ImageView<const T>( vBuf.data(), uiCols, uiRows ) ).data();
+
+				const auto& vFound = cCentroid.find( fnRender( 0.0, 0.0 ) );
+
+				fnCheckFound( vFound, uiMax, 0.0, 0.0 );
+
+				std::vector<std::pair<double, double>> vGuide;
+
+				for ( const auto& tSource : vFound )
+				{
+					vGuide.emplace_back( tSource.gX, tSource.gY );
+				}
+
+				// A guide star on blank sky is lost and must keep its position.
+				vGuide.emplace_back( ( uiCols / 2.0 ), 2.0 );
+
+				cCentroid.setGuideStars( vGuide );
+
+				const auto& vTracked = cCentroid.track( fnRender( 3.4, -2.6 ) );
+
+				const arc::gen3::image::Source_t* pTracked = vTracked.data();
+
+				for ( std::size_t i = 0; ( i + 1 ) < vTracked.size(); i++ )
+				{
+					fnCheck( vTracked[ i ], vOrder[ i ], 3.4, -2.6, "track()"s );
+				}
+
+				if ( vTracked.back().bValid || vTracked.back().gX != vGuide.back().first || vTracked.back().gY != vGuide.back().second )
+				{
+					throwArcGen3Error( "CArcCentroid::track() [ %u x %u ] found a star on blank sky!", uiCols, uiRows );
+				}
+
+				double gDx = 0.0, gDy = 0.0;
+
+				if ( cCentroid.offset( gDx, gDy ) != ( uiStars > 0 ) || std::fabs( gDx - ( uiStars > 0 ? 3.4 : 0.0 ) ) > 0.02 ||
+					 std::fabs( gDy - ( uiStars > 0 ? -2.6 : 0.0 ) ) > 0.02 )
+				{
+					throwArcGen3Error( "CArcCentroid::offset() [ %u x %u ] mismatch! Expected: 3.4, -2.6 Found: %f, %f", uiCols, uiRows, gDx, gDy );
+				}
+
+				if ( &cCentroid.find( fnRender( 3.4, -2.6 ) ) != &vFound || vFound.data() != pFound ||
+					 &cCentroid.track( fnRender( 0.0, 0.0 ) ) != &vTracked || vTracked.data() != pTracked )
+				{
+					throwArcGen3Error( "CArcCentroid [ %u x %u ] reallocated its results!", uiCols, uiRows );
+				}
+
+				fnCheckFound( vFound, uiMax, 3.4, -2.6 );
+			}
+
+			// A flat frame has no sources.
+			std::fill( vBuf.begin(), vBuf.end(), static_cast< T >( gLevel ) );
+
+			const arc::gen3::image::ImageView<const T> tFlat( vBuf.data(), uiCols, uiRows );
+
+			CArcCentroid<T> cCentroid;
+
+			if ( !cCentroid.find( tFlat ).empty() || cCentroid.measure( tFlat, ( uiCols / 2 ), ( uiRows / 2 ) ).bValid )
+			{
+				throwArcGen3Error( "CArcCentroid [ %u x %u ] found a source on a flat frame!", uiCols, uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyRamp                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies that checkRamp() accepts the output of fillWithRamp() and reports a corrupted pixel.            |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyRamp( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			std::vector<T> vBuf( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			CArcImage<T>::fillWithRamp( vBuf.data(), uiCols, uiRows, uiThreads );
+
+			const arc::gen3::image::ImageView<const T> tView( vBuf.data(), uiCols, uiRows );
+
+			arc::gen3::image::VerifyReport_t tReport = CArcImage<T>::checkRamp( tView, 0, CArcImage<T>::maxTVal(), uiThreads );
+
+			if ( tReport.uiErrors != 0 || tReport.uiPixels != vBuf.size() )
+			{
+				throwArcGen3Error( "CArcImage::checkRamp() [ %u x %u ] rejected fillWithRamp()! Errors: %J at [ %u, %u ] Pixels: %J", uiCols, uiRows,
+								   static_cast< unsigned long long >( tReport.uiErrors ), tReport.uiCol, tReport.uiRow,
+								   static_cast< unsigned long long >( tReport.uiPixels ) );
+			}
+
+			//
+			// A view of the lower rows continues the ramp of the rows above it
+			// ---------------------------------------------------------------------------
+			const std::uint32_t uiRow1 = ( uiRows / 2 );
+
+			const auto uiStart = static_cast< std::uint32_t >( ( static_cast< std::uint64_t >( uiRow1 ) * uiCols ) % CArcImage<T>::maxTVal() );
+
+			tReport = CArcImage<T>::checkRamp( tView.sub( 0, uiCols, uiRow1, uiRows ), uiStart, CArcImage<T>::maxTVal(), uiThreads );
+
+			if ( tReport.uiErrors != 0 )
+			{
+				throwArcGen3Error( "CArcImage::checkRamp( view ) [ %u x %u ] rejected rows %u to %u of fillWithRamp()! Errors: %J", uiCols, uiRows,
+								   uiRow1, uiRows, static_cast< unsigned long long >( tReport.uiErrors ) );
+			}
+
+			//
+			// A single corrupted pixel is reported with its position and values
+			// ---------------------------------------------------------------------------
+			const std::uint32_t uiCol = ( uiCols / 2 );
+			const std::uint32_t uiRow = ( uiRows / 2 );
+
+			T& rPixel = vBuf[ static_cast< std::size_t >( uiRow ) * uiCols + uiCol ];
+
+			const T uiGood = rPixel;
+
+			rPixel = static_cast< T >( uiGood + 1 );
+
+			tReport = CArcImage<T>::checkRamp( tView, 0, CArcImage<T>::maxTVal(), uiThreads );
+
+			if ( tReport.uiErrors != 1 || tReport.uiCol != uiCol || tReport.uiRow != uiRow ||
+				 tReport.uiExpected != static_cast< std::uint32_t >( uiGood ) || tReport.uiFound != static_cast< std::uint32_t >( rPixel ) )
+			{
+				throwArcGen3Error( "CArcImage::checkRamp() [ %u x %u ] misreported pixel [ %u, %u ]! Errors: %J at [ %u, %u ] Expected: %u Found: %u",
+								   uiCols, uiRows, uiCol, uiRow, static_cast< unsigned long long >( tReport.uiErrors ), tReport.uiCol, tReport.uiRow,
+								   tReport.uiExpected, tReport.uiFound );
+			}
+
+			//
+			// A short ramp and a constant, seen through a view into a wider buffer,
+			// with two corrupted pixels of which the first in raster order is reported
+			// ---------------------------------------------------------------------------
+			const std::uint32_t uiStride = ( uiCols + 3 );
+
+			std::vector<T> vWide( static_cast< std::size_t >( uiStride ) * uiRows, static_cast< T >( 1 ) );
+
+			const arc::gen3::image::ImageView<const T> tWide = arc::gen3::image::ImageView<const T>( vWide.data(), uiStride, uiRows ).sub( 2, ( uiCols + 2 ), 0, uiRows );
+
+			const std::size_t uiLast = ( vBuf.size() - 1 );
+
+			auto fnWidePixel = [ & ]( const std::size_t i ) -> T&
+			{
+				return vWide[ ( i / uiCols ) * uiStride + 2 + ( i % uiCols ) ];
+			};
+
+			for ( const bool bRamp : { true, false } )
+			{
+				auto fnExpected = [ & ]( const std::size_t i ) { return static_cast< T >( bRamp ? ( ( 3 + i ) % 10 ) : 9 ); };
+
+				auto fnCheck = [ & ] { return ( bRamp ? CArcImage<T>::checkRamp( tWide, 3, 10, uiThreads ) : CArcImage<T>::checkConstant( tWide, 9, uiThreads ) ); };
+
+				const char* pszWhat = ( bRamp ? "checkRamp( 3, 10 )" : "checkConstant( 9 )" );
+
+				for ( std::size_t i = 0; i < vBuf.size(); i++ )
+				{
+					fnWidePixel( i ) = fnExpected( i );
+				}
+
+				tReport = fnCheck();
+
+				if ( tReport.uiErrors != 0 || tReport.uiPixels != vBuf.size() )
+				{
+					throwArcGen3Error( "CArcImage::%s [ %u x %u ] rejected a valid view! Errors: %J at [ %u, %u ]", pszWhat, uiCols, uiRows,
+									   static_cast< unsigned long long >( tReport.uiErrors ), tReport.uiCol, tReport.uiRow );
+				}
+
+				fnWidePixel( uiLast / 3 ) = static_cast< T >( 11 );
+				fnWidePixel( uiLast ) = static_cast< T >( 12 );
+
+				tReport = fnCheck();
+
+				const std::uint64_t uiErrors = ( uiLast == 0 ? 1 : 2 );
+
+				if ( tReport.uiErrors != uiErrors || tReport.uiCol != ( ( uiLast / 3 ) % uiCols ) || tReport.uiRow != ( ( uiLast / 3 ) / uiCols ) ||
+					 tReport.uiExpected != fnExpected( uiLast / 3 ) || tReport.uiFound != static_cast< std::uint32_t >( uiLast == 0 ? 12 : 11 ) )
+				{
+					throwArcGen3Error( "CArcImage::%s [ %u x %u ] misreported corrupted pixels! Errors: %J at [ %u, %u ] Expected: %u Found: %u",
+									   pszWhat, uiCols, uiRows, static_cast< unsigned long long >( tReport.uiErrors ), tReport.uiCol, tReport.uiRow,
+									   tReport.uiExpected, tReport.uiFound );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyFrameVerifier                                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcFrameVerifier on a stream of three and a half frames pushed in pieces of one pixel, seven   |
+		// | pixels, a row and more than a frame, so the pieces straddle rows and frames. The default ramp, a short   |
+		// | ramp and a constant are each streamed clean and with a corrupted pixel in the second and third frames;   |
+		// | the report must count every pixel, complete frame and error, and locate the first error.                 |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyFrameVerifier( const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			const std::size_t uiFrame = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			const std::size_t uiPieces[] = { 1, 7, uiCols, ( uiFrame + 3 ) };
+
+			std::vector<T> vStream( ( uiFrame * 7 ) / 2 );
+
+			CArcFrameVerifier<T> cVerifier( uiCols, uiRows );
+
+			enum class e_Pattern { RAMP, SHORT_RAMP, CONSTANT };
+
+			for ( const auto ePattern : { e_Pattern::RAMP, e_Pattern::SHORT_RAMP, e_Pattern::CONSTANT } )
+			{
+				const char* pszWhat = "ramp";
+
+				std::uint64_t uiStart = 0, uiPeriod = CArcImage<T>::maxTVal();
+
+				if ( ePattern == e_Pattern::SHORT_RAMP )
+				{
+					pszWhat = "ramp( 3, 10 )";
+					uiStart = 3;
+					uiPeriod = 10;
+
+					cVerifier.setRamp( 3, 10 );
+				}
+
+				else if ( ePattern == e_Pattern::CONSTANT )
+				{
+					pszWhat = "constant( 9 )";
+					uiStart = 9;
+					uiPeriod = 0;
+
+					cVerifier.setConstant( 9 );
+				}
+
+				// The value of pixel i of every frame.
+				auto fnExpected = [ & ]( const std::size_t i ) { return static_cast< T >( uiPeriod == 0 ? uiStart : ( ( uiStart + i ) % uiPeriod ) ); };
+
+				for ( std::size_t i = 0; i < vStream.size(); i++ )
+				{
+					vStream[ i ] = fnExpected( i % uiFrame );
+				}
+
+				if ( ePattern == e_Pattern::RAMP )
+				{
+					for ( std::size_t i = 0; ( i + uiFrame ) <= vStream.size(); i += uiFrame )
+					{
+						CArcImage<T>::fillWithRamp( ( vStream.data() + i ), uiCols, uiRows );
+					}
+				}
+
+				for ( const bool bCorrupt : { false, true } )
+				{
+					// Pixel uiFrame / 2 + 1 of the second frame and the last pixel of the third.
+					const std::size_t uiBad1 = ( uiFrame + std::min( ( uiFrame / 2 + 1 ), ( uiFrame - 1 ) ) );
+					const std::size_t uiBad2 = ( 3 * uiFrame - 1 );
+
+					if ( bCorrupt )
+					{
+						vStream[ uiBad1 ] = static_cast< T >( fnExpected( uiBad1 % uiFrame ) + 1 );
+						vStream[ uiBad2 ] = static_cast< T >( fnExpected( uiBad2 % uiFrame ) + 1 );
+					}
+
+					cVerifier.reset();
+
+					for ( std::size_t i = 0, k = 0; i < vStream.size(); k++ )
+					{
+						const std::size_t uiCount = std::min( uiPieces[ k % std::size( uiPieces ) ], ( vStream.size() - i ) );
+
+						cVerifier.push( ( vStream.data() + i ), uiCount );
+
+						i += uiCount;
+					}
+
+					const arc::gen3::image::VerifyReport_t& tReport = cVerifier.report();
+
+					const std::size_t uiPixel = ( uiBad1 - uiFrame );
+
+					const bool bFirst = ( !bCorrupt || ( tReport.uiFrame == 1 && tReport.uiCol == ( uiPixel % uiCols ) && tReport.uiRow == ( uiPixel / uiCols ) &&
+														 tReport.uiExpected == fnExpected( uiPixel ) && tReport.uiFound == vStream[ uiBad1 ] ) );
+
+					if ( tReport.uiErrors != ( bCorrupt ? 2U : 0U ) || tReport.uiPixels != vStream.size() || tReport.uiFrames != 3 || !bFirst )
+					{
+						throwArcGen3Error( "CArcFrameVerifier %s [ %u x %u ] report mismatch! Errors: %J Pixels: %J Frames: %J First: frame %J [ %u, %u ] "
+										   "Expected: %u Found: %u", pszWhat, uiCols, uiRows, static_cast< unsigned long long >( tReport.uiErrors ),
+										   static_cast< unsigned long long >( tReport.uiPixels ), static_cast< unsigned long long >( tReport.uiFrames ),
+										   static_cast< unsigned long long >( tReport.uiFrame ), tReport.uiCol, tReport.uiRow, tReport.uiExpected,
+										   tReport.uiFound );
+					}
+				}
+			}
+
+			cVerifier.reset();
+
+			if ( cVerifier.report().uiErrors != 0 || cVerifier.report().uiPixels != 0 || cVerifier.report().uiFrames != 0 )
+			{
+				throwArcGen3Error( "CArcFrameVerifier::reset() [ %u x %u ] did not clear the report!", uiCols, uiRows );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyGenerators                                                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the pattern generators. fill() and fillWithGradient() are checked against brute force, and      |
+		// | fill() of a view must not touch the pixels around it. fillWithSmiley() must not depend on the thread     |
+		// | count, must match the brute force shading, which stays below maxTVal(), be blank outside the head and be |
+		// | mirror symmetric for an even width.                                                                      |
+		// | fillWithNoise() must depend only on the seed, with the bias, row and column patterns exactly separable,  |
+		// | the mean and noise of the model, and values clamped to 0 and maxTVal() - 1.                              |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyGenerators( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiThreads )
+		{
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			std::vector<T> vBuf( uiPixels );
+			std::vector<T> vOne( uiPixels );
+
+			CArcImage<T>::fill( vBuf.data(), uiCols, uiRows, static_cast< T >( 4321 ), uiThreads );
+
+			comparePixels( vBuf, []( std::size_t ) { return 4321; }, "CArcImage::fill()"s, uiCols, uiRows );
+
+			CArcImage<T>::fillWithGradient( vBuf.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vBuf, [ & ]( std::size_t i )
+			{
+				return static_cast< T >( ( CArcImage<T>::maxTVal() - 1 ) / uiRows * ( i / uiCols ) );
+			}, "CArcImage::fillWithGradient()"s, uiCols, uiRows );
+
+			//
+			// fill() of a view writes only the view
+			// ---------------------------------------------------------------------------
+			{
+				const arc::gen3::image::Roi_t tRoi = innerRoi( uiCols, uiRows );
+
+				std::vector<T> vView( uiPixels, static_cast< T >( 3 ) );
+
+				const arc::gen3::image::ImageView<T> tView = arc::gen3::image::ImageView<T>( vView.data(), uiCols, uiRows ).sub( tRoi );
+
+				if ( tView.size() > 0 )
+				{
+					CArcImage<T>::fill( tView, static_cast< T >( 5 ) );
+				}
+
+				comparePixels( vView, [ & ]( std::size_t i )
+				{
+					const std::uint32_t c = static_cast< std::uint32_t >( i % uiCols ), r = static_cast< std::uint32_t >( i / uiCols );
+
+					return ( ( c >= tRoi.uiCol1 && c < tRoi.uiCol2 && r >= tRoi.uiRow1 && r < tRoi.uiRow2 ) ? 5 : 3 );
+				}, "CArcImage::fill( ImageView )"s, uiCols, uiRows );
+			}
+
+			//
+			// The smiley face
+			// ---------------------------------------------------------------------------
+			CArcImage<T>::fillWithSmiley( vOne.data(), uiCols, uiRows, 1 );
+			CArcImage<T>::fillWithSmiley( vBuf.data(), uiCols, uiRows, uiThreads );
+
+			comparePixels( vBuf, [ & ]( std::size_t i ) { return vOne[ i ]; }, "CArcImage::fillWithSmiley() threads"s, uiCols, uiRows );
+
+			// The head is shaded from radius + ( maxTVal() - 1 ) / radius - 1 at the center, which is at most
+			// maxTVal() - 1, down by one per pixel of distance. Only the eyes and mouth are cut out of it.
+			const double gHead = ( std::min( uiCols, uiRows ) / 2.0 - 10.0 );
+
+			const std::uint32_t uiRadius = ( gHead >= 1.0 ? static_cast< std::uint32_t >( gHead ) : 0 );
+
+			comparePixels( vBuf, [ & ]( std::size_t i )
+			{
+				const double gDx = ( ( i % uiCols ) + 0.5 - ( uiCols / 2 ) );
+				const double gDy = ( ( i / uiCols ) + 0.5 - ( uiRows / 2 ) );
+
+				const double gDist = std::sqrt( gDx * gDx + gDy * gDy );
+
+				if ( uiRadius == 0 || gDist >= uiRadius || vBuf[ i ] == 0 )
+				{
+					return 0U;
+				}
+
+				return ( uiRadius + ( CArcImage<T>::maxTVal() - 1 ) / uiRadius - std::max( 1U, static_cast< std::uint32_t >( gDist ) ) );
+			}, "CArcImage::fillWithSmiley() shading"s, uiCols, uiRows );
+
+			if ( ( uiCols % 2 ) == 0 )
+			{
+				comparePixels( vBuf, [ & ]( std::size_t i )
+				{
+					return vBuf[ ( i / uiCols ) * uiCols + ( uiCols - 1 - i % uiCols ) ];
+				}, "CArcImage::fillWithSmiley() symmetry"s, uiCols, uiRows );
+			}
+
+			if ( uiRadius > 0 && std::all_of( vBuf.begin(), vBuf.end(), []( T tValue ) { return ( tValue == 0 ); } ) )
+			{
+				throwArcGen3Error( "CArcImage::fillWithSmiley() [ %u x %u ] drew nothing!", uiCols, uiRows );
+			}
+
+			//
+			// The noise generator
+			// ---------------------------------------------------------------------------
+			arc::gen3::image::NoiseModel_t tModel = { 1000.0, 2.0, 8.0, 100.0, 0.0, 0.0 };
+
+			CArcImage<T>::fillWithNoise( vOne.data(), uiCols, uiRows, tModel, 17, 1 );
+			CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 17, uiThreads );
+
+			comparePixels( vBuf, [ & ]( std::size_t i ) { return vOne[ i ]; }, "CArcImage::fillWithNoise() threads"s, uiCols, uiRows );
+
+			if ( uiPixels >= 16 )
+			{
+				for ( const std::uint64_t uiSeed : { 18ULL, ( 17ULL + ( 1ULL << 32 ) ) } )
+				{
+					CArcImage<T>::fillWithNoise( vOne.data(), uiCols, uiRows, tModel, uiSeed, uiThreads );
+
+					if ( vOne == vBuf )
+					{
+						throwArcGen3Error( "CArcImage::fillWithNoise() [ %u x %u ] seeds 17 and %J made the same frame!", uiCols, uiRows,
+										   static_cast< unsigned long long >( uiSeed ) );
+					}
+				}
+			}
+
+			if ( uiPixels >= 100 )
+			{
+				const arc::gen3::image::CStats cStats = bruteStats( vBuf.data(), uiCols, { 0, uiCols, 0, uiRows } );
+
+				const double gSigma = ( std::sqrt( tModel.gSignal + tModel.gReadNoise * tModel.gReadNoise ) / tModel.gGain );
+				const double gMean = ( tModel.gBias + tModel.gSignal / tModel.gGain );
+
+				if ( std::fabs( cStats.gMean - gMean ) > ( 5.0 * gSigma / std::sqrt( static_cast< double >( uiPixels ) ) ) ||
+					 std::fabs( cStats.gStdDev / std::sqrt( gSigma * gSigma + 1.0 / 12.0 ) - 1.0 ) > ( 5.0 / std::sqrt( 2.0 * uiPixels ) ) )
+				{
+					throwArcGen3Error( "CArcImage::fillWithNoise() [ %u x %u ] statistics mismatch! Expected: %f +/- %f Found: %f +/- %f", uiCols,
+									   uiRows, gMean, gSigma, cStats.gMean, cStats.gStdDev );
+				}
+			}
+
+			// Without pixel noise the row and column offsets are exactly separable; the bias is rounded.
+			tModel = { 1000.0, 2.0, 0.0, 0.0, 0.0, 0.0 };
+
+			CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 17, uiThreads );
+
+			comparePixels( vBuf, []( std::size_t ) { return 1000; }, "CArcImage::fillWithNoise() bias"s, uiCols, uiRows );
+
+			tModel.gRowNoise = 20.0;
+
+			CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 17, uiThreads );
+
+			comparePixels( vBuf, [ & ]( std::size_t i ) { return vBuf[ i - i % uiCols ]; }, "CArcImage::fillWithNoise() row offsets"s, uiCols, uiRows );
+
+			tModel.gRowNoise = 0.0;
+			tModel.gColumnNoise = 20.0;
+
+			CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 17, uiThreads );
+
+			comparePixels( vBuf, [ & ]( std::size_t i ) { return vBuf[ i % uiCols ]; }, "CArcImage::fillWithNoise() column offsets"s, uiCols, uiRows );
+
+			if ( uiPixels >= 16 && std::all_of( vBuf.begin(), vBuf.end(), [ & ]( T tValue ) { return ( tValue == vBuf[ 0 ] ); } ) )
+			{
+				throwArcGen3Error( "CArcImage::fillWithNoise() [ %u x %u ] made no column pattern!", uiCols, uiRows );
+			}
+
+			// Values clamp to 0 and maxTVal() - 1, and about half the pixels of a level at either limit reach it.
+			for ( const double gBias : { 0.0, static_cast< double >( CArcImage<T>::maxTVal() - 1 ) } )
+			{
+				tModel = { gBias, 1.0, 50.0, 0.0, 0.0, 0.0 };
+
+				CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 17, uiThreads );
+
+				const auto uiLimit = static_cast< T >( gBias );
+
+				const std::size_t uiAtLimit = static_cast< std::size_t >( std::count( vBuf.begin(), vBuf.end(), uiLimit ) );
+
+				const bool bBeyond = std::any_of( vBuf.begin(), vBuf.end(), [ & ]( T tValue )
+				{
+					return ( tValue > ( CArcImage<T>::maxTVal() - 1 ) || ( gBias > 0.0 ? ( tValue < gBias - 500.0 ) : ( tValue > 500 ) ) );
+				} );
+
+				if ( bBeyond || ( uiPixels >= 100 && ( uiAtLimit < uiPixels / 4 || uiAtLimit > ( 3 * uiPixels ) / 4 ) ) )
+				{
+					throwArcGen3Error( "CArcImage::fillWithNoise() [ %u x %u ] bias %f not clamped! %J of %J pixels at the limit", uiCols, uiRows,
+									   gBias, static_cast< unsigned long long >( uiAtLimit ), static_cast< unsigned long long >( uiPixels ) );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyThreads                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies the thread pool primitives. parallelForBlocks() must call every block once and split the range  |
+		// | into contiguous blocks, in block order, whose sizes differ by at most one, for empty ranges and for more |
+		// | blocks than rows. A block exception must reach the caller and leave the pool usable, and a pool must run |
+		// | as many tasks at once as it has workers plus the caller. parallelReduce() must combine in block order,   |
+		// | threadCount( 0 ) must follow the executor, and the library must run on an executor set by the caller.    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImageTest<T>::verifyThreads( void )
+		{
+			CArcThreadPool cPool( 3 );
+
+			for ( IArcExecutor* pExecutor : { static_cast< IArcExecutor* >( &cPool ), &CArcThreadPool::executor() } )
+			{
+				const std::uint32_t uiRanges[][ 3 ] = { { 0, 0, 4 }, { 5, 5, 4 }, { 7, 3, 4 }, { 0, 1, 4 }, { 3, 10, 0 }, { 3, 10, 1 },
+														 { 2, 5, 8 }, { 0, 1000, 7 }, { 10, 1033, 3 }, { 0, 64, 64 } };
+
+				for ( const auto& uiRange : uiRanges )
+				{
+					const std::uint32_t uiBegin = uiRange[ 0 ], uiEnd = uiRange[ 1 ];
+					const std::uint32_t uiCount = ( uiEnd > uiBegin ? ( uiEnd - uiBegin ) : 0 );
+					const std::uint32_t uiExpected = std::max( 1U, std::min( uiRange[ 2 ], uiCount ) );
+
+					std::vector<std::atomic<std::uint32_t>> vCalls( uiExpected + 1 );
+					std::vector<std::pair<std::uint32_t, std::uint32_t>> vBlocks( uiExpected + 1 );
+
+					const std::uint32_t uiBlocks = pExecutor->parallelForBlocks( uiBegin, uiEnd, uiRange[ 2 ], [ & ]( std::uint32_t uiBlock, std::uint32_t uiFirst, std::uint32_t uiLast )
+					{
+						const std::uint32_t b = std::min( uiBlock, uiExpected );
+
+						vCalls[ b ]++;
+						vBlocks[ b ] = std::make_pair( uiFirst, uiLast );
+					} );
+
+					std::uint32_t uiNext = uiBegin;
+					std::uint32_t uiMin = std::numeric_limits<std::uint32_t>::max(), uiMax = 0;
+
+					bool bMatch = ( uiBlocks == uiExpected && vCalls[ uiExpected ] == 0 );
+
+					for ( std::uint32_t b = 0; b < uiExpected && bMatch; b++ )
+					{
+						bMatch = ( vCalls[ b ] == 1 && vBlocks[ b ].first == uiNext && vBlocks[ b ].second >= vBlocks[ b ].first );
+
+						uiMin = std::min( uiMin, ( vBlocks[ b ].second - vBlocks[ b ].first ) );
+						uiMax = std::max( uiMax, ( vBlocks[ b ].second - vBlocks[ b ].first ) );
+
+						uiNext = vBlocks[ b ].second;
+					}
+
+					if ( !bMatch || uiNext != ( uiBegin + uiCount ) || ( uiMax - uiMin ) > 1 )
+					{
+						throwArcGen3Error( "IArcExecutor::parallelForBlocks( %u, %u, %u ) [ %u threads ] partition mismatch! Expected %u blocks, found %u",
+										   uiBegin, uiEnd, uiRange[ 2 ], pExecutor->concurrency(), uiExpected, uiBlocks );
+					}
+				}
+
+				//
+				// A block exception reaches the caller and the pool keeps working
+				// ---------------------------------------------------------------------------
+				for ( std::uint32_t uiThrower = 0; uiThrower < 4; uiThrower++ )
+				{
+					std::string sCaught;
+
+					try
+					{
+						pExecutor->parallelForBlocks( 0, 100, 4, [ & ]( std::uint32_t uiBlock, std::uint32_t, std::uint32_t )
+						{
+							if ( uiBlock == uiThrower )
+							{
+								throw std::range_error( "block "s + std::to_string( uiBlock ) );
+							}
+						} );
+					}
+					catch ( const std::range_error& e )
+					{
+						sCaught = e.what();
+					}
+
+					if ( sCaught != ( "block "s + std::to_string( uiThrower ) ) )
+					{
+						throwArcGen3Error( "IArcExecutor::parallelForBlocks() [ %u threads ] lost the exception of block %u! Caught: \"%s\"",
+										   pExecutor->concurrency(), uiThrower, sCaught.c_str() );
+					}
+				}
+
+				//
+				// Partial results combine in block order, and nested loops complete
+				// ---------------------------------------------------------------------------
+				const std::vector<std::uint32_t> vOrder = pExecutor->parallelReduce( 0, 1000, 7, std::vector<std::uint32_t>(),
+																					 [ & ]( std::vector<std::uint32_t>& vPartial, std::uint32_t uiFirst, std::uint32_t uiLast )
+				{
+					std::atomic<std::uint32_t> uiInner( 0 );
+
+					pExecutor->parallelFor( 4, [ & ]( std::uint32_t ) { uiInner++; } );
+
+					for ( std::uint32_t i = uiFirst; i < uiLast && uiInner == 4; i++ )
+					{
+						vPartial.push_back( i );
+					}
+				}, []( std::vector<std::uint32_t>& vResult, const std::vector<std::uint32_t>& vPartial )
+				{
+					vResult.insert( vResult.end(), vPartial.begin(), vPartial.end() );
+				} );
+
+				for ( std::uint32_t i = 0; i < 1000; i++ )
+				{
+					if ( vOrder.size() != 1000 || vOrder[ i ] != i )
+					{
+						throwArcGen3Error( "IArcExecutor::parallelReduce() [ %u threads ] combined out of block order at %u!", pExecutor->concurrency(), i );
+					}
+				}
+			}
+
+			//
+			// The pool runs a task on every worker and the caller at once
+			// ---------------------------------------------------------------------------
+			{
+				std::mutex tMutex;
+				std::condition_variable tAll;
+				std::uint32_t uiArrived = 0;
+				std::uint32_t uiTimedOut = 0;
+
+				const std::uint32_t uiTasks = ( cPool.concurrency() + 1 );
+
+				cPool.parallelFor( uiTasks, [ & ]( std::uint32_t )
+				{
+					std::unique_lock<std::mutex> tLock( tMutex );
+
+					if ( ++uiArrived == uiTasks )
+					{
+						tAll.notify_all();
+					}
+
+					else if ( !tAll.wait_for( tLock, std::chrono::seconds( 10 ), [ & ] { return ( uiArrived == uiTasks ); } ) )
+					{
+						uiTimedOut++;
+					}
+				} );
+
+				if ( uiTimedOut > 0 )
+				{
+					throwArcGen3Error( "CArcThreadPool [ %u threads ] did not run %u tasks at once!", cPool.concurrency(), uiTasks );
+				}
+			}
+
+			//
+			// threadCount() and forEachRowBlock() follow the executor set by the caller
+			// ---------------------------------------------------------------------------
+			class CCountingExecutor : public IArcExecutor
+			{
+				public:
+					std::uint32_t concurrency( void ) const noexcept override { return 5; }
+
+					void parallelFor( const std::uint32_t uiCount, const std::function<void( std::uint32_t )>& fnTask ) override
+					{
+						m_uiCalls++;
+
+						for ( std::uint32_t i = 0; i < uiCount; i++ )
+						{
+							fnTask( i );
+						}
+					}
+
+					std::uint32_t m_uiCalls = 0;
+			};
+
+			CCountingExecutor cCounting;
+
+			IArcExecutor& rPrevious = CArcThreadPool::executor();
+
+			CArcThreadPool::setExecutor( &cCounting );
+
+			const std::uint32_t uiCountAuto = CArcImage<T>::threadCount( 0 );
+			const std::uint32_t uiCountTwo = CArcImage<T>::threadCount( 2 );
+
+			const std::uint32_t uiBlocks = CArcImage<T>::forEachRowBlock( 0, 100, 0, []( std::uint32_t, std::uint32_t, std::uint32_t ) {} );
+
+			std::string sCaught;
+
+			try
+			{
+				CArcImage<T>::forEachRowBlock( 0, 100, 4, []( std::uint32_t uiBlock, std::uint32_t, std::uint32_t )
+				{
+					if ( uiBlock == 3 )
+					{
+						throw std::range_error( "row block 3" );
+					}
+				} );
+			}
+			catch ( const std::range_error& e )
+			{
+				sCaught = e.what();
+			}
+
+			CArcThreadPool::setExecutor( &rPrevious );
+
+			if ( uiCountAuto != 5 || uiCountTwo != 2 || uiBlocks != 5 || cCounting.m_uiCalls != 2 || sCaught != "row block 3" )
+			{
+				throwArcGen3Error( "CArcImage::threadCount() / forEachRowBlock() ignored the executor! threadCount( 0 ): %u threadCount( 2 ): %u "
+								   "Blocks: %u Executor calls: %u Caught: \"%s\"", uiCountAuto, uiCountTwo, uiBlocks, cCounting.m_uiCalls, sCaught.c_str() );
+			}
+
+			if ( CArcImage<T>::threadCount( 0 ) != std::max( 1U, CArcThreadPool::executor().concurrency() ) )
+			{
+				throwArcGen3Error( "CArcImage::threadCount( 0 ) [ %u ] does not match the executor [ %u ]!", CArcImage<T>::threadCount( 0 ),
+								   CArcThreadPool::executor().concurrency() );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyRampFit                                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies CArcRampFit against a direct least-squares fit of each pixel's reads. Each pixel is a line with |
+		// | a small deterministic wobble; every eleventh pixel climbs steeply to, or to one below, the saturation    |
+		// | level at the fourth read. The fitter is then cleared and given a second ramp with jump detection, where  |
+		// | some pixels step up by 500 ADU part way; those are checked against the weighted average of a direct fit  |
+		// | of each segment.                                                                                         |
+		// |                                                                                                          |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |  <IN>  -> uiReads		- The number of reads.                                                            |
+		// |  <IN>  -> uiThreads	- The number of threads.                                                          |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::verifyRampFit( const std::uint32_t uiCols, const std::uint32_t uiRows, const std::uint32_t uiReads, const std::uint32_t uiThreads )
+		{
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			const double gReadTime = 2.0;
+
+			const T uiSaturation = static_cast< T >( 30000 );
+
+			const double gJump = 500.0;
+
+			// The steep pixels reach the saturation level, or one below it, exactly at the fourth read
+			const auto fnRead = [ & ]( std::size_t i, std::uint32_t k )
+			{
+				const std::uint64_t uiWobble = ( testValue<T>( ( i * uiReads + k ), 7 ) % 5 );
+
+				if ( ( i % 11 ) == 0 )
+				{
+					return static_cast< T >( uiSaturation - ( ( i / 11 ) % 2 ) - 9000 + 3000 * k + ( k < 3 ? uiWobble : 0 ) );
+				}
+
+				return static_cast< T >( 100 + ( i % 1000 ) + ( ( i % 37 ) + 1 ) * k + uiWobble );
+			};
+
+			// The reads at which the second ramp steps up; one jump at the sixth read or two at the fourth and tenth
+			const auto fnJumps = []( std::size_t i ) -> std::vector<std::uint32_t>
+			{
+				if ( ( i % 13 ) == 0 )
+				{
+					return { 6 };
+				}
+
+				if ( ( i % 13 ) == 5 )
+				{
+					return { 3, 9 };
+				}
+
+				return {};
+			};
+
+			const auto fnJumpRead = [ & ]( std::size_t i, std::uint32_t k )
+			{
+				const std::vector<std::uint32_t> vJumps = fnJumps( i );
+
+				const auto uiSteps = std::count_if( vJumps.begin(), vJumps.end(), [ k ]( std::uint32_t uiJump ) { return ( uiJump <= k ); } );
+
+				const std::uint64_t uiWobble = ( testValue<T>( ( i * uiReads + k ), 8 ) % 5 );
+
+				return static_cast< T >( 100 + ( i % 1000 ) + ( ( i % 37 ) + 1 ) * k + uiWobble + static_cast< std::uint64_t >( gJump ) * uiSteps );
+			};
+
+			// Least-squares slope and intercept at the first read of reads [ uiFirst, uiLast ), with uiLast > uiFirst + 1
+			const auto fnLine = []( const auto& fnValue, std::uint32_t uiFirst, std::uint32_t uiLast, double& gSlope, double& gIntercept )
+			{
+				const double gN = static_cast< double >( uiLast - uiFirst );
+				const double gMeanK = ( ( gN - 1.0 ) / 2.0 );
+
+				double gMeanY = 0.0;
+
+				for ( std::uint32_t k = uiFirst; k < uiLast; k++ )
+				{
+					gMeanY += static_cast< double >( fnValue( k ) );
+				}
+
+				gMeanY /= gN;
+
+				double gSxy = 0.0, gSxx = 0.0;
+
+				for ( std::uint32_t k = uiFirst; k < uiLast; k++ )
+				{
+					const double gK = static_cast< double >( k - uiFirst );
+
+					gSxy += ( ( gK - gMeanK ) * ( static_cast< double >( fnValue( k ) ) - gMeanY ) );
+					gSxx += ( ( gK - gMeanK ) * ( gK - gMeanK ) );
+				}
+
+				gSlope = ( gSxy / gSxx );
+				gIntercept = ( gMeanY - gSlope * gMeanK );
+			};
+
+			const auto fnCheck = [ & ]( const char* szRamp, const std::vector<float>& vSlope, const std::vector<float>& vIntercept, const std::vector<std::uint8_t>& vQuality,
+										std::size_t i, double gSlope, double gIntercept, std::uint8_t uiQuality )
+			{
+				if ( vQuality[ i ] != uiQuality || !isClose( vSlope[ i ], gSlope, 1e-5 ) || !isClose( vIntercept[ i ], gIntercept, 1e-5 ) )
+				{
+					throwArcGen3Error( "CArcRampFit::fit()%s [ %u x %u ] %u reads mismatch at pixel [ %u, %u ]! Expected: %f, %f, %u Found: %f, %f, %u",
+									   szRamp, uiCols, uiRows, uiReads, static_cast< std::uint32_t >( i % uiCols ), static_cast< std::uint32_t >( i / uiCols ),
+									   gSlope, gIntercept, static_cast< std::uint32_t >( uiQuality ), static_cast< double >( vSlope[ i ] ),
+									   static_cast< double >( vIntercept[ i ] ), static_cast< std::uint32_t >( vQuality[ i ] ) );
+				}
+			};
+
+			CArcRampFit<T> cFit( uiCols, uiRows );
+
+			cFit.setReadTime( gReadTime );
+
+			cFit.setSaturation( uiSaturation );
+
+			std::vector<T> vRead( uiPixels );
+
+			for ( std::uint32_t k = 0; k < uiReads; k++ )
+			{
+				for ( std::size_t i = 0; i < uiPixels; i++ )
+				{
+					vRead[ i ] = fnRead( i, k );
+				}
+
+				cFit.add( vRead.data(), uiThreads );
+			}
+
+			if ( cFit.count() != uiReads )
+			{
+				throwArcGen3Error( "CArcRampFit::count() [ %u x %u ] mismatch! Expected: %u Found: %u", uiCols, uiRows, uiReads, cFit.count() );
+			}
+
+			std::vector<float> vSlope( uiPixels );
+			std::vector<float> vIntercept( uiPixels );
+			std::vector<std::uint8_t> vQuality( uiPixels );
+
+			cFit.fit( vSlope.data(), vIntercept.data(), vQuality.data(), uiThreads );
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				//
+				// Least-squares line through the reads below saturation
+				// --------------------------------------------------------------------
+				std::uint32_t uiUsable = 0;
+
+				while ( uiUsable < uiReads && fnRead( i, uiUsable ) < uiSaturation )
+				{
+					uiUsable++;
+				}
+
+				std::uint8_t uiQuality = ( uiUsable < uiReads ? arc::gen3::image::RAMP_SATURATED : 0 );
+
+				double gSlope = 0.0;
+				double gIntercept = static_cast< double >( fnRead( i, 0 ) );
+
+				if ( uiUsable >= 2 )
+				{
+					fnLine( [ & ]( std::uint32_t k ) { return fnRead( i, k ); }, 0, uiUsable, gSlope, gIntercept );
+
+					gSlope /= gReadTime;
+				}
+
+				else
+				{
+					uiQuality |= arc::gen3::image::RAMP_NO_SLOPE;
+				}
+
+				fnCheck( "", vSlope, vIntercept, vQuality, i, gSlope, gIntercept, uiQuality );
+			}
+
+			//
+			// Second ramp with jump detection, after clearing the first
+			// --------------------------------------------------------------------
+			cFit.clear();
+
+			if ( cFit.count() != 0 )
+			{
+				throwArcGen3Error( "CArcRampFit::clear() [ %u x %u ] left %u reads!", uiCols, uiRows, cFit.count() );
+			}
+
+			cFit.setJumpDetection( 5.0, 2.0 );
+
+			for ( std::uint32_t k = 0; k < uiReads; k++ )
+			{
+				for ( std::size_t i = 0; i < uiPixels; i++ )
+				{
+					vRead[ i ] = fnJumpRead( i, k );
+				}
+
+				cFit.add( vRead.data(), uiThreads );
+			}
+
+			cFit.fit( vSlope.data(), vIntercept.data(), vQuality.data(), uiThreads );
+
+			for ( std::size_t i = 0; i < uiPixels; i++ )
+			{
+				const auto fnValue = [ & ]( std::uint32_t k ) { return fnJumpRead( i, k ); };
+
+				std::vector<std::uint32_t> vBounds = { 0 };
+
+				for ( auto uiJump : fnJumps( i ) )
+				{
+					if ( uiJump < uiReads )
+					{
+						vBounds.push_back( uiJump );
+					}
+				}
+
+				vBounds.push_back( uiReads );
+
+				std::uint8_t uiQuality = ( vBounds.size() > 2 ? arc::gen3::image::RAMP_JUMP : 0 );
+
+				double gSlopeSum = 0.0;
+				double gWeightSum = 0.0;
+				double gIntercept = static_cast< double >( fnValue( 0 ) );
+
+				for ( std::size_t s = 0; ( s + 1 ) < vBounds.size(); s++ )
+				{
+					const double gN = static_cast< double >( vBounds[ s + 1 ] - vBounds[ s ] );
+
+					if ( gN >= 2.0 )
+					{
+						double gSlope = 0.0;
+						double gSegIntercept = 0.0;
+
+						fnLine( fnValue, vBounds[ s ], vBounds[ s + 1 ], gSlope, gSegIntercept );
+
+						gSlopeSum += ( gN * ( gN * gN - 1.0 ) * gSlope );
+						gWeightSum += ( gN * ( gN * gN - 1.0 ) );
+
+						if ( s == 0 )
+						{
+							gIntercept = gSegIntercept;
+						}
+					}
+				}
+
+				double gSlope = 0.0;
+
+				if ( gWeightSum > 0.0 )
+				{
+					gSlope = ( ( gSlopeSum / gWeightSum ) / gReadTime );
+				}
+
+				else
+				{
+					uiQuality |= arc::gen3::image::RAMP_NO_SLOPE;
+				}
+
+				fnCheck( " with jumps", vSlope, vIntercept, vQuality, i, gSlope, gIntercept, uiQuality );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyEmpty                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Verifies that images with zero rows or columns are rejected.                                             |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImageTest<T>::verifyEmpty( void )
+		{
+			const std::uint32_t uiDims[][ 2 ] = { { 8, 0 }, { 0, 8 }, { 0, 0 } };
+
+			std::vector<T> vBuf( 64, static_cast< T >( 7 ) );
+			std::vector<std::uint64_t> vSum( 64 );
+
+			expectThrow( "CArcImage::bin() factor 0"s, [ & ] { CArcImage<T>::bin( arc::gen3::image::ImageView<const T>( vBuf.data(), 8, 8 ), 0, vSum.data() ); } );
+			expectThrow( "CArcImage::bin() factor 257"s, [ & ] { CArcImage<T>::bin( arc::gen3::image::ImageView<const T>( vBuf.data(), 8, 8 ), 257, vSum.data() ); } );
+			expectThrow( "CArcImage::add( nullptr )"s, [ & ] { CArcImage<T>::add( static_cast< T* >( nullptr ), vBuf.data(), vBuf.data(), 8, 8 ); } );
+
+			CArcStack<T> cStack( 8, 8 );
+
+			std::vector<float> vReal( 64 );
+
+			expectThrow( "CArcStack::mean() of an empty stack"s, [ & ] { cStack.mean( vReal.data() ); } );
+			expectThrow( "CArcStack::variance() of an empty stack"s, [ & ] { cStack.variance( vReal.data() ); } );
+			expectThrow( "CArcStack::add( nullptr )"s, [ & ] { cStack.add( nullptr ); } );
+
+			CArcDisplayScale<T> cScale;
+
+			expectThrow( "CArcDisplayScale::setPercentile( 50, 50 )"s, [ & ] { cScale.setPercentile( 50.0, 50.0 ); } );
+			expectThrow( "CArcDisplayScale::setPercentile( -1, 50 )"s, [ & ] { cScale.setPercentile( -1.0, 50.0 ); } );
+			expectThrow( "CArcDisplayScale::setPercentile( 1, 101 )"s, [ & ] { cScale.setPercentile( 1.0, 101.0 ); } );
+			expectThrow( "CArcDisplayScale::setLimits( 5, 5 )"s, [ & ] { cScale.setLimits( 5.0, 5.0 ); } );
+			expectThrow( "CArcDisplayScale::setStretch( LOG, -1 )"s, [ & ] { cScale.setStretch( arc::gen3::image::e_Stretch::LOG, -1.0 ); } );
+			expectThrow( "CArcDisplayScale::setSampleSize( 0 )"s, [ & ] { cScale.setSampleSize( 0 ); } );
+			expectThrow( "CArcDisplayScale::setZScale( 0 )"s, [ & ] { cScale.setZScale( 0.0 ); } );
+			expectThrow( "CArcDisplayScale::scale( nullptr )"s, [ & ] { cScale.scale( vBuf.data(), 8, 8, nullptr ); } );
+
+			CArcCentroid<T> cCentroid;
+
+			expectThrow( "CArcCentroid::CArcCentroid( 0 )"s, [ & ] { CArcCentroid<T> cNone( 0 ); } );
+			expectThrow( "CArcCentroid::setBox( 1 )"s, [ & ] { cCentroid.setBox( 1 ); } );
+			expectThrow( "CArcCentroid::setBox( 33 )"s, [ & ] { cCentroid.setBox( CArcCentroid<T>::HALF_WIDTH_MAX + 1 ); } );
+			expectThrow( "CArcCentroid::setThreshold( 0 )"s, [ & ] { cCentroid.setThreshold( 0.0 ); } );
+
+			arc::gen3::image::NoiseModel_t tModel = { 100.0, 0.0, 5.0, 0.0, 0.0, 0.0 };
+
+			expectThrow( "CArcImage::fillWithNoise() gain 0"s, [ & ] { CArcImage<T>::fillWithNoise( vBuf.data(), 8, 8, tModel, 1 ); } );
+
+			tModel.gGain = 1.0;
+			tModel.gReadNoise = -1.0;
+
+			expectThrow( "CArcImage::fillWithNoise() read noise -1"s, [ & ] { CArcImage<T>::fillWithNoise( vBuf.data(), 8, 8, tModel, 1 ); } );
+
+			tModel.gReadNoise = 5.0;
+
+			if constexpr ( sizeof( T ) > sizeof( std::uint16_t ) )
+			{
+				expectThrow( "CArcImage::fill() maxTVal()"s, [ & ] { CArcImage<T>::fill( vBuf.data(), 8, 8, static_cast< T >( CArcImage<T>::maxTVal() ) ); } );
+			}
+
+			CArcFrameVerifier<T> cVerifier( 8, 8 );
+
+			expectThrow( "CArcFrameVerifier::setRamp( 0, 0 )"s, [ & ] { cVerifier.setRamp( 0, 0 ); } );
+			expectThrow( "CArcFrameVerifier::setRamp( 10, 10 )"s, [ & ] { cVerifier.setRamp( 10, 10 ); } );
+			expectThrow( "CArcFrameVerifier::setRamp() past the data type"s, [ & ]
+			{
+				cVerifier.setRamp( 0, ( static_cast< std::uint64_t >( std::numeric_limits<T>::max() ) + 2 ) );
+			} );
+			expectThrow( "CArcFrameVerifier::push( nullptr )"s, [ & ] { cVerifier.push( nullptr, 8 ); } );
+			expectThrow( "CArcImage::checkRamp( 10, 10 )"s, [ & ]
+			{
+				CArcImage<T>::checkRamp( arc::gen3::image::ImageView<const T>( vBuf.data(), 8, 8 ), 10, 10 );
+			} );
+
+			CArcRampFit<T> cFit( 8, 8 );
+
+			expectThrow( "CArcRampFit::fit() without reads"s, [ & ] { cFit.fit( vReal.data() ); } );
+			expectThrow( "CArcRampFit::setReadTime( 0 )"s, [ & ] { cFit.setReadTime( 0.0 ); } );
+			expectThrow( "CArcRampFit::setJumpDetection( -1, 2 )"s, [ & ] { cFit.setJumpDetection( -1.0, 2.0 ); } );
+			expectThrow( "CArcRampFit::setJumpDetection( 5, -1 )"s, [ & ] { cFit.setJumpDetection( 5.0, -1.0 ); } );
+			expectThrow( "CArcRampFit::setJumpDetection( 5, 2, 0 )"s, [ & ] { cFit.setJumpDetection( 5.0, 2.0, 0.0 ); } );
+			expectThrow( "CArcRampFit::add( nullptr )"s, [ & ] { cFit.add( nullptr ); } );
+
+			cFit.add( vBuf.data() );
+
+			expectThrow( "CArcRampFit::fit( nullptr )"s, [ & ] { cFit.fit( nullptr ); } );
+
+			cFit.clear();
+
+			expectThrow( "CArcRampFit::fit() after clear()"s, [ & ] { cFit.fit( vReal.data() ); } );
+
+			for ( const auto& uiDim : uiDims )
+			{
+				const std::uint32_t uiCols = uiDim[ 0 ];
+				const std::uint32_t uiRows = uiDim[ 1 ];
+
+				std::uint32_t uiCount = 0;
+
+				const arc::gen3::image::ImageView<const T> tView( vBuf.data(), uiCols, uiRows );
+
+				const std::string sDim = CArcBase::formatString( " [ %u x %u ]", uiCols, uiRows );
+
+				expectThrow( "CArcImage::getStats()"s + sDim, [ & ] { CArcImage<T>::getStats( vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::channelGrid()"s + sDim, [ & ] { CArcImage<T>::channelGrid( uiCols, uiRows, 1, 1 ); } );
+				expectThrow( "CArcImage::histogram()"s + sDim, [ & ] { CArcImage<T>::histogram( vBuf.data(), uiCols, uiRows, uiCount ); } );
+				expectThrow( "CArcImage::getProfiles()"s + sDim, [ & ] { CArcImage<T>::getProfiles( vBuf.data(), uiCols, uiRows, {} ); } );
+				expectThrow( "CArcImage::getStats( masked )"s + sDim, [ & ]
+				{
+					CArcImage<T>::getStats( vBuf.data(), uiCols, uiRows, arc::gen3::image::CBitMask( uiCols, uiRows ) );
+				} );
+				expectThrow( "CArcImage::bin()"s + sDim, [ & ] { CArcImage<T>::bin( tView, 1, vSum.data() ); } );
+				expectThrow( "CArcImage::detectDefects()"s + sDim, [ & ]
+				{
+					arc::gen3::image::CBitMask cMask;
+
+					CArcImage<T>::detectDefects( vBuf.data(), uiCols, uiRows, cMask );
+				} );
+				expectThrow( "CArcHistogram::compute()"s + sDim, [ & ] { CArcHistogram<T>().compute( vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::getDiffStats()"s + sDim, [ & ] { CArcImage<T>::getDiffStats( vBuf.data(), vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcPtc::CArcPtc()"s + sDim, [ & ] { CArcPtc<T> cPtc( uiCols, uiRows ); } );
+				expectThrow( "CArcStack::CArcStack()"s + sDim, [ & ] { CArcStack<T> cStack( uiCols, uiRows ); } );
+				expectThrow( "CArcCombine::CArcCombine()"s + sDim, [ & ] { CArcCombine<T> cCombine( uiCols, uiRows ); } );
+				expectThrow( "CArcCalibrate::CArcCalibrate()"s + sDim, [ & ] { CArcCalibrate<T> cCalibrate( uiCols, uiRows ); } );
+				expectThrow( "CArcDisplayScale::scale()"s + sDim, [ & ]
+				{
+					std::vector<std::uint8_t> vPreview( 64 );
+
+					CArcDisplayScale<T>().scale( vBuf.data(), uiCols, uiRows, vPreview.data() );
+				} );
+				expectThrow( "CArcCentroid::find()"s + sDim, [ & ] { cCentroid.find( tView ); } );
+				expectThrow( "CArcFrameVerifier::CArcFrameVerifier()"s + sDim, [ & ] { CArcFrameVerifier<T> cNone( uiCols, uiRows ); } );
+				expectThrow( "CArcRampFit::CArcRampFit()"s + sDim, [ & ] { CArcRampFit<T> cNone( uiCols, uiRows ); } );
+				expectThrow( "CArcImage::checkRamp()"s + sDim, [ & ] { CArcImage<T>::checkRamp( tView ); } );
+				expectThrow( "CArcImage::checkConstant()"s + sDim, [ & ] { CArcImage<T>::checkConstant( tView, 7 ); } );
+				expectThrow( "CArcImage::add()"s + sDim, [ & ] { CArcImage<T>::add( vBuf.data(), vBuf.data(), vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::subtract()"s + sDim, [ & ] { CArcImage<T>::subtract( vBuf.data(), vBuf.data(), vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::multiply()"s + sDim, [ & ] { CArcImage<T>::multiply( vBuf.data(), vBuf.data(), vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::divide()"s + sDim, [ & ] { CArcImage<T>::divide( vBuf.data(), vBuf.data(), vBuf.data(), uiCols, uiRows ); } );
+				expectThrow( "CArcImage::scale()"s + sDim, [ & ] { CArcImage<T>::scale( vBuf.data(), vBuf.data(), uiCols, uiRows, 2.0 ); } );
+				expectThrow( "CArcImage::offset()"s + sDim, [ & ] { CArcImage<T>::offset( vBuf.data(), vBuf.data(), uiCols, uiRows, 1 ); } );
+				expectThrow( "CArcImage::getStats( ImageView )"s + sDim, [ & ]
+				{
+					arc::gen3::image::CStats cStats;
+
+					CArcImage<T>::getStats( arc::gen3::image::ImageView<const T>( vBuf.data(), uiCols, uiRows ), cStats );
+				} );
+
+				CArcImage<T>::subtractHalves( vBuf.data(), uiCols, uiRows );
+				CArcImage<T>::fillWithGradient( vBuf.data(), uiCols, uiRows );
+				CArcImage<T>::fillWithNoise( vBuf.data(), uiCols, uiRows, tModel, 1 );
+
+				if ( std::any_of( vBuf.begin(), vBuf.end(), [] ( T tValue ) { return ( tValue != 7 ); } ) )
+				{
+					throwArcGen3Error( "CArcImage::subtractHalves(), fillWithGradient() or fillWithNoise()%s modified the buffer!", sDim.c_str() );
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | verifyAll                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Runs every check over a grid of geometries and thread counts.                                            |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T> void CArcImageTest<T>::verifyAll( void )
+		{
+			const std::uint32_t uiDims[][ 2 ] = { { 1, 1 }, { 1, 7 }, { 9, 1 }, { 200, 1 }, { 33, 17 }, { 256, 64 }, { 1031, 129 } };
+
+			const std::uint32_t uiThreads[] = { 1, 3, 0 };
+
+			const std::uint32_t uiFactors[] = { 1, 2, 3, 8 };
+
+			const std::uint32_t uiReads[] = { 1, 2, 12 };
+
+			verifyEmpty();
+			verifyThreads();
+
+			for ( const auto& uiDim : uiDims )
+			{
+				verifyCentroid( uiDim[ 0 ], uiDim[ 1 ] );
+				verifyFrameVerifier( uiDim[ 0 ], uiDim[ 1 ] );
+
+				for ( auto uiThread : uiThreads )
+				{
+					verifyStats( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyChannelStats( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyHistogram( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyPtc( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyArithmetic( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyStack( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyCombine( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyCalibrate( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyViews( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyProfiles( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyMaskedStats( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyDefects( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyDisplayScale( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyRamp( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+					verifyGenerators( uiDim[ 0 ], uiDim[ 1 ], uiThread );
+
+					for ( auto uiFactor : uiFactors )
+					{
+						if ( uiFactor <= uiDim[ 0 ] && uiFactor <= uiDim[ 1 ] )
+						{
+							verifyBin( uiDim[ 0 ], uiDim[ 1 ], uiFactor, uiThread );
+						}
+					}
+
+					for ( auto uiRead : uiReads )
+					{
+						verifyRampFit( uiDim[ 0 ], uiDim[ 1 ], uiRead, uiThread );
+					}
+				}
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | compareStats                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Compares two statistics; the counts and extremes exactly, the moments to a relative error of 1e-9.       |
+		// |                                                                                                          |
+		// |  <IN>  -> cFound		- The statistics to check.                                                        |
+		// |  <IN>  -> cExpected	- The brute force statistics.                                                     |
+		// |  <IN>  -> sWhat		- Description of the tested method.                                               |
+		// |  <IN>  -> uiCols		- The number of image columns.                                                    |
+		// |  <IN>  -> uiRows		- The number of image rows.                                                       |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcImageTest<T>::compareStats( const arc::gen3::image::CStats& cFound, const arc::gen3::image::CStats& cExpected, const std::string& sWhat,
+											 const std::uint32_t uiCols, const std::uint32_t uiRows )
+		{
+			const struct { const char* pszName; double gFound; double gExpected; double gTolerance; } tValues[] =
+			{
+				{ "pixel count",		cFound.gTotalPixels,	cExpected.gTotalPixels,		0.0  },
+				{ "minimum",			cFound.gMin,			cExpected.gMin,				0.0  },
+				{ "maximum",			cFound.gMax,			cExpected.gMax,				0.0  },
+				{ "saturated count",	cFound.gSaturatedCount,	cExpected.gSaturatedCount,	0.0  },
+				{ "mean",				cFound.gMean,			cExpected.gMean,			1e-9 },
+				{ "variance",			cFound.gVariance,		cExpected.gVariance,		1e-9 },
+				{ "standard deviation",	cFound.gStdDev,			cExpected.gStdDev,			1e-9 }
+			};
+
+			for ( const auto& tValue : tValues )
+			{
+				if ( !isClose( tValue.gFound, tValue.gExpected, tValue.gTolerance ) )
+				{
+					throwArcGen3Error( "%s [ %u x %u ] %s mismatch! Expected: %f Found: %f", sWhat.c_str(), uiCols, uiRows, tValue.pszName,
+									   tValue.gExpected, tValue.gFound );
+				}
+			}
+		}
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcImageTest<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcImageTest<arc::gen3::image::BPP_32>;
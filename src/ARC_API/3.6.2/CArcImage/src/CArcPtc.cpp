@@ -0,0 +1,290 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcPtc.cpp  ( Gen3 )                                                                                    |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC photon transfer curve ( PTC ) engine.                                     |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <CArcPtc.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Creates a PTC engine that evaluates the whole image as a single region.                                 |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcPtc<T>::CArcPtc( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiThreads( 1 ), m_uiPairs( 0 ), m_gBias( 0.0 )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+
+			setRois( { { 0, uiCols, 0, uiRows } } );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcPtc<T>::~CArcPtc( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setRois                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the regions evaluated for every pair.                                                              |
+		// |                                                                                                          |
+		// |  <IN> -> vRois - The regions.                                                                            |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::out_of_range                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::setRois( const std::vector<arc::gen3::image::Roi_t>& vRois )
+		{
+			CArcImage<T>::verifyRegions( vRois, m_uiCols, m_uiRows );
+
+			m_vRois = vRois;
+
+			m_vStats.resize( m_vRois.size() );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setGrid                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the regions to a grid of uiSize x uiSize regions centered in uiColCount x uiRowCount equal cells.  |
+		// |                                                                                                          |
+		// |  <IN> -> uiColCount - The number of cells across the columns.                                            |
+		// |  <IN> -> uiRowCount - The number of cells across the rows.                                               |
+		// |  <IN> -> uiSize     - The region size ( in pixels ). Zero uses the whole cell.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::setGrid( const std::uint32_t uiColCount, const std::uint32_t uiRowCount, const std::uint32_t uiSize )
+		{
+			if ( uiColCount == 0 || uiRowCount == 0 || uiColCount > m_uiCols || uiRowCount > m_uiRows )
+			{
+				throwArcGen3InvalidArgument( "Invalid region grid [ %u x %u ] for image [ %u x %u ].", uiColCount, uiRowCount, m_uiCols, m_uiRows );
+			}
+
+			const std::uint32_t uiCellCols = ( m_uiCols / uiColCount );
+			const std::uint32_t uiCellRows = ( m_uiRows / uiRowCount );
+
+			if ( uiSize > uiCellCols || uiSize > uiCellRows )
+			{
+				throwArcGen3InvalidArgument( "Invalid region size [ %u ], must fit the grid cell [ %u x %u ].", uiSize, uiCellCols, uiCellRows );
+			}
+
+			const std::uint32_t uiWidth = ( uiSize == 0 ? uiCellCols : uiSize );
+			const std::uint32_t uiHeight = ( uiSize == 0 ? uiCellRows : uiSize );
+
+			std::vector<arc::gen3::image::Roi_t> vRois;
+
+			vRois.reserve( static_cast< std::size_t >( uiColCount ) * uiRowCount );
+
+			for ( std::uint32_t r = 0; r < uiRowCount; r++ )
+			{
+				for ( std::uint32_t c = 0; c < uiColCount; c++ )
+				{
+					const std::uint32_t uiCol1 = ( c * uiCellCols + ( uiCellCols - uiWidth ) / 2 );
+					const std::uint32_t uiRow1 = ( r * uiCellRows + ( uiCellRows - uiHeight ) / 2 );
+
+					vRois.push_back( { uiCol1, ( uiCol1 + uiWidth ), uiRow1, ( uiRow1 + uiHeight ) } );
+				}
+			}
+
+			setRois( vRois );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  rois                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the regions evaluated for every pair.                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::vector<arc::gen3::image::Roi_t>& CArcPtc<T>::rois( void ) const noexcept
+		{
+			return m_vRois;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setBias                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the bias level subtracted from the signal of every point added afterwards.                         |
+		// |                                                                                                          |
+		// |  <IN> -> gBias - The bias level ( ADU ).                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::setBias( const double gBias ) noexcept
+		{
+			m_gBias = gBias;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setThreads                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the number of threads each pair is split over.                                                     |
+		// |                                                                                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::setThreads( const std::uint32_t uiThreads ) noexcept
+		{
+			m_uiThreads = uiThreads;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  addPair                                                                                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Evaluates one flat field pair in a single fused pass and appends a point per region to the table.       |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf1     - Pointer to the first image buffer.                                                  |
+		// |  <IN> -> pBuf2     - Pointer to the second image buffer.                                                 |
+		// |  <IN> -> gExposure - The pair exposure time.                                                             |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::addPair( const T* pBuf1, const T* pBuf2, const double gExposure )
+		{
+			CArcImage<T>::getDiffStats( pBuf1, pBuf2, m_uiCols, m_uiRows, m_vRois, m_vStats.data(), m_uiThreads );
+
+			for ( std::size_t r = 0; r < m_vRois.size(); r++ )
+			{
+				const auto& rStats = m_vStats[ r ];
+
+				arc::gen3::image::PtcPoint_t tPoint;
+
+				tPoint.uiPair = m_uiPairs;
+				tPoint.uiRoi = static_cast< std::uint32_t >( r );
+				tPoint.gExposure = gExposure;
+				tPoint.gMean1 = rStats.cStats1.gMean;
+				tPoint.gMean2 = rStats.cStats2.gMean;
+				tPoint.gSignal = ( 0.5 * ( rStats.cStats1.gMean + rStats.cStats2.gMean ) - m_gBias );
+				tPoint.gVariance = ( 0.5 * rStats.cDiffStats.gVariance );
+				tPoint.gDiffMean = rStats.cDiffStats.gMean;
+				tPoint.gPixels = rStats.cDiffStats.gTotalPixels;
+				tPoint.gSaturated = ( rStats.cStats1.gSaturatedCount + rStats.cStats2.gSaturatedCount );
+
+				m_vTable.push_back( tPoint );
+			}
+
+			m_uiPairs++;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  addPairs                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Evaluates a sequence of flat field pairs and appends a point per pair and region to the table.          |
+		// |                                                                                                          |
+		// |  <IN> -> vFrames    - The frames; frames 2k and 2k + 1 form pair k.                                      |
+		// |  <IN> -> vExposures - The exposure time of each pair.                                                    |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::addPairs( const std::vector<const T*>& vFrames, const std::vector<double>& vExposures )
+		{
+			if ( vFrames.size() != ( 2 * vExposures.size() ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid pair sequence, %u frames do not form %u pairs.",
+											 static_cast< std::uint32_t >( vFrames.size() ), static_cast< std::uint32_t >( vExposures.size() ) );
+			}
+
+			m_vTable.reserve( m_vTable.size() + vExposures.size() * m_vRois.size() );
+
+			for ( std::size_t p = 0; p < vExposures.size(); p++ )
+			{
+				addPair( vFrames[ 2 * p ], vFrames[ 2 * p + 1 ], vExposures[ p ] );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  table                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the table of points, ordered by pair and then region.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::vector<arc::gen3::image::PtcPoint_t>& CArcPtc<T>::table( void ) const noexcept
+		{
+			return m_vTable;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  toString                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the table as text with one whitespace separated line per point and a '#' header line.           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::string CArcPtc<T>::toString( void ) const
+		{
+			std::string sTable = "# pair  roi     exposure        signal      variance         mean1         mean2      diffmean     pixels  saturated\n";
+
+			char szLine[ 256 ];
+
+			for ( const auto& rPoint : m_vTable )
+			{
+				std::snprintf( szLine, sizeof( szLine ), "%6u %4u %12.6g %13.6f %13.6f %13.6f %13.6f %13.6f %10.0f %10.0f\n",
+							   rPoint.uiPair, rPoint.uiRoi, rPoint.gExposure, rPoint.gSignal, rPoint.gVariance, rPoint.gMean1,
+							   rPoint.gMean2, rPoint.gDiffMean, rPoint.gPixels, rPoint.gSaturated );
+
+				sTable += szLine;
+			}
+
+			return sTable;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  clear                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Removes all points from the table.                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcPtc<T>::clear( void ) noexcept
+		{
+			m_vTable.clear();
+
+			m_uiPairs = 0;
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcPtc<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcPtc<arc::gen3::image::BPP_32>;
@@ -0,0 +1,427 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcRampFit.cpp  ( Gen3 )                                                                                |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC streaming up-the-ramp slope fitter.                                       |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <CArcRampFit.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		namespace
+		{
+			// Least-squares line through the n reads of a segment at segment read indexes 0 to n - 1, from the sums
+			// of y and k x y, with y relative to the first read. The intercept is at segment read index 0. Requires
+			// n >= 2.
+			inline void segmentFit( const double gN, const double gSumY, const double gSumKY, double& gSlope, double& gIntercept ) noexcept
+			{
+				const double gSumK = ( gN * ( gN - 1.0 ) / 2.0 );
+
+				const double gDenom = ( gN * gN * ( gN * gN - 1.0 ) / 12.0 );
+
+				gSlope = ( ( gN * gSumKY - gSumK * gSumY ) / gDenom );
+
+				gIntercept = ( ( gSumY - gSlope * gSumK ) / gN );
+			}
+
+			// Weight of a segment slope; the inverse of the read noise limited slope variance, up to a constant.
+			inline double segmentWeight( const double gN ) noexcept
+			{
+				return ( gN * ( gN * gN - 1.0 ) );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Allocates the accumulators for reads of the specified size.                                             |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols - The image column size ( in pixels ).                                                   |
+		// |  <IN> -> uiRows - The image row size ( in pixels ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcRampFit<T>::CArcRampFit( const std::uint32_t uiCols, const std::uint32_t uiRows )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiReads( 0 ), m_gReadTime( 1.0 ), m_uiSaturation( std::numeric_limits<T>::max() ),
+			  m_gJumpSigma( 0.0 ), m_gReadNoise( 0.0 ), m_gGain( 1.0 )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			m_vRef.resize( uiPixels );
+			m_vPrev.resize( uiPixels );
+			m_vCount.resize( uiPixels );
+			m_vSumY.resize( uiPixels );
+			m_vSumKY.resize( uiPixels );
+			m_vSlopeSum.resize( uiPixels );
+			m_vWeightSum.resize( uiPixels );
+			m_vIntercept.resize( uiPixels );
+			m_vQuality.resize( uiPixels );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcRampFit<T>::~CArcRampFit( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setReadTime                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the time between reads.                                                                            |
+		// |                                                                                                          |
+		// |  <IN> -> gSeconds - The read interval.                                                                   |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::setReadTime( const double gSeconds )
+		{
+			if ( !( gSeconds > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid read time [ %f ], must be positive.", gSeconds );
+			}
+
+			m_gReadTime = gSeconds;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setSaturation                                                                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Sets the saturation level. Applies to the reads added from now on.                                      |
+		// |                                                                                                          |
+		// |  <IN> -> uiLevel - Reads at or above this value are saturated.                                           |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::setSaturation( const T uiLevel ) noexcept
+		{
+			m_uiSaturation = uiLevel;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  setJumpDetection                                                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Enables or disables jump detection. Applies to the reads added from now on.                             |
+		// |                                                                                                          |
+		// |  <IN> -> gSigma     - The threshold ( standard deviations ). Zero disables jump detection.               |
+		// |  <IN> -> gReadNoise - The read noise of a single read ( ADU rms ).                                       |
+		// |  <IN> -> gGain      - The gain ( electrons / ADU ).                                                      |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::setJumpDetection( const double gSigma, const double gReadNoise, const double gGain )
+		{
+			if ( !( gSigma >= 0.0 && gReadNoise >= 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid jump threshold [ %f ] or read noise [ %f ], must not be negative.", gSigma, gReadNoise );
+			}
+
+			if ( !( gGain > 0.0 ) )
+			{
+				throwArcGen3InvalidArgument( "Invalid gain [ %f ], must be positive.", gGain );
+			}
+
+			m_gJumpSigma = gSigma;
+
+			m_gReadNoise = gReadNoise;
+
+			m_gGain = gGain;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds the next read of the ramp. A pixel that is neither saturated nor jumping costs one compare and     |
+		// |  two multiply-adds; saturation and jumps are rare and take the slow path. On a jump the current segment  |
+		// |  is folded into the weighted slope sums, and its intercept kept if it is the first segment, before a     |
+		// |  new segment starts at the read.                                                                         |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::length_error                                                         |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::add( const T* pBuf, const std::uint32_t uiThreads )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid buffer reference ( nullptr )."s );
+			}
+
+			if ( m_uiReads >= READS_MAX )
+			{
+				throwArcGen3LengthError( "Read limit reached [ %u ]!", m_uiReads );
+			}
+
+			const bool bFirst = ( m_uiReads == 0 );
+
+			const T uiSaturation = m_uiSaturation;
+
+			const bool bJumps = ( m_gJumpSigma > 0.0 );
+
+			const double gSigma2 = ( m_gJumpSigma * m_gJumpSigma );
+			const double gReadVar = ( m_gReadNoise * m_gReadNoise );
+			const double gInvGain = ( 1.0 / m_gGain );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiCount = ( static_cast< std::size_t >( uiLast - uiFirst ) * m_uiCols );
+
+				const T* pSrc = ( pBuf + uiOffset );
+
+				T* pRef = ( m_vRef.data() + uiOffset );
+				T* pPrev = ( m_vPrev.data() + uiOffset );
+				std::uint16_t* pCount = ( m_vCount.data() + uiOffset );
+				double* pSumY = ( m_vSumY.data() + uiOffset );
+				double* pSumKY = ( m_vSumKY.data() + uiOffset );
+				std::uint8_t* pQuality = ( m_vQuality.data() + uiOffset );
+
+				if ( bFirst )
+				{
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const bool bSaturated = ( pSrc[ i ] >= uiSaturation );
+
+						pRef[ i ] = pSrc[ i ];
+						pPrev[ i ] = pSrc[ i ];
+						pCount[ i ] = ( bSaturated ? 0 : 1 );
+						pQuality[ i ] = ( bSaturated ? arc::gen3::image::RAMP_SATURATED : 0 );
+					}
+
+					std::fill_n( pSumY, uiCount, 0.0 );
+					std::fill_n( pSumKY, uiCount, 0.0 );
+					std::fill_n( m_vSlopeSum.data() + uiOffset, uiCount, 0.0f );
+					std::fill_n( m_vWeightSum.data() + uiOffset, uiCount, 0.0f );
+
+					return;
+				}
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					if ( ( pQuality[ i ] & arc::gen3::image::RAMP_SATURATED ) != 0 )
+					{
+						continue;
+					}
+
+					const T uiValue = pSrc[ i ];
+
+					if ( uiValue >= uiSaturation )
+					{
+						pQuality[ i ] |= arc::gen3::image::RAMP_SATURATED;
+
+						continue;
+					}
+
+					const double gN = pCount[ i ];
+					const double gY = ( static_cast< double >( uiValue ) - static_cast< double >( pRef[ i ] ) );
+
+					if ( bJumps && gN >= 2.0 )
+					{
+						const double gA = ( 1.0 / ( gN - 1.0 ) );
+						const double gMean = ( ( static_cast< double >( pPrev[ i ] ) - static_cast< double >( pRef[ i ] ) ) * gA );
+						const double gDev = ( ( static_cast< double >( uiValue ) - static_cast< double >( pPrev[ i ] ) ) - gMean );
+
+						//  The departure shares the previous read with the mean difference, so its read noise variance is
+						//  ( 1 + ( 1 + a )^2 + a^2 ) x rn^2 for a = 1 / ( n - 1 ); its shot noise is ( 1 + a ) x mean / gain.
+						const double gVar = ( gReadVar * ( 1.0 + ( 1.0 + gA ) * ( 1.0 + gA ) + gA * gA ) + ( 1.0 + gA ) * std::max( gMean, 0.0 ) * gInvGain );
+
+						if ( gDev * gDev > gSigma2 * gVar )
+						{
+							double gSlope = 0.0;
+							double gIntercept = 0.0;
+
+							segmentFit( gN, pSumY[ i ], pSumKY[ i ], gSlope, gIntercept );
+
+							const double gWeight = segmentWeight( gN );
+
+							m_vSlopeSum[ uiOffset + i ] += static_cast< float >( gWeight * gSlope );
+							m_vWeightSum[ uiOffset + i ] += static_cast< float >( gWeight );
+
+							if ( ( pQuality[ i ] & arc::gen3::image::RAMP_JUMP ) == 0 )
+							{
+								m_vIntercept[ uiOffset + i ] = static_cast< float >( gIntercept + pRef[ i ] );
+							}
+
+							pQuality[ i ] |= arc::gen3::image::RAMP_JUMP;
+
+							pRef[ i ] = uiValue;
+							pPrev[ i ] = uiValue;
+							pCount[ i ] = 1;
+							pSumY[ i ] = 0.0;
+							pSumKY[ i ] = 0.0;
+
+							continue;
+						}
+					}
+
+					pSumY[ i ] += gY;
+					pSumKY[ i ] += ( gN * gY );
+					pPrev[ i ] = uiValue;
+					pCount[ i ] = static_cast< std::uint16_t >( pCount[ i ] + 1 );
+				}
+			} );
+
+			m_uiReads++;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  count                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of reads added.                                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcRampFit<T>::count( void ) const noexcept
+		{
+			return m_uiReads;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  fit                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes the fit of the reads added so far. The current segment of each pixel is fitted and combined      |
+		// |  with the ended segments without changing the accumulators, so the ramp may continue afterwards.         |
+		// |                                                                                                          |
+		// |  <OUT> -> pSlope     - Pointer to a buffer of cols x rows slopes.                                        |
+		// |  <OUT> -> pIntercept - Pointer to a buffer of cols x rows intercepts, or nullptr.                        |
+		// |  <OUT> -> pQuality   - Pointer to a buffer of cols x rows quality flags, or nullptr.                     |
+		// |  <IN>  -> uiThreads  - The number of threads. Zero uses one per hardware thread.                         |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument, std::runtime_error                                                        |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::fit( float* pSlope, float* pIntercept, std::uint8_t* pQuality, const std::uint32_t uiThreads ) const
+		{
+			if ( pSlope == nullptr )
+			{
+				throwArcGen3InvalidArgument( "Invalid slope buffer reference ( nullptr )."s );
+			}
+
+			if ( m_uiReads == 0 )
+			{
+				throwArcGen3Error( "No reads have been added!"s );
+			}
+
+			const double gInvTime = ( 1.0 / m_gReadTime );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiEnd = ( static_cast< std::size_t >( uiLast ) * m_uiCols );
+
+				for ( std::size_t i = uiOffset; i < uiEnd; i++ )
+				{
+					const double gN = m_vCount[ i ];
+
+					double gSlopeSum = m_vSlopeSum[ i ];
+					double gWeightSum = m_vWeightSum[ i ];
+
+					double gIntercept = ( gN > 0.0 ? static_cast< double >( m_vRef[ i ] ) : 0.0 );
+
+					if ( gN >= 2.0 )
+					{
+						double gSlope = 0.0;
+						double gSegIntercept = 0.0;
+
+						segmentFit( gN, m_vSumY[ i ], m_vSumKY[ i ], gSlope, gSegIntercept );
+
+						gSlopeSum += ( segmentWeight( gN ) * gSlope );
+						gWeightSum += segmentWeight( gN );
+
+						gIntercept += gSegIntercept;
+					}
+
+					std::uint8_t uiQuality = m_vQuality[ i ];
+
+					if ( ( uiQuality & arc::gen3::image::RAMP_JUMP ) != 0 )
+					{
+						gIntercept = m_vIntercept[ i ];
+					}
+
+					if ( gWeightSum > 0.0 )
+					{
+						pSlope[ i ] = static_cast< float >( ( gSlopeSum / gWeightSum ) * gInvTime );
+					}
+
+					else
+					{
+						pSlope[ i ] = 0.0f;
+
+						uiQuality |= arc::gen3::image::RAMP_NO_SLOPE;
+					}
+
+					if ( pIntercept != nullptr )
+					{
+						pIntercept[ i ] = static_cast< float >( gIntercept );
+					}
+
+					if ( pQuality != nullptr )
+					{
+						pQuality[ i ] = uiQuality;
+					}
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  clear                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Starts a new ramp. The next read initializes the accumulators, so they are not zeroed here.             |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcRampFit<T>::clear( void ) noexcept
+		{
+			m_uiReads = 0;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  memoryBytes                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the accumulator memory held by the fitter.                                                      |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcRampFit<T>::memoryBytes( void ) const noexcept
+		{
+			return ( static_cast< std::uint64_t >( m_vRef.size() ) * ( 2 * sizeof( T ) + sizeof( std::uint16_t ) + 2 * sizeof( double ) + 3 * sizeof( float ) + sizeof( std::uint8_t ) ) );
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcRampFit<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcRampFit<arc::gen3::image::BPP_32>;
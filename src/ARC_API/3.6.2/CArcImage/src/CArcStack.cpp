@@ -0,0 +1,339 @@
+// +------------------------------------------------------------------------------------------------------------------+
+// |  FILE:  CArcStack.cpp  ( Gen3 )                                                                                  |
+// +------------------------------------------------------------------------------------------------------------------+
+// |  PURPOSE: This file implements the ARC streaming frame stacker.                                                  |
+// |                                                                                                                  |
+// |  AUTHOR:  Scott Streit			DATE: March 26, 2020                                                              |
+// |                                                                                                                  |
+// |  Copyright 2014 Astronomical Research Cameras, Inc. All rights reserved.                                         |
+// +------------------------------------------------------------------------------------------------------------------+
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include <CArcStack.h>
+
+using namespace std::string_literals;
+
+
+
+namespace arc
+{
+	namespace gen3
+	{
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Constructor                                                                                              |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Allocates the accumulators for frames of the specified size.                                            |
+		// |                                                                                                          |
+		// |  <IN> -> uiCols    - The image column size ( in pixels ).                                                |
+		// |  <IN> -> uiRows    - The image row size ( in pixels ).                                                   |
+		// |  <IN> -> bVariance - true to accumulate the per-pixel variance.                                          |
+		// |                                                                                                          |
+		// |  Throws std::invalid_argument                                                                            |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcStack<T>::CArcStack( const std::uint32_t uiCols, const std::uint32_t uiRows, const bool bVariance )
+			: CArcBase(), m_uiCols( uiCols ), m_uiRows( uiRows ), m_uiCount( 0 ), m_bVariance( bVariance )
+		{
+			CArcImage<T>::verifyDimensions( uiCols, uiRows );
+
+			const std::size_t uiPixels = ( static_cast< std::size_t >( uiCols ) * uiRows );
+
+			m_vSum.resize( uiPixels );
+
+			if ( bVariance )
+			{
+				m_vRef.resize( uiPixels );
+
+				m_vSumSq.resize( uiPixels );
+			}
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// | Destructor                                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		CArcStack<T>::~CArcStack( void )
+		{
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  add                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Adds a frame to the stack. The first frame initializes the accumulators, so clear() does not need to    |
+		// |  zero them. The per-pixel loops have no branches and are vectorized by the compiler.                     |
+		// |                                                                                                          |
+		// |  <IN> -> pBuf      - Pointer to the image buffer.                                                        |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::add( const T* pBuf, const std::uint32_t uiThreads )
+		{
+			if ( pBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid buffer parameter ( nullptr )!"s );
+			}
+
+			if ( m_uiCount == std::numeric_limits<std::uint32_t>::max() )
+			{
+				throwArcGen3Error( "Frame limit reached [ %u ]!", m_uiCount );
+			}
+
+			const bool bFirst = ( m_uiCount == 0 );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiCount = ( static_cast< std::size_t >( uiLast - uiFirst ) * m_uiCols );
+
+				const T* pSrc = ( pBuf + uiOffset );
+				std::uint64_t* pSum = ( m_vSum.data() + uiOffset );
+
+				if ( bFirst )
+				{
+					std::copy( pSrc, pSrc + uiCount, pSum );
+
+					if ( m_bVariance )
+					{
+						std::copy( pSrc, pSrc + uiCount, m_vRef.data() + uiOffset );
+
+						std::fill_n( m_vSumSq.data() + uiOffset, uiCount, 0.0 );
+					}
+
+					return;
+				}
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pSum[ i ] += pSrc[ i ];
+				}
+
+				if ( m_bVariance )
+				{
+					const T* pRef = ( m_vRef.data() + uiOffset );
+					double* pSumSq = ( m_vSumSq.data() + uiOffset );
+
+					for ( std::size_t i = 0; i < uiCount; i++ )
+					{
+						const double gDev = ( static_cast< double >( pSrc[ i ] ) - static_cast< double >( pRef[ i ] ) );
+
+						pSumSq[ i ] += ( gDev * gDev );
+					}
+				}
+			} );
+
+			m_uiCount++;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  count                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the number of frames added.                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint32_t CArcStack<T>::count( void ) const noexcept
+		{
+			return m_uiCount;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  sum                                                                                                     |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the per-pixel sum of all frames.                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		const std::uint64_t* CArcStack<T>::sum( void ) const noexcept
+		{
+			return m_vSum.data();
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  mean                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes the per-pixel mean of all frames.                                                                |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to a buffer of cols x rows values.                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::mean( float* pDstBuf, const std::uint32_t uiThreads ) const
+		{
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid destination buffer parameter ( nullptr )!"s );
+			}
+
+			verifyCount();
+
+			const double gCount = static_cast< double >( m_uiCount );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiCount = ( static_cast< std::size_t >( uiLast - uiFirst ) * m_uiCols );
+
+				const std::uint64_t* pSum = ( m_vSum.data() + uiOffset );
+				float* pDst = ( pDstBuf + uiOffset );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = static_cast< float >( static_cast< double >( pSum[ i ] ) / gCount );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  mean                                                                                                    |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes the per-pixel mean of all frames rounded to the nearest integer.                                 |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to a buffer of cols x rows pixels.                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::mean( T* pDstBuf, const std::uint32_t uiThreads ) const
+		{
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid destination buffer parameter ( nullptr )!"s );
+			}
+
+			verifyCount();
+
+			const double gCount = static_cast< double >( m_uiCount );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiCount = ( static_cast< std::size_t >( uiLast - uiFirst ) * m_uiCols );
+
+				const std::uint64_t* pSum = ( m_vSum.data() + uiOffset );
+				T* pDst = ( pDstBuf + uiOffset );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					pDst[ i ] = static_cast< T >( static_cast< double >( pSum[ i ] ) / gCount + 0.5 );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  variance                                                                                                |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Writes the per-pixel sample variance of all frames. With d = x - ref, where ref is the first frame, the |
+		// |  variance is ( sum( d^2 ) - sum( d )^2 / N ) / ( N - 1 ). sum( d ) is exact, as it is derived from the   |
+		// |  integer sum, so the deviations from the first frame carry no cancellation error.                        |
+		// |                                                                                                          |
+		// |  <IN> -> pDstBuf   - Pointer to a buffer of cols x rows values.                                          |
+		// |  <IN> -> uiThreads - The number of threads. Zero uses one per hardware thread.                           |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::variance( float* pDstBuf, const std::uint32_t uiThreads ) const
+		{
+			if ( pDstBuf == nullptr )
+			{
+				throwArcGen3Error( "Invalid destination buffer parameter ( nullptr )!"s );
+			}
+
+			if ( !m_bVariance )
+			{
+				throwArcGen3Error( "Variance was not enabled for this stack!"s );
+			}
+
+			verifyCount();
+
+			const double gCount = static_cast< double >( m_uiCount );
+
+			const double gDenom = ( m_uiCount > 1 ? ( gCount - 1.0 ) : 1.0 );
+
+			const double gScale = ( m_uiCount > 1 ? 1.0 : 0.0 );
+
+			CArcImage<T>::forEachRowBlock( 0, m_uiRows, uiThreads, [ & ]( std::uint32_t, std::uint32_t uiFirst, std::uint32_t uiLast )
+			{
+				const std::size_t uiOffset = ( static_cast< std::size_t >( uiFirst ) * m_uiCols );
+				const std::size_t uiCount = ( static_cast< std::size_t >( uiLast - uiFirst ) * m_uiCols );
+
+				const std::uint64_t* pSum = ( m_vSum.data() + uiOffset );
+				const double* pSumSq = ( m_vSumSq.data() + uiOffset );
+				const T* pRef = ( m_vRef.data() + uiOffset );
+				float* pDst = ( pDstBuf + uiOffset );
+
+				for ( std::size_t i = 0; i < uiCount; i++ )
+				{
+					const double gSumDev = static_cast< double >( static_cast< std::int64_t >( pSum[ i ] - static_cast< std::uint64_t >( pRef[ i ] ) * m_uiCount ) );
+
+					const double gM2 = ( pSumSq[ i ] - ( gSumDev * gSumDev ) / gCount );
+
+					pDst[ i ] = static_cast< float >( ( gM2 > 0.0 ? gM2 : 0.0 ) * gScale / gDenom );
+				}
+			} );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  clear                                                                                                   |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Removes all frames from the stack. The accumulators are kept for reuse.                                 |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::clear( void ) noexcept
+		{
+			m_uiCount = 0;
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  memoryBytes                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Returns the accumulator memory held by the stack.                                                       |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		std::uint64_t CArcStack<T>::memoryBytes( void ) const noexcept
+		{
+			return ( m_vSum.capacity() * sizeof( std::uint64_t ) + m_vRef.capacity() * sizeof( T ) + m_vSumSq.capacity() * sizeof( double ) );
+		}
+
+
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  verifyCount                                                                                             |
+		// +----------------------------------------------------------------------------------------------------------+
+		// |  Throws if no frames have been added.                                                                    |
+		// |                                                                                                          |
+		// |  Throws std::runtime_error                                                                               |
+		// +----------------------------------------------------------------------------------------------------------+
+		template <typename T>
+		void CArcStack<T>::verifyCount( void ) const
+		{
+			if ( m_uiCount == 0 )
+			{
+				throwArcGen3Error( "No frames have been added to the stack!"s );
+			}
+		}
+
+
+	}	// end gen3 namespace
+}		// end arc namespace
+
+
+/** Explicit instantiations - These are the only allowed instantiations of this class */
+template class arc::gen3::CArcStack<arc::gen3::image::BPP_16>;
+template class arc::gen3::CArcStack<arc::gen3::image::BPP_32>;